@@ -0,0 +1,130 @@
+/**
+ * @file serialization_example.cpp
+ * @brief This example compares the size and speed of the xml and binary archives of a large trajectory
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/core/serialization.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Create a time parameterized raster program like the results of a process planner
+ * @param num_rasters The number of raster segments
+ * @param num_states The number of states of each raster segment
+ * @return The program
+ */
+CompositeInstruction createTrajectoryProgram(int num_rasters, int num_states)
+{
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3", "joint_4", "joint_5", "joint_6" };
+
+  StateWaypoint start(joint_names, Eigen::VectorXd::Zero(6));
+  CompositeInstruction program;
+  program.setStartInstruction(MoveInstruction(start, MoveInstructionType::START));
+
+  double time = 0;
+  for (int r = 0; r < num_rasters; ++r)
+  {
+    CompositeInstruction raster;
+    raster.setDescription("Raster #" + std::to_string(r + 1));
+    for (int i = 0; i < num_states; ++i)
+    {
+      StateWaypoint swp(joint_names, Eigen::VectorXd::Constant(6, static_cast<double>(i) / num_states));
+      swp.velocity = Eigen::VectorXd::Constant(6, 0.1);
+      swp.acceleration = Eigen::VectorXd::Zero(6);
+      swp.time = (time += 0.01);
+      raster.push_back(MoveInstruction(swp, MoveInstructionType::LINEAR));
+    }
+    program.push_back(raster);
+  }
+
+  return program;
+}
+
+/**
+ * @brief Time the serialization and deserialization of a program
+ * @param name The name of the archive format
+ * @param program The program to archive
+ * @param to_archive Serialize the program to a string
+ * @param from_archive Deserialize the program from a string
+ */
+void benchmark(const std::string& name,
+               const Instruction& program,
+               const std::function<std::string(const Instruction&)>& to_archive,
+               const std::function<Instruction(const std::string&)>& from_archive)
+{
+  using Clock = std::chrono::high_resolution_clock;
+  const int iterations = 5;
+
+  std::string archive;
+  auto t1 = Clock::now();
+  for (int i = 0; i < iterations; ++i)
+    archive = to_archive(program);
+  auto t2 = Clock::now();
+  for (int i = 0; i < iterations; ++i)
+    from_archive(archive);
+  auto t3 = Clock::now();
+
+  auto write_ms = std::chrono::duration<double, std::milli>(t2 - t1).count() / iterations;
+  auto read_ms = std::chrono::duration<double, std::milli>(t3 - t2).count() / iterations;
+  auto mb = static_cast<double>(archive.size()) / (1024.0 * 1024.0);
+  std::cout << name << ": " << mb << " MB, write: " << write_ms << " ms (" << mb / (write_ms / 1000.0)
+            << " MB/s), read: " << read_ms << " ms (" << mb / (read_ms / 1000.0) << " MB/s)" << std::endl;
+}
+
+int main()
+{
+  // A program the size of the results of planning ten long rasters
+  const Instruction program = createTrajectoryProgram(10, 1000);
+
+  benchmark(
+      "XML",
+      program,
+      [](const Instruction& p) { return Serialization::toArchiveStringXML<Instruction>(p); },
+      [](const std::string& s) { return Serialization::fromArchiveStringXML<Instruction>(s); });
+
+  benchmark(
+      "Binary",
+      program,
+      [](const Instruction& p) { return Serialization::toArchiveStringBinary<Instruction>(p); },
+      [](const std::string& s) { return Serialization::fromArchiveStringBinary<Instruction>(s); });
+
+  benchmark(
+      "Binary (gzip)",
+      program,
+      [](const Instruction& p) { return Serialization::toArchiveStringBinary<Instruction>(p, true); },
+      [](const std::string& s) { return Serialization::fromArchiveStringBinary<Instruction>(s); });
+
+  std::cout << "Execution Complete" << std::endl;
+
+  return 0;
+}
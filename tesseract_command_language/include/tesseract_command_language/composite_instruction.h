@@ -28,6 +28,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
 #include <vector>
 #include <string>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -48,6 +49,36 @@ enum class CompositeInstructionOrder
   ORDERED_AND_REVERABLE  // Can go forward or reverse the order
 };
 
+/**
+ * @brief The number of instructions in a composite and all of its children
+ *
+ * The move and plan counts match getInstructionCount() using moveFilter and planFilter, so start instructions are
+ * only counted for the top most composite. The total matches getInstructionCount() without a filter.
+ */
+struct CompositeInstructionCounts
+{
+  long move{ 0 };
+  long plan{ 0 };
+  long total{ 0 };
+};
+
+/**
+ * @brief A composite of instructions
+ *
+ * The child instructions are shared between copies and are only cloned when a copy is modified (copy-on-write), so
+ * copying a composite does not copy its children and modifying a copy only clones the path to the modified child.
+ *
+ * Whether the children are shared is tracked by their ownership, so a copy made after a mutable reference, pointer or
+ * iterator to the children has been handed out (ex. non-const begin() or getInstructions()) still shares them. Such a
+ * reference must not be used to modify the children once this composite has been copied, the same as for the
+ * implicitly shared containers of other libraries.
+ *
+ * The number of move, plan and total instructions of each child subtree is cached on first use so counting them and
+ * locating the n-th move or plan instruction do not walk the whole program. The cache is discarded when the children
+ * are modified and is not kept while a mutable reference to the children, or the children of a child composite, has
+ * been handed out. In that case the counts are computed by walking the program and the n-th move or plan instruction
+ * is located by walking the program until it is found.
+ */
 class CompositeInstruction
 {
 public:
@@ -55,6 +86,12 @@ public:
                        CompositeInstructionOrder order = CompositeInstructionOrder::ORDERED,
                        ManipulatorInfo manipulator_info = ManipulatorInfo());
 
+  ~CompositeInstruction() = default;
+  CompositeInstruction(const CompositeInstruction& other);
+  CompositeInstruction& operator=(const CompositeInstruction& other);
+  CompositeInstruction(CompositeInstruction&&) = default;
+  CompositeInstruction& operator=(CompositeInstruction&&) = default;
+
   CompositeInstructionOrder getOrder() const;
 
   void setDescription(const std::string& description);
@@ -81,6 +118,42 @@ public:
   std::vector<tesseract_planning::Instruction>& getInstructions();
   const std::vector<tesseract_planning::Instruction>& getInstructions() const;
 
+  /**
+   * @brief Get the number of move, plan and total instructions in this composite and its children
+   * @details This is constant time when the counts are cached, otherwise they are computed and cached if possible
+   * @return The instruction counts, where this is considered the top most composite
+   */
+  CompositeInstructionCounts getInstructionCounts() const;
+
+  /**
+   * @brief Cache the instruction counts of this composite and its children if they are not already cached
+   * @return False if they can not be cached because a mutable reference to the children, or the children of a child
+   * composite, has been handed out
+   */
+  bool cacheInstructionCounts() const;
+
+  /**
+   * @brief Get the n-th move instruction, this is the n-th element of flatten(*this, moveFilter)
+   * @details This is logarithmic in the number of children of each composite along the path when the counts are cached.
+   * The non-const overload only clones the composites along the path that are shared and does not prevent caching the
+   * counts, so the returned instruction must remain a move instruction of the same type when modified.
+   * @param n The index of the move instruction
+   * @return The move instruction, nullptr if out of range
+   */
+  const Instruction* getMoveInstructionAt(long n) const;
+  Instruction* getMoveInstructionAt(long n);
+
+  /**
+   * @brief Get the n-th plan instruction, this is the n-th element of flatten(*this, planFilter)
+   * @details This is logarithmic in the number of children of each composite along the path when the counts are cached.
+   * The non-const overload only clones the composites along the path that are shared and does not prevent caching the
+   * counts, so the returned instruction must remain a plan instruction of the same type when modified.
+   * @param n The index of the plan instruction
+   * @return The plan instruction, nullptr if out of range
+   */
+  const Instruction* getPlanInstructionAt(long n) const;
+  Instruction* getPlanInstructionAt(long n);
+
   void print(const std::string& prefix = "") const;
 
   bool operator==(const CompositeInstruction& rhs) const;
@@ -117,7 +190,7 @@ public:
 #ifndef SWIG
 
   template <class InputIt>
-  CompositeInstruction(InputIt first, InputIt last) : container_(first, last)
+  CompositeInstruction(InputIt first, InputIt last) : container_(std::make_shared<std::vector<value_type>>(first, last))
   {
   }
 
@@ -206,7 +279,10 @@ public:
   template <class InputIt>
   void insert(const_iterator pos, InputIt first, InputIt last)
   {
-    container_.insert(pos, first, last);
+    // The iterator may reference the shared children so it is converted to an index before detaching
+    const auto index = std::distance(container().cbegin(), pos);
+    auto& container = detach();
+    container.insert(container.cbegin() + index, first, last);
   }
 
   /** @brief constructs element in-place */
@@ -250,7 +326,16 @@ public:
 #endif  // SWIG
 
 private:
-  std::vector<value_type> container_;
+  /** @brief The child instructions, these are shared with copies of this composite until modified */
+  std::shared_ptr<std::vector<value_type>> container_;
+
+  /** @brief True if a mutable reference to the children has been handed out so their counts can not be cached */
+  bool dirty_{ false };
+
+  struct Index;
+
+  /** @brief The cached instruction counts of the children, nullptr if not cached */
+  mutable std::shared_ptr<const Index> index_;
 
   /** @brief The description of the instruction */
   std::string description_{ "Tesseract Composite Instruction" };
@@ -276,6 +361,56 @@ private:
    */
   value_type start_instruction_{ NullInstruction() };
 
+  /** @brief Get the children for reading */
+  const std::vector<value_type>& container() const;
+
+  /**
+   * @brief Get the children for modification without changing their order or types
+   * @details They are cloned if currently shared with a copy, the cached counts are kept
+   */
+  std::vector<value_type>& uniqueContainer();
+
+  /**
+   * @brief Get the children for modification, they are cloned if currently shared with a copy
+   * @details Nothing is written when the children are not shared and their counts are not cached
+   */
+  std::vector<value_type>& detach();
+
+  /**
+   * @brief Get the children for modification where a mutable reference to them is handed out
+   * @details The counts of the children are not cached until the children are replaced or cleared
+   */
+  std::vector<value_type>& mutableContainer();
+
+  /**
+   * @brief Get the cached instruction counts of the children, they are computed and cached if not cached
+   * @return The instruction counts, nullptr if they can not be cached
+   */
+  std::shared_ptr<const Index> index() const;
+
+  /** @brief Compute the instruction counts of the children without caching them */
+  Index computeIndex() const;
+
+  /**
+   * @brief Find the path to the n-th move or plan instruction through const access
+   * @param n The index of the instruction, this is decremented by the number of instructions skipped
+   * @param path The child indices to the instruction, the last index is -1 if it is the start instruction
+   * @return True if found
+   */
+  static bool findPath(const CompositeInstruction& composite,
+                       long& n,
+                       bool plan,
+                       bool first_composite,
+                       std::vector<long>& path);
+
+  /** @brief Get a child for locate(), the mutable overload clones the children if shared */
+  static const Instruction& locateChild(const CompositeInstruction& composite, std::size_t i);
+  static Instruction& locateChild(CompositeInstruction& composite, std::size_t i);
+
+  /** @brief Locate the n-th move or plan instruction */
+  template <typename CompositeT, typename InstructionT>
+  static InstructionT* locate(CompositeT& composite, long n, bool plan);
+
   friend class boost::serialization::access;
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
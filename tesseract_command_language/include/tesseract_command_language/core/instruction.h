@@ -28,11 +28,16 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/unique_ptr.hpp>
 #include <boost/type_traits/is_virtual_base_of.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -78,6 +83,12 @@ CREATE_MEMBER_FUNC_SIGNATURE_NOARGS_CHECK(getDescription, const std::string&);
 CREATE_MEMBER_FUNC_SIGNATURE_CHECK(setDescription, void, const std::string&);
 CREATE_MEMBER_FUNC_SIGNATURE_CHECK(print, void, std::string);
 
+/** @brief The size of the inline buffer of an Instruction, large enough for the instructions without a waypoint */
+constexpr std::size_t INSTRUCTION_BUFFER_SIZE = 64;
+
+/** @brief The inline buffer of an Instruction */
+using InstructionStorage = std::aligned_storage_t<INSTRUCTION_BUFFER_SIZE, alignof(std::max_align_t)>;
+
 struct InstructionInnerBase
 {
   InstructionInnerBase() = default;
@@ -109,7 +120,12 @@ struct InstructionInnerBase
   virtual const void* recover() const = 0;
 
   // This is not required for user defined implementation
-  virtual std::unique_ptr<InstructionInnerBase> clone() const = 0;
+  // Copy into the inline buffer if it fits, otherwise onto the heap
+  virtual InstructionInnerBase* clone(void* buffer) const = 0;
+
+  // This is not required for user defined implementation
+  // Move into the inline buffer, returns nullptr if it does not fit
+  virtual InstructionInnerBase* move(void* buffer) noexcept = 0;
 
 private:
   friend class boost::serialization::access;
@@ -140,7 +156,7 @@ struct InstructionInner final : InstructionInnerBase
   InstructionInner& operator=(InstructionInner&&) = delete;
 
   // Constructors from T (copy and move variants).
-  explicit InstructionInner(T instruction) : instruction_(std::move(instruction))
+  explicit InstructionInner(const T& instruction) : instruction_(instruction)
   {
     static_assert(has_member_getDescription<T>::value, "Class does not have member function 'getDescription'");
     static_assert(has_member_setDescription<T>::value, "Class does not have member function 'setDescription'");
@@ -164,7 +180,38 @@ struct InstructionInner final : InstructionInnerBase
     static_assert(has_member_func_signature_print<T>::value, "Class 'print' function has incorrect signature");
   }
 
-  std::unique_ptr<InstructionInnerBase> clone() const final { return std::make_unique<InstructionInner>(instruction_); }
+  /** @brief Small instructions which are nothrow movable are stored in the inline buffer of an Instruction */
+  static constexpr bool isStoredInline()
+  {
+    return (sizeof(InstructionInner) <= sizeof(InstructionStorage) &&
+            alignof(InstructionInner) <= alignof(InstructionStorage) && std::is_nothrow_move_constructible<T>::value);
+  }
+
+  /** @brief Construct in the buffer if it fits, otherwise on the heap */
+  template <typename U>
+  static InstructionInnerBase* create(void* buffer, U&& instruction)
+  {
+    if (isStoredInline())
+      return new (buffer) InstructionInner(std::forward<U>(instruction));
+
+    return new InstructionInner(std::forward<U>(instruction));
+  }
+
+  InstructionInnerBase* clone(void* buffer) const final
+  {
+    if (isStoredInline())
+      return new (buffer) InstructionInner(instruction_);
+
+    return new InstructionInner(instruction_);
+  }
+
+  InstructionInnerBase* move(void* buffer) noexcept final
+  {
+    if (!isStoredInline())
+      return nullptr;
+
+    return new (buffer) InstructionInner(std::move(instruction_));
+  }
 
   void* recover() final { return &instruction_; }
 
@@ -240,22 +287,31 @@ class Instruction
 public:
   template <typename T, generic_ctor_enabler<T> = 0>
   Instruction(T&& instruction)  // NOLINT
-    : instruction_(std::make_unique<detail_instruction::InstructionInner<uncvref_t<T>>>(instruction))
   {
+    using InnerType = detail_instruction::InstructionInner<uncvref_t<T>>;
+    instruction_ = InnerType::create(&buffer_, std::forward<T>(instruction));
   }
 
   // Destructor
-  ~Instruction() = default;
+  ~Instruction() { reset(); }
 
   // Copy constructor
-  Instruction(const Instruction& other) { instruction_ = other.instruction_->clone(); }
+  Instruction(const Instruction& other)
+  {
+    if (other.instruction_ != nullptr)
+      instruction_ = other.instruction_->clone(&buffer_);
+  }
 
   // Move ctor.
-  Instruction(Instruction&& other) noexcept { instruction_.swap(other.instruction_); }
+  Instruction(Instruction&& other) noexcept { take(other); }
   // Move assignment.
   Instruction& operator=(Instruction&& other) noexcept
   {
-    instruction_.swap(other.instruction_);
+    if (this != &other)
+    {
+      reset();
+      take(other);
+    }
     return (*this);
   }
 
@@ -309,18 +365,82 @@ private:
   friend class boost::serialization::access;
   friend struct tesseract_planning::Serialization;
 
-  Instruction()  // NOLINT
-    : instruction_(nullptr)
+  Instruction() = default;  // NOLINT
+
+  /** @brief Check if the instruction is stored in the inline buffer */
+  bool isInline() const noexcept
+  {
+    return (static_cast<const void*>(instruction_) == static_cast<const void*>(&buffer_));
+  }
+
+  /** @brief Destroy the stored instruction leaving this empty */
+  void reset() noexcept
+  {
+    if (instruction_ == nullptr)
+      return;
+
+    if (isInline())
+      instruction_->~InstructionInnerBase();
+    else
+      delete instruction_;
+
+    instruction_ = nullptr;
+  }
+
+  /** @brief Take the instruction stored in other, this must be empty and other is left empty */
+  void take(Instruction& other) noexcept
   {
+    if (other.isInline())
+    {
+      instruction_ = other.instruction_->move(&buffer_);
+      other.reset();
+    }
+    else
+    {
+      instruction_ = other.instruction_;
+      other.instruction_ = nullptr;
+    }
   }
 
+  // The archive format is the same as when the instruction was always held by a std::unique_ptr
   template <class Archive>
-  void serialize(Archive& ar, const unsigned int /*version*/)  // NOLINT
+  void save(Archive& ar, const unsigned int /*version*/) const
   {
-    ar& boost::serialization::make_nvp("instruction", instruction_);
+    std::unique_ptr<detail_instruction::InstructionInnerBase> instruction(instruction_);
+    try
+    {
+      ar& boost::serialization::make_nvp("instruction", instruction);
+    }
+    catch (...)
+    {
+      instruction.release();  // NOLINT
+      throw;
+    }
+    instruction.release();  // NOLINT
+  }
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int /*version*/)
+  {
+    std::unique_ptr<detail_instruction::InstructionInnerBase> instruction;
+    ar& boost::serialization::make_nvp("instruction", instruction);
+
+    reset();
+    if (instruction == nullptr)
+      return;
+
+    instruction_ = instruction->move(&buffer_);
+    if (instruction_ == nullptr)
+      instruction_ = instruction.release();
   }
 
-  std::unique_ptr<detail_instruction::InstructionInnerBase> instruction_;
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  /** @brief Storage for small instructions so they do not require a heap allocation */
+  detail_instruction::InstructionStorage buffer_;
+
+  /** @brief The stored instruction, this points to either the inline buffer or the heap */
+  detail_instruction::InstructionInnerBase* instruction_{ nullptr };
 };
 
 }  // namespace tesseract_planning
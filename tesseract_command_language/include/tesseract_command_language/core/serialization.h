@@ -33,14 +33,95 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+namespace detail_serialization
+{
+/** @brief The magic bytes at the start of a binary archive */
+constexpr std::array<char, 4> BINARY_ARCHIVE_MAGIC{ { 'T', 'C', 'L', 'B' } };
+
+/** @brief The version of the binary archive header, increment if the header layout changes */
+constexpr std::uint32_t BINARY_ARCHIVE_VERSION = 1;
+
+/** @brief Binary archive header flag indicating the archive following the header is gzip compressed */
+constexpr std::uint32_t BINARY_ARCHIVE_GZIP = 0x1;
+
+inline void writeUInt32(std::ostream& os, std::uint32_t value)
+{
+  // Always little endian so the header can be read on any platform
+  std::array<char, 4> bytes{};
+  for (std::size_t i = 0; i < bytes.size(); ++i)
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+
+  os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+inline std::uint32_t readUInt32(std::istream& is)
+{
+  std::array<char, 4> bytes{};
+  is.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+  std::uint32_t value{ 0 };
+  for (std::size_t i = 0; i < bytes.size(); ++i)
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+
+  return value;
+}
+
+/**
+ * @brief Write the binary archive header
+ * @param os The output stream
+ * @param compress Indicate if the archive following the header is gzip compressed
+ */
+inline void writeBinaryArchiveHeader(std::ostream& os, bool compress)
+{
+  os.write(BINARY_ARCHIVE_MAGIC.data(), static_cast<std::streamsize>(BINARY_ARCHIVE_MAGIC.size()));
+  writeUInt32(os, BINARY_ARCHIVE_VERSION);
+  writeUInt32(os, (compress) ? BINARY_ARCHIVE_GZIP : 0);
+}
+
+/**
+ * @brief Read and validate the binary archive header, this throws if the stream is not a supported binary archive
+ * @param is The input stream
+ * @return True if the archive following the header is gzip compressed
+ */
+inline bool readBinaryArchiveHeader(std::istream& is)
+{
+  std::array<char, 4> magic{};
+  is.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+  if (!is || magic != BINARY_ARCHIVE_MAGIC)
+    throw std::runtime_error("Serialization: the stream is not a tesseract binary archive!");
+
+  const std::uint32_t version = readUInt32(is);
+  const std::uint32_t flags = readUInt32(is);
+  if (!is)
+    throw std::runtime_error("Serialization: the binary archive header is truncated!");
+
+  if (version > BINARY_ARCHIVE_VERSION)
+    throw std::runtime_error("Serialization: the binary archive version " + std::to_string(version) +
+                             " is newer than the supported version " + std::to_string(BINARY_ARCHIVE_VERSION) + "!");
+
+  if ((flags & ~BINARY_ARCHIVE_GZIP) != 0)
+    throw std::runtime_error("Serialization: the binary archive has unsupported flags!");
+
+  return ((flags & BINARY_ARCHIVE_GZIP) != 0);
+}
+}  // namespace detail_serialization
+
 struct Serialization
 {
   template <typename SerializableType>
@@ -112,6 +193,102 @@ struct Serialization
 
     return archive_type;
   }
+
+  /**
+   * @brief Write a binary archive to a stream
+   *
+   * The archive is prefixed with a small versioned header which records if the archive is compressed. Binary archives
+   * are much smaller and faster than XML archives but are not portable between platforms with a different endianness
+   * or type sizes.
+   *
+   * @param archive_type The object to serialize
+   * @param os The output stream, this should be opened in binary mode
+   * @param compress If true the archive is gzip compressed
+   */
+  template <typename SerializableType>
+  static void toArchiveStreamBinary(const SerializableType& archive_type, std::ostream& os, bool compress = false)
+  {
+    detail_serialization::writeBinaryArchiveHeader(os, compress);
+
+    boost::iostreams::filtering_ostream fos;
+    if (compress)
+      fos.push(boost::iostreams::gzip_compressor());
+    fos.push(os);
+
+    {  // Must be scoped because all data is not written until the boost::archive::binary_oarchive goes out of scope
+      boost::archive::binary_oarchive oa(fos);
+
+      // Boost uses the same function for serialization and deserialization so it requires a non-const reference
+      // Because we are only serializing here it is safe to cast away const
+      oa << boost::serialization::make_nvp<SerializableType>("archive_type",
+                                                             const_cast<SerializableType&>(archive_type));
+    }
+
+    // Closing the chain flushes the compressor
+    fos.reset();
+  }
+
+  template <typename SerializableType>
+  static std::string toArchiveStringBinary(const SerializableType& archive_type, bool compress = false)
+  {
+    std::stringstream ss(std::ios_base::out | std::ios_base::binary);
+    toArchiveStreamBinary<SerializableType>(archive_type, ss, compress);
+    return ss.str();
+  }
+
+  template <typename SerializableType>
+  static bool toArchiveFileBinary(const SerializableType& archive_type,
+                                  const std::string& file_path,
+                                  bool compress = false)
+  {
+    std::ofstream os(file_path, std::ios_base::out | std::ios_base::binary);
+    if (!os.good())
+      return false;
+
+    toArchiveStreamBinary<SerializableType>(archive_type, os, compress);
+    return os.good();
+  }
+
+  /**
+   * @brief Read a binary archive written by toArchiveStreamBinary, compressed archives are detected from the header
+   * @param is The input stream, this should be opened in binary mode
+   * @return The deserialized object
+   */
+  template <typename SerializableType>
+  static SerializableType fromArchiveStreamBinary(std::istream& is)
+  {
+    const bool compressed = detail_serialization::readBinaryArchiveHeader(is);
+
+    boost::iostreams::filtering_istream fis;
+    if (compressed)
+      fis.push(boost::iostreams::gzip_decompressor());
+    fis.push(is);
+
+    SerializableType archive_type;
+    {
+      boost::archive::binary_iarchive ia(fis);
+      ia >> BOOST_SERIALIZATION_NVP(archive_type);
+    }
+
+    return archive_type;
+  }
+
+  template <typename SerializableType>
+  static SerializableType fromArchiveStringBinary(const std::string& archive_binary)
+  {
+    std::stringstream ss(archive_binary, std::ios_base::in | std::ios_base::binary);
+    return fromArchiveStreamBinary<SerializableType>(ss);
+  }
+
+  template <typename SerializableType>
+  static SerializableType fromArchiveFileBinary(const std::string& file_path)
+  {
+    std::ifstream ifs(file_path, std::ios_base::in | std::ios_base::binary);
+    if (!ifs.good())
+      throw std::runtime_error("Serialization: failed to open file '" + file_path + "'!");
+
+    return fromArchiveStreamBinary<SerializableType>(ifs);
+  }
 };
 
 }  // namespace tesseract_planning
@@ -28,12 +28,16 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/unique_ptr.hpp>
 #include <boost/type_traits/is_virtual_base_of.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -72,6 +76,12 @@ namespace detail_waypoint
 CREATE_MEMBER_CHECK(print);
 CREATE_MEMBER_FUNC_SIGNATURE_CHECK(print, void, std::string);
 
+/** @brief The size of the inline buffer of a Waypoint, large enough for a JointWaypoint */
+constexpr std::size_t WAYPOINT_BUFFER_SIZE = 80;
+
+/** @brief The inline buffer of a Waypoint */
+using WaypointStorage = std::aligned_storage_t<WAYPOINT_BUFFER_SIZE, alignof(std::max_align_t)>;
+
 struct WaypointInnerBase
 {
   WaypointInnerBase() = default;
@@ -98,7 +108,12 @@ struct WaypointInnerBase
   virtual const void* recover() const = 0;
 
   // This is not required for user defined implementation
-  virtual std::unique_ptr<WaypointInnerBase> clone() const = 0;
+  // Copy into the inline buffer if it fits, otherwise onto the heap
+  virtual WaypointInnerBase* clone(void* buffer) const = 0;
+
+  // This is not required for user defined implementation
+  // Move into the inline buffer, returns nullptr if it does not fit
+  virtual WaypointInnerBase* move(void* buffer) noexcept = 0;
 
 private:
   friend class boost::serialization::access;
@@ -123,7 +138,7 @@ struct WaypointInner final : WaypointInnerBase
   WaypointInner& operator=(WaypointInner&&) = delete;
 
   // Constructors from T (copy and move variants).
-  explicit WaypointInner(T waypoint) : waypoint_(std::move(waypoint))
+  explicit WaypointInner(const T& waypoint) : waypoint_(waypoint)
   {
     static_assert(has_member_print<T>::value, "Class does not have member function 'print'");
     static_assert(has_member_func_signature_print<T>::value, "Class 'print' function has incorrect signature");
@@ -134,7 +149,38 @@ struct WaypointInner final : WaypointInnerBase
     static_assert(has_member_func_signature_print<T>::value, "Class 'print' function has incorrect signature");
   }
 
-  std::unique_ptr<WaypointInnerBase> clone() const final { return std::make_unique<WaypointInner>(waypoint_); }
+  /** @brief Small waypoints which are nothrow movable are stored in the inline buffer of a Waypoint */
+  static constexpr bool isStoredInline()
+  {
+    return (sizeof(WaypointInner) <= sizeof(WaypointStorage) && alignof(WaypointInner) <= alignof(WaypointStorage) &&
+            std::is_nothrow_move_constructible<T>::value);
+  }
+
+  /** @brief Construct in the buffer if it fits, otherwise on the heap */
+  template <typename U>
+  static WaypointInnerBase* create(void* buffer, U&& waypoint)
+  {
+    if (isStoredInline())
+      return new (buffer) WaypointInner(std::forward<U>(waypoint));
+
+    return new WaypointInner(std::forward<U>(waypoint));
+  }
+
+  WaypointInnerBase* clone(void* buffer) const final
+  {
+    if (isStoredInline())
+      return new (buffer) WaypointInner(waypoint_);
+
+    return new WaypointInner(waypoint_);
+  }
+
+  WaypointInnerBase* move(void* buffer) noexcept final
+  {
+    if (!isStoredInline())
+      return nullptr;
+
+    return new (buffer) WaypointInner(std::move(waypoint_));
+  }
 
   std::type_index getType() const final { return std::type_index(typeid(T)); }
 
@@ -205,22 +251,31 @@ class Waypoint
 public:
   template <typename T, generic_ctor_enabler<T> = 0>
   Waypoint(T&& waypoint)  // NOLINT
-    : waypoint_(std::make_unique<detail_waypoint::WaypointInner<uncvref_t<T>>>(waypoint))
   {
+    using InnerType = detail_waypoint::WaypointInner<uncvref_t<T>>;
+    waypoint_ = InnerType::create(&buffer_, std::forward<T>(waypoint));
   }
 
   // Destructor
-  ~Waypoint() = default;
+  ~Waypoint() { reset(); }
 
   // Copy constructor
-  Waypoint(const Waypoint& other) { waypoint_ = other.waypoint_->clone(); }
+  Waypoint(const Waypoint& other)
+  {
+    if (other.waypoint_ != nullptr)
+      waypoint_ = other.waypoint_->clone(&buffer_);
+  }
 
   // Move ctor.
-  Waypoint(Waypoint&& other) noexcept { waypoint_.swap(other.waypoint_); }
+  Waypoint(Waypoint&& other) noexcept { take(other); }
   // Move assignment.
   Waypoint& operator=(Waypoint&& other) noexcept
   {
-    waypoint_.swap(other.waypoint_);
+    if (this != &other)
+    {
+      reset();
+      take(other);
+    }
     return (*this);
   }
 
@@ -270,18 +325,82 @@ private:
   friend class boost::serialization::access;
   friend struct tesseract_planning::Serialization;
 
-  Waypoint()  // NOLINT
-    : waypoint_(nullptr)
+  Waypoint() = default;  // NOLINT
+
+  /** @brief Check if the waypoint is stored in the inline buffer */
+  bool isInline() const noexcept
+  {
+    return (static_cast<const void*>(waypoint_) == static_cast<const void*>(&buffer_));
+  }
+
+  /** @brief Destroy the stored waypoint leaving this empty */
+  void reset() noexcept
+  {
+    if (waypoint_ == nullptr)
+      return;
+
+    if (isInline())
+      waypoint_->~WaypointInnerBase();
+    else
+      delete waypoint_;
+
+    waypoint_ = nullptr;
+  }
+
+  /** @brief Take the waypoint stored in other, this must be empty and other is left empty */
+  void take(Waypoint& other) noexcept
   {
+    if (other.isInline())
+    {
+      waypoint_ = other.waypoint_->move(&buffer_);
+      other.reset();
+    }
+    else
+    {
+      waypoint_ = other.waypoint_;
+      other.waypoint_ = nullptr;
+    }
   }
 
+  // The archive format is the same as when the waypoint was always held by a std::unique_ptr
   template <class Archive>
-  void serialize(Archive& ar, const unsigned int /*version*/)  // NOLINT
+  void save(Archive& ar, const unsigned int /*version*/) const
   {
-    ar& boost::serialization::make_nvp("waypoint", waypoint_);
+    std::unique_ptr<detail_waypoint::WaypointInnerBase> waypoint(waypoint_);
+    try
+    {
+      ar& boost::serialization::make_nvp("waypoint", waypoint);
+    }
+    catch (...)
+    {
+      waypoint.release();  // NOLINT
+      throw;
+    }
+    waypoint.release();  // NOLINT
+  }
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int /*version*/)
+  {
+    std::unique_ptr<detail_waypoint::WaypointInnerBase> waypoint;
+    ar& boost::serialization::make_nvp("waypoint", waypoint);
+
+    reset();
+    if (waypoint == nullptr)
+      return;
+
+    waypoint_ = waypoint->move(&buffer_);
+    if (waypoint_ == nullptr)
+      waypoint_ = waypoint.release();
   }
 
-  std::unique_ptr<detail_waypoint::WaypointInnerBase> waypoint_;
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  /** @brief Storage for small waypoints so they do not require a heap allocation */
+  detail_waypoint::WaypointStorage buffer_;
+
+  /** @brief The stored waypoint, this points to either the inline buffer or the heap */
+  detail_waypoint::WaypointInnerBase* waypoint_{ nullptr };
 };
 
 }  // namespace tesseract_planning
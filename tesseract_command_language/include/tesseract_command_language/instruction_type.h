@@ -46,6 +46,8 @@ bool isPlanInstruction(const Instruction& instruction);
 
 bool isNullInstruction(const Instruction& instruction);
 
+bool isTrajectorySegmentInstruction(const Instruction& instruction);
+
 }  // namespace tesseract_planning
 
 #endif  // TESSERACT_COMMAND_LANGUAGE_INSTRUCTION_TYPE_H
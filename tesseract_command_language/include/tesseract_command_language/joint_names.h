@@ -0,0 +1,114 @@
+/**
+ * @file joint_names.h
+ * @brief An interned, immutable set of joint names
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_COMMAND_LANGUAGE_JOINT_NAMES_H
+#define TESSERACT_COMMAND_LANGUAGE_JOINT_NAMES_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_planning
+{
+/**
+ * @brief A handle to an interned, immutable list of joint names
+ *
+ * All handles created from the same ordered list of names share a single copy, so copying a handle does not copy any
+ * strings and comparing two handles is a pointer compare. The hash of the names is computed once when interned.
+ *
+ * The names are released once the last handle referencing them is destroyed.
+ */
+class JointNames
+{
+public:
+  /** @brief Construct an empty set of joint names */
+  JointNames() = default;
+
+  /**
+   * @brief Intern the provided joint names
+   * @param joint_names The ordered joint names
+   */
+  JointNames(std::vector<std::string> joint_names);  // NOLINT
+
+  /**
+   * @brief Intern the provided joint names
+   * @param joint_names The ordered joint names
+   */
+  JointNames(std::initializer_list<std::string> joint_names);
+
+  /** @brief Get the joint names */
+  const std::vector<std::string>& get() const;
+
+  /** @brief Allows the handle to be passed where a vector of joint names is expected */
+  operator const std::vector<std::string>&() const;  // NOLINT
+
+  std::size_t size() const;
+  bool empty() const;
+  const std::string& operator[](std::size_t i) const;
+  std::vector<std::string>::const_iterator begin() const;
+  std::vector<std::string>::const_iterator end() const;
+
+  /** @brief The hash of the joint names, zero if empty */
+  std::size_t hash() const;
+
+  /**
+   * @brief Equal operator, because the names are interned this is a pointer compare
+   * @param rhs JointNames
+   * @return True if the joint names are identical, including order
+   */
+  bool operator==(const JointNames& rhs) const;
+
+  /**
+   * @brief Not equal operator, because the names are interned this is a pointer compare
+   * @param rhs JointNames
+   * @return True if the joint names are not identical
+   */
+  bool operator!=(const JointNames& rhs) const;
+
+private:
+  struct Data
+  {
+    std::vector<std::string> names;
+    std::size_t hash{ 0 };
+  };
+
+  /** @brief The interned names, nullptr if empty */
+  std::shared_ptr<const Data> data_;
+
+  static std::shared_ptr<const Data> intern(std::vector<std::string> joint_names);
+};
+
+bool operator==(const JointNames& lhs, const std::vector<std::string>& rhs);
+bool operator==(const std::vector<std::string>& lhs, const JointNames& rhs);
+bool operator!=(const JointNames& lhs, const std::vector<std::string>& rhs);
+bool operator!=(const std::vector<std::string>& lhs, const JointNames& rhs);
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_COMMAND_LANGUAGE_JOINT_NAMES_H
@@ -34,6 +34,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/core/waypoint.h>
+#include <tesseract_command_language/joint_names.h>
 #include <tesseract_common/utils.h>
 
 namespace tesseract_planning
@@ -61,14 +62,14 @@ public:
 
   // This constructor allows you to construct MyVectorType from Eigen expressions
   template <typename OtherDerived>
-  JointWaypoint(std::vector<std::string> joint_names, const Eigen::MatrixBase<OtherDerived>& other)
+  JointWaypoint(JointNames joint_names, const Eigen::MatrixBase<OtherDerived>& other)
     : waypoint(other), joint_names(std::move(joint_names))
   {
     if (static_cast<Eigen::Index>(this->joint_names.size()) != this->waypoint.rows())
       throw std::runtime_error("JointWaypoint: joint_names is not the same size as position!");
   }
 
-  JointWaypoint(std::vector<std::string> joint_names, std::initializer_list<double> l)
+  JointWaypoint(JointNames joint_names, std::initializer_list<double> l)
     : joint_names(std::move(joint_names))
   {
     waypoint.resize(static_cast<Eigen::Index>(l.size()));
@@ -194,7 +195,8 @@ public:
 #endif  // SWIG
 
   Eigen::VectorXd waypoint;
-  std::vector<std::string> joint_names;
+  /** @brief The joint names, these are interned and shared between waypoints */
+  JointNames joint_names;
   /** @brief Joint distance below waypoint that is allowed. Each element should be <= 0 */
   Eigen::VectorXd lower_tolerance;
   /** @brief Joint distance above waypoint that is allowed. Each element should be >= 0 */
@@ -29,11 +29,14 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <any>
+#include <atomic>
 #include <iostream>
 #include <typeindex>
 #include <unordered_map>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #ifdef SWIG
@@ -49,6 +52,10 @@ namespace tesseract_planning
  *      - The key is the profile name
  *      - Where std::shared_ptr<const T> is the profile
  *    The ProfleEntry<T> is also stored in std::unordered_map where the key here is the std::type_index(typeid(T))
+ *
+ *    The profiles are stored as an immutable snapshot. Readers atomically load the current snapshot and never lock or
+ *    copy the profile maps, while writers are serialized, copy the part of the snapshot they modify and atomically
+ *    publish the new snapshot. A reader holding a snapshot is not affected by later writes.
  * @note When adding a profile entry the T should be the base class type.
  */
 class ProfileDictionary
@@ -57,6 +64,29 @@ public:
   using Ptr = std::shared_ptr<ProfileDictionary>;
   using ConstPtr = std::shared_ptr<const ProfileDictionary>;
 
+  template <typename ProfileType>
+  using ProfileEntry = std::unordered_map<std::string, std::shared_ptr<const ProfileType>>;
+
+  /**
+   * @brief Get the revision of the profiles
+   * @details This is incremented every time the profiles are modified, so it can be used to check if anything derived
+   * from the profiles is out of date
+   */
+  std::size_t getRevision() const { return revision_.load(); }
+
+  /**
+   * @brief Get the fingerprint of the profiles
+   * @details The profiles are opaque, so rather than hashing their contents every published snapshot is given a
+   * fingerprint which is unique within the process. Two dictionaries, or two revisions of a dictionary, never share a
+   * fingerprint, so an equal fingerprint guarantees the same profiles. This is serialized with the writers so the
+   * fingerprint always matches the current snapshot.
+   */
+  std::size_t getFingerprint() const
+  {
+    std::scoped_lock lock(mutex_);
+    return fingerprint_;
+  }
+
   /**
    * @brief Check if a profile entry exists
    * @return True if exists, otherwise false
@@ -64,34 +94,51 @@ public:
   template <typename ProfileType>
   bool hasProfileEntry() const
   {
-    std::shared_lock lock(mutex_);
-    return (profiles_.find(std::type_index(typeid(ProfileType))) != profiles_.end());
+    return (getProfileEntrySnapshot<ProfileType>() != nullptr);
   }
 
   /** @brief Remove a profile entry */
   template <typename ProfileType>
   void removeProfileEntry()
   {
-    std::unique_lock lock(mutex_);
-    profiles_.erase(std::type_index(typeid(ProfileType)));
+    std::scoped_lock lock(mutex_);
+    auto profiles = std::make_shared<ProfileEntries>(*snapshot());
+    profiles->erase(std::type_index(typeid(ProfileType)));
+    publish(std::move(profiles));
   }
 
   /**
    * @brief Get a profile entry
+   * @details This copies the profile map, use getProfileEntrySnapshot() to avoid the copy
    * @return The profile map associated with the profile entry
    */
   template <typename ProfileType>
-  std::unordered_map<std::string, std::shared_ptr<const ProfileType>> getProfileEntry() const
+  ProfileEntry<ProfileType> getProfileEntry() const
   {
-    std::shared_lock lock(mutex_);
-    auto it = profiles_.find(std::type_index(typeid(ProfileType)));
-    if (it != profiles_.end())
-      return std::any_cast<const std::unordered_map<std::string, std::shared_ptr<const ProfileType>>&>(it->second);
+    std::shared_ptr<const ProfileEntry<ProfileType>> entry = getProfileEntrySnapshot<ProfileType>();
+    if (entry != nullptr)
+      return *entry;
 
     throw std::runtime_error("Profile entry does not exist for type name " +
                              std::string(std::type_index(typeid(ProfileType)).name()));
   }
 
+  /**
+   * @brief Get an immutable snapshot of a profile entry without copying it
+   * @details The snapshot is not affected by profiles added or removed after it was taken
+   * @return The profile map associated with the profile entry, nullptr if it does not exist
+   */
+  template <typename ProfileType>
+  std::shared_ptr<const ProfileEntry<ProfileType>> getProfileEntrySnapshot() const
+  {
+    std::shared_ptr<const ProfileEntries> profiles = snapshot();
+    auto it = profiles->find(std::type_index(typeid(ProfileType)));
+    if (it == profiles->end())
+      return nullptr;
+
+    return std::any_cast<const std::shared_ptr<const ProfileEntry<ProfileType>>&>(it->second);
+  }
+
   /**
    * @brief Add a profile
    * @details If the profile entry does not exist it will create one
@@ -107,19 +154,19 @@ public:
     if (profile == nullptr)
       throw std::runtime_error("Adding profile that is a nullptr");
 
-    std::unique_lock lock(mutex_);
-    auto it = profiles_.find(std::type_index(typeid(ProfileType)));
-    if (it != profiles_.end())
-    {
-      std::any_cast<std::unordered_map<std::string, std::shared_ptr<const ProfileType>>&>(it->second)[profile_name] =
-          profile;
-    }
+    std::scoped_lock lock(mutex_);
+    auto profiles = std::make_shared<ProfileEntries>(*snapshot());
+    auto it = profiles->find(std::type_index(typeid(ProfileType)));
+    std::shared_ptr<ProfileEntry<ProfileType>> entry;
+    if (it != profiles->end())
+      entry = std::make_shared<ProfileEntry<ProfileType>>(
+          *std::any_cast<const std::shared_ptr<const ProfileEntry<ProfileType>>&>(it->second));
     else
-    {
-      std::unordered_map<std::string, std::shared_ptr<const ProfileType>> new_entry;
-      new_entry[profile_name] = profile;
-      profiles_[std::type_index(typeid(ProfileType))] = new_entry;
-    }
+      entry = std::make_shared<ProfileEntry<ProfileType>>();
+
+    (*entry)[profile_name] = profile;
+    (*profiles)[std::type_index(typeid(ProfileType))] = std::shared_ptr<const ProfileEntry<ProfileType>>(entry);
+    publish(std::move(profiles));
   }
 
   /**
@@ -130,17 +177,7 @@ public:
   template <typename ProfileType>
   bool hasProfile(const std::string& profile_name) const
   {
-    std::shared_lock lock(mutex_);
-    auto it = profiles_.find(std::type_index(typeid(ProfileType)));
-    if (it != profiles_.end())
-    {
-      const auto& profile_map =
-          std::any_cast<const std::unordered_map<std::string, std::shared_ptr<const ProfileType>>&>(it->second);
-      auto it2 = profile_map.find(profile_name);
-      if (it2 != profile_map.end())
-        return true;
-    }
-    return false;
+    return (findProfile<ProfileType>(profile_name) != nullptr);
   }
 
   /**
@@ -152,11 +189,32 @@ public:
   template <typename ProfileType>
   std::shared_ptr<const ProfileType> getProfile(const std::string& profile_name) const
   {
-    std::shared_lock lock(mutex_);
-    auto it = profiles_.at(std::type_index(typeid(ProfileType)));
-    const auto& profile_map =
-        std::any_cast<const std::unordered_map<std::string, std::shared_ptr<const ProfileType>>&>(it);
-    return profile_map.at(profile_name);
+    std::shared_ptr<const ProfileEntry<ProfileType>> entry = getProfileEntrySnapshot<ProfileType>();
+    if (entry == nullptr)
+      throw std::out_of_range("Profile entry does not exist for type name " +
+                              std::string(std::type_index(typeid(ProfileType)).name()));
+
+    return entry->at(profile_name);
+  }
+
+  /**
+   * @brief Find a profile by name
+   * @details This is the same as calling hasProfile() followed by getProfile() but only looks up the profile once
+   * @param profile_name The profile name
+   * @return The profile, nullptr if it does not exist
+   */
+  template <typename ProfileType>
+  std::shared_ptr<const ProfileType> findProfile(const std::string& profile_name) const
+  {
+    std::shared_ptr<const ProfileEntry<ProfileType>> entry = getProfileEntrySnapshot<ProfileType>();
+    if (entry == nullptr)
+      return nullptr;
+
+    auto it = entry->find(profile_name);
+    if (it == entry->end())
+      return nullptr;
+
+    return it->second;
   }
 
   /**
@@ -166,16 +224,55 @@ public:
   template <typename ProfileType>
   void removeProfile(const std::string& profile_name)
   {
-    std::unique_lock lock(mutex_);
-    auto it = profiles_.find(std::type_index(typeid(ProfileType)));
-    if (it != profiles_.end())
-      std::any_cast<std::unordered_map<std::string, std::shared_ptr<const ProfileType>>&>(it->second)
-          .erase(profile_name);
+    std::scoped_lock lock(mutex_);
+    std::shared_ptr<const ProfileEntries> current = snapshot();
+    auto it = current->find(std::type_index(typeid(ProfileType)));
+    if (it == current->end())
+      return;
+
+    auto entry = std::make_shared<ProfileEntry<ProfileType>>(
+        *std::any_cast<const std::shared_ptr<const ProfileEntry<ProfileType>>&>(it->second));
+    if (entry->erase(profile_name) == 0)
+      return;
+
+    auto profiles = std::make_shared<ProfileEntries>(*current);
+    (*profiles)[std::type_index(typeid(ProfileType))] = std::shared_ptr<const ProfileEntry<ProfileType>>(entry);
+    publish(std::move(profiles));
   }
 
 protected:
-  std::unordered_map<std::type_index, std::any> profiles_;
-  mutable std::shared_mutex mutex_;
+  /** @brief The profile entries, each std::any stores a std::shared_ptr<const ProfileEntry<T>> */
+  using ProfileEntries = std::unordered_map<std::type_index, std::any>;
+
+  /** @brief The current snapshot, this is never modified only replaced */
+  std::shared_ptr<const ProfileEntries> profiles_{ std::make_shared<const ProfileEntries>() };
+
+  /** @brief Serializes writers and getFingerprint(), readers of the profiles do not lock */
+  mutable std::mutex mutex_;
+
+  /** @brief Incremented every time a new snapshot is published */
+  std::atomic<std::size_t> revision_{ 0 };
+
+  /** @brief The fingerprint of the current snapshot, guarded by the mutex */
+  std::size_t fingerprint_{ nextFingerprint() };
+
+  /** @brief Get a fingerprint which was not given to any other snapshot */
+  static std::size_t nextFingerprint()
+  {
+    static std::atomic<std::size_t> counter{ 0 };
+    return ++counter;
+  }
+
+  /** @brief Get the current snapshot of the profile entries */
+  std::shared_ptr<const ProfileEntries> snapshot() const { return std::atomic_load(&profiles_); }
+
+  /** @brief Publish a new snapshot, the caller must hold the mutex */
+  void publish(std::shared_ptr<ProfileEntries> profiles)
+  {
+    std::atomic_store(&profiles_, std::shared_ptr<const ProfileEntries>(std::move(profiles)));
+    fingerprint_ = nextFingerprint();
+    ++revision_;
+  }
 };
 }  // namespace tesseract_planning
 
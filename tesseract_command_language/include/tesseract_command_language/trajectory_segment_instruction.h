@@ -0,0 +1,197 @@
+/**
+ * @file trajectory_segment_instruction.h
+ * @brief A flat trajectory container which stores each quantity in a contiguous block
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_COMMAND_LANGUAGE_TRAJECTORY_SEGMENT_INSTRUCTION_H
+#define TESSERACT_COMMAND_LANGUAGE_TRAJECTORY_SEGMENT_INSTRUCTION_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <Eigen/Core>
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/core/instruction.h>
+#include <tesseract_common/joint_state.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A trajectory stored as a structure of arrays.
+ *
+ * The joint names are stored once for the whole segment and the positions, velocities, accelerations and efforts are
+ * stored in column-major matrices of size dof x size, so the data of a single state is a contiguous column which can be
+ * accessed without copying (ex. getPositions().col(i)). Every block is always sized to match the segment and the times
+ * are the time from start of each state.
+ *
+ * This is intended for large planner results where storing a MoveInstruction with a StateWaypoint for every state is
+ * expensive. The planners do not produce or consume segments yet, moveFilter does not match them and the process
+ * planners and contact checks reject programs containing them (see hasTrajectorySegment).
+ */
+class TrajectorySegmentInstruction
+{
+public:
+  TrajectorySegmentInstruction() = default;  // Required for boost serialization do not use
+  TrajectorySegmentInstruction(std::vector<std::string> joint_names, Eigen::Index size);
+
+  /**
+   * @brief Construct a segment whose number of joints does not come from the joint names
+   * @param joint_names The joint names shared by all states, these are only metadata
+   * @param dof The number of joints of each state
+   * @param size The number of states
+   */
+  TrajectorySegmentInstruction(std::vector<std::string> joint_names, Eigen::Index dof, Eigen::Index size);
+
+  /**
+   * @brief Construct from a joint trajectory
+   *
+   * Throws if the states do not all share the same joint names.
+   * @param trajectory The joint trajectory to copy
+   */
+  explicit TrajectorySegmentInstruction(const tesseract_common::JointTrajectory& trajectory);
+
+  const std::string& getDescription() const;
+
+  void setDescription(const std::string& description);
+
+  const std::string& getProfile() const;
+
+  void setProfile(const std::string& profile);
+
+  void print(const std::string& prefix = "") const;  // NOLINT
+
+  /** @brief Get the joint names shared by all states */
+  const std::vector<std::string>& getJointNames() const;
+
+  /** @brief The number of states in the segment */
+  Eigen::Index size() const;
+
+  /** @brief The number of joints of each state, which is the number of rows of the blocks */
+  Eigen::Index dof() const;
+
+  /** @brief Check if the segment has no states */
+  bool empty() const;
+
+  /**
+   * @brief Resize the segment, existing states are preserved and new states are zero initialized
+   * @param size The new number of states
+   */
+  void resize(Eigen::Index size);
+
+  /** @brief The joint positions, each column is a state */
+  Eigen::MatrixXd& getPositions();
+  const Eigen::MatrixXd& getPositions() const;
+
+  /** @brief The joint velocities, each column is a state */
+  Eigen::MatrixXd& getVelocities();
+  const Eigen::MatrixXd& getVelocities() const;
+
+  /** @brief The joint accelerations, each column is a state */
+  Eigen::MatrixXd& getAccelerations();
+  const Eigen::MatrixXd& getAccelerations() const;
+
+  /** @brief The joint efforts, each column is a state */
+  Eigen::MatrixXd& getEfforts();
+  const Eigen::MatrixXd& getEfforts() const;
+
+  /** @brief The time from start of each state */
+  Eigen::VectorXd& getTimes();
+  const Eigen::VectorXd& getTimes() const;
+
+  /**
+   * @brief Get a copy of a single state
+   * @param i The index of the state
+   * @return The joint state
+   */
+  tesseract_common::JointState getState(Eigen::Index i) const;
+
+  /**
+   * @brief Set a single state
+   *
+   * Throws if the state joint names or number of joints do not match the segment, or if the index is out of range.
+   * Empty velocity, acceleration and effort are set to zero.
+   * @param i The index of the state
+   * @param state The joint state
+   */
+  void setState(Eigen::Index i, const tesseract_common::JointState& state);
+
+  /**
+   * @brief Convert to a joint trajectory
+   * @return A joint trajectory with a state for every column
+   */
+  tesseract_common::JointTrajectory toJointTrajectory() const;
+
+  /**
+   * @brief Equal operator. Does not compare descriptions
+   * @param rhs TrajectorySegmentInstruction
+   * @return True if equal, otherwise false
+   */
+  bool operator==(const TrajectorySegmentInstruction& rhs) const;
+
+  /**
+   * @brief Not equal operator. Does not compare descriptions
+   * @param rhs TrajectorySegmentInstruction
+   * @return True if not equal, otherwise false
+   */
+  bool operator!=(const TrajectorySegmentInstruction& rhs) const;
+
+private:
+  /** @brief The description of the instruction */
+  std::string description_{ "Tesseract Trajectory Segment Instruction" };
+
+  /** @brief The profile used for this segment */
+  std::string profile_{ "DEFAULT" };
+
+  /** @brief The joint names shared by all states */
+  std::vector<std::string> joint_names_;
+
+  /** @brief The joint positions (dof x size) */
+  Eigen::MatrixXd positions_;
+
+  /** @brief The joint velocities (dof x size) */
+  Eigen::MatrixXd velocities_;
+
+  /** @brief The joint accelerations (dof x size) */
+  Eigen::MatrixXd accelerations_;
+
+  /** @brief The joint efforts (dof x size) */
+  Eigen::MatrixXd efforts_;
+
+  /** @brief The time from start of each state (size) */
+  Eigen::VectorXd times_;
+
+  friend class boost::serialization::access;
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version);  // NOLINT
+};
+}  // namespace tesseract_planning
+
+#ifdef SWIG
+%tesseract_command_language_add_instruction_type(TrajectorySegmentInstruction)
+#else
+TESSERACT_INSTRUCTION_EXPORT_KEY(tesseract_planning::TrajectorySegmentInstruction);
+#endif  // SWIG
+
+#endif  // TESSERACT_COMMAND_LANGUAGE_TRAJECTORY_SEGMENT_INSTRUCTION_H
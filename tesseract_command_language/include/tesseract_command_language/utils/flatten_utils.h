@@ -30,6 +30,7 @@
 #include <tesseract_command_language/move_instruction.h>
 #include <tesseract_command_language/composite_instruction.h>
 #include <tesseract_command_language/utils/filter_functions.h>
+#include <tesseract_command_language/utils/flatten_view.h>
 
 namespace tesseract_planning
 {
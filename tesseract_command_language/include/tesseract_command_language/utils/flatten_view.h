@@ -0,0 +1,260 @@
+/**
+ * @file flatten_view.h
+ * @brief A lazy depth first view over the instructions of a composite
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_COMMAND_LANGUAGE_UTILS_FLATTEN_VIEW_H
+#define TESSERACT_COMMAND_LANGUAGE_UTILS_FLATTEN_VIEW_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/instruction_type.h>
+#include <tesseract_command_language/utils/filter_functions.h>
+
+namespace tesseract_planning
+{
+namespace detail_flatten
+{
+/**
+ * @brief A forward iterator which visits the instructions of a composite depth first in the same order as flatten()
+ *
+ * The position in each nested composite is kept in a fixed size stack so iterating does not allocate unless the
+ * composites are nested deeper than INLINE_DEPTH.
+ */
+template <typename CompositeT, typename InstructionT>
+class FlattenIterator
+{
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Instruction;
+  using difference_type = std::ptrdiff_t;
+  using pointer = InstructionT*;
+  using reference = InstructionT&;
+
+  /** @brief The nesting depth that can be iterated without allocating */
+  static constexpr std::size_t INLINE_DEPTH = 8;
+
+  /** @brief Construct the end iterator */
+  FlattenIterator() = default;
+
+  /**
+   * @brief Construct an iterator to the first instruction of the composite which passes the filter
+   * @param composite The composite to iterate
+   * @param filter The filter, this must outlive the iterator
+   */
+  FlattenIterator(CompositeT& composite, const flattenFilterFn* filter) : filter_(filter)
+  {
+    push(composite, true);
+    advance();
+  }
+
+  reference operator*() const { return *current_; }
+  pointer operator->() const { return current_; }
+
+  FlattenIterator& operator++()
+  {
+    advance();
+    return *this;
+  }
+
+  FlattenIterator operator++(int)
+  {
+    FlattenIterator tmp = *this;
+    advance();
+    return tmp;
+  }
+
+  bool operator==(const FlattenIterator& rhs) const { return (current_ == rhs.current_); }
+  bool operator!=(const FlattenIterator& rhs) const { return (current_ != rhs.current_); }
+
+  /** @brief The composite which contains the current instruction */
+  CompositeT& parent() const { return *parent_; }
+
+private:
+  struct Frame
+  {
+    CompositeT* composite{ nullptr };
+    std::ptrdiff_t index{ -1 };  // -1 is the start instruction
+    bool first_composite{ false };
+  };
+
+  const flattenFilterFn* filter_{ nullptr };
+  pointer current_{ nullptr };
+  CompositeT* parent_{ nullptr };
+
+  std::array<Frame, INLINE_DEPTH> frames_;
+  std::vector<Frame> overflow_frames_;
+  std::size_t depth_{ 0 };
+
+  bool include(const Instruction& instruction, const CompositeInstruction& composite, bool first_composite) const
+  {
+    return (filter_ == nullptr || !(*filter_) || (*filter_)(instruction, composite, first_composite));
+  }
+
+  Frame& top() { return (depth_ > INLINE_DEPTH) ? overflow_frames_.back() : frames_[depth_ - 1]; }
+
+  void push(CompositeT& composite, bool first_composite)
+  {
+    Frame frame{ &composite, -1, first_composite };
+    if (depth_ < INLINE_DEPTH)
+      frames_[depth_] = frame;
+    else
+      overflow_frames_.push_back(frame);
+
+    ++depth_;
+  }
+
+  void pop()
+  {
+    if (depth_ > INLINE_DEPTH)
+      overflow_frames_.pop_back();
+
+    --depth_;
+  }
+
+  void advance()
+  {
+    current_ = nullptr;
+    while (depth_ > 0)
+    {
+      Frame& frame = top();
+      CompositeT& composite = *frame.composite;
+      const bool first_composite = frame.first_composite;
+      const std::ptrdiff_t index = frame.index++;
+
+      if (index < 0)
+      {
+        if (composite.hasStartInstruction() && include(composite.getStartInstruction(), composite, first_composite))
+        {
+          current_ = &composite.getStartInstruction();
+          parent_ = &composite;
+          return;
+        }
+        continue;
+      }
+
+      if (static_cast<std::size_t>(index) >= composite.size())
+      {
+        pop();
+        continue;
+      }
+
+      InstructionT& instruction = composite[static_cast<std::size_t>(index)];
+      if (isCompositeInstruction(instruction))
+      {
+        // By default composite instructions are not visited just their children, but this allows for the filter to
+        // indicate that they should be visited.
+        const bool visit = (filter_ != nullptr && *filter_ && (*filter_)(instruction, composite, first_composite));
+        push(instruction.template as<CompositeInstruction>(), false);
+        if (visit)
+        {
+          current_ = &instruction;
+          parent_ = &composite;
+          return;
+        }
+        continue;
+      }
+
+      if (include(instruction, composite, first_composite))
+      {
+        current_ = &instruction;
+        parent_ = &composite;
+        return;
+      }
+    }
+  }
+};
+}  // namespace detail_flatten
+
+/**
+ * @brief A lazy view of the instructions of a composite, this visits the same instructions as flatten() in the same
+ * order without building a vector
+ *
+ * The view stores the filter, so it must outlive its iterators. The composite must not be modified while iterating.
+ */
+template <typename CompositeT, typename InstructionT>
+class BasicFlattenView
+{
+public:
+  using iterator = detail_flatten::FlattenIterator<CompositeT, InstructionT>;
+  using const_iterator = iterator;
+
+  /**
+   * @brief Construct a view
+   * @param composite The composite to view
+   * @param filter Used to filter only what should be considered. Should return true to include otherwise false
+   */
+  BasicFlattenView(CompositeT& composite, flattenFilterFn filter = nullptr)  // NOLINT
+    : composite_(&composite), filter_(std::move(filter))
+  {
+  }
+
+  iterator begin() const { return iterator(*composite_, &filter_); }
+  iterator end() const { return iterator(); }
+
+  /** @brief Check if no instructions pass the filter, this stops at the first instruction */
+  bool empty() const { return (begin() == end()); }
+
+  /** @brief The number of instructions which pass the filter, this iterates the whole view */
+  std::size_t size() const { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+private:
+  CompositeT* composite_;
+  flattenFilterFn filter_;
+};
+
+using FlattenView = BasicFlattenView<CompositeInstruction, Instruction>;
+using ConstFlattenView = BasicFlattenView<const CompositeInstruction, const Instruction>;
+
+/**
+ * @brief Create a lazy view of the instructions of a composite, see flatten()
+ * @param composite_instruction The composite instruction to view
+ * @param filter Used to filter only what should be considered. Should return true to include otherwise false
+ * @return A view which can be used in a range based for loop and with standard algorithms
+ */
+inline FlattenView flattenView(CompositeInstruction& composite_instruction, flattenFilterFn filter = nullptr)
+{
+  return FlattenView(composite_instruction, std::move(filter));
+}
+
+/**
+ * @brief Create a lazy view of the instructions of a composite, see flatten()
+ * @param composite_instruction The composite instruction to view
+ * @param filter Used to filter only what should be considered. Should return true to include otherwise false
+ * @return A view which can be used in a range based for loop and with standard algorithms
+ */
+inline ConstFlattenView flattenView(const CompositeInstruction& composite_instruction, flattenFilterFn filter = nullptr)
+{
+  return ConstFlattenView(composite_instruction, std::move(filter));
+}
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_COMMAND_LANGUAGE_UTILS_FLATTEN_VIEW_H
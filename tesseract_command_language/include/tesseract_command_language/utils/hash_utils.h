@@ -0,0 +1,152 @@
+/**
+ * @file hash_utils.h
+ * @brief Stable structural hashing of instructions and waypoints
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_COMMAND_LANGUAGE_UTILS_HASH_UTILS_H
+#define TESSERACT_COMMAND_LANGUAGE_UTILS_HASH_UTILS_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/core/instruction.h>
+#include <tesseract_command_language/core/waypoint.h>
+#include <tesseract_command_language/types.h>
+
+namespace tesseract_planning
+{
+class CartesianWaypoint;
+class JointWaypoint;
+class StateWaypoint;
+class NullWaypoint;
+class CompositeInstruction;
+class MoveInstruction;
+class PlanInstruction;
+class NullInstruction;
+class SetAnalogInstruction;
+class SetToolInstruction;
+class TimerInstruction;
+class WaitInstruction;
+class TrajectorySegmentInstruction;
+
+/**
+ * @brief Accumulates a 64 bit FNV-1a hash
+ * @details Values are added in a fixed byte order and doubles are normalized, so the hash of the same values is the
+ * same across runs and platforms. Containers add their size first so different splits of the same values do not
+ * collide.
+ */
+class StableHash
+{
+public:
+  void addBytes(const void* data, std::size_t size);
+
+  void addInteger(std::int64_t value);
+
+  void addUnsigned(std::uint64_t value);
+
+  /** @brief Add a double, negative zero is added as zero and every NaN is added as the same value */
+  void addDouble(double value);
+
+  void addString(const std::string& value);
+
+  void addStrings(const std::vector<std::string>& values);
+
+  /** @brief Add the size and the values of a matrix or vector in column major order */
+  void addMatrix(const Eigen::Ref<const Eigen::MatrixXd>& value);
+
+  void addIsometry(const Eigen::Isometry3d& value);
+
+  /** @brief Get the hash of the values added */
+  std::uint64_t getValue() const;
+
+private:
+  std::uint64_t value_{ 0xcbf29ce484222325ULL };
+};
+
+void hashAppend(StableHash& hash, const ManipulatorInfo& manipulator_info);
+
+void hashAppend(StableHash& hash, const NullWaypoint& waypoint);
+
+void hashAppend(StableHash& hash, const CartesianWaypoint& waypoint);
+
+void hashAppend(StableHash& hash, const JointWaypoint& waypoint);
+
+void hashAppend(StableHash& hash, const StateWaypoint& waypoint);
+
+/**
+ * @brief Add a waypoint of any type
+ * @details Waypoint types defined outside of the command language are hashed from their binary archive
+ */
+void hashAppend(StableHash& hash, const Waypoint& waypoint);
+
+void hashAppend(StableHash& hash, const NullInstruction& instruction);
+
+void hashAppend(StableHash& hash, const PlanInstruction& instruction);
+
+void hashAppend(StableHash& hash, const MoveInstruction& instruction);
+
+void hashAppend(StableHash& hash, const SetAnalogInstruction& instruction);
+
+void hashAppend(StableHash& hash, const SetToolInstruction& instruction);
+
+void hashAppend(StableHash& hash, const TimerInstruction& instruction);
+
+void hashAppend(StableHash& hash, const WaitInstruction& instruction);
+
+void hashAppend(StableHash& hash, const TrajectorySegmentInstruction& instruction);
+
+/**
+ * @brief Add a composite instruction including its start instruction and all of its children
+ * @note The profile overrides are not included since profiles can not be hashed, see ProfileDictionary::getFingerprint
+ */
+void hashAppend(StableHash& hash, const CompositeInstruction& instruction);
+
+/**
+ * @brief Add an instruction of any type
+ * @details Instruction types defined outside of the command language are hashed from their binary archive
+ */
+void hashAppend(StableHash& hash, const Instruction& instruction);
+
+/**
+ * @brief Get the stable structural hash of an instruction, waypoint or manipulator info
+ * @details Every member is included, also the descriptions, so apart from collisions an equal hash means equal values
+ * @param value The value to hash
+ * @return The hash
+ */
+template <typename T>
+std::uint64_t getStableHash(const T& value)
+{
+  StableHash hash;
+  hashAppend(hash, value);
+  return hash.getValue();
+}
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_COMMAND_LANGUAGE_UTILS_HASH_UTILS_H
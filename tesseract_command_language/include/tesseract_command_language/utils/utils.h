@@ -32,10 +32,13 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_names.h>
+#include <tesseract_command_language/trajectory_segment_instruction.h>
 
 #include <tesseract_command_language/utils/filter_functions.h>
 #include <tesseract_command_language/utils/flatten_utils.h>
 #include <tesseract_command_language/utils/get_instruction_utils.h>
+#include <tesseract_command_language/utils/hash_utils.h>
 
 #include <tesseract_common/joint_state.h>
 #include <tesseract_common/types.h>
@@ -50,6 +53,28 @@ namespace tesseract_planning
  */
 tesseract_common::JointTrajectory toJointTrajectory(const CompositeInstruction& composite_instructions);
 
+/**
+ * @brief Convert composite intruction to a single trajectory segment
+ *
+ * This extracts the same states as toJointTrajectory but stores them in contiguous blocks. Throws if the joint names
+ * are not the same throughout the program.
+ *
+ * @param composite_instructions The composite instruction to convert
+ * @return A trajectory segment, empty if the program does not contain any states
+ */
+TrajectorySegmentInstruction toTrajectorySegment(const CompositeInstruction& composite_instructions);
+
+/**
+ * @brief Check if a composite instruction or any of its child composites contains a trajectory segment
+ *
+ * The planners and contact checks only support move instructions, so they use this to reject trajectory segments
+ * instead of skipping them.
+ *
+ * @param composite_instructions The composite instruction to check
+ * @return True if a trajectory segment was found
+ */
+bool hasTrajectorySegment(const CompositeInstruction& composite_instructions);
+
 /**
  * @brief Gets joint position from waypoints that contain that information.
  *
@@ -97,6 +122,19 @@ Eigen::VectorXd getJointPosition(const std::vector<std::string>& joint_names, co
  */
 bool formatJointPosition(const std::vector<std::string>& joint_names, Waypoint& waypoint);
 
+/**
+ * @brief Format the waypoints joint ordered by the provided interned joint names
+ *
+ * Throws if waypoint does not directly contain that information
+ *
+ * If the waypoint is a JointWaypoint the check is a pointer compare and the waypoint will share the provided names.
+ *
+ * @param joint_names The joint names defining the order desired
+ * @param waypoint The waypoint to format
+ * @return True if formating was required, otherwise false.
+ */
+bool formatJointPosition(const JointNames& joint_names, Waypoint& waypoint);
+
 /**
  * @brief Check the waypoints joint order against the provided joint names
  *
@@ -111,6 +149,19 @@ bool formatJointPosition(const std::vector<std::string>& joint_names, Waypoint&
  */
 bool checkJointPositionFormat(const std::vector<std::string>& joint_names, const Waypoint& waypoint);
 
+/**
+ * @brief Check the waypoints joint order against the provided interned joint names
+ *
+ * Throws if waypoint does not directly contain that information
+ *
+ * If the waypoint is a JointWaypoint the check is a pointer compare.
+ *
+ * @param joint_names The joint names defining the order desired
+ * @param waypoint The waypoint to check format
+ * @return True if waypoint format is correct, otherwise false.
+ */
+bool checkJointPositionFormat(const JointNames& joint_names, const Waypoint& waypoint);
+
 /**
  * @brief Set the joint position for waypoints that contain that information
  * @param waypoint Waypoint to set
@@ -167,6 +218,13 @@ bool toDelimitedFile(const CompositeInstruction& composite_instructions,
                      const std::string& file_path,
                      char separator = ',');
 
+/**
+ * @brief Estimate the memory used by an instruction, including its waypoints and children
+ * @param instruction The instruction
+ * @return The estimated memory in bytes
+ */
+std::size_t estimateMemoryUsage(const Instruction& instruction);
+
 // TODO: implement validateSeedStructure
 #ifndef SWIG
 /**
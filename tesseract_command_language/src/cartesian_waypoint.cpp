@@ -16,9 +16,15 @@ void tesseract_planning::CartesianWaypoint::serialize(Archive& ar, const unsigne
 
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 template void tesseract_planning::CartesianWaypoint::serialize(boost::archive::xml_oarchive& ar,
                                                                const unsigned int version);
 template void tesseract_planning::CartesianWaypoint::serialize(boost::archive::xml_iarchive& ar,
                                                                const unsigned int version);
+template void tesseract_planning::CartesianWaypoint::serialize(boost::archive::binary_oarchive& ar,
+                                                               const unsigned int version);
+template void tesseract_planning::CartesianWaypoint::serialize(boost::archive::binary_iarchive& ar,
+                                                               const unsigned int version);
 
 TESSERACT_WAYPOINT_EXPORT_IMPLEMENT(tesseract_planning::CartesianWaypoint);
@@ -26,6 +26,9 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <stdexcept>
 #include <iostream>
 #include <boost/serialization/nvp.hpp>
@@ -33,10 +36,62 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/null_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/plan_instruction.h>
 #include <tesseract_command_language/composite_instruction.h>
 
 namespace tesseract_planning
 {
+/**
+ * @brief The instruction counts of a range of children
+ *
+ * Start move and plan instructions are counted separately because they are only counted when their parent is the top
+ * most composite.
+ */
+struct CompositeIndexCounts
+{
+  long move{ 0 };
+  long plan{ 0 };
+  long start_move{ 0 };
+  long start_plan{ 0 };
+  long total{ 0 };
+
+  long count(bool plan_instructions, bool first_composite) const
+  {
+    if (plan_instructions)
+      return (first_composite) ? plan + start_plan : plan;
+
+    return (first_composite) ? move + start_move : move;
+  }
+};
+
+/** @brief The cached instruction counts of the children of a composite */
+struct CompositeInstruction::Index
+{
+  /** @brief The counts of the children before each child, this has one more element than the number of children */
+  std::vector<CompositeIndexCounts> prefix;
+};
+
+/** @brief Add a single non composite instruction to the counts */
+static void countInstruction(CompositeIndexCounts& counts, const Instruction& instruction)
+{
+  ++counts.total;
+  if (isMoveInstruction(instruction))
+  {
+    if (instruction.as<MoveInstruction>().isStart())
+      ++counts.start_move;
+    else
+      ++counts.move;
+  }
+  else if (isPlanInstruction(instruction))
+  {
+    if (instruction.as<PlanInstruction>().isStart())
+      ++counts.start_plan;
+    else
+      ++counts.plan;
+  }
+}
+
 CompositeInstruction::CompositeInstruction(std::string profile,
                                            CompositeInstructionOrder order,
                                            ManipulatorInfo manipulator_info)
@@ -44,6 +99,26 @@ CompositeInstruction::CompositeInstruction(std::string profile,
 {
 }
 
+CompositeInstruction::CompositeInstruction(const CompositeInstruction& other)
+  : profile_overrides(other.profile_overrides)
+  , container_(other.container_)
+  , index_(std::atomic_load(&other.index_))
+  , description_(other.description_)
+  , manipulator_info_(other.manipulator_info_)
+  , profile_(other.profile_)
+  , order_(other.order_)
+  , start_instruction_(other.start_instruction_)
+{
+}
+
+CompositeInstruction& CompositeInstruction::operator=(const CompositeInstruction& other)
+{
+  if (this != &other)
+    (*this) = CompositeInstruction(other);
+
+  return (*this);
+}
+
 CompositeInstructionOrder CompositeInstruction::getOrder() const { return order_; }
 
 const std::string& CompositeInstruction::getDescription() const { return description_; }
@@ -72,17 +147,58 @@ bool CompositeInstruction::hasStartInstruction() const { return (!isNullInstruct
 
 void CompositeInstruction::setInstructions(std::vector<tesseract_planning::Instruction> instructions)
 {
-  container_.swap(instructions);
+  container_ = std::make_shared<std::vector<value_type>>(std::move(instructions));
+  dirty_ = false;
+  index_ = nullptr;
+}
+std::vector<tesseract_planning::Instruction>& CompositeInstruction::getInstructions() { return mutableContainer(); }
+const std::vector<tesseract_planning::Instruction>& CompositeInstruction::getInstructions() const
+{
+  return container();
+}
+
+CompositeInstructionCounts CompositeInstruction::getInstructionCounts() const
+{
+  std::shared_ptr<const Index> index = this->index();
+  CompositeIndexCounts counts = (index != nullptr) ? index->prefix.back() : computeIndex().prefix.back();
+  if (hasStartInstruction())
+    countInstruction(counts, start_instruction_);
+
+  CompositeInstructionCounts result;
+  result.move = counts.count(false, true);
+  result.plan = counts.count(true, true);
+  result.total = counts.total;
+  return result;
+}
+
+bool CompositeInstruction::cacheInstructionCounts() const { return (index() != nullptr); }
+
+const Instruction* CompositeInstruction::getMoveInstructionAt(long n) const
+{
+  return locate<const CompositeInstruction, const Instruction>(*this, n, false);
+}
+
+Instruction* CompositeInstruction::getMoveInstructionAt(long n)
+{
+  return locate<CompositeInstruction, Instruction>(*this, n, false);
+}
+
+const Instruction* CompositeInstruction::getPlanInstructionAt(long n) const
+{
+  return locate<const CompositeInstruction, const Instruction>(*this, n, true);
+}
+
+Instruction* CompositeInstruction::getPlanInstructionAt(long n)
+{
+  return locate<CompositeInstruction, Instruction>(*this, n, true);
 }
-std::vector<tesseract_planning::Instruction>& CompositeInstruction::getInstructions() { return container_; }
-const std::vector<tesseract_planning::Instruction>& CompositeInstruction::getInstructions() const { return container_; }
 
 void CompositeInstruction::print(const std::string& prefix) const
 {
   std::cout << prefix + "Composite Instruction, Description: " << getDescription() << std::endl;
   std::cout << prefix + "--- Start Instruction, Description: " << start_instruction_.getDescription() << std::endl;
   std::cout << prefix + "{" << std::endl;
-  for (const auto& i : *this)
+  for (const auto& i : container())
     i.print(prefix + "  ");
   std::cout << prefix + "}" << std::endl;
 }
@@ -94,12 +210,16 @@ bool CompositeInstruction::operator==(const CompositeInstruction& rhs) const
   equal &= (profile_ == rhs.profile_);  // NOLINT
   equal &= (manipulator_info_ == rhs.manipulator_info_);
   equal &= (start_instruction_ == rhs.start_instruction_);
-  equal &= (container_.size() == rhs.container_.size());
-  if (equal)
+
+  // Shared children are equal without comparing each child
+  const std::vector<value_type>& lhs_container = container();
+  const std::vector<value_type>& rhs_container = rhs.container();
+  equal &= (lhs_container.size() == rhs_container.size());
+  if (equal && &lhs_container != &rhs_container)
   {
-    for (std::size_t i = 0; i < container_.size(); ++i)
+    for (std::size_t i = 0; i < lhs_container.size(); ++i)
     {
-      equal &= (container_[i] == rhs.container_[i]);
+      equal &= (lhs_container[i] == rhs_container[i]);
 
       if (!equal)
         break;
@@ -110,93 +230,326 @@ bool CompositeInstruction::operator==(const CompositeInstruction& rhs) const
 
 bool CompositeInstruction::operator!=(const CompositeInstruction& rhs) const { return !operator==(rhs); }
 
+const std::vector<CompositeInstruction::value_type>& CompositeInstruction::container() const
+{
+  static const std::vector<value_type> empty;
+  return (container_ != nullptr) ? *container_ : empty;
+}
+
+std::vector<CompositeInstruction::value_type>& CompositeInstruction::uniqueContainer()
+{
+  // Unique children are only written by the owner, so nothing is written here unless required. This allows several
+  // threads to modify different children of the same composite.
+  if (container_ == nullptr)
+  {
+    container_ = std::make_shared<std::vector<value_type>>();
+  }
+  else if (container_.use_count() > 1)
+  {
+    // Cloning the children only copies their own shared children, so only this level of the tree is cloned
+    container_ = std::make_shared<std::vector<value_type>>(*container_);
+  }
+  else
+  {
+    // Synchronize with the release of the other owners which may have been on other threads before modifying
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+  return *container_;
+}
+
+std::vector<CompositeInstruction::value_type>& CompositeInstruction::detach()
+{
+  std::vector<value_type>& container = uniqueContainer();
+  if (std::atomic_load(&index_) != nullptr)
+    std::atomic_store(&index_, std::shared_ptr<const Index>());
+
+  return container;
+}
+
+std::vector<CompositeInstruction::value_type>& CompositeInstruction::mutableContainer()
+{
+  std::vector<value_type>& container = detach();
+  if (!dirty_)
+    dirty_ = true;
+
+  return container;
+}
+
+std::shared_ptr<const CompositeInstruction::Index> CompositeInstruction::index() const
+{
+  // The children may be shared with copies on other threads so the cache is accessed atomically
+  std::shared_ptr<const Index> cached = std::atomic_load(&index_);
+  if (cached != nullptr)
+    return cached;
+
+  // The counts can not be reused if any of the children may be modified through a mutable reference
+  if (dirty_)
+    return nullptr;
+
+  for (const auto& child : container())
+  {
+    if (isCompositeInstruction(child) && child.as<CompositeInstruction>().index() == nullptr)
+      return nullptr;
+  }
+
+  auto index = std::make_shared<const Index>(computeIndex());
+  std::atomic_store(&index_, index);
+  return index;
+}
+
+CompositeInstruction::Index CompositeInstruction::computeIndex() const
+{
+  const std::vector<value_type>& children = container();
+  Index index;
+  index.prefix.reserve(children.size() + 1);
+  index.prefix.emplace_back();
+  for (const auto& child : children)
+  {
+    CompositeIndexCounts counts = index.prefix.back();
+    if (isCompositeInstruction(child))
+    {
+      // Start instructions of a child composite are never the start of the program so they are not counted
+      const auto& composite = child.as<CompositeInstruction>();
+      std::shared_ptr<const Index> child_index = composite.index();
+      CompositeIndexCounts child_counts =
+          (child_index != nullptr) ? child_index->prefix.back() : composite.computeIndex().prefix.back();
+      if (composite.hasStartInstruction())
+        countInstruction(child_counts, composite.getStartInstruction());
+
+      counts.move += child_counts.move;
+      counts.plan += child_counts.plan;
+      counts.total += child_counts.total + 1;
+    }
+    else
+    {
+      countInstruction(counts, child);
+    }
+    index.prefix.push_back(counts);
+  }
+
+  return index;
+}
+
+bool CompositeInstruction::findPath(const CompositeInstruction& composite,
+                                    long& n,
+                                    bool plan,
+                                    bool first_composite,
+                                    std::vector<long>& path)
+{
+  // The start instruction is before the children
+  if (composite.hasStartInstruction())
+  {
+    CompositeIndexCounts start_counts;
+    countInstruction(start_counts, composite.getStartInstruction());
+    if (start_counts.count(plan, first_composite) > 0)
+    {
+      if (n == 0)
+      {
+        path.push_back(-1);
+        return true;
+      }
+
+      --n;
+    }
+  }
+
+  const std::vector<value_type>& children = composite.container();
+  std::shared_ptr<const Index> index = composite.index();
+  if (index != nullptr)
+  {
+    // Skip directly to the child whose subtree contains the n-th instruction
+    const std::vector<CompositeIndexCounts>& prefix = index->prefix;
+    if (n >= prefix.back().count(plan, first_composite))
+    {
+      n -= prefix.back().count(plan, first_composite);
+      return false;
+    }
+
+    auto it = std::upper_bound(
+        prefix.begin() + 1, prefix.end(), n, [plan, first_composite](long value, const CompositeIndexCounts& counts) {
+          return value < counts.count(plan, first_composite);
+        });
+    const auto child_idx = static_cast<std::size_t>(std::distance(prefix.begin() + 1, it));
+    n -= prefix[child_idx].count(plan, first_composite);
+
+    path.push_back(static_cast<long>(child_idx));
+    const Instruction& child = children[child_idx];
+    if (!isCompositeInstruction(child))
+      return true;
+
+    return findPath(child.as<CompositeInstruction>(), n, plan, false, path);
+  }
+
+  // The counts can not be cached so the children are walked until the n-th instruction is found
+  for (std::size_t i = 0; i < children.size(); ++i)
+  {
+    const Instruction& child = children[i];
+    path.push_back(static_cast<long>(i));
+    if (isCompositeInstruction(child))
+    {
+      if (findPath(child.as<CompositeInstruction>(), n, plan, false, path))
+        return true;
+    }
+    else
+    {
+      CompositeIndexCounts counts;
+      countInstruction(counts, child);
+      if (counts.count(plan, first_composite) > 0)
+      {
+        if (n == 0)
+          return true;
+
+        --n;
+      }
+    }
+    path.pop_back();
+  }
+
+  return false;
+}
+
+const Instruction& CompositeInstruction::locateChild(const CompositeInstruction& composite, std::size_t i)
+{
+  return composite.container()[i];
+}
+
+Instruction& CompositeInstruction::locateChild(CompositeInstruction& composite, std::size_t i)
+{
+  // Only the shared composites along the path are cloned, the counts stay valid because no child is added or removed
+  return composite.uniqueContainer()[i];
+}
+
+template <typename CompositeT, typename InstructionT>
+InstructionT* CompositeInstruction::locate(CompositeT& composite, long n, bool plan)
+{
+  // The path is found through const access so no mutable reference to the children is handed out while searching
+  std::vector<long> path;
+  if (n < 0 || !findPath(composite, n, plan, true, path))
+    return nullptr;
+
+  CompositeT* current = &composite;
+  for (std::size_t i = 0; i + 1 < path.size(); ++i)
+    current = &(locateChild(*current, static_cast<std::size_t>(path[i])).template as<CompositeInstruction>());
+
+  if (path.back() < 0)
+    return &(current->getStartInstruction());
+
+  return &(locateChild(*current, static_cast<std::size_t>(path.back())));
+}
+
 ///////////////
 // Iterators //
 ///////////////
-CompositeInstruction::iterator CompositeInstruction::begin() { return container_.begin(); }
-CompositeInstruction::const_iterator CompositeInstruction::begin() const { return container_.begin(); }
-CompositeInstruction::iterator CompositeInstruction::end() { return container_.end(); }
-CompositeInstruction::const_iterator CompositeInstruction::end() const { return container_.end(); }
-CompositeInstruction::reverse_iterator CompositeInstruction::rbegin() { return container_.rbegin(); }
-CompositeInstruction::const_reverse_iterator CompositeInstruction::rbegin() const { return container_.rbegin(); }
-CompositeInstruction::reverse_iterator CompositeInstruction::rend() { return container_.rend(); }
-CompositeInstruction::const_reverse_iterator CompositeInstruction::crend() const { return container_.crend(); }
-CompositeInstruction::const_reverse_iterator CompositeInstruction::rend() const { return container_.rend(); }
-CompositeInstruction::const_iterator CompositeInstruction::cbegin() const { return container_.cbegin(); }
-CompositeInstruction::const_iterator CompositeInstruction::cend() const { return container_.cend(); }
-CompositeInstruction::const_reverse_iterator const CompositeInstruction::crbegin() { return container_.crbegin(); }
-CompositeInstruction::const_reverse_iterator const CompositeInstruction::crend() { return container_.crend(); }
+CompositeInstruction::iterator CompositeInstruction::begin() { return mutableContainer().begin(); }
+CompositeInstruction::const_iterator CompositeInstruction::begin() const { return container().begin(); }
+CompositeInstruction::iterator CompositeInstruction::end() { return mutableContainer().end(); }
+CompositeInstruction::const_iterator CompositeInstruction::end() const { return container().end(); }
+CompositeInstruction::reverse_iterator CompositeInstruction::rbegin() { return mutableContainer().rbegin(); }
+CompositeInstruction::const_reverse_iterator CompositeInstruction::rbegin() const { return container().rbegin(); }
+CompositeInstruction::reverse_iterator CompositeInstruction::rend() { return mutableContainer().rend(); }
+CompositeInstruction::const_reverse_iterator CompositeInstruction::crend() const { return container().crend(); }
+CompositeInstruction::const_reverse_iterator CompositeInstruction::rend() const { return container().rend(); }
+CompositeInstruction::const_iterator CompositeInstruction::cbegin() const { return container().cbegin(); }
+CompositeInstruction::const_iterator CompositeInstruction::cend() const { return container().cend(); }
+CompositeInstruction::const_reverse_iterator const CompositeInstruction::crbegin() { return container().crbegin(); }
+CompositeInstruction::const_reverse_iterator const CompositeInstruction::crend() { return container().crend(); }
 
 //////////////
 // Capacity //
 //////////////
-bool CompositeInstruction::empty() const { return container_.empty(); }
-CompositeInstruction::size_type CompositeInstruction::size() const { return container_.size(); }
-CompositeInstruction::size_type CompositeInstruction::max_size() const { return container_.max_size(); }
-void CompositeInstruction::reserve(size_type n) { container_.reserve(n); }
-CompositeInstruction::size_type CompositeInstruction::capacity() const { return container_.capacity(); }
-void CompositeInstruction::shrink_to_fit() { container_.shrink_to_fit(); }
+bool CompositeInstruction::empty() const { return container().empty(); }
+CompositeInstruction::size_type CompositeInstruction::size() const { return container().size(); }
+CompositeInstruction::size_type CompositeInstruction::max_size() const { return container().max_size(); }
+void CompositeInstruction::reserve(size_type n) { detach().reserve(n); }
+CompositeInstruction::size_type CompositeInstruction::capacity() const { return container().capacity(); }
+void CompositeInstruction::shrink_to_fit() { detach().shrink_to_fit(); }
 
 ////////////////////
 // Element Access //
 ////////////////////
-CompositeInstruction::reference CompositeInstruction::front() { return container_.front(); }
-CompositeInstruction::const_reference CompositeInstruction::front() const { return container_.front(); }
-CompositeInstruction::reference CompositeInstruction::back() { return container_.back(); }
-CompositeInstruction::const_reference CompositeInstruction::back() const { return container_.back(); }
-CompositeInstruction::reference CompositeInstruction::at(size_type n) { return container_.at(n); }
-CompositeInstruction::const_reference CompositeInstruction::at(size_type n) const { return container_.at(n); }
-CompositeInstruction::pointer CompositeInstruction::data() { return container_.data(); }
-CompositeInstruction::const_pointer CompositeInstruction::data() const { return container_.data(); }
-CompositeInstruction::reference CompositeInstruction::operator[](size_type pos) { return container_[pos]; }
-CompositeInstruction::const_reference CompositeInstruction::operator[](size_type pos) const { return container_[pos]; };
+CompositeInstruction::reference CompositeInstruction::front() { return mutableContainer().front(); }
+CompositeInstruction::const_reference CompositeInstruction::front() const { return container().front(); }
+CompositeInstruction::reference CompositeInstruction::back() { return mutableContainer().back(); }
+CompositeInstruction::const_reference CompositeInstruction::back() const { return container().back(); }
+CompositeInstruction::reference CompositeInstruction::at(size_type n) { return mutableContainer().at(n); }
+CompositeInstruction::const_reference CompositeInstruction::at(size_type n) const { return container().at(n); }
+CompositeInstruction::pointer CompositeInstruction::data() { return mutableContainer().data(); }
+CompositeInstruction::const_pointer CompositeInstruction::data() const { return container().data(); }
+CompositeInstruction::reference CompositeInstruction::operator[](size_type pos) { return mutableContainer()[pos]; }
+CompositeInstruction::const_reference CompositeInstruction::operator[](size_type pos) const
+{
+  return container()[pos];
+};
 
 ///////////////
 // Modifiers //
 ///////////////
-void CompositeInstruction::clear() { container_.clear(); }
+void CompositeInstruction::clear()
+{
+  // Any outstanding references are invalidated so the counts of the new children can be cached again
+  container_ = nullptr;
+  dirty_ = false;
+  index_ = nullptr;
+}
 CompositeInstruction::iterator CompositeInstruction::insert(const_iterator p, const value_type& x)
 {
-  return container_.insert(p, x);
+  const auto index = std::distance(container().cbegin(), p);
+  auto& container = mutableContainer();
+  return container.insert(container.cbegin() + index, x);
 }
 CompositeInstruction::iterator CompositeInstruction::insert(const_iterator p, value_type&& x)
 {
-  return container_.insert(p, x);
+  const auto index = std::distance(container().cbegin(), p);
+  auto& container = mutableContainer();
+  return container.insert(container.cbegin() + index, x);
 }
 CompositeInstruction::iterator CompositeInstruction::insert(const_iterator p, std::initializer_list<value_type> l)
 {
-  return container_.insert(p, l);
+  const auto index = std::distance(container().cbegin(), p);
+  auto& container = mutableContainer();
+  return container.insert(container.cbegin() + index, l);
 }
 
 template <class... Args>
 CompositeInstruction::iterator CompositeInstruction::emplace(const_iterator pos, Args&&... args)
 {
-  return container_.emplace(pos, std::forward<Args>(args)...);
+  const auto index = std::distance(container().cbegin(), pos);
+  auto& container = mutableContainer();
+  return container.emplace(container.cbegin() + index, std::forward<Args>(args)...);
 }
 
-CompositeInstruction::iterator CompositeInstruction::erase(const_iterator p) { return container_.erase(p); }
+CompositeInstruction::iterator CompositeInstruction::erase(const_iterator p)
+{
+  const auto index = std::distance(container().cbegin(), p);
+  auto& container = mutableContainer();
+  return container.erase(container.cbegin() + index);
+}
 CompositeInstruction::iterator CompositeInstruction::erase(const_iterator first, const_iterator last)
 {
-  return container_.erase(first, last);
+  const auto index = std::distance(container().cbegin(), first);
+  const auto count = std::distance(first, last);
+  auto& container = mutableContainer();
+  return container.erase(container.cbegin() + index, container.cbegin() + index + count);
 }
-void CompositeInstruction::push_back(const value_type& x) { container_.push_back(x); }
-void CompositeInstruction::push_back(const value_type&& x) { container_.push_back(x); }
+void CompositeInstruction::push_back(const value_type& x) { detach().push_back(x); }
+void CompositeInstruction::push_back(const value_type&& x) { detach().push_back(x); }
 
 template <typename... Args>
 #if __cplusplus > 201402L
 CompositeInstruction::reference CompositeInstruction::emplace_back(Args&&... args)
 {
-  return container_.emplace_back(std::forward<Args>(args)...);
+  return mutableContainer().emplace_back(std::forward<Args>(args)...);
 }
 #else
 void CompositeInstruction::emplace_back(Args&&... args)
 {
-  container_.emplace_back(std::forward<Args>(args)...);
+  detach().emplace_back(std::forward<Args>(args)...);
 }
 #endif
 
-void CompositeInstruction::pop_back() { container_.pop_back(); }
-void CompositeInstruction::swap(std::vector<value_type>& other) { container_.swap(other); }
+void CompositeInstruction::pop_back() { detach().pop_back(); }
+void CompositeInstruction::swap(std::vector<value_type>& other) { detach().swap(other); }
 
 template <class Archive>
 void CompositeInstruction::serialize(Archive& ar, const unsigned int /*version*/)
@@ -206,16 +559,36 @@ void CompositeInstruction::serialize(Archive& ar, const unsigned int /*version*/
   ar& boost::serialization::make_nvp("profile", profile_);
   ar& boost::serialization::make_nvp("order", order_);
   ar& boost::serialization::make_nvp("start_instruction", start_instruction_);
-  ar& boost::serialization::make_nvp("container", container_);
+
+  // The children may be shared with copies so they are loaded into a new container
+  if (Archive::is_loading::value)
+  {
+    std::vector<value_type> container;
+    ar& boost::serialization::make_nvp("container", container);
+    setInstructions(std::move(container));
+  }
+  else
+  {
+    if (container_ == nullptr)
+      container_ = std::make_shared<std::vector<value_type>>();
+
+    ar& boost::serialization::make_nvp("container", *container_);
+  }
 }
 
 }  // namespace tesseract_planning
 
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 template void tesseract_planning::CompositeInstruction::serialize(boost::archive::xml_oarchive& ar,
                                                                   const unsigned int version);
 template void tesseract_planning::CompositeInstruction::serialize(boost::archive::xml_iarchive& ar,
                                                                   const unsigned int version);
+template void tesseract_planning::CompositeInstruction::serialize(boost::archive::binary_oarchive& ar,
+                                                                  const unsigned int version);
+template void tesseract_planning::CompositeInstruction::serialize(boost::archive::binary_iarchive& ar,
+                                                                  const unsigned int version);
 
 TESSERACT_INSTRUCTION_EXPORT_IMPLEMENT(tesseract_planning::CompositeInstruction);
@@ -29,6 +29,7 @@
 #include <tesseract_command_language/plan_instruction.h>
 #include <tesseract_command_language/move_instruction.h>
 #include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/trajectory_segment_instruction.h>
 
 namespace tesseract_planning
 {
@@ -52,4 +53,9 @@ bool isNullInstruction(const Instruction& instruction)
   return (instruction.getType() == std::type_index(typeid(NullInstruction)));
 }
 
+bool isTrajectorySegmentInstruction(const Instruction& instruction)
+{
+  return (instruction.getType() == std::type_index(typeid(TrajectorySegmentInstruction)));
+}
+
 }  // namespace tesseract_planning
@@ -0,0 +1,134 @@
+/**
+ * @file joint_names.cpp
+ * @brief An interned, immutable set of joint names
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/joint_names.h>
+
+namespace tesseract_planning
+{
+static const std::vector<std::string>& emptyJointNames()
+{
+  static const std::vector<std::string> empty;
+  return empty;
+}
+
+static std::size_t hashJointNames(const std::vector<std::string>& joint_names)
+{
+  std::size_t seed = joint_names.size();
+  for (const auto& name : joint_names)
+    seed ^= std::hash<std::string>{}(name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+  return seed;
+}
+
+JointNames::JointNames(std::vector<std::string> joint_names) : data_(intern(std::move(joint_names))) {}
+
+JointNames::JointNames(std::initializer_list<std::string> joint_names)
+  : data_(intern(std::vector<std::string>(joint_names)))
+{
+}
+
+const std::vector<std::string>& JointNames::get() const { return (data_) ? data_->names : emptyJointNames(); }
+
+JointNames::operator const std::vector<std::string>&() const { return get(); }
+
+std::size_t JointNames::size() const { return (data_) ? data_->names.size() : 0; }
+
+bool JointNames::empty() const { return (data_ == nullptr); }
+
+const std::string& JointNames::operator[](std::size_t i) const { return get()[i]; }
+
+std::vector<std::string>::const_iterator JointNames::begin() const { return get().begin(); }
+
+std::vector<std::string>::const_iterator JointNames::end() const { return get().end(); }
+
+std::size_t JointNames::hash() const { return (data_) ? data_->hash : 0; }
+
+bool JointNames::operator==(const JointNames& rhs) const { return (data_ == rhs.data_); }
+
+bool JointNames::operator!=(const JointNames& rhs) const { return !operator==(rhs); }
+
+std::shared_ptr<const JointNames::Data> JointNames::intern(std::vector<std::string> joint_names)
+{
+  if (joint_names.empty())
+    return nullptr;
+
+  // The registry only holds weak references so names are released with their last handle. Expired entries are
+  // removed when their bucket is visited and the whole table is swept each time it doubles in size.
+  static std::mutex mutex;
+  static std::unordered_multimap<std::size_t, std::weak_ptr<const Data>> registry;
+  static std::size_t next_sweep{ 64 };
+
+  const std::size_t hash = hashJointNames(joint_names);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto range = registry.equal_range(hash);
+  for (auto it = range.first; it != range.second;)
+  {
+    std::shared_ptr<const Data> data = it->second.lock();
+    if (data == nullptr)
+    {
+      it = registry.erase(it);
+      continue;
+    }
+
+    if (data->names == joint_names)
+      return data;
+
+    ++it;
+  }
+
+  auto data = std::make_shared<Data>();
+  data->names = std::move(joint_names);
+  data->hash = hash;
+  registry.emplace(hash, data);
+
+  if (registry.size() >= next_sweep)
+  {
+    for (auto it = registry.begin(); it != registry.end();)
+      it = (it->second.expired()) ? registry.erase(it) : std::next(it);
+
+    next_sweep = std::max<std::size_t>(64, 2 * registry.size());
+  }
+
+  return data;
+}
+
+bool operator==(const JointNames& lhs, const std::vector<std::string>& rhs) { return (lhs.get() == rhs); }
+
+bool operator==(const std::vector<std::string>& lhs, const JointNames& rhs) { return (lhs == rhs.get()); }
+
+bool operator!=(const JointNames& lhs, const std::vector<std::string>& rhs) { return !(lhs == rhs); }
+
+bool operator!=(const std::vector<std::string>& lhs, const JointNames& rhs) { return !(lhs == rhs); }
+
+}  // namespace tesseract_planning
@@ -40,7 +40,7 @@ bool JointWaypoint::operator==(const JointWaypoint& rhs) const
 
   bool equal = true;
   equal &= tesseract_common::almostEqualRelativeAndAbs(waypoint, rhs.waypoint, max_diff);
-  equal &= tesseract_common::isIdentical(joint_names, rhs.joint_names);
+  equal &= (joint_names == rhs.joint_names);
   equal &= tesseract_common::almostEqualRelativeAndAbs(lower_tolerance, rhs.lower_tolerance, max_diff);
   equal &= tesseract_common::almostEqualRelativeAndAbs(upper_tolerance, rhs.upper_tolerance, max_diff);
   return equal;
@@ -50,7 +50,12 @@ bool JointWaypoint::operator!=(const JointWaypoint& rhs) const { return !operato
 template <class Archive>
 void JointWaypoint::serialize(Archive& ar, const unsigned int /*version*/)
 {
-  ar& BOOST_SERIALIZATION_NVP(joint_names);
+  // Serialized as a vector of names so archives do not depend on interning
+  std::vector<std::string> names = joint_names;
+  ar& boost::serialization::make_nvp("joint_names", names);
+  if (Archive::is_loading::value)
+    joint_names = JointNames(std::move(names));
+
   ar& BOOST_SERIALIZATION_NVP(waypoint);
   ar& BOOST_SERIALIZATION_NVP(upper_tolerance);
   ar& BOOST_SERIALIZATION_NVP(lower_tolerance);
@@ -59,9 +64,15 @@ void JointWaypoint::serialize(Archive& ar, const unsigned int /*version*/)
 
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 template void tesseract_planning::JointWaypoint::serialize(boost::archive::xml_oarchive& ar,
                                                            const unsigned int version);
 template void tesseract_planning::JointWaypoint::serialize(boost::archive::xml_iarchive& ar,
                                                            const unsigned int version);
+template void tesseract_planning::JointWaypoint::serialize(boost::archive::binary_oarchive& ar,
+                                                           const unsigned int version);
+template void tesseract_planning::JointWaypoint::serialize(boost::archive::binary_iarchive& ar,
+                                                           const unsigned int version);
 
 TESSERACT_WAYPOINT_EXPORT_IMPLEMENT(tesseract_planning::JointWaypoint);
@@ -0,0 +1,261 @@
+/**
+ * @file trajectory_segment_instruction.cpp
+ * @brief A flat trajectory container which stores each quantity in a contiguous block
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <iostream>
+#include <stdexcept>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/trajectory_segment_instruction.h>
+#include <tesseract_common/utils.h>
+
+namespace tesseract_planning
+{
+static bool almostEqualBlock(const Eigen::MatrixXd& lhs, const Eigen::MatrixXd& rhs, double max_diff)
+{
+  if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+    return false;
+
+  return tesseract_common::almostEqualRelativeAndAbs(Eigen::Map<const Eigen::VectorXd>(lhs.data(), lhs.size()),
+                                                     Eigen::Map<const Eigen::VectorXd>(rhs.data(), rhs.size()),
+                                                     max_diff);
+}
+
+TrajectorySegmentInstruction::TrajectorySegmentInstruction(std::vector<std::string> joint_names, Eigen::Index size)
+  : joint_names_(std::move(joint_names)), positions_(static_cast<Eigen::Index>(joint_names_.size()), 0)
+{
+  resize(size);
+}
+
+TrajectorySegmentInstruction::TrajectorySegmentInstruction(std::vector<std::string> joint_names,
+                                                           Eigen::Index dof,
+                                                           Eigen::Index size)
+  : joint_names_(std::move(joint_names)), positions_(dof, 0)
+{
+  resize(size);
+}
+
+TrajectorySegmentInstruction::TrajectorySegmentInstruction(const tesseract_common::JointTrajectory& trajectory)
+{
+  if (trajectory.empty())
+    return;
+
+  joint_names_ = trajectory.front().joint_names;
+  positions_.resize(trajectory.front().position.size(), 0);
+  resize(static_cast<Eigen::Index>(trajectory.size()));
+  for (std::size_t i = 0; i < trajectory.size(); ++i)
+    setState(static_cast<Eigen::Index>(i), trajectory[i]);
+}
+
+const std::string& TrajectorySegmentInstruction::getDescription() const { return description_; }
+
+void TrajectorySegmentInstruction::setDescription(const std::string& description) { description_ = description; }
+
+const std::string& TrajectorySegmentInstruction::getProfile() const { return profile_; }
+
+void TrajectorySegmentInstruction::setProfile(const std::string& profile)
+{
+  profile_ = (profile.empty()) ? "DEFAULT" : profile;
+}
+
+void TrajectorySegmentInstruction::print(const std::string& prefix) const  // NOLINT
+{
+  std::cout << prefix + "Trajectory Segment Instruction, States: " << size() << ", DOF: " << dof();
+  if (!empty())
+    std::cout << ", Duration: " << (times_(size() - 1) - times_(0));
+  std::cout << ", Description: " << getDescription() << std::endl;
+}
+
+const std::vector<std::string>& TrajectorySegmentInstruction::getJointNames() const { return joint_names_; }
+
+Eigen::Index TrajectorySegmentInstruction::size() const { return times_.size(); }
+
+Eigen::Index TrajectorySegmentInstruction::dof() const { return positions_.rows(); }
+
+bool TrajectorySegmentInstruction::empty() const { return (times_.size() == 0); }
+
+void TrajectorySegmentInstruction::resize(Eigen::Index size)
+{
+  const Eigen::Index old_size = this->size();
+  const Eigen::Index n = dof();
+
+  positions_.conservativeResize(n, size);
+  velocities_.conservativeResize(n, size);
+  accelerations_.conservativeResize(n, size);
+  efforts_.conservativeResize(n, size);
+  times_.conservativeResize(size);
+
+  if (size > old_size)
+  {
+    const Eigen::Index added = size - old_size;
+    positions_.rightCols(added).setZero();
+    velocities_.rightCols(added).setZero();
+    accelerations_.rightCols(added).setZero();
+    efforts_.rightCols(added).setZero();
+    times_.tail(added).setZero();
+  }
+}
+
+Eigen::MatrixXd& TrajectorySegmentInstruction::getPositions() { return positions_; }
+const Eigen::MatrixXd& TrajectorySegmentInstruction::getPositions() const { return positions_; }
+
+Eigen::MatrixXd& TrajectorySegmentInstruction::getVelocities() { return velocities_; }
+const Eigen::MatrixXd& TrajectorySegmentInstruction::getVelocities() const { return velocities_; }
+
+Eigen::MatrixXd& TrajectorySegmentInstruction::getAccelerations() { return accelerations_; }
+const Eigen::MatrixXd& TrajectorySegmentInstruction::getAccelerations() const { return accelerations_; }
+
+Eigen::MatrixXd& TrajectorySegmentInstruction::getEfforts() { return efforts_; }
+const Eigen::MatrixXd& TrajectorySegmentInstruction::getEfforts() const { return efforts_; }
+
+Eigen::VectorXd& TrajectorySegmentInstruction::getTimes() { return times_; }
+const Eigen::VectorXd& TrajectorySegmentInstruction::getTimes() const { return times_; }
+
+tesseract_common::JointState TrajectorySegmentInstruction::getState(Eigen::Index i) const
+{
+  tesseract_common::JointState state(joint_names_, positions_.col(i));
+  state.velocity = velocities_.col(i);
+  state.acceleration = accelerations_.col(i);
+  state.effort = efforts_.col(i);
+  state.time = times_(i);
+  return state;
+}
+
+void TrajectorySegmentInstruction::setState(Eigen::Index i, const tesseract_common::JointState& state)
+{
+  if (!tesseract_common::isIdentical(joint_names_, state.joint_names))
+    throw std::runtime_error("TrajectorySegmentInstruction: state joint names do not match the segment!");
+
+  if (i < 0 || i >= size())
+    throw std::out_of_range("TrajectorySegmentInstruction: state index is out of range!");
+
+  auto valid_size = [this](const Eigen::VectorXd& v, bool allow_empty) {
+    return (v.size() == dof() || (allow_empty && v.size() == 0));
+  };
+  if (!valid_size(state.position, false) || !valid_size(state.velocity, true) ||
+      !valid_size(state.acceleration, true) || !valid_size(state.effort, true))
+    throw std::runtime_error("TrajectorySegmentInstruction: state size does not match the segment!");
+
+  positions_.col(i) = state.position;
+
+  if (state.velocity.size() == 0)
+    velocities_.col(i).setZero();
+  else
+    velocities_.col(i) = state.velocity;
+
+  if (state.acceleration.size() == 0)
+    accelerations_.col(i).setZero();
+  else
+    accelerations_.col(i) = state.acceleration;
+
+  if (state.effort.size() == 0)
+    efforts_.col(i).setZero();
+  else
+    efforts_.col(i) = state.effort;
+
+  times_(i) = state.time;
+}
+
+tesseract_common::JointTrajectory TrajectorySegmentInstruction::toJointTrajectory() const
+{
+  tesseract_common::JointTrajectory trajectory;
+  trajectory.reserve(static_cast<std::size_t>(size()));
+  for (Eigen::Index i = 0; i < size(); ++i)
+    trajectory.push_back(getState(i));
+
+  return trajectory;
+}
+
+bool TrajectorySegmentInstruction::operator==(const TrajectorySegmentInstruction& rhs) const
+{
+  static auto max_diff = static_cast<double>(std::numeric_limits<float>::epsilon());
+
+  bool equal = true;
+  equal &= (profile_ == rhs.profile_);
+  equal &= tesseract_common::isIdentical(joint_names_, rhs.joint_names_);
+  equal &= (times_.size() == rhs.times_.size());
+  if (!equal)
+    return false;
+
+  equal &= almostEqualBlock(positions_, rhs.positions_, max_diff);
+  equal &= almostEqualBlock(velocities_, rhs.velocities_, max_diff);
+  equal &= almostEqualBlock(accelerations_, rhs.accelerations_, max_diff);
+  equal &= almostEqualBlock(efforts_, rhs.efforts_, max_diff);
+  equal &= tesseract_common::almostEqualRelativeAndAbs(times_, rhs.times_, max_diff);
+  return equal;
+}
+
+bool TrajectorySegmentInstruction::operator!=(const TrajectorySegmentInstruction& rhs) const
+{
+  return !operator==(rhs);
+}
+
+template <class Archive>
+void TrajectorySegmentInstruction::serialize(Archive& ar, const unsigned int /*version*/)
+{
+  ar& boost::serialization::make_nvp("description", description_);
+  ar& boost::serialization::make_nvp("profile", profile_);
+  ar& boost::serialization::make_nvp("joint_names", joint_names_);
+
+  Eigen::Index num_joints = dof();
+  Eigen::Index num_states = size();
+  ar& boost::serialization::make_nvp("dof", num_joints);
+  ar& boost::serialization::make_nvp("size", num_states);
+  if (Archive::is_loading::value)
+  {
+    positions_.resize(num_joints, 0);
+    resize(num_states);
+  }
+
+  const auto block_size = static_cast<std::size_t>(positions_.size());
+  const auto times_size = static_cast<std::size_t>(times_.size());
+  ar& boost::serialization::make_nvp("positions", boost::serialization::make_array(positions_.data(), block_size));
+  ar& boost::serialization::make_nvp("velocities", boost::serialization::make_array(velocities_.data(), block_size));
+  ar& boost::serialization::make_nvp("accelerations",
+                                     boost::serialization::make_array(accelerations_.data(), block_size));
+  ar& boost::serialization::make_nvp("efforts", boost::serialization::make_array(efforts_.data(), block_size));
+  ar& boost::serialization::make_nvp("times", boost::serialization::make_array(times_.data(), times_size));
+}
+}  // namespace tesseract_planning
+
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+template void tesseract_planning::TrajectorySegmentInstruction::serialize(boost::archive::xml_oarchive& ar,
+                                                                          const unsigned int version);
+template void tesseract_planning::TrajectorySegmentInstruction::serialize(boost::archive::xml_iarchive& ar,
+                                                                          const unsigned int version);
+template void tesseract_planning::TrajectorySegmentInstruction::serialize(boost::archive::binary_oarchive& ar,
+                                                                          const unsigned int version);
+template void tesseract_planning::TrajectorySegmentInstruction::serialize(boost::archive::binary_iarchive& ar,
+                                                                          const unsigned int version);
+
+TESSERACT_INSTRUCTION_EXPORT_IMPLEMENT(tesseract_planning::TrajectorySegmentInstruction);
@@ -37,6 +37,19 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/**
+ * @brief Check if a filter is one of the free function filters
+ * @details The composite instruction caches the counts for moveFilter and planFilter so these can skip walking the
+ * program
+ */
+static bool isFilter(const locateFilterFn& locate_filter,
+                     bool (*filter)(const Instruction&, const CompositeInstruction&, bool))
+{
+  using FilterPtr = bool (*)(const Instruction&, const CompositeInstruction&, bool);
+  const FilterPtr* target = locate_filter.target<FilterPtr>();
+  return (target != nullptr && *target == filter);
+}
+
 const Instruction* getFirstInstructionHelper(const CompositeInstruction& composite_instruction,
                                              locateFilterFn locate_filter,
                                              bool process_child_composites,
@@ -227,6 +240,12 @@ const Instruction* getFirstInstruction(const CompositeInstruction& composite_ins
                                        locateFilterFn locate_filter,
                                        bool process_child_composites)
 {
+  if (process_child_composites && isFilter(locate_filter, moveFilter))
+    return composite_instruction.getMoveInstructionAt(0);
+
+  if (process_child_composites && isFilter(locate_filter, planFilter))
+    return composite_instruction.getPlanInstructionAt(0);
+
   return getFirstInstructionHelper(composite_instruction, locate_filter, process_child_composites, true);
 }
 
@@ -234,6 +253,12 @@ Instruction* getFirstInstruction(CompositeInstruction& composite_instruction,
                                  locateFilterFn locate_filter,
                                  bool process_child_composites)
 {
+  if (process_child_composites && isFilter(locate_filter, moveFilter))
+    return composite_instruction.getMoveInstructionAt(0);
+
+  if (process_child_composites && isFilter(locate_filter, planFilter))
+    return composite_instruction.getPlanInstructionAt(0);
+
   return getFirstInstructionHelper(composite_instruction, locate_filter, process_child_composites, true);
 }
 
@@ -241,6 +266,16 @@ const Instruction* getLastInstruction(const CompositeInstruction& composite_inst
                                       locateFilterFn locate_filter,
                                       bool process_child_composites)
 {
+  // The counts would be computed by walking the whole program if they can not be cached
+  if (process_child_composites && composite_instruction.cacheInstructionCounts())
+  {
+    if (isFilter(locate_filter, moveFilter))
+      return composite_instruction.getMoveInstructionAt(composite_instruction.getInstructionCounts().move - 1);
+
+    if (isFilter(locate_filter, planFilter))
+      return composite_instruction.getPlanInstructionAt(composite_instruction.getInstructionCounts().plan - 1);
+  }
+
   return getLastInstructionHelper(composite_instruction, locate_filter, process_child_composites, true);
 }
 
@@ -248,6 +283,16 @@ Instruction* getLastInstruction(CompositeInstruction& composite_instruction,
                                 locateFilterFn locate_filter,
                                 bool process_child_composites)
 {
+  // The counts would be computed by walking the whole program if they can not be cached
+  if (process_child_composites && composite_instruction.cacheInstructionCounts())
+  {
+    if (isFilter(locate_filter, moveFilter))
+      return composite_instruction.getMoveInstructionAt(composite_instruction.getInstructionCounts().move - 1);
+
+    if (isFilter(locate_filter, planFilter))
+      return composite_instruction.getPlanInstructionAt(composite_instruction.getInstructionCounts().plan - 1);
+  }
+
   return getLastInstructionHelper(composite_instruction, locate_filter, process_child_composites, true);
 }
 
@@ -255,6 +300,18 @@ long getInstructionCount(const CompositeInstruction& composite_instruction,
                          locateFilterFn locate_filter,
                          bool process_child_composites)
 {
+  if (process_child_composites && composite_instruction.cacheInstructionCounts())
+  {
+    if (!locate_filter)
+      return composite_instruction.getInstructionCounts().total;
+
+    if (isFilter(locate_filter, moveFilter))
+      return composite_instruction.getInstructionCounts().move;
+
+    if (isFilter(locate_filter, planFilter))
+      return composite_instruction.getInstructionCounts().plan;
+  }
+
   return getInstructionCountHelper(composite_instruction, locate_filter, process_child_composites, true);
 }
 }  // namespace tesseract_planning
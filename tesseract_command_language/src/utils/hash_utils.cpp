@@ -0,0 +1,291 @@
+/**
+ * @file hash_utils.cpp
+ * @brief Stable structural hashing of instructions and waypoints
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <cstring>
+#include <limits>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/utils/hash_utils.h>
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/core/serialization.h>
+#include <tesseract_command_language/instruction_type.h>
+#include <tesseract_command_language/waypoint_type.h>
+
+namespace tesseract_planning
+{
+static constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+void StableHash::addBytes(const void* data, std::size_t size)
+{
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    value_ ^= bytes[i];
+    value_ *= FNV_PRIME;
+  }
+}
+
+void StableHash::addInteger(std::int64_t value) { addUnsigned(static_cast<std::uint64_t>(value)); }
+
+void StableHash::addUnsigned(std::uint64_t value)
+{
+  // Always little endian so the hash is the same on any platform
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    value_ ^= (value >> (8 * i)) & 0xFF;
+    value_ *= FNV_PRIME;
+  }
+}
+
+void StableHash::addDouble(double value)
+{
+  if (value == 0)
+    value = 0;
+  else if (std::isnan(value))
+    value = std::numeric_limits<double>::quiet_NaN();
+
+  std::uint64_t bits{ 0 };
+  std::memcpy(&bits, &value, sizeof(bits));
+  addUnsigned(bits);
+}
+
+void StableHash::addString(const std::string& value)
+{
+  addUnsigned(value.size());
+  addBytes(value.data(), value.size());
+}
+
+void StableHash::addStrings(const std::vector<std::string>& values)
+{
+  addUnsigned(values.size());
+  for (const auto& value : values)
+    addString(value);
+}
+
+void StableHash::addMatrix(const Eigen::Ref<const Eigen::MatrixXd>& value)
+{
+  addInteger(value.rows());
+  addInteger(value.cols());
+  for (Eigen::Index c = 0; c < value.cols(); ++c)
+    for (Eigen::Index r = 0; r < value.rows(); ++r)
+      addDouble(value(r, c));
+}
+
+void StableHash::addIsometry(const Eigen::Isometry3d& value) { addMatrix(value.matrix()); }
+
+std::uint64_t StableHash::getValue() const { return value_; }
+
+void hashAppend(StableHash& hash, const ManipulatorInfo& manipulator_info)
+{
+  hash.addString(manipulator_info.manipulator);
+  hash.addString(manipulator_info.manipulator_ik_solver);
+  hash.addString(manipulator_info.working_frame);
+
+  const auto& tcp = manipulator_info.tcp;
+  if (tcp.isString())
+  {
+    hash.addInteger(1);
+    hash.addString(tcp.getString());
+  }
+  else if (tcp.isTransform())
+  {
+    hash.addInteger(2);
+    hash.addIsometry(tcp.getTransform());
+  }
+  else
+  {
+    hash.addInteger(0);
+  }
+
+  hash.addInteger(tcp.isExternal() ? 1 : 0);
+  if (tcp.isExternal())
+    hash.addString(tcp.getExternalFrame());
+}
+
+void hashAppend(StableHash& hash, const NullWaypoint& /*waypoint*/) { hash.addString("NullWaypoint"); }
+
+void hashAppend(StableHash& hash, const CartesianWaypoint& waypoint)
+{
+  hash.addString("CartesianWaypoint");
+  hash.addIsometry(waypoint.waypoint);
+  hash.addMatrix(waypoint.lower_tolerance);
+  hash.addMatrix(waypoint.upper_tolerance);
+}
+
+void hashAppend(StableHash& hash, const JointWaypoint& waypoint)
+{
+  hash.addString("JointWaypoint");
+  hash.addStrings(waypoint.joint_names);
+  hash.addMatrix(waypoint.waypoint);
+  hash.addMatrix(waypoint.lower_tolerance);
+  hash.addMatrix(waypoint.upper_tolerance);
+}
+
+void hashAppend(StableHash& hash, const StateWaypoint& waypoint)
+{
+  hash.addString("StateWaypoint");
+  hash.addStrings(waypoint.joint_names);
+  hash.addMatrix(waypoint.position);
+  hash.addMatrix(waypoint.velocity);
+  hash.addMatrix(waypoint.acceleration);
+  hash.addMatrix(waypoint.effort);
+  hash.addDouble(waypoint.time);
+}
+
+void hashAppend(StableHash& hash, const Waypoint& waypoint)
+{
+  if (isNullWaypoint(waypoint))
+    hashAppend(hash, waypoint.as<NullWaypoint>());
+  else if (isCartesianWaypoint(waypoint))
+    hashAppend(hash, waypoint.as<CartesianWaypoint>());
+  else if (isJointWaypoint(waypoint))
+    hashAppend(hash, waypoint.as<JointWaypoint>());
+  else if (isStateWaypoint(waypoint))
+    hashAppend(hash, waypoint.as<StateWaypoint>());
+  else
+  {
+    hash.addString(waypoint.getType().name());
+    hash.addString(Serialization::toArchiveStringBinary<Waypoint>(waypoint));
+  }
+}
+
+void hashAppend(StableHash& hash, const NullInstruction& instruction)
+{
+  hash.addString("NullInstruction");
+  hash.addString(instruction.getDescription());
+}
+
+void hashAppend(StableHash& hash, const PlanInstruction& instruction)
+{
+  hash.addString("PlanInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addInteger(static_cast<int>(instruction.getPlanType()));
+  hash.addString(instruction.getProfile());
+  hashAppend(hash, instruction.getManipulatorInfo());
+  hashAppend(hash, instruction.getWaypoint());
+}
+
+void hashAppend(StableHash& hash, const MoveInstruction& instruction)
+{
+  hash.addString("MoveInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addInteger(static_cast<int>(instruction.getMoveType()));
+  hash.addString(instruction.getProfile());
+  hashAppend(hash, instruction.getManipulatorInfo());
+  hashAppend(hash, instruction.getWaypoint());
+}
+
+void hashAppend(StableHash& hash, const SetAnalogInstruction& instruction)
+{
+  hash.addString("SetAnalogInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addString(instruction.getKey());
+  hash.addInteger(instruction.getIndex());
+  hash.addDouble(instruction.getValue());
+}
+
+void hashAppend(StableHash& hash, const SetToolInstruction& instruction)
+{
+  hash.addString("SetToolInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addInteger(instruction.getTool());
+}
+
+void hashAppend(StableHash& hash, const TimerInstruction& instruction)
+{
+  hash.addString("TimerInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addInteger(static_cast<int>(instruction.getTimerType()));
+  hash.addDouble(instruction.getTimerTime());
+  hash.addInteger(instruction.getTimerIO());
+}
+
+void hashAppend(StableHash& hash, const WaitInstruction& instruction)
+{
+  hash.addString("WaitInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addInteger(static_cast<int>(instruction.getWaitType()));
+  hash.addDouble(instruction.getWaitTime());
+  hash.addInteger(instruction.getWaitIO());
+}
+
+void hashAppend(StableHash& hash, const TrajectorySegmentInstruction& instruction)
+{
+  hash.addString("TrajectorySegmentInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addString(instruction.getProfile());
+  hash.addStrings(instruction.getJointNames());
+  hash.addMatrix(instruction.getPositions());
+  hash.addMatrix(instruction.getVelocities());
+  hash.addMatrix(instruction.getAccelerations());
+  hash.addMatrix(instruction.getEfforts());
+  hash.addMatrix(instruction.getTimes());
+}
+
+void hashAppend(StableHash& hash, const CompositeInstruction& instruction)
+{
+  hash.addString("CompositeInstruction");
+  hash.addString(instruction.getDescription());
+  hash.addString(instruction.getProfile());
+  hash.addInteger(static_cast<int>(instruction.getOrder()));
+  hashAppend(hash, instruction.getManipulatorInfo());
+  hashAppend(hash, instruction.getStartInstruction());
+
+  hash.addUnsigned(instruction.size());
+  for (const auto& child : instruction)
+    hashAppend(hash, child);
+}
+
+void hashAppend(StableHash& hash, const Instruction& instruction)
+{
+  if (isCompositeInstruction(instruction))
+    hashAppend(hash, instruction.as<CompositeInstruction>());
+  else if (isMoveInstruction(instruction))
+    hashAppend(hash, instruction.as<MoveInstruction>());
+  else if (isPlanInstruction(instruction))
+    hashAppend(hash, instruction.as<PlanInstruction>());
+  else if (isNullInstruction(instruction))
+    hashAppend(hash, instruction.as<NullInstruction>());
+  else if (isTrajectorySegmentInstruction(instruction))
+    hashAppend(hash, instruction.as<TrajectorySegmentInstruction>());
+  else if (instruction.getType() == std::type_index(typeid(SetAnalogInstruction)))
+    hashAppend(hash, instruction.as<SetAnalogInstruction>());
+  else if (instruction.getType() == std::type_index(typeid(SetToolInstruction)))
+    hashAppend(hash, instruction.as<SetToolInstruction>());
+  else if (instruction.getType() == std::type_index(typeid(TimerInstruction)))
+    hashAppend(hash, instruction.as<TimerInstruction>());
+  else if (instruction.getType() == std::type_index(typeid(WaitInstruction)))
+    hashAppend(hash, instruction.as<WaitInstruction>());
+  else
+  {
+    hash.addString(instruction.getType().name());
+    hash.addString(Serialization::toArchiveStringBinary<Instruction>(instruction));
+  }
+}
+
+}  // namespace tesseract_planning
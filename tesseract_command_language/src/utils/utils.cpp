@@ -34,6 +34,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/joint_waypoint.h>
 #include <tesseract_command_language/cartesian_waypoint.h>
 #include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_command_language/trajectory_segment_instruction.h>
+#include <tesseract_common/utils.h>
 
 namespace tesseract_planning
 {
@@ -48,39 +50,144 @@ static tesseract_planning::locateFilterFn toJointTrajectoryMoveFilter =
 
         return true;
       }
-      return false;
+      return tesseract_planning::isTrajectorySegmentInstruction(i);
     };
 
+/** @brief Converts the time of each state of a program to the time from the start of the program */
+class TrajectoryTimeAccumulator
+{
+public:
+  double operator()(double current_time)
+  {
+    // It is possible for sub composites to start back from zero, this accounts for it
+    if (current_time < last_time_)
+      last_time_ = 0;
+
+    total_time_ += current_time - last_time_;
+    last_time_ = current_time;
+    return total_time_;
+  }
+
+private:
+  double last_time_{ 0 };
+  double total_time_{ 0 };
+};
+
 tesseract_common::JointTrajectory toJointTrajectory(const CompositeInstruction& composite_instructions)
 {
   tesseract_common::JointTrajectory trajectory;
-  std::vector<std::reference_wrapper<const tesseract_planning::Instruction>> flattened_program =
-      tesseract_planning::flatten(composite_instructions, toJointTrajectoryMoveFilter);
+  auto flattened_program = flattenView(composite_instructions, toJointTrajectoryMoveFilter);
   trajectory.reserve(flattened_program.size());
 
-  double last_time = 0;
-  double current_time = 0;
-  double total_time = 0;
-  for (auto& i : flattened_program)
+  TrajectoryTimeAccumulator accumulate_time;
+  for (const Instruction& i : flattened_program)
   {
-    const auto& mi = i.get().as<tesseract_planning::MoveInstruction>();
+    if (isTrajectorySegmentInstruction(i))
+    {
+      const auto& segment = i.as<TrajectorySegmentInstruction>();
+      for (Eigen::Index s = 0; s < segment.size(); ++s)
+      {
+        trajectory.push_back(segment.getState(s));
+        trajectory.back().time = accumulate_time(trajectory.back().time);
+      }
+      continue;
+    }
+
+    const auto& mi = i.as<tesseract_planning::MoveInstruction>();
     const auto& swp = mi.getWaypoint().as<tesseract_planning::StateWaypoint>();
-    tesseract_common::JointState joint_state(swp);
-    current_time = joint_state.time;
+    trajectory.emplace_back(swp);
+    trajectory.back().time = accumulate_time(trajectory.back().time);
+  }
+  return trajectory;
+}
 
-    // It is possible for sub composites to start back from zero, this accounts for it
-    if (current_time < last_time)
-      last_time = 0;
-
-    double dt = current_time - last_time;
-    total_time += dt;
-    joint_state.time = total_time;
-    last_time = current_time;
-    trajectory.push_back(joint_state);
+TrajectorySegmentInstruction toTrajectorySegment(const CompositeInstruction& composite_instructions)
+{
+  auto flattened_program = flattenView(composite_instructions, toJointTrajectoryMoveFilter);
+
+  // Size the segment up front so the states are copied straight into the contiguous blocks
+  Eigen::Index num_states = 0;
+  Eigen::Index dof = 0;
+  const std::vector<std::string>* joint_names = nullptr;
+  for (const Instruction& i : flattened_program)
+  {
+    if (isTrajectorySegmentInstruction(i))
+    {
+      const auto& segment = i.as<TrajectorySegmentInstruction>();
+      num_states += segment.size();
+      if (joint_names == nullptr && !segment.empty())
+      {
+        joint_names = &segment.getJointNames();
+        dof = segment.dof();
+      }
+    }
+    else
+    {
+      ++num_states;
+      if (joint_names == nullptr)
+      {
+        // The number of joints comes from the state because the joint names of a state waypoint may be empty
+        const auto& swp = i.as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+        joint_names = &swp.joint_names;
+        dof = swp.position.size();
+      }
+    }
   }
+
+  if (joint_names == nullptr)
+    return TrajectorySegmentInstruction();
+
+  TrajectorySegmentInstruction trajectory(*joint_names, dof, num_states);
+  trajectory.setProfile(composite_instructions.getProfile());
+
+  TrajectoryTimeAccumulator accumulate_time;
+  Eigen::Index idx = 0;
+  for (const Instruction& i : flattened_program)
+  {
+    if (isTrajectorySegmentInstruction(i))
+    {
+      const auto& segment = i.as<TrajectorySegmentInstruction>();
+      if (!tesseract_common::isIdentical(*joint_names, segment.getJointNames()))
+        throw std::runtime_error("toTrajectorySegment: joint names are not the same throughout the program!");
+
+      if (segment.dof() != dof)
+        throw std::runtime_error("toTrajectorySegment: number of joints is not the same throughout the program!");
+
+      const Eigen::Index n = segment.size();
+      trajectory.getPositions().middleCols(idx, n) = segment.getPositions();
+      trajectory.getVelocities().middleCols(idx, n) = segment.getVelocities();
+      trajectory.getAccelerations().middleCols(idx, n) = segment.getAccelerations();
+      trajectory.getEfforts().middleCols(idx, n) = segment.getEfforts();
+      for (Eigen::Index s = 0; s < n; ++s)
+        trajectory.getTimes()(idx + s) = accumulate_time(segment.getTimes()(s));
+
+      idx += n;
+      continue;
+    }
+
+    const auto& swp = i.as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+    trajectory.setState(idx, swp);
+    trajectory.getTimes()(idx) = accumulate_time(swp.time);
+    ++idx;
+  }
+
   return trajectory;
 }
 
+bool hasTrajectorySegment(const CompositeInstruction& composite_instructions)
+{
+  for (const auto& instruction : composite_instructions)
+  {
+    if (isTrajectorySegmentInstruction(instruction))
+      return true;
+
+    if (isCompositeInstruction(instruction) && hasTrajectorySegment(instruction.as<CompositeInstruction>()))
+      return true;
+  }
+
+  return false;
+}
+
 const Eigen::VectorXd& getJointPosition(const Waypoint& waypoint)
 {
   if (isJointWaypoint(waypoint))
@@ -103,33 +210,20 @@ const std::vector<std::string>& getJointNames(const Waypoint& waypoint)
   throw std::runtime_error("Unsupported waypoint type.");
 }
 
-Eigen::VectorXd getJointPosition(const std::vector<std::string>& joint_names, const Waypoint& waypoint)
+/**
+ * @brief Reorder joint values from the order of jn to the order of joint_names
+ * @param joint_names The joint names defining the order desired
+ * @param jn The joint names of the joint values
+ * @param jv The joint values
+ * @return The joint values ordered by the provided joint_names
+ */
+static Eigen::VectorXd reorderJointPosition(const std::vector<std::string>& joint_names,
+                                            const std::vector<std::string>& jn,
+                                            const Eigen::VectorXd& jv)
 {
-  Eigen::VectorXd jv;
-  std::vector<std::string> jn;
-  if (isJointWaypoint(waypoint))
-  {
-    const auto& jwp = waypoint.as<JointWaypoint>();
-    jv = jwp.waypoint;
-    jn = jwp.joint_names;
-  }
-  else if (isStateWaypoint(waypoint))
-  {
-    const auto& swp = waypoint.as<StateWaypoint>();
-    jv = swp.position;
-    jn = swp.joint_names;
-  }
-  else
-  {
-    throw std::runtime_error("Unsupported waypoint type.");
-  }
-
   if (jn.size() != joint_names.size())
     throw std::runtime_error("Joint name sizes do not match!");
 
-  if (joint_names == jn)
-    return jv;
-
   Eigen::VectorXd output = jv;
   for (std::size_t i = 0; i < joint_names.size(); ++i)
   {
@@ -147,19 +241,19 @@ Eigen::VectorXd getJointPosition(const std::vector<std::string>& joint_names, co
   return output;
 }
 
-bool formatJointPosition(const std::vector<std::string>& joint_names, Waypoint& waypoint)
+Eigen::VectorXd getJointPosition(const std::vector<std::string>& joint_names, const Waypoint& waypoint)
 {
-  Eigen::VectorXd* jv;
-  std::vector<std::string>* jn;
+  const Eigen::VectorXd* jv;
+  const std::vector<std::string>* jn;
   if (isJointWaypoint(waypoint))
   {
-    auto& jwp = waypoint.as<JointWaypoint>();
+    const auto& jwp = waypoint.as<JointWaypoint>();
     jv = &(jwp.waypoint);
-    jn = &(jwp.joint_names);
+    jn = &(jwp.joint_names.get());
   }
   else if (isStateWaypoint(waypoint))
   {
-    auto& swp = waypoint.as<StateWaypoint>();
+    const auto& swp = waypoint.as<StateWaypoint>();
     jv = &(swp.position);
     jn = &(swp.joint_names);
   }
@@ -172,26 +266,45 @@ bool formatJointPosition(const std::vector<std::string>& joint_names, Waypoint&
     throw std::runtime_error("Joint name sizes do not match!");
 
   if (joint_names == *jn)
+    return *jv;
+
+  return reorderJointPosition(joint_names, *jn, *jv);
+}
+
+bool formatJointPosition(const std::vector<std::string>& joint_names, Waypoint& waypoint)
+{
+  // Only intern the names if the waypoint needs to be reformatted
+  if (checkJointPositionFormat(joint_names, waypoint))
     return false;
 
-  Eigen::VectorXd output = *jv;
-  for (std::size_t i = 0; i < joint_names.size(); ++i)
-  {
-    if (joint_names[i] == (*jn)[i])
-      continue;
+  return formatJointPosition(JointNames(joint_names), waypoint);
+}
 
-    auto it = std::find(jn->begin(), jn->end(), joint_names[i]);
-    if (it == jn->end())
-      throw std::runtime_error("Joint names do not match!");
+bool formatJointPosition(const JointNames& joint_names, Waypoint& waypoint)
+{
+  if (isJointWaypoint(waypoint))
+  {
+    auto& jwp = waypoint.as<JointWaypoint>();
+    if (jwp.joint_names == joint_names)
+      return false;
 
-    long idx = std::distance(jn->begin(), it);
-    output(static_cast<long>(i)) = (*jv)(static_cast<long>(idx));
+    jwp.waypoint = reorderJointPosition(joint_names, jwp.joint_names, jwp.waypoint);
+    jwp.joint_names = joint_names;
+    return true;
   }
 
-  *jn = joint_names;
-  *jv = output;
+  if (isStateWaypoint(waypoint))
+  {
+    auto& swp = waypoint.as<StateWaypoint>();
+    if (swp.joint_names == joint_names)
+      return false;
 
-  return true;
+    swp.position = reorderJointPosition(joint_names, swp.joint_names, swp.position);
+    swp.joint_names = joint_names;
+    return true;
+  }
+
+  throw std::runtime_error("Unsupported waypoint type.");
 }
 
 bool checkJointPositionFormat(const std::vector<std::string>& joint_names, const Waypoint& waypoint)
@@ -205,6 +318,17 @@ bool checkJointPositionFormat(const std::vector<std::string>& joint_names, const
   throw std::runtime_error("Unsupported waypoint type.");
 }
 
+bool checkJointPositionFormat(const JointNames& joint_names, const Waypoint& waypoint)
+{
+  if (isJointWaypoint(waypoint))
+    return (joint_names == waypoint.as<JointWaypoint>().joint_names);
+
+  if (isStateWaypoint(waypoint))
+    return (joint_names == waypoint.as<StateWaypoint>().joint_names);
+
+  throw std::runtime_error("Unsupported waypoint type.");
+}
+
 bool setJointPosition(Waypoint& waypoint, const Eigen::Ref<const Eigen::VectorXd>& position)
 {
   if (isJointWaypoint(waypoint))
@@ -333,10 +457,12 @@ bool toDelimitedFile(const CompositeInstruction& composite_instructions, const s
   std::ofstream myfile;
   myfile.open(file_path);
 
-  std::vector<std::reference_wrapper<const Instruction>> mi = flatten(composite_instructions, &moveFilter);
+  auto mi = flattenView(composite_instructions, &moveFilter);
+  if (mi.empty())
+    return false;
 
   // Write Joint names as header
-  std::vector<std::string> joint_names = getJointNames(mi.front().get().as<MoveInstruction>().getWaypoint());
+  std::vector<std::string> joint_names = getJointNames(mi.begin()->as<MoveInstruction>().getWaypoint());
 
   for (std::size_t i = 0; i < joint_names.size() - 1; ++i)
     myfile << joint_names[i] << separator;
@@ -344,9 +470,9 @@ bool toDelimitedFile(const CompositeInstruction& composite_instructions, const s
   myfile << joint_names.back() << std::endl;
 
   // Write Positions
-  for (const auto& i : mi)
+  for (const Instruction& i : mi)
   {
-    Eigen::VectorXd p = getJointPosition(i.get().as<MoveInstruction>().getWaypoint());
+    Eigen::VectorXd p = getJointPosition(i.as<MoveInstruction>().getWaypoint());
     myfile << p.format(eigen_format) << std::endl;
   }
 
@@ -354,6 +480,48 @@ bool toDelimitedFile(const CompositeInstruction& composite_instructions, const s
   return true;
 }
 
+static std::size_t getMatrixMemoryUsage(const Eigen::Ref<const Eigen::MatrixXd>& matrix)
+{
+  return static_cast<std::size_t>(matrix.size()) * sizeof(double);
+}
+
+static std::size_t getNamesMemoryUsage(const std::vector<std::string>& names)
+{
+  std::size_t memory_usage = names.size() * sizeof(std::string);
+  for (const auto& name : names)
+    memory_usage += name.size();
+
+  return memory_usage;
+}
+
+static std::size_t getWaypointMemoryUsage(const Waypoint& waypoint)
+{
+  if (isStateWaypoint(waypoint))
+  {
+    const auto& swp = waypoint.as<StateWaypoint>();
+    return sizeof(StateWaypoint) + getNamesMemoryUsage(swp.joint_names) + getMatrixMemoryUsage(swp.position) +
+           getMatrixMemoryUsage(swp.velocity) + getMatrixMemoryUsage(swp.acceleration) +
+           getMatrixMemoryUsage(swp.effort);
+  }
+
+  if (isJointWaypoint(waypoint))
+  {
+    // The joint names are interned so they are shared with the other waypoints
+    const auto& jwp = waypoint.as<JointWaypoint>();
+    return sizeof(JointWaypoint) + getMatrixMemoryUsage(jwp.waypoint) + getMatrixMemoryUsage(jwp.lower_tolerance) +
+           getMatrixMemoryUsage(jwp.upper_tolerance);
+  }
+
+  if (isCartesianWaypoint(waypoint))
+  {
+    const auto& cwp = waypoint.as<CartesianWaypoint>();
+    return sizeof(CartesianWaypoint) + getMatrixMemoryUsage(cwp.lower_tolerance) +
+           getMatrixMemoryUsage(cwp.upper_tolerance);
+  }
+
+  return sizeof(Waypoint);
+}
+
 CompositeInstruction generateSkeletonSeed(const CompositeInstruction& composite_instructions)
 {
   CompositeInstruction seed = composite_instructions;
@@ -361,4 +529,37 @@ CompositeInstruction generateSkeletonSeed(const CompositeInstruction& composite_
   return seed;
 }
 
+std::size_t estimateMemoryUsage(const Instruction& instruction)
+{
+  if (isCompositeInstruction(instruction))
+  {
+    const auto& composite = instruction.as<CompositeInstruction>();
+    std::size_t memory_usage = sizeof(Instruction) + sizeof(CompositeInstruction) +
+                               estimateMemoryUsage(composite.getStartInstruction());
+    for (const auto& child : composite)
+      memory_usage += estimateMemoryUsage(child);
+
+    return memory_usage;
+  }
+
+  if (isMoveInstruction(instruction))
+    return sizeof(Instruction) + sizeof(MoveInstruction) +
+           getWaypointMemoryUsage(instruction.as<MoveInstruction>().getWaypoint());
+
+  if (isPlanInstruction(instruction))
+    return sizeof(Instruction) + sizeof(PlanInstruction) +
+           getWaypointMemoryUsage(instruction.as<PlanInstruction>().getWaypoint());
+
+  if (isTrajectorySegmentInstruction(instruction))
+  {
+    const auto& segment = instruction.as<TrajectorySegmentInstruction>();
+    return sizeof(Instruction) + sizeof(TrajectorySegmentInstruction) +
+           getNamesMemoryUsage(segment.getJointNames()) + getMatrixMemoryUsage(segment.getPositions()) +
+           getMatrixMemoryUsage(segment.getVelocities()) + getMatrixMemoryUsage(segment.getAccelerations()) +
+           getMatrixMemoryUsage(segment.getEfforts()) + getMatrixMemoryUsage(segment.getTimes());
+  }
+
+  return sizeof(Instruction);
+}
+
 }  // namespace tesseract_planning
@@ -90,9 +90,15 @@ void WaitInstruction::serialize(Archive& ar, const unsigned int /*version*/)
 
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 template void tesseract_planning::WaitInstruction::serialize(boost::archive::xml_oarchive& ar,
                                                              const unsigned int version);
 template void tesseract_planning::WaitInstruction::serialize(boost::archive::xml_iarchive& ar,
                                                              const unsigned int version);
+template void tesseract_planning::WaitInstruction::serialize(boost::archive::binary_oarchive& ar,
+                                                             const unsigned int version);
+template void tesseract_planning::WaitInstruction::serialize(boost::archive::binary_iarchive& ar,
+                                                             const unsigned int version);
 
 TESSERACT_INSTRUCTION_EXPORT_IMPLEMENT(tesseract_planning::WaitInstruction);
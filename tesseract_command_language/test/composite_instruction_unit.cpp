@@ -0,0 +1,263 @@
+/**
+ * @file composite_instruction_unit.cpp
+ * @brief Contains unit tests for CompositeInstruction
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/wait_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/plan_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_command_language/utils/flatten_utils.h>
+#include <tesseract_command_language/utils/get_instruction_utils.h>
+
+using namespace tesseract_planning;
+
+static CompositeInstruction createProgram()
+{
+  CompositeInstruction program;
+  for (int i = 0; i < 3; ++i)
+  {
+    CompositeInstruction sub;
+    for (int j = 0; j < 4; ++j)
+      sub.push_back(WaitInstruction(j));
+
+    program.push_back(sub);
+  }
+  return program;
+}
+
+static CompositeInstruction createMotionProgram()
+{
+  Waypoint wp = StateWaypoint({ "j1", "j2" }, Eigen::VectorXd::Zero(2));
+  CompositeInstruction program;
+  program.setStartInstruction(MoveInstruction(wp, MoveInstructionType::START));
+  for (int i = 0; i < 3; ++i)
+  {
+    CompositeInstruction sub;
+    sub.setStartInstruction(MoveInstruction(wp, MoveInstructionType::START));
+    for (int j = 0; j < 4; ++j)
+    {
+      sub.push_back(MoveInstruction(wp, MoveInstructionType::FREESPACE));
+      sub.push_back(PlanInstruction(wp, PlanInstructionType::FREESPACE));
+    }
+
+    CompositeInstruction nested;
+    nested.push_back(MoveInstruction(wp, MoveInstructionType::LINEAR));
+    nested.push_back(WaitInstruction(i));
+    sub.push_back(nested);
+
+    program.push_back(sub);
+    program.push_back(WaitInstruction(i));
+  }
+  return program;
+}
+
+static void checkInstructionCounts(const CompositeInstruction& program)
+{
+  auto all = [](const Instruction&, const CompositeInstruction&, bool) { return true; };
+  CompositeInstructionCounts counts = program.getInstructionCounts();
+  EXPECT_EQ(counts.total, getInstructionCount(program, all));
+
+  auto moves = flatten(program, moveFilter);
+  EXPECT_EQ(counts.move, static_cast<long>(moves.size()));
+  EXPECT_EQ(getMoveInstructionCount(program), counts.move);
+  for (std::size_t i = 0; i < moves.size(); ++i)
+    EXPECT_EQ(program.getMoveInstructionAt(static_cast<long>(i)), &moves[i].get());
+
+  auto plans = flatten(program, planFilter);
+  EXPECT_EQ(counts.plan, static_cast<long>(plans.size()));
+  EXPECT_EQ(getPlanInstructionCount(program), counts.plan);
+  for (std::size_t i = 0; i < plans.size(); ++i)
+    EXPECT_EQ(program.getPlanInstructionAt(static_cast<long>(i)), &plans[i].get());
+
+  EXPECT_EQ(program.getMoveInstructionAt(-1), nullptr);
+  EXPECT_EQ(program.getMoveInstructionAt(counts.move), nullptr);
+  EXPECT_EQ(program.getPlanInstructionAt(counts.plan), nullptr);
+
+  if (!moves.empty())
+  {
+    EXPECT_EQ(getFirstMoveInstruction(program), &moves.front().get().as<MoveInstruction>());
+    EXPECT_EQ(getLastMoveInstruction(program), &moves.back().get().as<MoveInstruction>());
+  }
+}
+
+TEST(TesseractCommandLanguageCompositeInstructionUnit, copyOnWrite)  // NOLINT
+{
+  const CompositeInstruction program = createProgram();
+
+  // A copy shares the children until it is modified
+  CompositeInstruction copy = program;
+  const CompositeInstruction& const_copy = copy;
+  EXPECT_EQ(&program.getInstructions(), &const_copy.getInstructions());
+  EXPECT_TRUE(program == copy);
+
+  // Modifying a nested child only clones the path to that child
+  copy.back().as<CompositeInstruction>().front().as<WaitInstruction>().setWaitTime(42);
+  EXPECT_NE(&program.getInstructions(), &const_copy.getInstructions());
+  EXPECT_DOUBLE_EQ(program.back().as<CompositeInstruction>().front().as<WaitInstruction>().getWaitTime(), 0);
+  EXPECT_DOUBLE_EQ(const_copy.back().as<CompositeInstruction>().front().as<WaitInstruction>().getWaitTime(), 42);
+  EXPECT_EQ(&program.front().as<CompositeInstruction>().getInstructions(),
+            &const_copy.front().as<CompositeInstruction>().getInstructions());
+  EXPECT_FALSE(program == copy);
+
+  // Iterators from the shared children can be used to modify a copy
+  CompositeInstruction copy2 = program;
+  copy2.erase(program.begin() + 1);
+  EXPECT_EQ(copy2.size(), 2);
+  EXPECT_EQ(program.size(), 3);
+}
+
+TEST(TesseractCommandLanguageCompositeInstructionUnit, copyAfterMutableReference)  // NOLINT
+{
+  CompositeInstruction program = createProgram();
+  const CompositeInstruction& const_program = program;
+
+  // Sharing is tracked by ownership so the children are shared even after a mutable reference was handed out
+  program.front().setDescription("Modified");
+  CompositeInstruction copy = program;
+  const CompositeInstruction& const_copy = copy;
+  EXPECT_EQ(&const_program.getInstructions(), &const_copy.getInstructions());
+
+  // Modifying either one afterwards clones the children
+  program.front().setDescription("Modified again");
+  EXPECT_NE(&const_program.getInstructions(), &const_copy.getInstructions());
+  EXPECT_EQ(const_program.front().getDescription(), "Modified again");
+  EXPECT_EQ(const_copy.front().getDescription(), "Modified");
+
+  // Unique children are modified in place
+  const std::vector<Instruction>* children = &const_program.getInstructions();
+  program.back().setDescription("Unique");
+  copy.back().setDescription("Unique");
+  EXPECT_EQ(&const_program.getInstructions(), children);
+
+  // Clearing invalidates all references
+  program.clear();
+  program.push_back(WaitInstruction(1));
+  CompositeInstruction copy2 = program;
+  EXPECT_EQ(&const_program.getInstructions(), &static_cast<const CompositeInstruction&>(copy2).getInstructions());
+}
+
+TEST(TesseractCommandLanguageCompositeInstructionUnit, instructionCounts)  // NOLINT
+{
+  Waypoint wp = StateWaypoint({ "j1", "j2" }, Eigen::VectorXd::Zero(2));
+  CompositeInstruction program = createMotionProgram();
+  const CompositeInstruction& const_program = program;
+
+  // Only the start instruction of the top most composite is counted
+  CompositeInstructionCounts counts = const_program.getInstructionCounts();
+  EXPECT_EQ(counts.move, 16);
+  EXPECT_EQ(counts.plan, 12);
+  EXPECT_EQ(counts.total, 43);
+  checkInstructionCounts(const_program);
+
+  // Copies share the cached counts and are updated when modified
+  CompositeInstruction copy = const_program;
+  copy.push_back(MoveInstruction(wp, MoveInstructionType::FREESPACE));
+  EXPECT_EQ(copy.getInstructionCounts().move, 17);
+  EXPECT_EQ(const_program.getInstructionCounts().move, 16);
+  checkInstructionCounts(copy);
+
+  // Modifying a nested child through a mutable reference
+  auto& sub = program[2].as<CompositeInstruction>();
+  sub.erase(sub.begin(), sub.begin() + 2);
+  EXPECT_EQ(const_program.getInstructionCounts().move, 15);
+  checkInstructionCounts(const_program);
+
+  auto& nested = sub.back().as<CompositeInstruction>();
+  nested.push_back(PlanInstruction(wp, PlanInstructionType::LINEAR));
+  EXPECT_EQ(const_program.getInstructionCounts().plan, 12);
+  checkInstructionCounts(const_program);
+
+  nested.front().as<MoveInstruction>().setMoveType(MoveInstructionType::START);
+  EXPECT_EQ(const_program.getInstructionCounts().move, 14);
+  checkInstructionCounts(const_program);
+
+  // The children can be cached again once replaced
+  program.setInstructions(copy.getInstructions());
+  checkInstructionCounts(const_program);
+
+  // Non-const access returns the same instruction
+  EXPECT_EQ(program.getMoveInstructionAt(3), &flatten(program, moveFilter)[3].get());
+  program.clear();
+  EXPECT_EQ(const_program.getInstructionCounts().move, 1);
+  EXPECT_EQ(const_program.getMoveInstructionAt(0), &const_program.getStartInstruction());
+}
+
+TEST(TesseractCommandLanguageCompositeInstructionUnit, instructionCountsNotCacheable)  // NOLINT
+{
+  Waypoint wp = StateWaypoint({ "j1", "j2" }, Eigen::VectorXd::Zero(2));
+  CompositeInstruction program = createMotionProgram();
+  const CompositeInstruction& const_program = program;
+  EXPECT_TRUE(const_program.cacheInstructionCounts());
+
+  // Locating a mutable instruction does not hand out references to the composites along the path
+  program.getMoveInstructionAt(5)->setDescription("Located");
+  getLastPlanInstruction(program)->setDescription("Last");
+  EXPECT_TRUE(const_program.cacheInstructionCounts());
+  EXPECT_EQ(const_program.getMoveInstructionAt(5)->getDescription(), "Located");
+  EXPECT_EQ(getLastPlanInstruction(const_program)->getDescription(), "Last");
+
+  // Only the shared composites along the path are cloned
+  CompositeInstruction copy = const_program;
+  const CompositeInstruction& const_copy = copy;
+  copy.getMoveInstructionAt(5)->setDescription("Copy");
+  EXPECT_EQ(const_program.getMoveInstructionAt(5)->getDescription(), "Located");
+  EXPECT_EQ(const_copy.getMoveInstructionAt(5)->getDescription(), "Copy");
+  EXPECT_NE(&const_program.getInstructions(), &const_copy.getInstructions());
+  EXPECT_EQ(&const_program[4].as<CompositeInstruction>().getInstructions(),
+            &const_copy[4].as<CompositeInstruction>().getInstructions());
+  EXPECT_TRUE(const_copy.cacheInstructionCounts());
+
+  // A mutable reference to a nested child prevents caching the counts of every composite containing it
+  auto& nested = program[0].as<CompositeInstruction>().back().as<CompositeInstruction>();
+  EXPECT_FALSE(const_program.cacheInstructionCounts());
+  EXPECT_FALSE(const_program.front().as<CompositeInstruction>().cacheInstructionCounts());
+  EXPECT_TRUE(const_program[2].as<CompositeInstruction>().cacheInstructionCounts());
+
+  // The program is walked instead and modifications through the reference are found
+  nested.push_back(MoveInstruction(wp, MoveInstructionType::LINEAR));
+  nested.back().setDescription("Nested");
+  EXPECT_EQ(const_program.getInstructionCounts().move, 17);
+  EXPECT_EQ(const_program.getMoveInstructionAt(6)->getDescription(), "Nested");
+  checkInstructionCounts(const_program);
+  EXPECT_EQ(getInstructionCount(program, moveFilter), 17);
+  EXPECT_EQ(getLastMoveInstruction(program), &flatten(program, moveFilter).back().get().as<MoveInstruction>());
+  EXPECT_FALSE(const_program.cacheInstructionCounts());
+
+  // The counts can be cached again once the children are replaced
+  program.setInstructions(copy.getInstructions());
+  EXPECT_TRUE(const_program.cacheInstructionCounts());
+  checkInstructionCounts(const_program);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -158,6 +158,68 @@ TEST(TesseractCommandLanguageJointWaypointUnit, equalityOperatorAndSerialization
   }
 }
 
+TEST(TesseractCommandLanguageJointWaypointUnit, internedJointNames)  // NOLINT
+{
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3" };
+
+  JointWaypoint wp1(joint_names, Eigen::VectorXd::Constant(3, 1));
+  JointWaypoint wp2(joint_names, Eigen::VectorXd::Constant(3, 2));
+  JointWaypoint wp3({ "joint_3", "joint_2", "joint_1" }, Eigen::VectorXd::Constant(3, 1));
+
+  // Identical names share the same storage
+  EXPECT_TRUE(wp1.joint_names == wp2.joint_names);
+  EXPECT_EQ(&wp1.joint_names.get(), &wp2.joint_names.get());
+  EXPECT_EQ(wp1.joint_names.hash(), wp2.joint_names.hash());
+  EXPECT_TRUE(wp1.joint_names != wp3.joint_names);
+
+  // The handle can be used where a vector of names is expected
+  EXPECT_TRUE(wp1.joint_names == joint_names);
+  EXPECT_TRUE(joint_names == wp1.joint_names);
+  EXPECT_TRUE(wp3.joint_names != joint_names);
+  const std::vector<std::string>& names = wp1.joint_names;
+  EXPECT_EQ(names, joint_names);
+  EXPECT_EQ(wp1.joint_names.size(), 3);
+  EXPECT_EQ(wp1.joint_names[1], "joint_2");
+
+  // Assigning a vector interns it
+  wp3.joint_names = joint_names;
+  EXPECT_TRUE(wp1.joint_names == wp3.joint_names);
+
+  JointNames empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_TRUE(empty == JointNames(std::vector<std::string>()));
+}
+
+TEST(TesseractCommandLanguageJointWaypointUnit, inlineStorage)  // NOLINT
+{
+  EXPECT_TRUE(detail_waypoint::WaypointInner<JointWaypoint>::isStoredInline());
+
+  JointWaypoint jwp({ "joint_1", "joint_2", "joint_3" }, Eigen::VectorXd::Constant(3, 1));
+  Waypoint wp(jwp);
+  EXPECT_TRUE(wp.as<JointWaypoint>() == jwp);
+
+  // Copies are independent
+  Waypoint copy(wp);
+  copy.as<JointWaypoint>().waypoint(0) = 5;
+  EXPECT_TRUE(wp.as<JointWaypoint>() == jwp);
+  EXPECT_FALSE(copy.as<JointWaypoint>() == jwp);
+
+  // Moving does not copy the waypoint data
+  const double* data = wp.as<JointWaypoint>().waypoint.data();
+  Waypoint moved(std::move(wp));
+  EXPECT_EQ(moved.as<JointWaypoint>().waypoint.data(), data);
+
+  copy = std::move(moved);
+  EXPECT_EQ(copy.as<JointWaypoint>().waypoint.data(), data);
+
+  // Converting from an rvalue moves
+  JointWaypoint jwp2 = jwp;
+  data = jwp2.waypoint.data();
+  Waypoint wp2(std::move(jwp2));
+  EXPECT_EQ(wp2.as<JointWaypoint>().waypoint.data(), data);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -197,6 +197,36 @@ TEST(TesseractCommandLanguageSerializeUnit, serializationCompositeInstruction)
   }
 }
 
+TEST(TesseractCommandLanguageSerializeUnit, serializationCompositeInstructionBinary)  // NOLINT
+{
+  Instruction program = getProgram();
+  for (bool compress : { false, true })
+  {
+    {  // Archive program to file
+      std::string file_path = tesseract_common::getTempPath() + "composite_instruction_boost.bin";
+      EXPECT_TRUE(Serialization::toArchiveFileBinary<Instruction>(program, file_path, compress));
+      Instruction nprogram = Serialization::fromArchiveFileBinary<Instruction>(file_path);
+      EXPECT_TRUE(program == nprogram);
+    }
+
+    {  // Archive program to string
+      std::string program_string = Serialization::toArchiveStringBinary<Instruction>(program, compress);
+      EXPECT_FALSE(program_string.empty());
+      Instruction nprogram = Serialization::fromArchiveStringBinary<Instruction>(program_string);
+      EXPECT_TRUE(program == nprogram);
+    }
+  }
+
+  // The binary archive is smaller than the xml archive
+  std::string xml_string = Serialization::toArchiveStringXML<Instruction>(program);
+  std::string binary_string = Serialization::toArchiveStringBinary<Instruction>(program);
+  EXPECT_LT(binary_string.size(), xml_string.size());
+
+  // Invalid archives throw
+  EXPECT_ANY_THROW(Serialization::fromArchiveStringBinary<Instruction>(xml_string));  // NOLINT
+  EXPECT_ANY_THROW(Serialization::fromArchiveStringBinary<Instruction>(binary_string.substr(0, 6)));  // NOLINT
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
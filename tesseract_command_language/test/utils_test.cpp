@@ -26,6 +26,7 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <fstream>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/command_language.h>
@@ -154,6 +155,76 @@ TEST(TesseractCommandLanguageUtilsUnit, flatten)  // NOLINT
   }
 }
 
+TEST(TesseractCommandLanguageUtilsUnit, flattenView)  // NOLINT
+{
+  // Create a composite with start instructions and a nesting deeper than the inline depth of the iterator
+  CompositeInstruction composite;
+  composite.setStartInstruction(PlanInstruction(CartesianWaypoint(Eigen::Isometry3d::Identity()),
+                                                PlanInstructionType::START));
+  for (std::size_t i = 0; i < 3; i++)
+  {
+    CompositeInstruction sub_composite;
+    if (i == 1)
+      sub_composite.setStartInstruction(PlanInstruction(CartesianWaypoint(Eigen::Isometry3d::Identity()),
+                                                        PlanInstructionType::START));
+
+    for (std::size_t j = 0; j < 2; j++)
+      sub_composite.push_back(PlanInstruction(CartesianWaypoint(Eigen::Isometry3d::Identity()),
+                                              PlanInstructionType::LINEAR));
+
+    CompositeInstruction nested;
+    nested.push_back(PlanInstruction(CartesianWaypoint(Eigen::Isometry3d::Identity()), PlanInstructionType::LINEAR));
+    for (std::size_t d = 0; d < 10; d++)
+    {
+      CompositeInstruction parent;
+      parent.push_back(nested);
+      nested = parent;
+    }
+    sub_composite.push_back(nested);
+    sub_composite.push_back(CompositeInstruction());
+    composite.push_back(sub_composite);
+  }
+
+  flattenFilterFn all_filter = [](const Instruction&, const CompositeInstruction&, bool) { return true; };
+  flattenFilterFn first_filter = [](const Instruction& i, const CompositeInstruction&, bool parent_is_first_composite) {
+    return (parent_is_first_composite || !isCompositeInstruction(i));
+  };
+
+  for (const flattenFilterFn& filter : { flattenFilterFn(), all_filter, first_filter })
+  {
+    const CompositeInstruction& const_composite = composite;
+    std::vector<std::reference_wrapper<const Instruction>> flattened = flatten(const_composite, filter);
+
+    std::size_t cnt = 0;
+    for (const auto& i : flattenView(const_composite, filter))
+    {
+      ASSERT_LT(cnt, flattened.size());
+      EXPECT_EQ(&i, &flattened[cnt].get());
+      ++cnt;
+    }
+    EXPECT_EQ(cnt, flattened.size());
+    EXPECT_EQ(flattenView(const_composite, filter).size(), flattened.size());
+
+    // Mutable view visits the same instructions
+    std::vector<std::reference_wrapper<Instruction>> mutable_flattened = flatten(composite, filter);
+    auto view = flattenView(composite, filter);
+    EXPECT_TRUE(std::equal(view.begin(),
+                           view.end(),
+                           mutable_flattened.begin(),
+                           mutable_flattened.end(),
+                           [](const Instruction& lhs, const Instruction& rhs) { return &lhs == &rhs; }));
+  }
+
+  // Works with standard algorithms
+  auto view = flattenView(composite, moveFilter);
+  EXPECT_TRUE(view.empty());
+  auto plan_view = flattenView(composite, planFilter);
+  EXPECT_EQ(std::count_if(plan_view.begin(),
+                          plan_view.end(),
+                          [](const Instruction& i) { return isPlanInstruction(i); }),
+            static_cast<std::ptrdiff_t>(plan_view.size()));
+}
+
 TEST(TesseractCommandLanguageUtilsUnit, flattenToPattern)  // NOLINT
 {
   // Create a composite
@@ -503,6 +574,157 @@ TEST(TesseractCommandLanguageUtilsUnit, toDelimitedFile)
   EXPECT_EQ(check, buffer.str());
 }
 
+TEST(TesseractCommandLanguageUtilsUnit, toTrajectorySegment)  // NOLINT
+{
+  std::vector<std::string> joint_names = { "1", "2", "3" };
+
+  CompositeInstruction composite;
+  for (int i = 0; i < 5; ++i)
+  {
+    StateWaypoint swp(joint_names, Eigen::VectorXd::Constant(3, i));
+    swp.velocity = Eigen::VectorXd::Constant(3, 2 * i);
+    swp.time = i;
+    composite.push_back(MoveInstruction(swp, MoveInstructionType::FREESPACE));
+  }
+  EXPECT_FALSE(hasTrajectorySegment(composite));
+
+  // The time of each sub composite restarts from zero
+  CompositeInstruction sub_composite;
+  TrajectorySegmentInstruction sub_segment(joint_names, 3);
+  for (Eigen::Index i = 0; i < sub_segment.size(); ++i)
+  {
+    sub_segment.getPositions().col(i).setConstant(static_cast<double>(5 + i));
+    sub_segment.getTimes()(i) = static_cast<double>(i);
+  }
+  sub_composite.push_back(sub_segment);
+  composite.push_back(sub_composite);
+
+  EXPECT_TRUE(hasTrajectorySegment(composite));
+
+  TrajectorySegmentInstruction segment = toTrajectorySegment(composite);
+  ASSERT_EQ(segment.size(), 8);
+  ASSERT_EQ(segment.dof(), 3);
+  EXPECT_TRUE(tesseract_common::isIdentical(segment.getJointNames(), joint_names));
+
+  tesseract_common::JointTrajectory trajectory = toJointTrajectory(composite);
+  ASSERT_EQ(trajectory.size(), 8);
+  for (Eigen::Index i = 0; i < segment.size(); ++i)
+  {
+    const auto& state = trajectory[static_cast<std::size_t>(i)];
+    EXPECT_TRUE(segment.getPositions().col(i).isApprox(state.position));
+    EXPECT_TRUE(segment.getVelocities().col(i).isApprox(state.velocity));
+    EXPECT_NEAR(segment.getTimes()(i), state.time, 1e-8);
+  }
+  EXPECT_NEAR(segment.getTimes()(4), 4, 1e-8);
+  EXPECT_NEAR(segment.getTimes()(5), 4, 1e-8);
+  EXPECT_NEAR(segment.getTimes()(7), 6, 1e-8);
+
+  // Round trip through a joint trajectory
+  TrajectorySegmentInstruction from_trajectory(trajectory);
+  EXPECT_TRUE(from_trajectory == segment);
+  EXPECT_EQ(from_trajectory.toJointTrajectory().size(), trajectory.size());
+
+  // Joint names must match the segment
+  tesseract_common::JointState bad_state({ "a", "b", "c" }, Eigen::VectorXd::Zero(3));
+  EXPECT_ANY_THROW(segment.setState(0, bad_state));  // NOLINT
+
+  // The state sizes must match the segment and the index must be in range
+  tesseract_common::JointState short_state(joint_names, Eigen::VectorXd::Zero(2));
+  EXPECT_ANY_THROW(segment.setState(0, short_state));  // NOLINT
+  tesseract_common::JointState bad_velocity(joint_names, Eigen::VectorXd::Zero(3));
+  bad_velocity.velocity = Eigen::VectorXd::Zero(4);
+  EXPECT_ANY_THROW(segment.setState(0, bad_velocity));  // NOLINT
+  EXPECT_ANY_THROW(segment.setState(segment.size(), trajectory.front()));  // NOLINT
+  EXPECT_NO_THROW(segment.setState(0, trajectory.front()));  // NOLINT
+}
+
+TEST(TesseractCommandLanguageUtilsUnit, toTrajectorySegmentUnnamed)  // NOLINT
+{
+  // The number of joints comes from the states when the state waypoints have no joint names
+  CompositeInstruction composite;
+  for (int i = 0; i < 4; ++i)
+  {
+    StateWaypoint swp;
+    swp.position = Eigen::VectorXd::Constant(3, i);
+    swp.time = i;
+    composite.push_back(MoveInstruction(swp, MoveInstructionType::FREESPACE));
+  }
+
+  TrajectorySegmentInstruction segment = toTrajectorySegment(composite);
+  ASSERT_EQ(segment.size(), 4);
+  ASSERT_EQ(segment.dof(), 3);
+  EXPECT_TRUE(segment.getJointNames().empty());
+  for (Eigen::Index i = 0; i < segment.size(); ++i)
+    EXPECT_TRUE(segment.getPositions().col(i).isApprox(Eigen::VectorXd::Constant(3, static_cast<double>(i))));
+
+  // The number of joints must be the same for every state
+  StateWaypoint short_swp;
+  short_swp.position = Eigen::VectorXd::Zero(2);
+  composite.push_back(MoveInstruction(short_swp, MoveInstructionType::FREESPACE));
+  EXPECT_ANY_THROW(toTrajectorySegment(composite));  // NOLINT
+}
+
+TEST(TesseractCommandLanguageUtilsUnit, getStableHash)  // NOLINT
+{
+  std::vector<std::string> joint_names{ "joint_1", "joint_2", "joint_3" };
+  auto createProgram = [&joint_names](double x) {
+    CompositeInstruction program("DEFAULT", CompositeInstructionOrder::ORDERED, ManipulatorInfo("manipulator"));
+    program.setStartInstruction(PlanInstruction(StateWaypoint(joint_names, Eigen::VectorXd::Zero(3)),
+                                                PlanInstructionType::START));
+
+    CompositeInstruction raster("RASTER");
+    raster.push_back(PlanInstruction(JointWaypoint(joint_names, Eigen::VectorXd::Ones(3)),
+                                     PlanInstructionType::FREESPACE));
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    pose.translation().x() = x;
+    raster.push_back(PlanInstruction(CartesianWaypoint(pose), PlanInstructionType::LINEAR, "RASTER"));
+    program.push_back(raster);
+    program.push_back(WaitInstruction(1.5));
+    program.push_back(SetToolInstruction(2));
+    return program;
+  };
+
+  CompositeInstruction program = createProgram(0.5);
+  const std::uint64_t hash = getStableHash(program);
+  EXPECT_EQ(hash, getStableHash(createProgram(0.5)));
+  EXPECT_EQ(hash, getStableHash(Instruction(program)));
+  EXPECT_NE(hash, getStableHash(createProgram(0.6)));
+
+  // Negative zero is hashed as zero
+  EXPECT_EQ(getStableHash(createProgram(0.0)), getStableHash(createProgram(-0.0)));
+
+  // Every member contributes to the hash
+  CompositeInstruction modified = program;
+  modified.setDescription("modified");
+  EXPECT_NE(hash, getStableHash(modified));
+
+  modified = program;
+  modified.getManipulatorInfo().working_frame = "base_link";
+  EXPECT_NE(hash, getStableHash(modified));
+
+  modified = program;
+  modified.getInstructions().back() = SetToolInstruction(3);
+  EXPECT_NE(hash, getStableHash(modified));
+
+  modified = program;
+  modified.front().as<CompositeInstruction>().front().as<PlanInstruction>().setProfile("FREESPACE");
+  EXPECT_NE(hash, getStableHash(modified));
+
+  modified = program;
+  modified.resetStartInstruction();
+  EXPECT_NE(hash, getStableHash(modified));
+
+  // Moving an instruction into a child composite changes the structure
+  modified = program;
+  modified.pop_back();
+  modified.front().as<CompositeInstruction>().push_back(SetToolInstruction(2));
+  EXPECT_NE(hash, getStableHash(modified));
+
+  // Waypoints of different types with the same values do not collide
+  EXPECT_NE(getStableHash(Waypoint(JointWaypoint(joint_names, Eigen::VectorXd::Zero(3)))),
+            getStableHash(Waypoint(StateWaypoint(joint_names, Eigen::VectorXd::Zero(3)))));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
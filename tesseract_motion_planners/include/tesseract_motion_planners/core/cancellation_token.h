@@ -0,0 +1,153 @@
+/**
+ * @file cancellation_token.h
+ * @brief A thread safe token used to request that planning stops as soon as possible or by a deadline
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_CANCELLATION_TOKEN_H
+#define TESSERACT_MOTION_PLANNERS_CANCELLATION_TOKEN_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#ifdef SWIG
+%shared_ptr(tesseract_planning::CancellationToken)
+#endif  // SWIG
+
+namespace tesseract_planning
+{
+/**
+ * @brief A thread safe token used to cooperatively cancel planning
+ * @details The planners poll the token between iterations or stages and return a cancelled status once it is set. A
+ * token can not be reset, so a new one must be created for each request.
+ *
+ * A token may also have a deadline, which the planners use to limit their planning time. A token created from a
+ * parent is cancelled when the parent is cancelled and expires no later than the parent.
+ */
+class CancellationToken
+{
+public:
+  using Ptr = std::shared_ptr<CancellationToken>;
+  using ConstPtr = std::shared_ptr<const CancellationToken>;
+  using Clock = std::chrono::steady_clock;
+
+  CancellationToken() = default;
+
+  /**
+   * @brief Create a token which is cancelled with its parent
+   * @param parent The parent token
+   * @param deadline The deadline of the token
+   */
+  CancellationToken(ConstPtr parent, Clock::time_point deadline = Clock::time_point::max())
+    : parent_(std::move(parent)), deadline_(deadline)
+  {
+  }
+
+  /** @brief Request cancellation */
+  void cancel() { cancelled_ = true; }
+
+  /**
+   * @brief Check if cancellation was requested for this token or its parent
+   * @return True if cancelled, otherwise false
+   */
+  bool isCancelled() const { return (cancelled_ || (parent_ != nullptr && parent_->isCancelled())); }
+
+  /**
+   * @brief Set the deadline
+   * @details This is not thread safe, so it must be set before the token is shared
+   * @param deadline The deadline
+   */
+  void setDeadline(Clock::time_point deadline) { deadline_ = deadline; }
+
+  /**
+   * @brief Get the deadline, which is the earliest of this token and its parent
+   * @return The deadline, Clock::time_point::max() if it does not have one
+   */
+  Clock::time_point getDeadline() const
+  {
+    return (parent_ != nullptr) ? std::min(deadline_, parent_->getDeadline()) : deadline_;
+  }
+
+  /**
+   * @brief Check if the token has a deadline
+   * @return True if it has a deadline, otherwise false
+   */
+  bool hasDeadline() const { return (getDeadline() != Clock::time_point::max()); }
+
+  /**
+   * @brief Check if the deadline has passed
+   * @return True if expired, otherwise false
+   */
+  bool isExpired() const { return (hasDeadline() && Clock::now() >= getDeadline()); }
+
+  /**
+   * @brief Get the time remaining until the deadline
+   * @return The remaining time in seconds, std::numeric_limits<double>::max() if it does not have a deadline
+   */
+  double getRemainingTime() const
+  {
+    if (!hasDeadline())
+      return std::numeric_limits<double>::max();
+
+    return std::max(std::chrono::duration<double>(getDeadline() - Clock::now()).count(), 0.0);
+  }
+
+protected:
+  std::atomic<bool> cancelled_{ false };
+  ConstPtr parent_;
+  Clock::time_point deadline_{ Clock::time_point::max() };
+};
+
+/**
+ * @brief Check if a token was cancelled
+ * @param token The token, which may be nullptr
+ * @return True if the token is not nullptr and was cancelled, otherwise false
+ */
+inline bool isCancelled(const CancellationToken::ConstPtr& token) { return (token != nullptr && token->isCancelled()); }
+
+/**
+ * @brief Check if the deadline of a token has passed
+ * @param token The token, which may be nullptr
+ * @return True if the token is not nullptr and expired, otherwise false
+ */
+inline bool isExpired(const CancellationToken::ConstPtr& token) { return (token != nullptr && token->isExpired()); }
+
+/**
+ * @brief Limit a planning time to the time remaining until the deadline of a token
+ * @param planning_time The planning time in seconds
+ * @param token The token, which may be nullptr
+ * @return The planning time in seconds
+ */
+inline double limitPlanningTime(double planning_time, const CancellationToken::ConstPtr& token)
+{
+  return (token != nullptr) ? std::min(planning_time, token->getRemainingTime()) : planning_time;
+}
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_CANCELLATION_TOKEN_H
@@ -0,0 +1,151 @@
+/**
+ * @file trace_recorder.h
+ * @brief Records the time spans of a planning request, which can be saved as a Chrome trace
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_TRACE_RECORDER_H
+#define TESSERACT_MOTION_PLANNERS_TRACE_RECORDER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#ifdef SWIG
+%shared_ptr(tesseract_planning::TraceRecorder)
+#endif  // SWIG
+
+namespace tesseract_planning
+{
+/**
+ * @brief Records the time spans of a planning request, which can be saved as a Chrome trace
+ * @details The spans are recorded with the thread they ran on, so the trace shows how the request was spread over the
+ * workers. The saved file can be opened with chrome://tracing or https://ui.perfetto.dev. This is thread safe.
+ */
+class TraceRecorder
+{
+public:
+  using Ptr = std::shared_ptr<TraceRecorder>;
+  using ConstPtr = std::shared_ptr<const TraceRecorder>;
+  using Clock = std::chrono::steady_clock;
+
+  /** @brief A recorded time span */
+  struct Span
+  {
+    std::string name;
+    std::string category;
+    Clock::time_point start;
+    Clock::time_point end;
+    std::size_t thread{ 0 };
+  };
+
+  TraceRecorder();
+
+  /**
+   * @brief Record a span which ran on the calling thread
+   * @param name The name of the span
+   * @param category The category of the span
+   * @param start The start time
+   * @param end The end time
+   */
+  void record(std::string name, std::string category, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * @brief Get the recorded spans
+   * @return The spans in the order they ended
+   */
+  std::vector<Span> getSpans() const;
+
+  /**
+   * @brief Convert the recorded spans to the Chrome trace event format
+   * @return The trace as JSON
+   */
+  std::string toChromeTrace() const;
+
+  /**
+   * @brief Save the recorded spans in the Chrome trace event format
+   * @param filepath The file to write
+   * @return True if successful, otherwise false
+   */
+  bool save(const std::string& filepath) const;
+
+protected:
+  mutable std::mutex mutex_;
+  Clock::time_point origin_;
+  std::vector<Span> spans_;
+
+  /** @brief The small ids given to the threads in the order they first recorded a span */
+  std::map<std::thread::id, std::size_t> thread_ids_;
+};
+
+/**
+ * @brief Records a span from its construction to its destruction
+ * @details If the recorder is nullptr nothing is recorded, so tracing costs a pointer check when it is not enabled.
+ */
+class TraceSpan
+{
+public:
+  /**
+   * @brief Start a span
+   * @param recorder The recorder, which may be nullptr
+   * @param name The name of the span
+   * @param category The category of the span
+   */
+  TraceSpan(TraceRecorder::Ptr recorder, std::string_view name, std::string_view category)
+    : recorder_(std::move(recorder))
+  {
+    if (recorder_ == nullptr)
+      return;
+
+    name_ = name;
+    category_ = category;
+    start_ = TraceRecorder::Clock::now();
+  }
+
+  ~TraceSpan()
+  {
+    if (recorder_ != nullptr)
+      recorder_->record(std::move(name_), std::move(category_), start_, TraceRecorder::Clock::now());
+  }
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+
+private:
+  TraceRecorder::Ptr recorder_;
+  std::string name_;
+  std::string category_;
+  TraceRecorder::Clock::time_point start_;
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_TRACE_RECORDER_H
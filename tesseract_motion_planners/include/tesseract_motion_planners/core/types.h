@@ -30,6 +30,8 @@
 #include <tesseract_common/status_code.h>
 #include <tesseract_common/types.h>
 #include <tesseract_command_language/command_language.h>
+#include <tesseract_motion_planners/core/cancellation_token.h>
+#include <tesseract_motion_planners/core/trace_recorder.h>
 
 namespace tesseract_planning
 {
@@ -71,6 +73,18 @@ struct PlannerRequest
    */
   PlannerProfileRemapping composite_profile_remapping;
 
+  /**
+   * @brief An optional token used to cancel planning
+   * @details The planners check it between iterations or stages and return a cancelled status once it is set.
+   */
+  CancellationToken::ConstPtr cancellation_token;
+
+  /**
+   * @brief An optional recorder for the time spans of the planning stages
+   * @details The planners record spans like problem generation and the solve, if nullptr nothing is recorded.
+   */
+  TraceRecorder::Ptr trace_recorder;
+
   /**
    * @brief data Planner specific data. For planners included in Tesseract_planning this is the planner problem that
    * will be used if it is not null
@@ -29,6 +29,7 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <Eigen/Geometry>
+#include <atomic>
 #include <memory>
 #include <console_bridge/console.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -154,6 +155,7 @@ flattenProgramToPattern(const CompositeInstruction& composite_instruction, const
 
 /**
  * @brief Should perform a continuous collision check over the trajectory.
+ * @details Throws if the program contains a trajectory segment, these are not supported yet.
  * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
  * @param manager A continuous contact manager
  * @param state_solver The environment state solver
@@ -169,6 +171,7 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
 
 /**
  * @brief Should perform a discrete collision check over the trajectory
+ * @details Throws if the program contains a trajectory segment, these are not supported yet.
  * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
  * @param manager A continuous contact manager
  * @param state_solver The environment state solver
@@ -182,6 +185,64 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
                          const CompositeInstruction& program,
                          const tesseract_collision::CollisionCheckConfig& config);
 
+/**
+ * @brief Should perform a continuous collision check over a range of a flattened trajectory
+ * @details Step i is the segment between move instruction i and i + 1. This allows a trajectory to be split into
+ * chunks which are checked independently, each with their own contact manager.
+ * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
+ * @param manager A continuous contact manager
+ * @param state_solver The environment state solver
+ * @param program The flattened move instructions of the program to check for contacts
+ * @param start_step The first step to check
+ * @param end_step One past the last step to check, this is clamped to the number of steps
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param abort If provided and set by another thread the check returns early
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::ContinuousContactManager& manager,
+                         const tesseract_environment::StateSolver& state_solver,
+                         const std::vector<std::reference_wrapper<const Instruction>>& program,
+                         std::size_t start_step,
+                         std::size_t end_step,
+                         const tesseract_collision::CollisionCheckConfig& config,
+                         const std::atomic<bool>* abort = nullptr);
+
+/**
+ * @brief Should perform a discrete collision check over a range of a flattened trajectory
+ * @details Step i is move instruction i along with the interpolated states leading up to move instruction i + 1. This
+ * allows a trajectory to be split into chunks which are checked independently, each with their own contact manager.
+ * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
+ * @param manager A discrete contact manager
+ * @param state_solver The environment state solver
+ * @param program The flattened move instructions of the program to check for contacts
+ * @param start_step The first step to check
+ * @param end_step One past the last step to check, this is clamped to the number of steps
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param abort If provided and set by another thread the check returns early
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::DiscreteContactManager& manager,
+                         const tesseract_environment::StateSolver& state_solver,
+                         const std::vector<std::reference_wrapper<const Instruction>>& program,
+                         std::size_t start_step,
+                         std::size_t end_step,
+                         const tesseract_collision::CollisionCheckConfig& config,
+                         const std::atomic<bool>* abort = nullptr);
+
+/**
+ * @brief Get the links moved by a manipulator, which are the active links of its kinematics along with the links
+ * attached to them
+ * @details The links are cached for each environment and manipulator and computed again once the revision of the
+ * environment changes, so the scene graph is only searched once for each revision. This is thread safe.
+ * @param env The environment
+ * @param manipulator The name of the manipulator
+ * @return The active link names, empty if the manipulator does not exist
+ */
+std::vector<std::string> getActiveLinkNames(const tesseract_environment::Environment& env,
+                                            const std::string& manipulator);
+
 /**
  * @brief This generates a naive seed for the provided program
  * @details This will generate a seed where each plan instruction has a single move instruction associated to it using
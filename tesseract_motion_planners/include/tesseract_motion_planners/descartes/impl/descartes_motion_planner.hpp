@@ -85,6 +85,7 @@ tesseract_common::StatusCode DescartesMotionPlanner<FloatType>::solve(const Plan
 
     try
     {
+      TraceSpan span(request.trace_recorder, "Descartes: Generate Problem", "planner");
       problem = problem_generator(name_, request, plan_profiles);
     }
     catch (std::exception& e)
@@ -98,9 +99,25 @@ tesseract_common::StatusCode DescartesMotionPlanner<FloatType>::solve(const Plan
     response.data = problem;
   }
 
+  // The graph is built and searched in stages, planning may be cancelled or run out of time between them
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(DescartesMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
+  if (isExpired(request.cancellation_token))
+  {
+    CONSOLE_BRIDGE_logError("DescartesMotionPlanner has no time left before the deadline of the request.");
+    response.status = tesseract_common::StatusCode(DescartesMotionPlannerStatusCategory::ErrorFailedToFindValidSolution,
+                                                   status_category_);
+    return response.status;
+  }
+
   descartes_light::Solver<FloatType> graph_builder(problem->manip_inv_kin->numJoints());
   try
   {
+    TraceSpan span(request.trace_recorder, "Descartes: Build Graph", "planner");
     graph_builder.build(problem->samplers, problem->edge_evaluators, problem->num_threads);
   }
   catch (...)
@@ -127,8 +144,26 @@ tesseract_common::StatusCode DescartesMotionPlanner<FloatType>::solve(const Plan
   //  response.succeeded_waypoints = config_->waypoints;
   //  response.failed_waypoints.clear();
 
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(DescartesMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
+  if (isExpired(request.cancellation_token))
+  {
+    CONSOLE_BRIDGE_logError("DescartesMotionPlanner has no time left before the deadline of the request.");
+    response.status = tesseract_common::StatusCode(DescartesMotionPlannerStatusCategory::ErrorFailedToFindValidSolution,
+                                                   status_category_);
+    return response.status;
+  }
+
   // Search for edges
-  std::vector<Eigen::Matrix<FloatType, Eigen::Dynamic, 1>> solution_float_type = graph_builder.search();
+  std::vector<Eigen::Matrix<FloatType, Eigen::Dynamic, 1>> solution_float_type;
+  {
+    TraceSpan span(request.trace_recorder, "Descartes: Search", "planner");
+    solution_float_type = graph_builder.search();
+  }
   if (solution_float_type.empty())
   {
     CONSOLE_BRIDGE_logError("Search for graph completion failed");
@@ -137,6 +172,12 @@ tesseract_common::StatusCode DescartesMotionPlanner<FloatType>::solve(const Plan
     return response.status;
   }
 
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(DescartesMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
   // Enforce limits
   std::vector<Eigen::VectorXd> solution;
   solution.reserve(solution_float_type.size());
@@ -77,10 +77,7 @@ DefaultDescartesProblemGenerator(const std::string& name,
     CONSOLE_BRIDGE_logError("Check Kinematics failed. This means that Inverse Kinematics does not agree with KDL "
                             "(TrajOpt). Did you change the URDF recently?");
 
-  std::vector<std::string> active_link_names = prob->manip_inv_kin->getActiveLinkNames();
-  auto adjacency_map = std::make_shared<tesseract_environment::AdjacencyMap>(
-      request.env->getSceneGraph(), active_link_names, request.env_state->link_transforms);
-  const std::vector<std::string>& active_links = adjacency_map->getActiveLinkNames();
+  const std::vector<std::string> active_links = getActiveLinkNames(*request.env, composite_mi.manipulator);
 
   // Flatten the input for planning
   auto instructions_flat = flattenProgram(request.instructions);
@@ -51,6 +51,7 @@ public:
     SolutionFound = 0,
     ErrorInvalidInput = -2,
     ErrorFailedToFindValidSolution = -3,
+    Cancelled = -4,
   };
 
 private:
@@ -182,8 +182,9 @@ std::shared_ptr<const ProfileType> applyProfileOverrides(const std::string task_
   if (!overrides)
     return nominal_profile;
 
-  if (overrides->hasProfile<ProfileType>(task_name))
-    return overrides->getProfile<ProfileType>(task_name);
+  std::shared_ptr<const ProfileType> profile = overrides->findProfile<ProfileType>(task_name);
+  if (profile)
+    return profile;
 
   return nominal_profile;
 }
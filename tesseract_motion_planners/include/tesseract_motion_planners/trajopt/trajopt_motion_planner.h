@@ -129,6 +129,7 @@ public:
     SolutionFound = 0,
     ErrorInvalidInput = -1,
     FailedToFindValidSolution = -3,
+    Cancelled = -4,
   };
 
 private:
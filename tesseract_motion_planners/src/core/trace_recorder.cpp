@@ -0,0 +1,127 @@
+/**
+ * @file trace_recorder.cpp
+ * @brief Records the time spans of a planning request, which can be saved as a Chrome trace
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/core/trace_recorder.h>
+
+namespace tesseract_planning
+{
+/** @brief Escape a string so it may be used as a JSON string */
+static std::string escape(const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value)
+  {
+    if (c == '\\' || c == '"')
+    {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      std::array<char, 7> code{};
+      std::snprintf(code.data(), code.size(), "\\u%04x", static_cast<unsigned>(c));
+      escaped.append(code.data());
+    }
+    else
+    {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+TraceRecorder::TraceRecorder() : origin_(Clock::now()) {}
+
+void TraceRecorder::record(std::string name, std::string category, Clock::time_point start, Clock::time_point end)
+{
+  std::scoped_lock lock(mutex_);
+  auto it = thread_ids_.emplace(std::this_thread::get_id(), thread_ids_.size() + 1).first;
+  spans_.push_back(Span{ std::move(name), std::move(category), start, end, it->second });
+}
+
+std::vector<TraceRecorder::Span> TraceRecorder::getSpans() const
+{
+  std::scoped_lock lock(mutex_);
+  return spans_;
+}
+
+std::string TraceRecorder::toChromeTrace() const
+{
+  std::vector<Span> spans;
+  std::size_t num_threads{ 0 };
+  {
+    std::scoped_lock lock(mutex_);
+    spans = spans_;
+    num_threads = thread_ids_.size();
+  }
+
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t thread = 1; thread <= num_threads; ++thread)
+  {
+    if (thread > 1)
+      out << ",";
+
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+        << ",\"args\":{\"name\":\"Thread " << thread << "\"}}";
+  }
+
+  for (const auto& span : spans)
+  {
+    if (num_threads > 0)
+      out << ",";
+
+    // The timestamps are in microseconds since the recorder was created
+    double ts = std::chrono::duration<double, std::micro>(span.start - origin_).count();
+    double dur = std::chrono::duration<double, std::micro>(span.end - span.start).count();
+    out << "{\"name\":\"" << escape(span.name) << "\",\"cat\":\"" << escape(span.category)
+        << "\",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur << ",\"pid\":1,\"tid\":" << span.thread << "}";
+  }
+  out << "]}";
+
+  return out.str();
+}
+
+bool TraceRecorder::save(const std::string& filepath) const
+{
+  std::ofstream out(filepath);
+  if (!out)
+    return false;
+
+  out << toChromeTrace();
+  return static_cast<bool>(out);
+}
+}  // namespace tesseract_planning
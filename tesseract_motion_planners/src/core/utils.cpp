@@ -26,8 +26,13 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <Eigen/Geometry>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <typeindex>
+#include <unordered_map>
+#include <utility>
 #include <console_bridge/console.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -103,25 +108,25 @@ tesseract_common::Toolpath toToolpath(const Instruction& instruction,
 
     const std::string& tip_link = composite_mi_fwd_kin->getTipLinkName();
 
-    std::vector<std::reference_wrapper<const Instruction>> fi = tesseract_planning::flatten(ci, planFilter);
+    auto fi = tesseract_planning::flattenView(ci, planFilter);
     if (fi.empty())
-      fi = tesseract_planning::flatten(ci, moveFilter);
+      fi = tesseract_planning::flattenView(ci, moveFilter);
 
-    for (const auto& i : fi)
+    for (const Instruction& i : fi)
     {
       ManipulatorInfo manip_info;
 
       // Check for updated manipulator information and get waypoint
       Waypoint wp{ NullWaypoint() };
-      if (isPlanInstruction(i.get()))
+      if (isPlanInstruction(i))
       {
-        const auto& pi = i.get().as<PlanInstruction>();
+        const auto& pi = i.as<PlanInstruction>();
         manip_info = composite_mi.getCombined(pi.getManipulatorInfo());
         wp = pi.getWaypoint();
       }
-      else if (isMoveInstruction(i.get()))
+      else if (isMoveInstruction(i))
       {
-        const auto& mi = i.get().as<MoveInstruction>();
+        const auto& mi = i.as<MoveInstruction>();
         manip_info = composite_mi.getCombined(mi.getManipulatorInfo());
         wp = mi.getWaypoint();
       }
@@ -296,170 +301,240 @@ flattenProgramToPattern(const CompositeInstruction& composite_instruction, const
   return flattenToPattern(composite_instruction, pattern, programFlattenFilter);
 }
 
+namespace
+{
+/**
+ * @brief Scratch space reused while walking a trajectory for contacts
+ *
+ * Each state solver is cloned once and updated in place. The solvers are private to the buffer so their current states
+ * are handed to the contact checks as is, each waypoint and interpolated substate is solved exactly once without
+ * allocating or copying an EnvState per substep.
+ */
+struct ContactCheckProgramBuffer
+{
+  /**
+   * @brief Constructor
+   * @param state_solver The state solver to clone
+   * @param segments Indicate if segments are checked, in which case a second solver is cloned for state1
+   */
+  ContactCheckProgramBuffer(const tesseract_environment::StateSolver& state_solver, bool segments)
+    : solver0(state_solver.clone()), solver1((segments) ? state_solver.clone() : nullptr)
+  {
+  }
+
+  /** @brief Solve the provided joint values into state0 */
+  void solve0(const std::vector<std::string>& joint_names, const Eigen::Ref<const Eigen::VectorXd>& joint_values)
+  {
+    state0 = solve(*solver0, joint_names, joint_values);
+  }
+
+  /** @brief Solve the provided joint values into state1 */
+  void solve1(const std::vector<std::string>& joint_names, const Eigen::Ref<const Eigen::VectorXd>& joint_values)
+  {
+    state1 = solve(*solver1, joint_names, joint_values);
+  }
+
+  /** @brief Make the end of the checked segment the start of the next one */
+  void advance()
+  {
+    std::swap(solver0, solver1);
+    std::swap(state0, state1);
+  }
+
+  /** @brief Interpolate between two positions into the substep buffer, growing it only when required */
+  void interpolate(const Eigen::VectorXd& start, const Eigen::VectorXd& stop, long cnt)
+  {
+    if (subtraj.rows() < cnt || subtraj.cols() != start.size())
+      subtraj.resize(cnt, start.size());
+
+    for (long iVar = 0; iVar < start.size(); ++iVar)
+      subtraj.col(iVar).head(cnt) = Eigen::VectorXd::LinSpaced(cnt, start(iVar), stop(iVar));
+  }
+
+  tesseract_environment::StateSolver::Ptr solver0;
+  tesseract_environment::StateSolver::Ptr solver1;
+  tesseract_environment::EnvState::Ptr state0;
+  tesseract_environment::EnvState::Ptr state1;
+  tesseract_common::TrajArray subtraj;
+
+private:
+  static tesseract_environment::EnvState::Ptr solve(tesseract_environment::StateSolver& solver,
+                                                    const std::vector<std::string>& joint_names,
+                                                    const Eigen::Ref<const Eigen::VectorXd>& joint_values)
+  {
+    solver.setState(joint_names, joint_values);
+
+    // The contact checks only read the state, and no one else has access to the solver
+    return std::const_pointer_cast<tesseract_environment::EnvState>(solver.getCurrentState());
+  }
+};
+
+const StateWaypoint& getStateWaypoint(const Instruction& instruction)
+{
+  return instruction.as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+}
+
+void logSegmentCollision(const std::string& type,
+                         std::size_t step,
+                         std::size_t num_steps,
+                         long substep,
+                         const std::vector<std::string>& joint_names,
+                         const Eigen::Ref<const Eigen::VectorXd>& state0,
+                         const Eigen::Ref<const Eigen::VectorXd>& state1)
+{
+  if (console_bridge::getLogLevel() <= console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
+    return;
+
+  std::stringstream ss;
+  ss << type << " collision detected at step: " << step << " of " << num_steps;
+  if (substep >= 0)
+    ss << " substep: " << substep;
+  ss << std::endl;
+
+  ss << "     Names:";
+  for (const auto& name : joint_names)
+    ss << " " << name;
+
+  ss << std::endl
+     << "    State0: " << state0.transpose() << std::endl
+     << "    State1: " << state1.transpose() << std::endl;
+
+  CONSOLE_BRIDGE_logError(ss.str().c_str());
+}
+
+void logStateCollision(std::size_t step,
+                       std::size_t num_steps,
+                       long substep,
+                       const std::vector<std::string>& joint_names,
+                       const Eigen::Ref<const Eigen::VectorXd>& state)
+{
+  if (console_bridge::getLogLevel() <= console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
+    return;
+
+  std::stringstream ss;
+  ss << "Discrete collision detected at step: " << step << " of " << num_steps;
+  if (substep >= 0)
+    ss << " substate: " << substep;
+  ss << std::endl;
+
+  ss << "     Names:";
+  for (const auto& name : joint_names)
+    ss << " " << name;
+
+  ss << std::endl << "    State: " << state.transpose() << std::endl;
+
+  CONSOLE_BRIDGE_logError(ss.str().c_str());
+}
+}  // namespace
+
 bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
                          tesseract_collision::ContinuousContactManager& manager,
                          const tesseract_environment::StateSolver& state_solver,
                          const CompositeInstruction& program,
                          const tesseract_collision::CollisionCheckConfig& config)
+{
+  // Trajectory segments are not checked yet, so they are rejected instead of being skipped
+  if (hasTrajectorySegment(program))
+    throw std::runtime_error("contactCheckProgram does not support trajectory segments!");
+
+  // Flatten results once, every segment is then visited exactly once
+  std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+  return contactCheckProgram(contacts, manager, state_solver, mi, 0, mi.size(), config);
+}
+
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::ContinuousContactManager& manager,
+                         const tesseract_environment::StateSolver& state_solver,
+                         const std::vector<std::reference_wrapper<const Instruction>>& mi,
+                         std::size_t start_step,
+                         std::size_t end_step,
+                         const tesseract_collision::CollisionCheckConfig& config,
+                         const std::atomic<bool>* abort)
 {
   if (config.type != tesseract_collision::CollisionEvaluatorType::CONTINUOUS &&
       config.type != tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
     throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
                              "ContactManager type (Continuous)");
+
+  const bool lvs = (config.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS);
+  assert(!lvs || config.longest_valid_segment_length > 0);
+
+  const bool first_only = (config.contact_request.type == tesseract_collision::ContactTestType::FIRST);
   bool found = false;
 
-  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+  // Step i is the segment between state i and i + 1
+  if (mi.size() < 2)
+    return found;
+
+  end_step = std::min(end_step, mi.size() - 1);
+  if (start_step >= end_step)
+    return found;
+
+  contacts.reserve(contacts.size() + (end_step - start_step));
+  ContactCheckProgramBuffer buffer(state_solver, true);
+
+  // state0 always holds the solved start of the segment being checked
+  const auto& swp_start = getStateWaypoint(mi[start_step].get());
+  buffer.solve0(swp_start.joint_names, swp_start.position);
+
+  for (std::size_t iStep = start_step; iStep < end_step; ++iStep)
   {
-    assert(config.longest_valid_segment_length > 0);
+    if (abort != nullptr && abort->load())
+      return found;
 
-    // Flatten results
-    std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+    const auto& swp0 = getStateWaypoint(mi[iStep].get());
+    const auto& swp1 = getStateWaypoint(mi[iStep + 1].get());
 
-    contacts.reserve(mi.size() - 1);
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
+    // TODO: Should check joint names and make sure they are in the same order
+    double dist = (lvs) ? (swp1.position - swp0.position).norm() : 0;
+    if (lvs && dist > config.longest_valid_segment_length)
     {
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+      long cnt = static_cast<long>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
+      buffer.interpolate(swp0.position, swp1.position, cnt);
 
-      // TODO: Should check joint names and make sure they are in the same order
-      double dist = (swp1.position - swp0.position).norm();
-      if (dist > config.longest_valid_segment_length)
+      for (long iSubStep = 0; iSubStep < cnt - 1; ++iSubStep)
       {
-        long cnt = static_cast<long>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
-        tesseract_common::TrajArray subtraj(cnt, swp0.position.size());
-        for (long iVar = 0; iVar < swp0.position.size(); ++iVar)
-          subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, swp0.position(iVar), swp1.position(iVar));
-
-        for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
+        buffer.solve1(swp0.joint_names, buffer.subtraj.row(iSubStep + 1));
+        if (checkTrajectorySegment(contacts, manager, buffer.state0, buffer.state1, config))
         {
-          tesseract_environment::EnvState::Ptr state0 = state_solver.getState(swp0.joint_names, subtraj.row(iSubStep));
-          tesseract_environment::EnvState::Ptr state1 =
-              state_solver.getState(swp0.joint_names, subtraj.row(iSubStep + 1));
-          if (checkTrajectorySegment(contacts, manager, state0, state1, config))
-          {
-            found = true;
-            if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-            {
-              std::stringstream ss;
-              ss << "Continuous collision detected at step: " << iStep << " of " << (mi.size() - 1)
-                 << " substep: " << iSubStep << std::endl;
-
-              ss << "     Names:";
-              for (const auto& name : swp0.joint_names)
-                ss << " " << name;
-
-              ss << std::endl
-                 << "    State0: " << subtraj.row(iSubStep) << std::endl
-                 << "    State1: " << subtraj.row(iSubStep + 1) << std::endl;
-
-              CONSOLE_BRIDGE_logError(ss.str().c_str());
-            }
-          }
-
-          if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-            break;
+          found = true;
+          logSegmentCollision("Continuous",
+                              iStep,
+                              mi.size() - 1,
+                              iSubStep,
+                              swp0.joint_names,
+                              buffer.subtraj.row(iSubStep),
+                              buffer.subtraj.row(iSubStep + 1));
         }
 
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
-      }
-      else
-      {
-        // Flatten results
-        std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
-
-        contacts.reserve(mi.size() - 1);
-        for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
-        {
-          const auto& swp0 = mi.at(iStep).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-          const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+        if (found && first_only)
+          return found;
 
-          // TODO: Should check joint names and make sure they are in the same order
-          double dist = (swp1.position - swp0.position).norm();
-          if (dist > config.longest_valid_segment_length)
-          {
-            long cnt = static_cast<long>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
-            tesseract_common::TrajArray subtraj(cnt, swp0.position.size());
-            for (long iVar = 0; iVar < swp0.position.size(); ++iVar)
-              subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, swp0.position(iVar), swp1.position(iVar));
-
-            for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
-            {
-              tesseract_environment::EnvState::Ptr state0 =
-                  state_solver.getState(swp0.joint_names, subtraj.row(iSubStep));
-              tesseract_environment::EnvState::Ptr state1 =
-                  state_solver.getState(swp0.joint_names, subtraj.row(iSubStep + 1));
-              if (checkTrajectorySegment(contacts, manager, state0, state1, config))
-              {
-                found = true;
-                if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-                {
-                  std::stringstream ss;
-                  ss << "Continuous collision detected at step: " << iStep << " of " << (mi.size() - 1)
-                     << " substep: " << iSubStep << std::endl;
-
-                  ss << "     Names:";
-                  for (const auto& name : swp0.joint_names)
-                    ss << " " << name;
-
-                  ss << std::endl
-                     << "    State0: " << subtraj.row(iSubStep) << std::endl
-                     << "    State1: " << subtraj.row(iSubStep + 1) << std::endl;
-
-                  CONSOLE_BRIDGE_logError(ss.str().c_str());
-                }
-              }
-
-              if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-                break;
-            }
-
-            if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-              break;
-          }
-        }
+        buffer.advance();
       }
     }
-  }
-  else
-  {
-    bool found = false;
-
-    // Flatten results
-    std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
-
-    contacts.reserve(mi.size());
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
+    else
     {
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      tesseract_environment::EnvState::Ptr state0 = state_solver.getState(swp0.joint_names, swp0.position);
-      tesseract_environment::EnvState::Ptr state1 = state_solver.getState(swp1.joint_names, swp1.position);
-
-      if (checkTrajectorySegment(contacts, manager, state0, state1, config))
+      buffer.solve1(swp1.joint_names, swp1.position);
+      if (checkTrajectorySegment(contacts, manager, buffer.state0, buffer.state1, config))
       {
         found = true;
-        if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-        {
-          std::stringstream ss;
-          ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
-
-          ss << "     Names:";
-          for (const auto& name : swp0.joint_names)
-            ss << " " << name;
-
-          ss << std::endl
-             << "    State0: " << swp0.position << std::endl
-             << "    State1: " << swp1.position << std::endl;
-
-          CONSOLE_BRIDGE_logError(ss.str().c_str());
-        }
+        logSegmentCollision((lvs) ? "Continuous" : "Discrete",
+                            iStep,
+                            mi.size() - 1,
+                            -1,
+                            swp0.joint_names,
+                            swp0.position,
+                            swp1.position);
       }
 
-      if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-        break;
+      if (found && first_only)
+        return found;
+
+      buffer.advance();
     }
   }
+
   return found;
 }
 
@@ -468,129 +543,153 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
                          const tesseract_environment::StateSolver& state_solver,
                          const CompositeInstruction& program,
                          const tesseract_collision::CollisionCheckConfig& config)
+{
+  // Trajectory segments are not checked yet, so they are rejected instead of being skipped
+  if (hasTrajectorySegment(program))
+    throw std::runtime_error("contactCheckProgram does not support trajectory segments!");
+
+  // Flatten results once, every state is then solved exactly once
+  std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+  return contactCheckProgram(contacts, manager, state_solver, mi, 0, mi.size(), config);
+}
+
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::DiscreteContactManager& manager,
+                         const tesseract_environment::StateSolver& state_solver,
+                         const std::vector<std::reference_wrapper<const Instruction>>& mi,
+                         std::size_t start_step,
+                         std::size_t end_step,
+                         const tesseract_collision::CollisionCheckConfig& config,
+                         const std::atomic<bool>* abort)
 {
   if (config.type != tesseract_collision::CollisionEvaluatorType::DISCRETE &&
       config.type != tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
     throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
                              "ContactManager type (Discrete)");
+
+  const bool lvs = (config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE);
+  assert(!lvs || config.longest_valid_segment_length > 0);
+
+  const bool first_only = (config.contact_request.type == tesseract_collision::ContactTestType::FIRST);
   bool found = false;
 
-  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
+  if (mi.empty())
+    return found;
+
+  // Step i is state i along with the substates leading up to state i + 1. The last state is only checked when using
+  // longest valid segment
+  end_step = std::min(end_step, (lvs) ? mi.size() : mi.size() - 1);
+  if (start_step >= end_step)
+    return found;
+
+  contacts.reserve(contacts.size() + (end_step - start_step));
+  ContactCheckProgramBuffer buffer(state_solver, false);
+
+  for (std::size_t iStep = start_step; iStep < end_step; ++iStep)
   {
-    assert(config.longest_valid_segment_length > 0);
+    if (abort != nullptr && abort->load())
+      return found;
 
-    // Flatten results
-    std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+    const auto& swp0 = getStateWaypoint(mi[iStep].get());
 
-    contacts.reserve(mi.size());
-    for (std::size_t iStep = 0; iStep < mi.size(); ++iStep)
+    double dist = -1;
+    if (lvs && iStep < mi.size() - 1)
     {
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      const StateWaypoint* swp1 = nullptr;
-
-      double dist = -1;
-      if (iStep < mi.size() - 1)
-      {
-        swp1 = &mi.at(iStep + 1).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-        dist = (swp1->position - swp0.position).norm();
-      }
+      const auto& swp1 = getStateWaypoint(mi[iStep + 1].get());
+      dist = (swp1.position - swp0.position).norm();
 
       if (dist > 0 && dist > config.longest_valid_segment_length)
       {
-        int cnt = static_cast<int>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
-        tesseract_common::TrajArray subtraj(cnt, swp0.position.size());
-        for (long iVar = 0; iVar < swp0.position.size(); ++iVar)
-          subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, swp0.position(iVar), swp1->position(iVar));
+        long cnt = static_cast<long>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
+        buffer.interpolate(swp0.position, swp1.position, cnt);
 
-        for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
+        // The final substate is the start of the next step so it is not checked here
+        for (long iSubStep = 0; iSubStep < cnt - 1; ++iSubStep)
         {
-          tesseract_environment::EnvState::Ptr state = state_solver.getState(swp0.joint_names, subtraj.row(iSubStep));
-          if (checkTrajectoryState(contacts, manager, state, config))
+          buffer.solve0(swp0.joint_names, buffer.subtraj.row(iSubStep));
+          if (checkTrajectoryState(contacts, manager, buffer.state0, config))
           {
             found = true;
-            if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-            {
-              std::stringstream ss;
-              ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1)
-                 << " substate: " << iSubStep << std::endl;
-
-              ss << "     Names:";
-              for (const auto& name : swp0.joint_names)
-                ss << " " << name;
-
-              ss << std::endl << "    State: " << subtraj.row(iSubStep) << std::endl;
-
-              CONSOLE_BRIDGE_logError(ss.str().c_str());
-            }
+            logStateCollision(iStep, mi.size() - 1, iSubStep, swp0.joint_names, buffer.subtraj.row(iSubStep));
           }
 
-          if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-            break;
+          if (found && first_only)
+            return found;
         }
-
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
+        continue;
       }
-      else
-      {
-        tesseract_environment::EnvState::Ptr state = state_solver.getState(swp0.joint_names, swp0.position);
-        if (checkTrajectoryState(contacts, manager, state, config))
-        {
-          found = true;
-          if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-          {
-            std::stringstream ss;
-            ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
+    }
 
-            ss << "     Names:";
-            for (const auto& name : swp0.joint_names)
-              ss << " " << name;
+    buffer.solve0(swp0.joint_names, swp0.position);
+    if (checkTrajectoryState(contacts, manager, buffer.state0, config))
+    {
+      found = true;
+      logStateCollision(iStep, mi.size() - 1, -1, swp0.joint_names, swp0.position);
+    }
 
-            ss << std::endl << "    State: " << swp0.position << std::endl;
+    if (found && first_only)
+      return found;
+  }
 
-            CONSOLE_BRIDGE_logError(ss.str().c_str());
-          }
-        }
+  return found;
+}
 
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
-      }
-    }
-  }
-  else
-  {
-    // Flatten results
-    std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+namespace
+{
+/** @brief The active links of a manipulator computed for a revision of an environment */
+struct ActiveLinkNamesEntry
+{
+  std::weak_ptr<const tesseract_scene_graph::SceneGraph> scene_graph;
+  int revision{ 0 };
+  std::vector<std::string> active_link_names;
+};
 
-    contacts.reserve(mi.size());
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
-    {
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+/**
+ * @brief The cached active links by scene graph and manipulator
+ * @details Every environment, including clones, owns its own scene graph, which is only modified along with the
+ * revision. The weak pointer detects a scene graph which was destroyed and another one allocated at the same address.
+ */
+using ActiveLinkNamesKey = std::pair<const tesseract_scene_graph::SceneGraph*, std::string>;
+std::map<ActiveLinkNamesKey, ActiveLinkNamesEntry> active_link_names_cache;
+std::mutex active_link_names_mutex;
+}  // namespace
 
-      tesseract_environment::EnvState::Ptr state = state_solver.getState(swp0.joint_names, swp0.position);
-      if (checkTrajectoryState(contacts, manager, state, config))
-      {
-        found = true;
-        if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-        {
-          std::stringstream ss;
-          ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
+std::vector<std::string> getActiveLinkNames(const tesseract_environment::Environment& env,
+                                            const std::string& manipulator)
+{
+  tesseract_scene_graph::SceneGraph::ConstPtr scene_graph = env.getSceneGraph();
+  const int revision = env.getRevision();
+  const auto key = std::make_pair(scene_graph.get(), manipulator);
+  {
+    std::scoped_lock lock(active_link_names_mutex);
+    auto it = active_link_names_cache.find(key);
+    if (it != active_link_names_cache.end() && it->second.revision == revision &&
+        it->second.scene_graph.lock() == scene_graph)
+      return it->second.active_link_names;
+  }
 
-          ss << "     Names:";
-          for (const auto& name : swp0.joint_names)
-            ss << " " << name;
+  auto kin = env.getManipulatorManager()->getFwdKinematicSolver(manipulator);
+  if (kin == nullptr)
+    return {};
 
-          ss << std::endl << "    State0: " << swp0.position << std::endl;
+  // The kinematics does not know of every link affected by its motion so the adjacency map is used
+  tesseract_environment::AdjacencyMap adjacency_map(
+      scene_graph, kin->getActiveLinkNames(), env.getCurrentState()->link_transforms);
+  std::vector<std::string> active_link_names = adjacency_map.getActiveLinkNames();
 
-          CONSOLE_BRIDGE_logError(ss.str().c_str());
-        }
-      }
+  std::scoped_lock lock(active_link_names_mutex);
 
-      if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-        break;
-    }
+  // Remove the links of destroyed environments so the cache does not grow with every clone
+  for (auto it = active_link_names_cache.begin(); it != active_link_names_cache.end();)
+  {
+    if (it->second.scene_graph.expired())
+      it = active_link_names_cache.erase(it);
+    else
+      ++it;
   }
-  return found;
+
+  active_link_names_cache[key] = ActiveLinkNamesEntry{ scene_graph, revision, active_link_names };
+  return active_link_names;
 }
 
 void generateNaiveSeedHelper(CompositeInstruction& composite_instructions,
@@ -738,49 +837,101 @@ CompositeInstruction generateNaiveSeed(const CompositeInstruction& composite_ins
   return seed;
 }
 
+namespace
+{
+/** @brief Caches the interned joint names of each manipulator so the kinematics are only looked up once */
+class FormatProgramJointNamesCache
+{
+public:
+  explicit FormatProgramJointNamesCache(const tesseract_environment::Environment& env) : env_(env) {}
+
+  const JointNames& get(const std::string& manipulator)
+  {
+    auto it = cache_.find(manipulator);
+    if (it != cache_.end())
+      return it->second;
+
+    auto fwd_kin = env_.getManipulatorManager()->getFwdKinematicSolver(manipulator);
+    if (fwd_kin == nullptr)
+      throw std::runtime_error("formatProgram: Failed to get forward kinematics for manipulator '" + manipulator +
+                               "'!");
+
+    return cache_.emplace(manipulator, JointNames(fwd_kin->getJointNames())).first->second;
+  }
+
+private:
+  const tesseract_environment::Environment& env_;
+  std::unordered_map<std::string, JointNames> cache_;
+};
+
+/** @brief Check if the joint positions of a plan or move instruction must be formatted */
+template <typename InstructionType>
+bool isJointPositionFormatRequired(const InstructionType& instruction,
+                                   FormatProgramJointNamesCache& joint_names_cache,
+                                   const ManipulatorInfo& manip_info)
+{
+  if (!isStateWaypoint(instruction.getWaypoint()) && !isJointWaypoint(instruction.getWaypoint()))
+    return false;
+
+  ManipulatorInfo mi = manip_info.getCombined(instruction.getManipulatorInfo());
+  return !checkJointPositionFormat(joint_names_cache.get(mi.manipulator), instruction.getWaypoint());
+}
+
+/** @brief Check if the joint positions of an instruction or any of its children must be formatted */
+bool isFormatRequired(const Instruction& instruction,
+                      FormatProgramJointNamesCache& joint_names_cache,
+                      const ManipulatorInfo& manip_info)
+{
+  if (isCompositeInstruction(instruction))
+  {
+    const auto& composite = instruction.as<CompositeInstruction>();
+    return std::any_of(composite.begin(), composite.end(), [&](const Instruction& child) {
+      return isFormatRequired(child, joint_names_cache, manip_info);
+    });
+  }
+
+  if (isPlanInstruction(instruction))
+    return isJointPositionFormatRequired(instruction.as<PlanInstruction>(), joint_names_cache, manip_info);
+
+  if (isMoveInstruction(instruction))
+    return isJointPositionFormatRequired(instruction.as<MoveInstruction>(), joint_names_cache, manip_info);
+
+  return false;
+}
+
+/** @brief Format the joint positions of a plan or move instruction */
+template <typename InstructionType>
+void formatInstructionJointPosition(InstructionType& instruction,
+                                    FormatProgramJointNamesCache& joint_names_cache,
+                                    const ManipulatorInfo& manip_info)
+{
+  ManipulatorInfo mi = manip_info.getCombined(instruction.getManipulatorInfo());
+  formatJointPosition(joint_names_cache.get(mi.manipulator), instruction.getWaypoint());
+}
+
 bool formatProgramHelper(CompositeInstruction& composite_instructions,
-                         const tesseract_environment::Environment& env,
+                         FormatProgramJointNamesCache& joint_names_cache,
                          const ManipulatorInfo& manip_info)
 {
   bool format_required = false;
-  for (auto& i : composite_instructions)
+  for (std::size_t idx = 0; idx < composite_instructions.size(); ++idx)
   {
+    // Only the children which are formatted are accessed mutably, so the others stay shared with copies
+    if (!isFormatRequired(std::as_const(composite_instructions)[idx], joint_names_cache, manip_info))
+      continue;
+
+    format_required = true;
+    Instruction& i = composite_instructions[idx];
     if (isCompositeInstruction(i))
-    {
-      if (formatProgramHelper(i.as<CompositeInstruction>(), env, manip_info))
-        format_required = true;
-    }
+      formatProgramHelper(i.as<CompositeInstruction>(), joint_names_cache, manip_info);
     else if (isPlanInstruction(i))
-    {
-      auto& base_instruction = i.as<PlanInstruction>();
-      ManipulatorInfo mi = manip_info.getCombined(base_instruction.getManipulatorInfo());
-
-      ManipulatorInfo combined_mi = mi.getCombined(base_instruction.getManipulatorInfo());
-      auto fwd_kin = env.getManipulatorManager()->getFwdKinematicSolver(combined_mi.manipulator);
-
-      if (isStateWaypoint(base_instruction.getWaypoint()) || isJointWaypoint(base_instruction.getWaypoint()))
-      {
-        if (formatJointPosition(fwd_kin->getJointNames(), base_instruction.getWaypoint()))
-          format_required = true;
-      }
-    }
+      formatInstructionJointPosition(i.as<PlanInstruction>(), joint_names_cache, manip_info);
     else if (isMoveInstruction(i))
-    {
-      auto& base_instruction = i.as<MoveInstruction>();
-      ManipulatorInfo mi = manip_info.getCombined(base_instruction.getManipulatorInfo());
-
-      ManipulatorInfo combined_mi = mi.getCombined(base_instruction.getManipulatorInfo());
-      auto fwd_kin = env.getManipulatorManager()->getFwdKinematicSolver(combined_mi.manipulator);
-
-      if (isStateWaypoint(base_instruction.getWaypoint()) || isJointWaypoint(base_instruction.getWaypoint()))
-      {
-        if (formatJointPosition(fwd_kin->getJointNames(), base_instruction.getWaypoint()))
-          format_required = true;
-      }
-    }
+      formatInstructionJointPosition(i.as<MoveInstruction>(), joint_names_cache, manip_info);
   }
   return format_required;
 }
+}  // namespace
 
 bool formatProgram(CompositeInstruction& composite_instructions, const tesseract_environment::Environment& env)
 {
@@ -789,37 +940,34 @@ bool formatProgram(CompositeInstruction& composite_instructions, const tesseract
 
   bool format_required = false;
   ManipulatorInfo mi = composite_instructions.getManipulatorInfo();
+  FormatProgramJointNamesCache joint_names_cache(env);
 
   if (isPlanInstruction(composite_instructions.getStartInstruction()))
   {
     auto& pi = composite_instructions.getStartInstruction().as<PlanInstruction>();
-
-    ManipulatorInfo start_mi = mi.getCombined(pi.getManipulatorInfo());
-    auto fwd_kin = env.getManipulatorManager()->getFwdKinematicSolver(start_mi.manipulator);
-
     if (isStateWaypoint(pi.getWaypoint()) || isJointWaypoint(pi.getWaypoint()))
     {
-      if (formatJointPosition(fwd_kin->getJointNames(), pi.getWaypoint()))
+      ManipulatorInfo start_mi = mi.getCombined(pi.getManipulatorInfo());
+      const JointNames& joint_names = joint_names_cache.get(start_mi.manipulator);
+      if (formatJointPosition(joint_names, pi.getWaypoint()))
         format_required = true;
     }
   }
   else if (isMoveInstruction(composite_instructions.getStartInstruction()))
   {
     auto& pi = composite_instructions.getStartInstruction().as<MoveInstruction>();
-
-    ManipulatorInfo start_mi = mi.getCombined(pi.getManipulatorInfo());
-    auto fwd_kin = env.getManipulatorManager()->getFwdKinematicSolver(start_mi.manipulator);
-
     if (isStateWaypoint(pi.getWaypoint()) || isJointWaypoint(pi.getWaypoint()))
     {
-      if (formatJointPosition(fwd_kin->getJointNames(), pi.getWaypoint()))
+      ManipulatorInfo start_mi = mi.getCombined(pi.getManipulatorInfo());
+      const JointNames& joint_names = joint_names_cache.get(start_mi.manipulator);
+      if (formatJointPosition(joint_names, pi.getWaypoint()))
         format_required = true;
     }
   }
   else
     throw std::runtime_error("Top most composite instruction start instruction has invalid waypoint type!");
 
-  if (formatProgramHelper(composite_instructions, env, mi))
+  if (formatProgramHelper(composite_instructions, joint_names_cache, mi))
     format_required = true;
 
   return format_required;
@@ -55,6 +55,10 @@ std::string DescartesMotionPlannerStatusCategory::message(int code) const
     {
       return "Failed to search graph";
     }
+    case Cancelled:
+    {
+      return "Planning was cancelled";
+    }
     default:
     {
       assert(false);
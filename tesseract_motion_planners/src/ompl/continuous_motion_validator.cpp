@@ -30,6 +30,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/continuous_motion_validator.h>
+#include <tesseract_motion_planners/core/utils.h>
 
 namespace tesseract_planning
 {
@@ -49,11 +50,9 @@ ContinuousMotionValidator::ContinuousMotionValidator(
 {
   joints_ = kin_->getJointNames();
 
-  // kinematics objects does not know of every link affected by its motion so must compute adjacency map
-  // to determine all active links.
-  tesseract_environment::AdjacencyMap adj_map(
-      env->getSceneGraph(), kin_->getActiveLinkNames(), env->getCurrentState()->link_transforms);
-  links_ = adj_map.getActiveLinkNames();
+  // kinematics objects does not know of every link affected by its motion so the cached active links of the
+  // manipulator are used
+  links_ = getActiveLinkNames(*env, kin_->getName());
 
   continuous_contact_manager_->setActiveCollisionObjects(links_);
   continuous_contact_manager_->setCollisionMarginData(collision_check_config.collision_margin_data,
@@ -29,6 +29,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <ompl/base/goals/GoalState.h>
 #include <ompl/base/goals/GoalStates.h>
+#include <ompl/base/PlannerTerminationCondition.h>
 #include <ompl/tools/multiplan/ParallelPlan.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -48,6 +49,23 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/**
+ * @brief Create a termination condition which stops after the planning time or once the token is cancelled
+ * @param planning_time The planning time in seconds, which should already be limited to the deadline of the token
+ * @param token The cancellation token of the request, which may be nullptr
+ * @return The termination condition
+ */
+static ompl::base::PlannerTerminationCondition createTerminationCondition(double planning_time,
+                                                                          const CancellationToken::ConstPtr& token)
+{
+  if (token == nullptr)
+    return ompl::base::timedPlannerTerminationCondition(planning_time);
+
+  return ompl::base::plannerOrTerminationCondition(
+      ompl::base::timedPlannerTerminationCondition(planning_time),
+      ompl::base::PlannerTerminationCondition([token]() { return token->isCancelled(); }));
+}
+
 bool checkStartState(const ompl::base::ProblemDefinitionPtr& prob_def,
                      const Eigen::Ref<const Eigen::VectorXd>& state,
                      const OMPLStateExtractor& extractor)
@@ -97,7 +115,7 @@ const std::string& OMPLMotionPlanner::getName() const { return name_; }
 
 bool OMPLMotionPlanner::terminate()
 {
-  CONSOLE_BRIDGE_logWarn("Termination of ongoing optimization is not implemented yet");
+  CONSOLE_BRIDGE_logWarn("Use PlannerRequest::cancellation_token to terminate ongoing optimization");
   return false;
 }
 
@@ -128,6 +146,7 @@ tesseract_common::StatusCode OMPLMotionPlanner::solve(const PlannerRequest& requ
 
     try
     {
+      TraceSpan span(request.trace_recorder, "OMPL: Generate Problem", "planner");
       problem = problem_generator(name_, request, plan_profiles);
     }
     catch (std::exception& e)
@@ -154,24 +173,31 @@ tesseract_common::StatusCode OMPLMotionPlanner::solve(const PlannerRequest& requ
       parallel_plan->addPlanner(planner->create(p->simple_setup->getSpaceInformation()));
 
     ompl::base::PlannerStatus status;
+    auto solve_start = TraceRecorder::Clock::now();
     if (!p->optimize)
     {
       // Solve problem. Results are stored in the response
       // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
       // and finishes at the end state.
-      status = parallel_plan->solve(p->planning_time, 1, static_cast<unsigned>(p->max_solutions), false);
+      double planning_time = limitPlanningTime(p->planning_time, request.cancellation_token);
+      status = parallel_plan->solve(createTerminationCondition(planning_time, request.cancellation_token),
+                                    1,
+                                    static_cast<unsigned>(p->max_solutions),
+                                    false);
     }
     else
     {
-      ompl::time::point end = ompl::time::now() + ompl::time::seconds(p->planning_time);
+      double planning_time = limitPlanningTime(p->planning_time, request.cancellation_token);
+      ompl::time::point end = ompl::time::now() + ompl::time::seconds(planning_time);
       const ompl::base::ProblemDefinitionPtr& pdef = p->simple_setup->getProblemDefinition();
-      while (ompl::time::now() < end)
+      while (ompl::time::now() < end && !isCancelled(request.cancellation_token))
       {
         // Solve problem. Results are stored in the response
         // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
         // and finishes at the end state.
+        double remaining_time = std::max(ompl::time::seconds(end - ompl::time::now()), 0.0);
         ompl::base::PlannerStatus localResult =
-            parallel_plan->solve(std::max(ompl::time::seconds(end - ompl::time::now()), 0.0),
+            parallel_plan->solve(createTerminationCondition(remaining_time, request.cancellation_token),
                                  1,
                                  static_cast<unsigned>(p->max_solutions),
                                  false);
@@ -204,6 +230,15 @@ tesseract_common::StatusCode OMPLMotionPlanner::solve(const PlannerRequest& requ
       }
     }
 
+    if (request.trace_recorder != nullptr)
+      request.trace_recorder->record("OMPL: Solve", "planner", solve_start, TraceRecorder::Clock::now());
+
+    if (isCancelled(request.cancellation_token))
+    {
+      response.status = tesseract_common::StatusCode(OMPLMotionPlannerStatusCategory::Cancelled, status_category_);
+      return response.status;
+    }
+
     if (status != ompl::base::PlannerStatus::EXACT_SOLUTION)
     {
       response.status = tesseract_common::StatusCode(OMPLMotionPlannerStatusCategory::ErrorFailedToFindValidSolution,
@@ -211,6 +246,7 @@ tesseract_common::StatusCode OMPLMotionPlanner::solve(const PlannerRequest& requ
       return response.status;
     }
 
+    TraceSpan simplify_span(request.trace_recorder, "OMPL: Simplify", "planner");
     if (p->simplify)
     {
       p->simple_setup->simplifySolution();
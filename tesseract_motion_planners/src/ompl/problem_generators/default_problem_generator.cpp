@@ -27,6 +27,7 @@
 #include <tesseract_kinematics/core/validate.h>
 #include <tesseract_motion_planners/planner_utils.h>
 #include <tesseract_motion_planners/core/types.h>
+#include <tesseract_motion_planners/core/utils.h>
 #include <tesseract_motion_planners/ompl/problem_generators/default_problem_generator.h>
 #include <tesseract_command_language/utils/utils.h>
 
@@ -89,12 +90,7 @@ std::vector<OMPLProblem::Ptr> DefaultOMPLProblemGenerator(const std::string& nam
   }
 
   // Get Active Link Names
-  {
-    std::vector<std::string> active_link_names = manip_inv_kin_->getActiveLinkNames();
-    auto adjacency_map = std::make_shared<tesseract_environment::AdjacencyMap>(
-        request.env->getSceneGraph(), active_link_names, request.env_state->link_transforms);
-    active_link_names_ = adjacency_map->getActiveLinkNames();
-  }
+  active_link_names_ = getActiveLinkNames(*request.env, composite_mi.manipulator);
 
   // Check and make sure it does not contain any composite instruction
   for (const auto& instruction : request.instructions)
@@ -31,6 +31,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/utils.h>
 #include <tesseract_motion_planners/ompl/state_collision_validator.h>
+#include <tesseract_motion_planners/core/utils.h>
 
 namespace tesseract_planning
 {
@@ -49,11 +50,9 @@ StateCollisionValidator::StateCollisionValidator(
 {
   joints_ = kin_->getJointNames();
 
-  // kinematics objects does not know of every link affected by its motion so must compute adjacency map
-  // to determine all active links.
-  tesseract_environment::AdjacencyMap adj_map(
-      env_->getSceneGraph(), kin_->getActiveLinkNames(), env_->getCurrentState()->link_transforms);
-  links_ = adj_map.getActiveLinkNames();
+  // kinematics objects does not know of every link affected by its motion so the cached active links of the
+  // manipulator are used
+  links_ = getActiveLinkNames(*env_, kin_->getName());
 
   contact_manager_->setActiveCollisionObjects(links_);
   contact_manager_->setCollisionMarginData(collision_check_config.collision_margin_data,
@@ -59,6 +59,10 @@ std::string SimpleMotionPlannerStatusCategory::message(int code) const
     {
       return "Failed to find valid solution";
     }
+    case Cancelled:
+    {
+      return "Planning was cancelled";
+    }
     default:
     {
       assert(false);
@@ -83,7 +87,7 @@ const std::string& SimpleMotionPlanner::getName() const { return name_; }
 
 bool SimpleMotionPlanner::terminate()
 {
-  CONSOLE_BRIDGE_logWarn("Termination of ongoing planning is not implemented yet");
+  CONSOLE_BRIDGE_logWarn("Use PlannerRequest::cancellation_token to terminate ongoing planning");
   return false;
 }
 
@@ -132,6 +136,13 @@ tesseract_common::StatusCode SimpleMotionPlanner::solve(const PlannerRequest& re
     return response.status;
   }
 
+  // The seed is incomplete if planning was cancelled while it was processed
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(SimpleMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
   // Set start instruction
   MoveInstruction move_start_instruction_seed(start_instruction.getWaypoint(),
                                               MoveInstructionType::START,
@@ -222,6 +233,9 @@ CompositeInstruction SimpleMotionPlanner::processCompositeInstruction(const Comp
 
   for (const auto& instruction : instructions)
   {
+    if (isCancelled(request.cancellation_token))
+      break;
+
     if (isCompositeInstruction(instruction))
     {
       seed.push_back(processCompositeInstruction(instruction.as<CompositeInstruction>(), prev_instruction, request));
@@ -78,10 +78,7 @@ DefaultTrajoptProblemGenerator(const std::string& name,
   auto seed_flat = flattenProgramToPattern(request.seed, request.instructions);
 
   // Get kinematics information
-  tesseract_environment::Environment::ConstPtr env = request.env;
-  tesseract_environment::AdjacencyMap map(
-      env->getSceneGraph(), pci->kin->getActiveLinkNames(), env->getCurrentState()->link_transforms);
-  const std::vector<std::string>& active_links = map.getActiveLinkNames();
+  const std::vector<std::string> active_links = getActiveLinkNames(*request.env, composite_mi.manipulator);
 
   // Create a temp seed storage.
   std::vector<Eigen::VectorXd> seed_states;
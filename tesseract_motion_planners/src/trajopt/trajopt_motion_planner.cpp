@@ -64,6 +64,10 @@ std::string TrajOptMotionPlannerStatusCategory::message(int code) const
     {
       return "Failed to find valid solution";
     }
+    case Cancelled:
+    {
+      return "Planning was cancelled";
+    }
     default:
     {
       assert(false);
@@ -83,7 +87,7 @@ const std::string& TrajOptMotionPlanner::getName() const { return name_; }
 
 bool TrajOptMotionPlanner::terminate()
 {
-  CONSOLE_BRIDGE_logWarn("Termination of ongoing optimization is not implemented yet");
+  CONSOLE_BRIDGE_logWarn("Use PlannerRequest::cancellation_token to terminate ongoing optimization");
   return false;
 }
 
@@ -119,6 +123,7 @@ tesseract_common::StatusCode TrajOptMotionPlanner::solve(const PlannerRequest& r
 
     try
     {
+      TraceSpan span(request.trace_recorder, "TrajOpt: Generate Problem", "planner");
       pci = problem_generator(name_, request, plan_profiles, composite_profiles, solver_profiles);
     }
     catch (std::exception& e)
@@ -132,8 +137,26 @@ tesseract_common::StatusCode TrajOptMotionPlanner::solve(const PlannerRequest& r
     response.data = pci;
   }
 
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(TrajOptMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
+  if (isExpired(request.cancellation_token))
+  {
+    CONSOLE_BRIDGE_logError("TrajOptPlanner has no time left before the deadline of the request.");
+    response.status =
+        tesseract_common::StatusCode(TrajOptMotionPlannerStatusCategory::FailedToFindValidSolution, status_category_);
+    return response.status;
+  }
+
   // Construct Problem
-  trajopt::TrajOptProb::Ptr problem = trajopt::ConstructProblem(*pci);
+  trajopt::TrajOptProb::Ptr problem;
+  {
+    TraceSpan span(request.trace_recorder, "TrajOpt: ConstructProblem", "planner");
+    problem = trajopt::ConstructProblem(*pci);
+  }
 
   // Set Log Level
   if (verbose)
@@ -146,14 +169,50 @@ tesseract_common::StatusCode TrajOptMotionPlanner::solve(const PlannerRequest& r
   opt.setParameters(pci->opt_info);
   opt.initialize(trajToDblVec(problem->GetInitTraj()));
 
+  // Only use the time which is left before the deadline
+  opt.getParameters().max_time = limitPlanningTime(opt.getParameters().max_time, request.cancellation_token);
+
   // Add all callbacks
   for (const sco::Optimizer::Callback& callback : callbacks)
   {
     opt.addCallback(callback);
   }
 
+  // The callbacks can not stop the optimizer, so exhaust its limits to end it at the next iteration
+  if (request.cancellation_token != nullptr)
+  {
+    opt.addCallback([&opt, token = request.cancellation_token](sco::OptProb*, sco::OptResults&) {
+      if (!token->isCancelled())
+        return;
+
+      opt.getParameters().max_iter = 0;
+      opt.getParameters().max_merit_coeff_increases = 0;
+      opt.getParameters().max_time = 0;
+    });
+  }
+
+  // The callbacks are called at the start of each iteration, so each span covers the previous iteration
+  if (request.trace_recorder != nullptr)
+  {
+    opt.addCallback([recorder = request.trace_recorder,
+                     start = TraceRecorder::Clock::now()](sco::OptProb*, sco::OptResults&) mutable {
+      auto now = TraceRecorder::Clock::now();
+      recorder->record("TrajOpt: SQP Iteration", "planner", start, now);
+      start = now;
+    });
+  }
+
   // Optimize
-  opt.optimize();
+  {
+    TraceSpan span(request.trace_recorder, "TrajOpt: Optimize", "planner");
+    opt.optimize();
+  }
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status = tesseract_common::StatusCode(TrajOptMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
   if (opt.results().status != sco::OptStatus::OPT_CONVERGED)
   {
     response.status =
@@ -61,9 +61,7 @@ DefaultTrajOptIfoptProblemGenerator(const std::string& name,
 
   // Get kinematics information
   tesseract_environment::Environment::ConstPtr env = request.env;
-  tesseract_environment::AdjacencyMap map(
-      env->getSceneGraph(), kin->getActiveLinkNames(), env->getCurrentState()->link_transforms);
-  const std::vector<std::string>& active_links = map.getActiveLinkNames();
+  const std::vector<std::string> active_links = getActiveLinkNames(*env, manipulator);
 
   // Flatten input instructions
   auto instructions_flat = flattenProgram(request.instructions);
@@ -27,6 +27,7 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <tesseract_environment/core/utils.h>
+#include <trajopt_sqp/sqp_callback.h>
 #include <trajopt_sqp/trust_region_sqp_solver.h>
 #include <trajopt_sqp/osqp_eigen_solver.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -40,6 +41,40 @@ using namespace trajopt;
 
 namespace tesseract_planning
 {
+/** @brief Stops the solver once the cancellation token of the request is set or its deadline has passed */
+class CancellationSQPCallback : public trajopt_sqp::SQPCallback
+{
+public:
+  CancellationSQPCallback(CancellationToken::ConstPtr token) : token_(std::move(token)) {}
+
+  bool execute(const ifopt::Problem& /*nlp*/, const trajopt_sqp::SQPResults& /*sqp_results*/) override
+  {
+    return !(token_->isCancelled() || token_->isExpired());
+  }
+
+private:
+  CancellationToken::ConstPtr token_;
+};
+
+/** @brief Records a span for each iteration of the solver */
+class TraceSQPCallback : public trajopt_sqp::SQPCallback
+{
+public:
+  TraceSQPCallback(TraceRecorder::Ptr recorder) : recorder_(std::move(recorder)) {}
+
+  bool execute(const ifopt::Problem& /*nlp*/, const trajopt_sqp::SQPResults& /*sqp_results*/) override
+  {
+    auto now = TraceRecorder::Clock::now();
+    recorder_->record("TrajOptIfopt: SQP Iteration", "planner", start_, now);
+    start_ = now;
+    return true;
+  }
+
+private:
+  TraceRecorder::Ptr recorder_;
+  TraceRecorder::Clock::time_point start_{ TraceRecorder::Clock::now() };
+};
+
 TrajOptIfoptMotionPlannerStatusCategory::TrajOptIfoptMotionPlannerStatusCategory(std::string name)
   : name_(std::move(name))
 {
@@ -61,6 +96,10 @@ std::string TrajOptIfoptMotionPlannerStatusCategory::message(int code) const
     {
       return "Failed to find valid solution";
     }
+    case Cancelled:
+    {
+      return "Planning was cancelled";
+    }
     default:
     {
       assert(false);
@@ -78,7 +117,7 @@ const std::string& TrajOptIfoptMotionPlanner::getName() const { return name_; }
 
 bool TrajOptIfoptMotionPlanner::terminate()
 {
-  CONSOLE_BRIDGE_logWarn("Termination of ongoing optimization is not implemented yet");
+  CONSOLE_BRIDGE_logWarn("Use PlannerRequest::cancellation_token to terminate ongoing optimization");
   return false;
 }
 
@@ -114,10 +153,26 @@ tesseract_common::StatusCode TrajOptIfoptMotionPlanner::solve(const PlannerReque
           tesseract_common::StatusCode(TrajOptIfoptMotionPlannerStatusCategory::ErrorInvalidInput, status_category_);
       return response.status;
     }
+    TraceSpan span(request.trace_recorder, "TrajOptIfopt: Generate Problem", "planner");
     problem = problem_generator(name_, request, plan_profiles, composite_profiles);
     response.data = problem;
   }
 
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status =
+        tesseract_common::StatusCode(TrajOptIfoptMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
+
+  if (isExpired(request.cancellation_token))
+  {
+    CONSOLE_BRIDGE_logError("TrajOptIfoptPlanner has no time left before the deadline of the request.");
+    response.status = tesseract_common::StatusCode(TrajOptIfoptMotionPlannerStatusCategory::FailedToFindValidSolution,
+                                                   status_category_);
+    return response.status;
+  }
+
   // Create optimizer
   /** @todo Enable solver selection (e.g. IPOPT) */
   auto qp_solver = std::make_shared<trajopt_sqp::OSQPEigenSolver>();
@@ -137,9 +192,24 @@ tesseract_common::StatusCode TrajOptIfoptMotionPlanner::solve(const PlannerReque
     solver.registerCallback(callback);
   }
 
+  if (request.cancellation_token != nullptr)
+    solver.registerCallback(std::make_shared<CancellationSQPCallback>(request.cancellation_token));
+
+  if (request.trace_recorder != nullptr)
+    solver.registerCallback(std::make_shared<TraceSQPCallback>(request.trace_recorder));
+
   // solve
   solver.verbose = verbose;
-  solver.Solve(*(problem->nlp));
+  {
+    TraceSpan span(request.trace_recorder, "TrajOptIfopt: Solve", "planner");
+    solver.Solve(*(problem->nlp));
+  }
+  if (isCancelled(request.cancellation_token))
+  {
+    response.status =
+        tesseract_common::StatusCode(TrajOptIfoptMotionPlannerStatusCategory::Cancelled, status_category_);
+    return response.status;
+  }
 
   // Check success
   if (solver.getStatus() != trajopt_sqp::SQPStatus::NLP_CONVERGED)
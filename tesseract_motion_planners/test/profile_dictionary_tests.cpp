@@ -26,6 +26,9 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/profile_dictionary.h>
@@ -119,6 +122,72 @@ TEST(TesseractPlanningProfileDictionaryUnit, ProfileDictionaryTest)
   EXPECT_EQ(profile_check4->a, 20);
 }
 
+TEST(TesseractPlanningProfileDictionaryUnit, ProfileDictionarySnapshotTest)
+{
+  ProfileDictionary profiles;
+  EXPECT_TRUE(profiles.getProfileEntrySnapshot<ProfileBase>() == nullptr);
+  EXPECT_TRUE(profiles.findProfile<ProfileBase>("key") == nullptr);
+
+  profiles.addProfile<ProfileBase>("key", std::make_shared<ProfileTest>(10));
+  auto snapshot = profiles.getProfileEntrySnapshot<ProfileBase>();
+  ASSERT_TRUE(snapshot != nullptr);
+  EXPECT_EQ(snapshot->size(), 1);
+  EXPECT_EQ(profiles.findProfile<ProfileBase>("key")->a, 10);
+  EXPECT_TRUE(profiles.findProfile<ProfileBase>("DoesNotExist") == nullptr);
+
+  // A snapshot is not affected by later changes
+  profiles.addProfile<ProfileBase>("key", std::make_shared<ProfileTest>(20));
+  profiles.addProfile<ProfileBase>("key2", std::make_shared<ProfileTest>(30));
+  EXPECT_EQ(snapshot->size(), 1);
+  EXPECT_EQ(snapshot->at("key")->a, 10);
+  EXPECT_EQ(profiles.getProfileEntrySnapshot<ProfileBase>()->size(), 2);
+  EXPECT_EQ(profiles.findProfile<ProfileBase>("key")->a, 20);
+
+  profiles.removeProfile<ProfileBase>("key");
+  EXPECT_FALSE(profiles.hasProfile<ProfileBase>("key"));
+  EXPECT_TRUE(profiles.hasProfile<ProfileBase>("key2"));
+
+  profiles.removeProfileEntry<ProfileBase>();
+  EXPECT_FALSE(profiles.hasProfileEntry<ProfileBase>());
+  EXPECT_EQ(snapshot->at("key")->a, 10);
+}
+
+TEST(TesseractPlanningProfileDictionaryUnit, ProfileDictionaryConcurrentTest)
+{
+  ProfileDictionary profiles;
+  profiles.addProfile<ProfileBase>("key", std::make_shared<ProfileTest>(0));
+
+  // Readers always see a complete snapshot while a writer is adding and replacing profiles
+  std::atomic<bool> done{ false };
+  std::atomic<long> failures{ 0 };
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+  {
+    readers.emplace_back([&profiles, &done, &failures]() {
+      while (!done)
+      {
+        auto profile = profiles.findProfile<ProfileBase>("key");
+        auto snapshot = profiles.getProfileEntrySnapshot<ProfileBase>();
+        if (profile == nullptr || snapshot == nullptr || snapshot->find("key") == snapshot->end())
+          ++failures;
+      }
+    });
+  }
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    profiles.addProfile<ProfileBase>("key", std::make_shared<ProfileTest>(i));
+    profiles.addProfile<ProfileBase>("key" + std::to_string(i % 10), std::make_shared<ProfileTest>(i));
+  }
+  done = true;
+
+  for (auto& reader : readers)
+    reader.join();
+
+  EXPECT_EQ(failures, 0);
+  EXPECT_EQ(profiles.findProfile<ProfileBase>("key")->a, 999);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
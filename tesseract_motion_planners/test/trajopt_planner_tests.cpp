@@ -21,6 +21,7 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
+#include <map>
 
 // These contain the definitions of the cost types
 #include <trajopt/trajectory_costs.hpp>
@@ -293,6 +294,116 @@ TEST_F(TesseractPlanningTrajoptUnit, TrajoptFreespaceJointJoint)  // NOLINT
 }
 
 // This test tests freespace motion b/n 1 joint waypoint and 1 cartesian waypoint
+TEST_F(TesseractPlanningTrajoptUnit, TrajoptPlannerCancellation)  // NOLINT
+{
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(manip.manipulator);
+  const std::vector<std::string>& joint_names = fwd_kin->getJointNames();
+  auto cur_state = env_->getCurrentState();
+
+  // Specify a JointWaypoint as the start
+  JointWaypoint wp1(joint_names, { 0, 0, 0, -1.57, 0, 0, 0 });
+
+  // Specify a Joint Waypoint as the finish
+  JointWaypoint wp2(joint_names, { 0, 0, 0, 1.57, 0, 0, 0 });
+
+  // Create a program
+  CompositeInstruction program("TEST_PROFILE");
+  program.setStartInstruction(PlanInstruction(wp1, PlanInstructionType::START, "TEST_PROFILE"));
+  program.setManipulatorInfo(manip);
+  program.push_back(PlanInstruction(wp2, PlanInstructionType::FREESPACE, "TEST_PROFILE"));
+
+  // Create Planner
+  TrajOptMotionPlanner test_planner;
+  test_planner.plan_profiles["TEST_PROFILE"] = std::make_shared<TrajOptDefaultPlanProfile>();
+  test_planner.composite_profiles["TEST_PROFILE"] = std::make_shared<TrajOptDefaultCompositeProfile>();
+  test_planner.problem_generator = &DefaultTrajoptProblemGenerator;
+
+  // Create Planning Request
+  PlannerRequest request;
+  request.seed = generateSeed(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+  request.instructions = program;
+  request.env = env_;
+  request.env_state = env_->getCurrentState();
+
+  // A token cancelled before solving stops the planner before the problem is constructed
+  auto token = std::make_shared<CancellationToken>();
+  token->cancel();
+  request.cancellation_token = token;
+
+  PlannerResponse response;
+  tesseract_common::StatusCode status = test_planner.solve(request, response);
+  EXPECT_FALSE(status);
+  EXPECT_EQ(status.value(), TrajOptMotionPlannerStatusCategory::Cancelled);
+
+  // A token cancelled during the optimization stops it instead of running the full iteration budget
+  token = std::make_shared<CancellationToken>();
+  request.cancellation_token = token;
+
+  int iterations = 0;
+  test_planner.callbacks.emplace_back([&iterations, token](sco::OptProb*, sco::OptResults&) {
+    ++iterations;
+    token->cancel();
+  });
+
+  status = test_planner.solve(request, response);
+  EXPECT_FALSE(status);
+  EXPECT_EQ(status.value(), TrajOptMotionPlannerStatusCategory::Cancelled);
+  EXPECT_LE(iterations, 2);
+}
+
+TEST_F(TesseractPlanningTrajoptUnit, TrajoptPlannerTrace)  // NOLINT
+{
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(manip.manipulator);
+  const std::vector<std::string>& joint_names = fwd_kin->getJointNames();
+  auto cur_state = env_->getCurrentState();
+
+  // Specify a JointWaypoint as the start
+  JointWaypoint wp1(joint_names, { 0, 0, 0, -1.57, 0, 0, 0 });
+
+  // Specify a Joint Waypoint as the finish
+  JointWaypoint wp2(joint_names, { 0, 0, 0, 1.57, 0, 0, 0 });
+
+  // Create a program
+  CompositeInstruction program("TEST_PROFILE");
+  program.setStartInstruction(PlanInstruction(wp1, PlanInstructionType::START, "TEST_PROFILE"));
+  program.setManipulatorInfo(manip);
+  program.push_back(PlanInstruction(wp2, PlanInstructionType::FREESPACE, "TEST_PROFILE"));
+
+  // Create Planner
+  TrajOptMotionPlanner test_planner;
+  test_planner.plan_profiles["TEST_PROFILE"] = std::make_shared<TrajOptDefaultPlanProfile>();
+  test_planner.composite_profiles["TEST_PROFILE"] = std::make_shared<TrajOptDefaultCompositeProfile>();
+  test_planner.problem_generator = &DefaultTrajoptProblemGenerator;
+
+  // Create Planning Request
+  PlannerRequest request;
+  request.seed = generateSeed(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+  request.instructions = program;
+  request.env = env_;
+  request.env_state = env_->getCurrentState();
+  request.trace_recorder = std::make_shared<TraceRecorder>();
+
+  PlannerResponse response;
+  tesseract_common::StatusCode status = test_planner.solve(request, response);
+  EXPECT_TRUE(status);
+
+  // Each stage of the planner is recorded
+  std::map<std::string, int> span_counts;
+  for (const auto& span : request.trace_recorder->getSpans())
+  {
+    EXPECT_LE(span.start, span.end);
+    ++span_counts[span.name];
+  }
+  EXPECT_EQ(span_counts["TrajOpt: Generate Problem"], 1);
+  EXPECT_EQ(span_counts["TrajOpt: ConstructProblem"], 1);
+  EXPECT_EQ(span_counts["TrajOpt: Optimize"], 1);
+  EXPECT_GE(span_counts["TrajOpt: SQP Iteration"], 1);
+
+  std::string trace = request.trace_recorder->toChromeTrace();
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"TrajOpt: ConstructProblem\""), std::string::npos);
+}
+
 TEST_F(TesseractPlanningTrajoptUnit, TrajoptFreespaceJointCart)  // NOLINT
 {
   auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(manip.manipulator);
@@ -34,6 +34,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_motion_planners/core/utils.h>
 #include <tesseract_motion_planners/planner_utils.h>
 #include <tesseract_command_language/plan_instruction.h>
+#include <tesseract_command_language/trajectory_segment_instruction.h>
 
 using namespace tesseract_planning;
 using namespace tesseract_environment;
@@ -122,6 +123,225 @@ TEST_F(TesseractPlanningUtilsUnit, GetProfileStringTest)
   EXPECT_EQ(output_profile, "profile_1_remapped");
 }
 
+TEST_F(TesseractPlanningUtilsUnit, ContactCheckProgram)  // NOLINT
+{
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver("manipulator");
+  std::vector<std::string> joint_names = fwd_kin->getJointNames();
+
+  // Build a trajectory where some segments are longer and some shorter than the longest valid segment
+  CompositeInstruction program;
+  for (long i = 0; i < 20; ++i)
+  {
+    Eigen::VectorXd position = Eigen::VectorXd::Zero(static_cast<long>(joint_names.size()));
+    position(0) = (i % 2 == 0) ? 0.01 * static_cast<double>(i) : 0.1 * static_cast<double>(i);
+    program.push_back(MoveInstruction(StateWaypoint(joint_names, position), MoveInstructionType::FREESPACE));
+  }
+
+  tesseract_environment::StateSolver::Ptr state_solver = env_->getStateSolver();
+  std::vector<std::string> active_links = fwd_kin->getActiveLinkNames();
+
+  auto discrete_manager = env_->getDiscreteContactManager();
+  discrete_manager->setActiveCollisionObjects(active_links);
+  auto continuous_manager = env_->getContinuousContactManager();
+  continuous_manager->setActiveCollisionObjects(active_links);
+
+  tesseract_collision::CollisionCheckConfig config;
+  config.longest_valid_segment_length = 0.05;
+
+  std::vector<tesseract_collision::ContactResultMap> contacts;
+  config.type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+  EXPECT_FALSE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  EXPECT_TRUE(contacts.empty());
+
+  config.type = tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE;
+  EXPECT_FALSE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  EXPECT_TRUE(contacts.empty());
+
+  config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  EXPECT_FALSE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  EXPECT_TRUE(contacts.empty());
+
+  config.type = tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS;
+  EXPECT_FALSE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  EXPECT_TRUE(contacts.empty());
+
+  // The evaluator type must match the contact manager type
+  EXPECT_ANY_THROW(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));  // NOLINT
+  config.type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+  EXPECT_ANY_THROW(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));  // NOLINT
+
+  // Trajectory segments are rejected instead of being skipped
+  CompositeInstruction segment_composite;
+  segment_composite.push_back(TrajectorySegmentInstruction(joint_names, 2));
+  program.push_back(segment_composite);
+  EXPECT_ANY_THROW(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));  // NOLINT
+  config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  EXPECT_ANY_THROW(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));  // NOLINT
+}
+
+/** @brief Check that every contact of every step is between the robot and the wall */
+void checkWallContacts(const std::vector<tesseract_collision::ContactResultMap>& contacts)
+{
+  for (const auto& step_contacts : contacts)
+  {
+    EXPECT_FALSE(step_contacts.empty());
+    for (const auto& pair : step_contacts)
+      EXPECT_TRUE(pair.first.first == "wall_link" || pair.first.second == "wall_link");
+  }
+}
+
+/** @brief Get the link pairs in contact for a step */
+std::vector<std::pair<std::string, std::string>> getContactPairs(const tesseract_collision::ContactResultMap& contacts)
+{
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (const auto& pair : contacts)
+    pairs.push_back(pair.first);
+
+  return pairs;
+}
+
+TEST_F(TesseractPlanningUtilsUnit, ContactCheckProgramCollision)  // NOLINT
+{
+  // Add a thin wall in front of the robot which the forearm goes through when the first joint is zero
+  Environment::Ptr env = env_->clone();
+  tesseract_scene_graph::Link wall_link("wall_link");
+  auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+  collision->origin = Eigen::Isometry3d::Identity();
+  collision->origin.translation() = Eigen::Vector3d(0.5, 0, 0.55);
+  collision->geometry = std::make_shared<tesseract_geometry::Box>(0.4, 0.001, 0.4);
+  wall_link.collision.push_back(collision);
+
+  tesseract_scene_graph::Joint wall_joint("wall_joint");
+  wall_joint.parent_link_name = "base_link";
+  wall_joint.child_link_name = wall_link.getName();
+  wall_joint.type = tesseract_scene_graph::JointType::FIXED;
+  EXPECT_TRUE(env->addLink(wall_link, wall_joint));
+
+  auto fwd_kin = env->getManipulatorManager()->getFwdKinematicSolver("manipulator");
+  std::vector<std::string> joint_names = fwd_kin->getJointNames();
+
+  // The states on either side of the wall are collision free and only the first joint moves
+  CompositeInstruction program;
+  for (double j1 : { -0.5, 0.0, 0.0, -0.5, 0.5, 0.5 })
+  {
+    Eigen::VectorXd position(7);
+    position << j1, 0.5, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+    program.push_back(MoveInstruction(StateWaypoint(joint_names, position), MoveInstructionType::FREESPACE));
+  }
+
+  tesseract_environment::StateSolver::Ptr state_solver = env->getStateSolver();
+  std::vector<std::string> active_links = fwd_kin->getActiveLinkNames();
+
+  auto discrete_manager = env->getDiscreteContactManager();
+  discrete_manager->setActiveCollisionObjects(active_links);
+  auto continuous_manager = env->getContinuousContactManager();
+  continuous_manager->setActiveCollisionObjects(active_links);
+
+  // The segment from -0.5 to 0.5 is split at zero, the others are not split
+  tesseract_collision::CollisionCheckConfig config;
+  config.longest_valid_segment_length = 0.5;
+
+  // Discrete finds states 1 and 2 in collision, the last state is not checked
+  std::vector<tesseract_collision::ContactResultMap> contacts;
+  config.type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+  config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+  EXPECT_TRUE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 2);
+  checkWallContacts(contacts);
+  EXPECT_EQ(getContactPairs(contacts[0]), getContactPairs(contacts[1]));
+  std::vector<std::pair<std::string, std::string>> wall_pairs = getContactPairs(contacts[0]);
+
+  contacts.clear();
+  config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
+  EXPECT_TRUE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 1);
+  checkWallContacts(contacts);
+
+  // Longest valid segment also checks the substate at zero between states 3 and 4
+  contacts.clear();
+  config.type = tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE;
+  config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+  EXPECT_TRUE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 3);
+  checkWallContacts(contacts);
+  for (const auto& step_contacts : contacts)
+    EXPECT_EQ(getContactPairs(step_contacts), wall_pairs);
+
+  contacts.clear();
+  config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
+  EXPECT_TRUE(contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 1);
+  checkWallContacts(contacts);
+
+  // Continuous checks every segment touching zero and the segment through the wall, only the last one is free
+  contacts.clear();
+  config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+  EXPECT_TRUE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 4);
+  checkWallContacts(contacts);
+
+  contacts.clear();
+  config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
+  EXPECT_TRUE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 1);
+  checkWallContacts(contacts);
+
+  // Longest valid segment checks both halves of the segment through the wall
+  contacts.clear();
+  config.type = tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS;
+  config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+  EXPECT_TRUE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 5);
+  checkWallContacts(contacts);
+
+  contacts.clear();
+  config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
+  EXPECT_TRUE(contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config));
+  ASSERT_EQ(contacts.size(), 1);
+  checkWallContacts(contacts);
+
+  // Only checking the states before the wall finds nothing
+  contacts.clear();
+  std::vector<std::reference_wrapper<const Instruction>> mi = flatten(program, moveFilter);
+  config.type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+  config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+  EXPECT_FALSE(contactCheckProgram(contacts, *discrete_manager, *state_solver, mi, 0, 1, config));
+  EXPECT_TRUE(contacts.empty());
+}
+
+TEST_F(TesseractPlanningUtilsUnit, GetActiveLinkNames)  // NOLINT
+{
+  Environment::Ptr env = env_->clone();
+  auto fwd_kin = env->getManipulatorManager()->getFwdKinematicSolver("manipulator");
+  AdjacencyMap adjacency_map(
+      env->getSceneGraph(), fwd_kin->getActiveLinkNames(), env->getCurrentState()->link_transforms);
+
+  std::vector<std::string> active_links = getActiveLinkNames(*env, "manipulator");
+  EXPECT_FALSE(active_links.empty());
+  EXPECT_EQ(active_links, adjacency_map.getActiveLinkNames());
+
+  // The cached links are returned again
+  EXPECT_EQ(getActiveLinkNames(*env, "manipulator"), active_links);
+  EXPECT_TRUE(getActiveLinkNames(*env, "missing_manipulator").empty());
+
+  // A link added to the manipulator is included once the revision changed
+  tesseract_scene_graph::Link link("extra_tool_link");
+  tesseract_scene_graph::Joint joint("extra_tool_joint");
+  joint.type = tesseract_scene_graph::JointType::FIXED;
+  joint.parent_link_name = fwd_kin->getTipLinkName();
+  joint.child_link_name = link.getName();
+  EXPECT_TRUE(env->addLink(link, joint));
+
+  std::vector<std::string> modified_active_links = getActiveLinkNames(*env, "manipulator");
+  EXPECT_EQ(modified_active_links.size(), active_links.size() + 1);
+  EXPECT_TRUE(std::find(modified_active_links.begin(), modified_active_links.end(), "extra_tool_link") !=
+              modified_active_links.end());
+
+  // Other environments are not affected
+  EXPECT_EQ(getActiveLinkNames(*env_, "manipulator"), active_links);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,182 @@
+/**
+ * @file priority_scheduling_example.cpp
+ * @brief This example measures the latency of short freespace requests while long raster requests run in the
+ * background, with and without priority classes
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <raster_example_program.h>
+#include <freespace_example_program.h>
+#include <tesseract_environment/core/environment.h>
+#include <tesseract_environment/ofkt/ofkt_state_solver.h>
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/utils/utils.h>
+#include <tesseract_process_managers/core/process_planning_server.h>
+#include <tesseract_process_managers/core/default_process_planners.h>
+
+using namespace tesseract_planning;
+
+std::string locateResource(const std::string& url)
+{
+  std::string mod_url = url;
+  if (url.find("package://tesseract_support") == 0)
+  {
+    mod_url.erase(0, strlen("package://tesseract_support"));
+    size_t pos = mod_url.find('/');
+    if (pos == std::string::npos)
+    {
+      return std::string();
+    }
+
+    std::string package = mod_url.substr(0, pos);
+    mod_url.erase(0, pos);
+    std::string package_path = std::string(TESSERACT_SUPPORT_DIR);
+
+    if (package_path.empty())
+    {
+      return std::string();
+    }
+
+    mod_url = package_path + mod_url;
+  }
+
+  return mod_url;
+}
+
+/**
+ * @brief Get a percentile of the request latencies
+ * @param latencies The latencies in milliseconds
+ * @param percentile The percentile between zero and one
+ * @return The latency in milliseconds
+ */
+double getPercentile(std::vector<double> latencies, double percentile)
+{
+  std::sort(latencies.begin(), latencies.end());
+  auto index = static_cast<std::size_t>(percentile * static_cast<double>(latencies.size() - 1));
+  return latencies[index];
+}
+
+/**
+ * @brief Run short requests one after the other while background requests run
+ * @param planning_server The planning server
+ * @param background_request The long running request
+ * @param num_background The number of background requests submitted at the start
+ * @param request The short request
+ * @param num_requests The number of short requests
+ * @return The latency of each short request in milliseconds
+ */
+std::vector<double> runRequests(ProcessPlanningServer& planning_server,
+                                const ProcessPlanningRequest& background_request,
+                                int num_background,
+                                const ProcessPlanningRequest& request,
+                                int num_requests)
+{
+  std::vector<ProcessPlanningFuture> background_responses;
+  background_responses.reserve(static_cast<std::size_t>(num_background));
+  for (int i = 0; i < num_background; ++i)
+    background_responses.push_back(planning_server.run(background_request));
+
+  std::vector<double> latencies;
+  latencies.reserve(static_cast<std::size_t>(num_requests));
+  for (int i = 0; i < num_requests; ++i)
+  {
+    auto start = std::chrono::high_resolution_clock::now();
+    ProcessPlanningFuture response = planning_server.run(request);
+    response.wait();
+    auto stop = std::chrono::high_resolution_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+
+    // Space the requests out like a user would
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // The background requests are not of interest here
+  for (auto& response : background_responses)
+    response.interface->abort();
+
+  planning_server.waitForAll();
+  return latencies;
+}
+
+int main()
+{
+  const int num_background = 8;
+  const int num_requests = 100;
+  const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 4U);
+
+  // --------------------
+  // Perform setup
+  // --------------------
+  tesseract_scene_graph::ResourceLocator::Ptr locator =
+      std::make_shared<tesseract_scene_graph::SimpleResourceLocator>(locateResource);
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+  env->init<tesseract_environment::OFKTStateSolver>(urdf_path, srdf_path, locator);
+
+  // The background requests plan a full raster program
+  ProcessPlanningRequest background_request;
+  background_request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+  background_request.instructions = Instruction(rasterExampleProgram(DEFAULT_PROFILE_KEY, "PROCESS"));
+  background_request.priority = ProcessPlanningPriority::LOW;
+
+  // The latency critical requests plan a single freespace motion
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::TRAJOPT_PLANNER_NAME;
+  request.instructions = Instruction(freespaceExampleProgramABB());
+  request.priority = ProcessPlanningPriority::HIGH;
+
+  for (bool use_priority : { false, true })
+  {
+    ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env, 4), num_threads);
+    planning_server.loadDefaultProcessPlanners();
+
+    // Reserve a quarter of the threads for latency critical requests and run one background request at a time
+    if (use_priority)
+    {
+      planning_server.configurePriorityClass(ProcessPlanningPriority::HIGH, num_threads / 4);
+      planning_server.configurePriorityClass(ProcessPlanningPriority::LOW, num_threads - (num_threads / 4), 1);
+    }
+
+    std::vector<double> latencies =
+        runRequests(planning_server, background_request, num_background, request, num_requests);
+
+    RequestSchedulerMetrics metrics = planning_server.getSchedulerMetrics(ProcessPlanningPriority::LOW);
+    std::cout << ((use_priority) ? "Priority Classes" : "Shared Executor") << ": p50 " << getPercentile(latencies, 0.5)
+              << " ms, p99 " << getPercentile(latencies, 0.99) << " ms, background max wait "
+              << metrics.max_wait_time * 1000 << " ms" << std::endl;
+  }
+
+  std::cout << "Execution Complete" << std::endl;
+
+  return 0;
+}
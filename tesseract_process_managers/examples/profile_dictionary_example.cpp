@@ -0,0 +1,138 @@
+/**
+ * @file profile_dictionary_example.cpp
+ * @brief This example measures the throughput of reading profiles from a shared dictionary with concurrent requests
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/profile_dictionary.h>
+
+#include <tesseract_motion_planners/simple/simple_motion_planner.h>
+#include <tesseract_motion_planners/simple/profile/simple_planner_lvs_plan_profile.h>
+
+#include <tesseract_motion_planners/ompl/ompl_motion_planner.h>
+#include <tesseract_motion_planners/ompl/profile/ompl_default_plan_profile.h>
+
+#include <tesseract_motion_planners/trajopt/trajopt_motion_planner.h>
+#include <tesseract_motion_planners/trajopt/profile/trajopt_default_plan_profile.h>
+#include <tesseract_motion_planners/trajopt/profile/trajopt_default_composite_profile.h>
+#include <tesseract_motion_planners/trajopt/profile/trajopt_default_solver_profile.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Assign the profiles to the planners the same way the freespace taskflow does for every request
+ * @param profiles The shared profile dictionary
+ */
+void setupPlanners(const ProfileDictionary& profiles)
+{
+  auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
+  if (auto entry = profiles.getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+    interpolator->plan_profiles = *entry;
+
+  auto ompl_planner = std::make_shared<OMPLMotionPlanner>();
+  if (auto entry = profiles.getProfileEntrySnapshot<OMPLPlanProfile>())
+    ompl_planner->plan_profiles = *entry;
+
+  auto trajopt_planner = std::make_shared<TrajOptMotionPlanner>();
+  if (auto entry = profiles.getProfileEntrySnapshot<TrajOptPlanProfile>())
+    trajopt_planner->plan_profiles = *entry;
+
+  if (auto entry = profiles.getProfileEntrySnapshot<TrajOptCompositeProfile>())
+    trajopt_planner->composite_profiles = *entry;
+
+  if (auto entry = profiles.getProfileEntrySnapshot<TrajOptSolverProfile>())
+    trajopt_planner->solver_profiles = *entry;
+
+  // Profile overrides are looked up by task name for every instruction
+  for (int i = 0; i < 10; ++i)
+    profiles.findProfile<TrajOptPlanProfile>("Override");
+}
+
+int main()
+{
+  const int num_profiles = 20;
+  const int requests_per_thread = 20000;
+
+  ProfileDictionary profiles;
+  for (int i = 0; i < num_profiles; ++i)
+  {
+    std::string name = "PROFILE_" + std::to_string(i);
+    profiles.addProfile<SimplePlannerPlanProfile>(name, std::make_shared<SimplePlannerLVSPlanProfile>());
+    profiles.addProfile<OMPLPlanProfile>(name, std::make_shared<OMPLDefaultPlanProfile>());
+    profiles.addProfile<TrajOptPlanProfile>(name, std::make_shared<TrajOptDefaultPlanProfile>());
+    profiles.addProfile<TrajOptCompositeProfile>(name, std::make_shared<TrajOptDefaultCompositeProfile>());
+    profiles.addProfile<TrajOptSolverProfile>(name, std::make_shared<TrajOptDefaultSolverProfile>());
+  }
+
+  const unsigned max_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+  {
+    // A writer keeps publishing new profiles while the requests are read
+    std::atomic<bool> done{ false };
+    std::thread writer([&profiles, &done]() {
+      auto profile = std::make_shared<TrajOptDefaultPlanProfile>();
+      while (!done)
+      {
+        profiles.addProfile<TrajOptPlanProfile>("PROFILE_0", profile);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (unsigned t = 0; t < num_threads; ++t)
+    {
+      threads.emplace_back([&profiles]() {
+        for (int i = 0; i < requests_per_thread; ++i)
+          setupPlanners(profiles);
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    done = true;
+    writer.join();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    double requests = static_cast<double>(num_threads) * requests_per_thread;
+    std::cout << "Threads: " << num_threads << ", Requests: " << requests << ", Time: " << seconds
+              << " s, Requests/s: " << requests / seconds << std::endl;
+  }
+
+  std::cout << "Execution Complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file taskflow_cache_example.cpp
+ * @brief This example compares the cost of generating a taskflow to the cost of executing it, with and without the
+ * taskflow cache
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <chrono>
+#include <iostream>
+#include <taskflow/taskflow.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <raster_example_program.h>
+#include <tesseract_environment/core/environment.h>
+#include <tesseract_environment/ofkt/ofkt_state_solver.h>
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/utils/utils.h>
+#include <tesseract_process_managers/core/process_planning_server.h>
+#include <tesseract_process_managers/core/default_process_planners.h>
+#include <tesseract_motion_planners/simple/profile/simple_planner_lvs_plan_profile.h>
+
+using namespace tesseract_planning;
+
+std::string locateResource(const std::string& url)
+{
+  std::string mod_url = url;
+  if (url.find("package://tesseract_support") == 0)
+  {
+    mod_url.erase(0, strlen("package://tesseract_support"));
+    size_t pos = mod_url.find('/');
+    if (pos == std::string::npos)
+    {
+      return std::string();
+    }
+
+    std::string package = mod_url.substr(0, pos);
+    mod_url.erase(0, pos);
+    std::string package_path = std::string(TESSERACT_SUPPORT_DIR);
+
+    if (package_path.empty())
+    {
+      return std::string();
+    }
+
+    mod_url = package_path + mod_url;
+  }
+
+  return mod_url;
+}
+
+/**
+ * @brief Run the request sequentially and report the average time per request
+ * @param planning_server The planning server
+ * @param request The request to run
+ * @param num_requests The number of times to run the request
+ * @return The average time per request in milliseconds
+ */
+double runRequests(ProcessPlanningServer& planning_server, const ProcessPlanningRequest& request, int num_requests)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < num_requests; ++i)
+  {
+    ProcessPlanningFuture response = planning_server.run(request);
+    response.wait();
+  }
+  planning_server.waitForAll();
+  auto stop = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() / num_requests;
+}
+
+int main()
+{
+  const int num_requests = 100;
+
+  // --------------------
+  // Perform setup
+  // --------------------
+  tesseract_scene_graph::ResourceLocator::Ptr locator =
+      std::make_shared<tesseract_scene_graph::SimpleResourceLocator>(locateResource);
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+  env->init<tesseract_environment::OFKTStateSolver>(urdf_path, srdf_path, locator);
+
+  // Create Process Planning Request, the simple planner is used so execution is cheap
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+  request.instructions = Instruction(rasterExampleProgram(DEFAULT_PROFILE_KEY, "PROCESS"));
+
+  // Measure the cost of generating the taskflow only
+  {
+    ProfileDictionary::Ptr profiles = std::make_shared<ProfileDictionary>();
+    TaskflowGenerator::UPtr generator = createRasterGenerator();
+    Instruction results = generateSkeletonSeed(request.instructions.as<CompositeInstruction>());
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < num_requests; ++i)
+    {
+      TaskInput input(env, &request.instructions, &results, false, profiles);
+      TaskflowContainer container = generator->generateTaskflow(input, nullptr, nullptr);
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Generate Taskflow: " << std::chrono::duration<double, std::milli>(stop - start).count() / num_requests
+              << " ms" << std::endl;
+  }
+
+  for (bool use_cache : { false, true })
+  {
+    ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env, 1), 1);
+    planning_server.loadDefaultProcessPlanners();
+
+    auto profile = std::make_shared<SimplePlannerLVSPlanProfile>();
+    planning_server.getProfiles()->addProfile<SimplePlannerPlanProfile>(DEFAULT_PROFILE_KEY, profile);
+    planning_server.getProfiles()->addProfile<SimplePlannerPlanProfile>("PROCESS", profile);
+
+    if (use_cache)
+    {
+      planning_server.enableTaskflowCache();
+      planning_server.precompileTaskflows(request);
+    }
+
+    std::cout << ((use_cache) ? "Cached" : "Generated") << " Taskflow Request: "
+              << runRequests(planning_server, request, num_requests) << " ms" << std::endl;
+  }
+
+  std::cout << "Execution Complete" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file contact_manager_pool.h
+ * @brief A pool of configured contact managers shared by the tasks of process planning requests
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_CONTACT_MANAGER_POOL_H
+#define TESSERACT_PROCESS_MANAGERS_CONTACT_MANAGER_POOL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_collision/core/discrete_contact_manager.h>
+#include <tesseract_collision/core/continuous_contact_manager.h>
+#include <tesseract_environment/core/environment.h>
+
+#ifdef SWIG
+%shared_ptr(tesseract_planning::ContactManagerPool)
+#endif  // SWIG
+
+namespace tesseract_planning
+{
+/**
+ * @brief A pool of contact managers configured for a manipulator, which are borrowed by tasks instead of cloning the
+ * collision world of the environment for every check
+ * @details The managers are keyed by the environment name and revision, the manipulator, which determines the active
+ * links, and the collision margin data. Managers of an older revision are discarded as soon as a newer revision is
+ * borrowed. The environment must not have been modified without changing its revision, so environments which had
+ * commands applied for a single request must not borrow from the pool.
+ *
+ * Borrowed managers are returned to the pool once the returned pointer and all copies of it are destroyed, which
+ * requires the pool to be owned by a shared pointer. This is thread safe.
+ */
+class ContactManagerPool : public std::enable_shared_from_this<ContactManagerPool>
+{
+public:
+  using Ptr = std::shared_ptr<ContactManagerPool>;
+  using ConstPtr = std::shared_ptr<const ContactManagerPool>;
+
+  ContactManagerPool() = default;
+  ~ContactManagerPool() = default;
+  ContactManagerPool(const ContactManagerPool&) = delete;
+  ContactManagerPool& operator=(const ContactManagerPool&) = delete;
+  ContactManagerPool(ContactManagerPool&&) = delete;
+  ContactManagerPool& operator=(ContactManagerPool&&) = delete;
+
+  /**
+   * @brief Borrow a discrete contact manager
+   * @details The active collision objects are the links moved by the manipulator and the transforms of all collision
+   * objects are set to the current state of the environment.
+   * @param env The environment
+   * @param manipulator The name of the manipulator
+   * @param margin_data The collision margin data
+   * @return The contact manager, which is returned to the pool once released
+   */
+  tesseract_collision::DiscreteContactManager::Ptr
+  borrowDiscreteContactManager(const tesseract_environment::Environment& env,
+                               const std::string& manipulator,
+                               const tesseract_collision::CollisionMarginData& margin_data);
+
+  /**
+   * @brief Borrow a continuous contact manager
+   * @details The active collision objects are the links moved by the manipulator and the transforms of all collision
+   * objects are set to the current state of the environment.
+   * @param env The environment
+   * @param manipulator The name of the manipulator
+   * @param margin_data The collision margin data
+   * @return The contact manager, which is returned to the pool once released
+   */
+  tesseract_collision::ContinuousContactManager::Ptr
+  borrowContinuousContactManager(const tesseract_environment::Environment& env,
+                                 const std::string& manipulator,
+                                 const tesseract_collision::CollisionMarginData& margin_data);
+
+  /** @brief Get the number of contact managers in the pool which are not borrowed */
+  std::size_t size() const;
+
+  /** @brief Get the number of borrowed contact managers which were taken from the pool */
+  std::size_t getHits() const;
+
+  /** @brief Get the number of borrowed contact managers which had to be created because the pool was empty */
+  std::size_t getMisses() const;
+
+  /** @brief Remove all contact managers which are not borrowed */
+  void clear();
+
+protected:
+  struct Entry
+  {
+    std::string env_name;
+    int revision{ 0 };
+    std::vector<tesseract_collision::DiscreteContactManager::Ptr> discrete;
+    std::vector<tesseract_collision::ContinuousContactManager::Ptr> continuous;
+  };
+
+  std::size_t hits_{ 0 };
+  std::size_t misses_{ 0 };
+  mutable std::mutex mutex_;
+
+  /** @brief The contact managers which are not borrowed by key */
+  std::unordered_map<std::uint64_t, Entry> entries_;
+
+  /** @brief The newest revision borrowed for each environment name */
+  std::unordered_map<std::string, int> revisions_;
+
+  /**
+   * @brief Get the key of the contact managers
+   * @param env The environment
+   * @param manipulator The name of the manipulator
+   * @param margin_data The collision margin data
+   * @param continuous Indicates if the key is for continuous contact managers
+   * @return The key
+   */
+  static std::uint64_t getKey(const tesseract_environment::Environment& env,
+                              const std::string& manipulator,
+                              const tesseract_collision::CollisionMarginData& margin_data,
+                              bool continuous);
+
+  /**
+   * @brief Take a contact manager from the pool, discarding the contact managers of older revisions
+   * @param key The key of the contact manager
+   * @param env The environment
+   * @return The contact manager, nullptr if the pool has none
+   */
+  template <typename ContactManagerPtr>
+  ContactManagerPtr take(std::uint64_t key, const tesseract_environment::Environment& env);
+
+  /**
+   * @brief Lend a contact manager, it is returned to the pool once the returned pointer and all copies are destroyed
+   * @param key The key of the contact manager
+   * @param env The environment
+   * @param manager The contact manager
+   * @return The borrowed contact manager
+   */
+  template <typename ContactManagerPtr>
+  ContactManagerPtr lend(std::uint64_t key, const tesseract_environment::Environment& env, ContactManagerPtr manager);
+
+  /**
+   * @brief Return a contact manager to the pool, it is discarded if its revision is out of date
+   * @param key The key of the contact manager
+   * @param env_name The name of the environment the contact manager was created for
+   * @param revision The revision of the environment the contact manager was created for
+   * @param manager The contact manager
+   */
+  template <typename ContactManagerPtr>
+  void giveBack(std::uint64_t key, const std::string& env_name, int revision, ContactManagerPtr manager);
+};
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_CONTACT_MANAGER_POOL_H
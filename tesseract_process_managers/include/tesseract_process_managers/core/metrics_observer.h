@@ -0,0 +1,199 @@
+/**
+ * @file metrics_observer.h
+ * @brief A taskflow observer which records task latency histograms and worker utilization
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_METRICS_OBSERVER_H
+#define TESSERACT_PROCESS_MANAGERS_METRICS_OBSERVER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <taskflow/taskflow.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/task_info.h>
+
+namespace tesseract_planning
+{
+/** @brief A histogram of durations with fixed bucket bounds */
+struct LatencyHistogram
+{
+  /** @brief The number of bounded buckets, the last bucket counts the durations above the largest bound */
+  static constexpr std::size_t BUCKET_COUNT = 18;
+
+  /**
+   * @brief Get the upper bounds of the buckets
+   * @return The upper bounds in seconds, from 100 microseconds to 60 seconds
+   */
+  static const std::array<double, BUCKET_COUNT>& getBucketBounds();
+
+  /** @brief The number of durations in each bucket, these are not cumulative */
+  std::array<std::uint64_t, BUCKET_COUNT + 1> buckets{};
+
+  /** @brief The number of durations recorded */
+  std::uint64_t count{ 0 };
+
+  /** @brief The sum of the durations in seconds */
+  double sum{ 0 };
+
+  /** @brief The maximum duration in seconds */
+  double max{ 0 };
+
+  /**
+   * @brief Record a duration
+   * @param seconds The duration in seconds
+   */
+  void record(double seconds);
+
+  /**
+   * @brief Add the durations of another histogram
+   * @param other The other histogram
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Estimate a percentile of the durations
+   * @param percentile The percentile between zero and one
+   * @return The upper bound of the bucket containing the percentile in seconds, limited to the maximum duration
+   */
+  double getPercentile(double percentile) const;
+};
+
+/** @brief The metrics of the tasks with the same name */
+struct TaskMetrics
+{
+  /** @brief The time spent running the task */
+  LatencyHistogram latency;
+
+  /** @brief The number of times the task succeeded */
+  std::uint64_t successes{ 0 };
+
+  /** @brief The number of times the task failed */
+  std::uint64_t failures{ 0 };
+};
+
+/** @brief The utilization of the workers of an executor */
+struct ExecutorMetrics
+{
+  /** @brief The name of the observer */
+  std::string name;
+
+  /** @brief The number of workers */
+  std::size_t num_workers{ 0 };
+
+  /** @brief The time in seconds the workers spent running tasks */
+  double busy_time{ 0 };
+
+  /** @brief The time in seconds since the observer was set up */
+  double elapsed_time{ 0 };
+
+  /** @brief The fraction of the available worker time spent running tasks */
+  double utilization{ 0 };
+};
+
+/**
+ * @brief A taskflow observer which records task latency histograms and worker utilization
+ * @details The latencies are recorded per task name. Each worker records into its own shard, so recording does not
+ * contend with the other workers and the shards are only merged when the metrics are requested. Task names with an
+ * index, like raster_1 or "Raster #1: description", are grouped by dropping the index.
+ *
+ * The observer can not see whether a task succeeded, so the results counted by the TaskInfoContainer of a request are
+ * recorded once it finished, see TaskInfoContainer::getTaskResults.
+ */
+class MetricsObserver : public tf::ObserverInterface
+{
+public:
+  using Ptr = std::shared_ptr<MetricsObserver>;
+  using ConstPtr = std::shared_ptr<const MetricsObserver>;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructor
+   * @param name The name given to the Observer, which is used to label the utilization of its executor
+   */
+  MetricsObserver(std::string name);
+
+  void set_up(size_t num_workers) final;
+
+  void on_entry(tf::WorkerView w, tf::TaskView tv) final;
+
+  void on_exit(tf::WorkerView w, tf::TaskView tv) final;
+
+  /**
+   * @brief Record the results of the tasks of a finished request
+   * @param task_results The results of the tasks of the request by task name
+   */
+  void recordTaskResults(const std::map<std::string, TaskResultCounts>& task_results);
+
+  /**
+   * @brief Add the recorded task metrics
+   * @param tasks The task metrics by task name which the recorded metrics are added to
+   */
+  void getTaskMetrics(std::map<std::string, TaskMetrics>& tasks) const;
+
+  /**
+   * @brief Get the utilization of the workers of the executor
+   * @return The executor metrics
+   */
+  ExecutorMetrics getExecutorMetrics() const;
+
+  /** @brief Clear the recorded metrics */
+  void clear();
+
+  /**
+   * @brief Get the name a task is grouped by
+   * @param task_name The name of the task
+   * @return The task name without its index
+   */
+  static std::string getTaskGroupName(const std::string& task_name);
+
+protected:
+  /** @brief The metrics recorded by a worker */
+  struct WorkerShard
+  {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, LatencyHistogram> latencies;
+    std::vector<Clock::time_point> entry_times;
+    double busy_time{ 0 };
+  };
+
+  std::string name_;
+  Clock::time_point start_time_;
+  std::vector<std::unique_ptr<WorkerShard>> shards_;
+
+  mutable std::mutex results_mutex_;
+  std::unordered_map<std::string, TaskResultCounts> results_;
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_METRICS_OBSERVER_H
@@ -0,0 +1,175 @@
+/**
+ * @file plan_result_cache.h
+ * @brief A cache of the results of process planning requests
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_PLAN_RESULT_CACHE_H
+#define TESSERACT_PROCESS_MANAGERS_PLAN_RESULT_CACHE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/taskflow_interface.h>
+
+#include <tesseract_motion_planners/core/types.h>
+
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/profile_dictionary.h>
+
+#include <tesseract_environment/core/environment.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A least recently used cache of the results of process planning requests, bounded by memory
+ * @details The results are keyed by a structural hash of everything the planning depends on: the process planner, the
+ * program, the seed, the profile remapping, the environment revision and state and the fingerprint of the profiles.
+ * The program and the seed are stored along with the hash and compared on lookup, so results are never returned for a
+ * different program or seed whose hash collides. The segments published while planning are stored with the results so
+ * they can be published again for a request served from the cache. This is thread safe.
+ */
+class PlanResultCache
+{
+public:
+  using Ptr = std::shared_ptr<PlanResultCache>;
+  using ConstPtr = std::shared_ptr<const PlanResultCache>;
+
+  /** @brief Identifies the results of a request */
+  struct Key
+  {
+    /** @brief The structural hash of everything the planning depends on */
+    std::uint64_t hash{ 0 };
+
+    /** @brief The formatted program of the request, compared on lookup */
+    Instruction program{ NullInstruction() };
+
+    /** @brief The seed of the request, a null instruction if not provided. This is compared on lookup. */
+    Instruction seed{ NullInstruction() };
+
+    bool operator==(const Key& rhs) const;
+    bool operator!=(const Key& rhs) const;
+  };
+
+  /** @brief The stored results of a request */
+  struct Plan
+  {
+    /** @brief The results of the request */
+    Instruction results{ NullInstruction() };
+
+    /** @brief The segments published while planning the request, without their results which are part of results */
+    std::vector<ProcessPlanningSegment> segments;
+  };
+
+  /** @param max_memory_usage The maximum estimated memory in bytes used by the stored results */
+  PlanResultCache(std::size_t max_memory_usage);
+  ~PlanResultCache() = default;
+  PlanResultCache(const PlanResultCache&) = delete;
+  PlanResultCache& operator=(const PlanResultCache&) = delete;
+  PlanResultCache(PlanResultCache&&) = delete;
+  PlanResultCache& operator=(PlanResultCache&&) = delete;
+
+  /**
+   * @brief Create the key identifying the results of a request
+   * @param name The name of the process planner
+   * @param program The formatted program of the request
+   * @param seed The seed of the request, nullptr if not provided
+   * @param plan_profile_remapping The plan profile remapping of the request
+   * @param composite_profile_remapping The composite profile remapping of the request
+   * @param env The environment the request is planned in, after the state and commands of the request were applied
+   * @param profiles_fingerprint The fingerprint of the profile dictionary, see ProfileDictionary::getFingerprint
+   * @return The key, holding a copy of the program and the seed
+   */
+  static Key getKey(const std::string& name,
+                              const CompositeInstruction& program,
+                              const Instruction* seed,
+                              const PlannerProfileRemapping& plan_profile_remapping,
+                              const PlannerProfileRemapping& composite_profile_remapping,
+                              const tesseract_environment::Environment& env,
+                              std::size_t profiles_fingerprint);
+
+  /**
+   * @brief Get the results stored for a key and mark them as most recently used
+   * @param key The key of the request
+   * @return The results and published segments, nullptr if none are stored for the hash, program and seed of the key
+   */
+  std::shared_ptr<const Plan> get(const Key& key);
+
+  /**
+   * @brief Store the results of a request, evicting the least recently used results until they fit
+   * @details Results stored for the same hash are replaced
+   * @param key The key of the request
+   * @param results The results of the request
+   * @param segments The segments published while planning the request, without their results
+   * @return False if the results are larger than the maximum memory usage, otherwise true
+   */
+  bool add(const Key& key, const Instruction& results, const std::vector<ProcessPlanningSegment>& segments = {});
+
+  /** @brief Get the number of results stored */
+  std::size_t size() const;
+
+  /** @brief Get the estimated memory in bytes used by the stored results */
+  std::size_t getMemoryUsage() const;
+
+  /** @brief Get the maximum estimated memory in bytes used by the stored results */
+  std::size_t getMaxMemoryUsage() const;
+
+  /** @brief Get the number of requests which were served from the cache */
+  std::size_t getHits() const;
+
+  /** @brief Get the number of requests which were not found in the cache */
+  std::size_t getMisses() const;
+
+  /** @brief Remove all results */
+  void clear();
+
+protected:
+  struct Entry
+  {
+    Key key;
+    std::shared_ptr<const Plan> plan;
+    std::size_t memory_usage;
+  };
+
+  std::size_t max_memory_usage_;
+  std::size_t memory_usage_{ 0 };
+  std::size_t hits_{ 0 };
+  std::size_t misses_{ 0 };
+  mutable std::mutex mutex_;
+
+  /** @brief The stored results, the most recently used first */
+  std::list<Entry> entries_;
+
+  /** @brief The stored results by the hash of their key */
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index_;
+};
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_PLAN_RESULT_CACHE_H
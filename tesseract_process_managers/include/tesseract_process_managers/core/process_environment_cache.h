@@ -28,6 +28,9 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -71,15 +74,36 @@ public:
    * @details This will first call refreshCache to ensure it has an updated tesseract then proceed
    */
   virtual tesseract_environment::Environment::Ptr getCachedEnvironment() = 0;
+
+  /**
+   * @brief Lease an Environment object from the cache
+   * @details The environment is returned to the cache once the returned pointer and all copies of it are destroyed.
+   * The default implementation does not return it.
+   */
+  virtual tesseract_environment::Environment::Ptr leaseEnvironment() { return getCachedEnvironment(); }
 };
 
-class ProcessEnvironmentCache : public EnvironmentCache
+/**
+ * @brief A cache of environment clones
+ * @details The cache is refilled in the background once the number of cached environments drops to the low watermark
+ * and when the environment revision changes, so requests only clone the environment when the cache is empty.
+ *
+ * Leased environments are returned to the cache once released unless the environment or the leased environment was
+ * modified, which requires the cache to be owned by a shared pointer.
+ */
+class ProcessEnvironmentCache : public EnvironmentCache,
+                                public std::enable_shared_from_this<ProcessEnvironmentCache>
 {
 public:
   using Ptr = std::shared_ptr<ProcessEnvironmentCache>;
   using ConstPtr = std::shared_ptr<const ProcessEnvironmentCache>;
 
   ProcessEnvironmentCache(tesseract_environment::Environment::ConstPtr env, std::size_t cache_size = 5);
+  ~ProcessEnvironmentCache() override;
+  ProcessEnvironmentCache(const ProcessEnvironmentCache&) = delete;
+  ProcessEnvironmentCache& operator=(const ProcessEnvironmentCache&) = delete;
+  ProcessEnvironmentCache(ProcessEnvironmentCache&&) = delete;
+  ProcessEnvironmentCache& operator=(ProcessEnvironmentCache&&) = delete;
 
   /**
    * @brief Set the cache size used to hold tesseract objects for motion planning
@@ -96,12 +120,41 @@ public:
   /** @brief If the environment has changed it will rebuild the cache of tesseract objects */
   void refreshCache() override;
 
+  /**
+   * @brief Set the low watermark of the cache
+   * @details The cache is refilled up to the cache size in the background once it holds this many environments
+   * @param size The low watermark
+   */
+  void setCacheLowWatermark(long size);
+
+  /**
+   * @brief Get the low watermark of the cache
+   * @return The low watermark
+   */
+  long getCacheLowWatermark() const;
+
   /**
    * @brief This will pop an Environment object from the queue
-   * @details This will first call refreshCache to ensure it has an updated tesseract then proceed
+   * @details If the cache is empty the environment is cloned. The environment is not returned to the cache.
    */
   tesseract_environment::Environment::Ptr getCachedEnvironment() override;
 
+  /**
+   * @brief Lease an Environment object from the cache
+   * @details The environment is set to the current state and returned to the cache once the returned pointer and all
+   * copies of it are destroyed, unless either environment was modified in the meantime.
+   */
+  tesseract_environment::Environment::Ptr leaseEnvironment() override;
+
+  /** @brief Get the number of requested environments which were taken from the cache */
+  std::size_t getCacheHits() const;
+
+  /** @brief Get the number of requested environments which had to be cloned because the cache was empty */
+  std::size_t getCacheMisses() const;
+
+  /** @brief Get the fraction of requested environments which were taken from the cache */
+  double getCacheHitRate() const;
+
 protected:
   /** @brief The tesseract_object used to create the cache */
   tesseract_environment::Environment::ConstPtr env_;
@@ -109,14 +162,42 @@ protected:
   /** @brief The environment revision number at the time the cache was populated */
   int cache_env_revision_{ 0 };
 
-  /** @brief The assigned cache size */
+  /** @brief The assigned cache size, this is the high watermark */
   std::size_t cache_size_{ 5 };
 
+  /** @brief The cache is refilled once it holds this many environments */
+  std::size_t cache_low_watermark_{ 2 };
+
   /** @brief A vector of cached Tesseact objects */
   std::deque<tesseract_environment::Environment::Ptr> cache_;
 
   /** @brief The mutex used when reading and writing to cache_ */
   mutable std::shared_mutex cache_mutex_;
+
+  /** @brief Used to wake the thread refilling the cache */
+  std::condition_variable_any refill_cv_;
+
+  /** @brief Indicates the refill thread should exit */
+  bool refill_stop_{ false };
+
+  /** @brief The thread refilling the cache in the background */
+  std::thread refill_thread_;
+
+  std::atomic<std::size_t> hits_{ 0 };
+  std::atomic<std::size_t> misses_{ 0 };
+
+  /** @brief Take an environment from the cache, cloning it if the cache is empty */
+  tesseract_environment::Environment::Ptr takeEnvironment();
+
+  /**
+   * @brief Return an environment to the cache
+   * @param env The environment to return
+   * @param revision The revision of the environment when it was leased
+   */
+  void returnEnvironment(tesseract_environment::Environment::Ptr env, int revision);
+
+  /** @brief The loop run by the refill thread */
+  void refill();
 };
 }  // namespace tesseract_planning
 #endif  // TESSERACT_PROCESS_MANAGERS_PROCESS_ENVIRONMENT_CACHE_H
@@ -28,6 +28,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <taskflow/taskflow.hpp>
@@ -62,6 +63,12 @@ struct ProcessPlanningFuture
   /** @brief This is used to abort the associated process and check if the process was successful */
   TaskflowInterface::Ptr interface;
 
+  /**
+   * @brief The fingerprint of the environment the process was planned in, see getEnvironmentFingerprint
+   * @details Pass this as ProcessPlanningRequest::previous_environment_fingerprint to reuse the results
+   */
+  std::uint64_t environment_fingerprint{ 0 };
+
 #ifndef SWIG
   /** @brief The stored input to the process */
   std::unique_ptr<Instruction> input;
@@ -93,7 +100,11 @@ struct ProcessPlanningFuture
 #ifdef SWIG
   %ignore taskflow_container;
 #endif  // SWIG
-  /** @brief The taskflow container returned from the TaskflowGenerator that must remain during taskflow execution */
+  /**
+   * @brief The taskflow container returned from the TaskflowGenerator that must remain during taskflow execution
+   * @details This is empty for requests run by the planning server, whose taskflow is owned by its taskflow cache or
+   * request scheduler until the taskflow finished
+   */
   TaskflowContainer taskflow_container;
 
   /** @brief Clear all content */
@@ -105,6 +116,13 @@ struct ProcessPlanningFuture
    */
   bool ready() const;
 
+  /**
+   * @brief Cancel the process
+   * @details This aborts the process and cancels the motion planners which are currently running, so the remaining
+   * tasks are skipped and the workers are released within a planner iteration. Call wait() to know when it finished.
+   */
+  void cancel();
+
   /** @brief Wait until the process has finished */
   void wait() const;
 
@@ -0,0 +1,89 @@
+/**
+ * @file process_planning_metrics.h
+ * @brief A snapshot of the metrics of a process planning server
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_PROCESS_PLANNING_METRICS_H
+#define TESSERACT_PROCESS_MANAGERS_PROCESS_PLANNING_METRICS_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <map>
+#include <string>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/metrics_observer.h>
+#include <tesseract_process_managers/core/request_scheduler.h>
+
+namespace tesseract_planning
+{
+/** @brief A snapshot of the metrics of a process planning server */
+struct ProcessPlanningMetrics
+{
+  /** @brief The task metrics by task name */
+  std::map<std::string, TaskMetrics> tasks;
+
+  /** @brief The utilization of each executor */
+  std::vector<ExecutorMetrics> executors;
+
+  /** @brief The scheduling metrics by priority class */
+  std::map<ProcessPlanningPriority, RequestSchedulerMetrics> requests;
+
+  /**
+   * @brief Convert to the Prometheus text exposition format
+   * @return The metrics in the Prometheus text format
+   */
+  std::string toPrometheus() const;
+
+  /**
+   * @brief Convert to a JSON document
+   * @return The metrics as JSON
+   */
+  std::string toJSON() const;
+
+  /**
+   * @brief Save in the Prometheus text exposition format
+   * @param filepath The file to write
+   * @return True if successful, otherwise false
+   */
+  bool savePrometheus(const std::string& filepath) const;
+
+  /**
+   * @brief Save as a JSON document
+   * @param filepath The file to write
+   * @return True if successful, otherwise false
+   */
+  bool saveJSON(const std::string& filepath) const;
+};
+
+/**
+ * @brief Get the name of a priority class
+ * @param priority The priority class
+ * @return The name in lower case
+ */
+std::string toString(ProcessPlanningPriority priority);
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_PROCESS_PLANNING_METRICS_H
@@ -28,11 +28,14 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <map>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_process_managers/core/taskflow_interface.h>
 #include <tesseract_motion_planners/core/types.h>
 
 #include <tesseract_command_language/core/instruction.h>
@@ -42,6 +45,14 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/** @brief The priority class of a process planning request, see ProcessPlanningServer::configurePriorityClass */
+enum class ProcessPlanningPriority : int
+{
+  LOW = 0,    /**< @brief Background requests which may wait for the others */
+  NORMAL = 1, /**< @brief The default priority */
+  HIGH = 2,   /**< @brief Latency critical requests */
+};
+
 struct ProcessPlanningRequest
 {
   /** @brief The name of the Process Pipeline (aka. Taskflow) to use */
@@ -53,6 +64,26 @@ struct ProcessPlanningRequest
   /** @brief This should an xml string of the command language instructions (Optional) */
   Instruction seed{ NullInstruction() };
 
+  /**
+   * @brief The program of a previous request to reuse the results of (Optional)
+   * @details The raster process planners compare the program with this one segment by segment and only plan the
+   * segments which changed, the segments around them and the segments connecting them to the rest of the program. The
+   * other segments are copied from previous_results. Everything else the planning depends on, like the process planner
+   * and the profiles, must be the same as for the previous request. Nothing is reused if the environment changed, see
+   * previous_environment_fingerprint, or if this request applies commands to the environment.
+   */
+  Instruction previous_instructions{ NullInstruction() };
+
+  /** @brief The results of the previous request, this is required if previous_instructions is provided (Optional) */
+  Instruction previous_results{ NullInstruction() };
+
+  /**
+   * @brief The environment fingerprint of the previous request, see ProcessPlanningFuture::environment_fingerprint
+   * @details This is required if previous_instructions is provided, the previous results are only reused if it matches
+   * the environment revision and state of this request (Optional)
+   */
+  std::uint64_t previous_environment_fingerprint{ 0 };
+
   /** @brief Environment state to start planning with (Optional)  */
   tesseract_environment::EnvState::ConstPtr env_state;
 
@@ -73,6 +104,42 @@ struct ProcessPlanningRequest
    * for a given motion planner. (Optional)
    */
   PlannerProfileRemapping composite_profile_remapping;
+
+  /**
+   * @brief The time by which the request must be finished (Optional)
+   * @details The remaining time is split across the stages of the taskflow and once it passes the request is aborted
+   * and TaskflowInterface::isExpired() returns true
+   */
+  CancellationToken::Clock::time_point deadline{ CancellationToken::Clock::time_point::max() };
+
+  /** @brief The priority class of the request (Optional) */
+  ProcessPlanningPriority priority{ ProcessPlanningPriority::NORMAL };
+
+  /**
+   * @brief Record a trace of the request (Optional)
+   * @details The spans of the tasks and of the stages inside the planners are saved as a Chrome trace next to the
+   * taskflow graph dump once the request finished. It can also be accessed through TaskflowInterface::getTraceRecorder.
+   */
+  bool trace{ false };
+
+  /**
+   * @brief Called with each segment of the program as soon as it finished planning (Optional)
+   * @details The raster process planners publish each raster, transition, approach, departure, from start and to end
+   * segment once its taskflow including the contact check and time parameterization finished, so execution may start
+   * before the whole program is planned. See TaskflowInterface::setSegmentCallback for the threading requirements.
+   * Segments reused from previous_results are published too. Requests served from the plan cache publish the segments
+   * of the cached results from ProcessPlanningServer::run before it returns.
+   */
+  ProcessPlanningSegmentFn segment_callback;
+
+  /**
+   * @brief How much of the inputs and outputs of each task is saved to its TaskInfo (Optional)
+   * @details TaskInfoCaptureMode::LIGHTWEIGHT saves the environment revision instead of a clone of the environment
+   */
+  TaskInfoCaptureMode task_info_capture_mode{ TaskInfoCaptureMode::NONE };
+
+  /** @brief Which TaskInfos are kept once their task finished (Optional) */
+  TaskInfoRetentionPolicy task_info_retention_policy;
 };
 
 namespace process_planner_names
@@ -28,14 +28,22 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 #include <taskflow/taskflow.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/profile_dictionary.h>
 
+#include <tesseract_process_managers/core/contact_manager_pool.h>
+#include <tesseract_process_managers/core/metrics_observer.h>
+#include <tesseract_process_managers/core/plan_result_cache.h>
 #include <tesseract_process_managers/core/process_environment_cache.h>
+#include <tesseract_process_managers/core/process_planning_metrics.h>
+#include <tesseract_process_managers/core/request_scheduler.h>
+#include <tesseract_process_managers/core/taskflow_cache.h>
 #include <tesseract_process_managers/core/taskflow_generator.h>
 #include <tesseract_process_managers/core/process_planning_request.h>
 #include <tesseract_process_managers/core/process_planning_future.h>
@@ -143,12 +151,107 @@ public:
   /** @brief Wait for all process currently being executed to finish before returning */
   void waitForAll();
 
+  /**
+   * @brief Configure how the requests of a priority class are scheduled
+   * @details By default every priority class runs on the executor of the planning server without limits. Giving the
+   * latency critical class its own threads and limiting the number of running background requests keeps long
+   * background requests from delaying the others. This should be called before requests of the class are run.
+   * @param priority The priority class
+   * @param num_threads The number of threads dedicated to the class, if zero the threads of the planning server are
+   * used
+   * @param max_active The maximum number of requests of the class running at the same time, zero for no limit
+   * @param max_queued The maximum number of requests of the class waiting to run, zero for no limit. Requests run once
+   * the queue is full are aborted.
+   */
+  void configurePriorityClass(ProcessPlanningPriority priority,
+                              std::size_t num_threads,
+                              std::size_t max_active = 0,
+                              std::size_t max_queued = 0);
+
+  /**
+   * @brief Get the scheduling metrics of a priority class
+   * @param priority The priority class
+   * @return The queue depth, admission counts and wait times of the class
+   */
+  RequestSchedulerMetrics getSchedulerMetrics(ProcessPlanningPriority priority) const;
+
+  /**
+   * @brief Get the metrics recorded since the planning server was created or the metrics were cleared
+   * @details This includes the latency histograms and results of each task, the utilization of each executor and the
+   * scheduling metrics of each priority class. The snapshot can be exported in the Prometheus text format or as JSON.
+   * @return A snapshot of the metrics
+   */
+  ProcessPlanningMetrics getMetrics() const;
+
+  /** @brief Clear the task metrics and worker utilization, the scheduling metrics are not cleared */
+  void clearMetrics();
+
   /** @brief This add a Taskflow profiling observer to the executor */
   void enableTaskflowProfiling();
 
   /** @brief This remove the Taskflow profiling observer from the executor if one exists */
   void disableTaskflowProfiling();
 
+  /**
+   * @brief Reuse the taskflows generated for previous requests with the same process planner and program structure
+   * @details Instead of generating a new taskflow for every request, the cached taskflow is rebound to the new request.
+   * This requires every registered taskflow generator to only access the request data when the tasks are executed.
+   * @param max_size The maximum number of taskflows stored for each process planner and program structure, this is the
+   * number of these requests which may run at the same time without generating a taskflow. If zero the number of
+   * threads used by the planning server is used.
+   */
+  void enableTaskflowCache(std::size_t max_size = 0);
+
+  /** @brief This removes the taskflow cache if one exists, waiting for running requests using it to finish */
+  void disableTaskflowCache();
+
+  /**
+   * @brief Return the stored results for requests identical to a previous successful request instead of planning
+   * @details A request is identical if the process planner, program, seed, profile remapping, environment revision and
+   * state and the profiles all match, see PlanResultCache. The future of a request served from the cache is ready
+   * immediately. The least recently used results are evicted once the cache exceeds its memory limit. Requests which
+   * apply commands to the environment are neither served from nor added to the cache.
+   * @param max_memory_usage The maximum estimated memory in bytes used by the stored results
+   */
+  void enablePlanCache(std::size_t max_memory_usage = 256 * 1024 * 1024);
+
+  /** @brief This removes the plan result cache if one exists */
+  void disablePlanCache();
+
+  /**
+   * @brief Get the plan result cache
+   * @return The plan result cache, nullptr if it is not enabled
+   */
+  PlanResultCache::Ptr getPlanCache() const;
+
+  /**
+   * @brief Let the contact checks of requests borrow configured contact managers from a pool shared by all requests
+   * instead of cloning the collision world of the environment for every check
+   * @details Requests which apply commands to the environment do not use the pool, see ContactManagerPool.
+   */
+  void enableContactManagerPool();
+
+  /** @brief This removes the contact manager pool if one exists */
+  void disableContactManagerPool();
+
+  /**
+   * @brief Get the contact manager pool
+   * @return The contact manager pool, nullptr if it is not enabled
+   */
+  ContactManagerPool::Ptr getContactManagerPool() const;
+
+#ifndef SWIG
+  /**
+   * @brief Generate taskflows ahead of time so requests with the same process planner and program structure do not
+   * need to generate one
+   * @details The taskflow cache must be enabled. This does not run the request.
+   * @param request A request with the process planner, program structure and seed of the requests to prepare for
+   * @param count The number of taskflows to generate
+   * @return The number of taskflows added to the cache
+   */
+  std::size_t precompileTaskflows(const ProcessPlanningRequest& request, std::size_t count = 1);
+#endif  // SWIG
+
   /**
    * @brief Get the profile dictionary associated with the planning server
    * @return Profile dictionary
@@ -166,8 +269,46 @@ protected:
   std::shared_ptr<tf::Executor> executor_;
   std::shared_ptr<tf::TFProfObserver> profile_observer_;
 
+  /** @brief The metrics observer of each executor, the first is the observer of the shared executor */
+  std::vector<MetricsObserver::Ptr> metrics_observers_;
+
   std::unordered_map<std::string, TaskflowGenerator::UPtr> process_planners_;
   ProfileDictionary::Ptr profiles_{ std::make_shared<ProfileDictionary>() };
+
+  /** @brief Schedules the requests by priority class, this must be destroyed before the executor */
+  RequestScheduler::Ptr scheduler_;
+
+  /** @brief The cached taskflows, this must be destroyed before the executor */
+  TaskflowCache::Ptr taskflow_cache_;
+
+  /** @brief The cached results of previous requests */
+  PlanResultCache::Ptr plan_cache_;
+
+  /** @brief The contact managers shared by the contact checks of the requests */
+  ContactManagerPool::Ptr contact_manager_pool_;
+
+  /** @brief Get the taskflow cache key of a request */
+  static std::string getTaskflowKey(const ProcessPlanningRequest& request,
+                                    const CompositeInstruction& program,
+                                    bool has_seed,
+                                    const std::set<std::size_t>& reused_segments);
+
+  /**
+   * @brief Copy the results of the segments which can be reused from the previous request of a request
+   * @param request The request
+   * @param generator The taskflow generator of the process planner of the request
+   * @param program The formatted program of the request
+   * @param env The environment the request is planned in
+   * @param environment_fingerprint The fingerprint of the environment, see getEnvironmentFingerprint
+   * @param results The results of the request the reused segments are copied to
+   * @return The indices of the reused segments, empty if the environment changed since the previous request
+   */
+  static std::set<std::size_t> reusePreviousResults(const ProcessPlanningRequest& request,
+                                                    const TaskflowGenerator& generator,
+                                                    const CompositeInstruction& program,
+                                                    const tesseract_environment::Environment& env,
+                                                    std::uint64_t environment_fingerprint,
+                                                    Instruction& results);
 };
 
 }  // namespace tesseract_planning
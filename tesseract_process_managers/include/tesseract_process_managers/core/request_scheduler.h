@@ -0,0 +1,204 @@
+/**
+ * @file request_scheduler.h
+ * @brief Schedules the taskflows of process planning requests by priority class
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_REQUEST_SCHEDULER_H
+#define TESSERACT_PROCESS_MANAGERS_REQUEST_SCHEDULER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <taskflow/taskflow.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/metrics_observer.h>
+#include <tesseract_process_managers/core/process_planning_request.h>
+#include <tesseract_process_managers/core/taskflow_cache.h>
+
+namespace tesseract_planning
+{
+/** @brief The scheduling metrics of a priority class */
+struct RequestSchedulerMetrics
+{
+  /** @brief The number of requests waiting for a running request to finish */
+  std::size_t queue_depth{ 0 };
+
+  /** @brief The number of requests running */
+  std::size_t active{ 0 };
+
+  /** @brief The number of requests accepted */
+  std::size_t admitted{ 0 };
+
+  /** @brief The number of requests rejected because the queue was full */
+  std::size_t rejected{ 0 };
+
+  /** @brief The number of requests finished */
+  std::size_t completed{ 0 };
+
+  /** @brief The average time in seconds between submitting and starting a request */
+  double average_wait_time{ 0 };
+
+  /** @brief The maximum time in seconds between submitting and starting a request */
+  double max_wait_time{ 0 };
+
+  /** @brief The times between submitting and starting a request */
+  LatencyHistogram wait_times;
+};
+
+/**
+ * @brief Schedules the taskflows of process planning requests by priority class
+ * @details Each priority class may run on its own executor, so long running requests of one class can not take the
+ * workers of another. A class may also limit the number of its requests running at the same time, further requests
+ * wait in a first in first out queue and are started as the running ones finish. Requests are rejected once the queue
+ * is full. This is thread safe.
+ */
+class RequestScheduler
+{
+public:
+  using Ptr = std::shared_ptr<RequestScheduler>;
+  using ConstPtr = std::shared_ptr<const RequestScheduler>;
+  using Clock = std::chrono::steady_clock;
+  using FinishedCallback = std::function<void()>;
+
+  /** @param executor The executor used by the priority classes which do not have their own */
+  RequestScheduler(std::shared_ptr<tf::Executor> executor);
+  ~RequestScheduler();
+  RequestScheduler(const RequestScheduler&) = delete;
+  RequestScheduler& operator=(const RequestScheduler&) = delete;
+  RequestScheduler(RequestScheduler&&) = delete;
+  RequestScheduler& operator=(RequestScheduler&&) = delete;
+
+  /**
+   * @brief Configure a priority class
+   * @details This should be called before requests of the class are submitted
+   * @param priority The priority class
+   * @param executor The executor running the requests of the class, if nullptr the shared executor is used
+   * @param max_active The maximum number of requests of the class running at the same time, zero for no limit
+   * @param max_queued The maximum number of requests of the class waiting to start, zero for no limit
+   */
+  void configure(ProcessPlanningPriority priority,
+                 std::shared_ptr<tf::Executor> executor,
+                 std::size_t max_active = 0,
+                 std::size_t max_queued = 0);
+
+  /**
+   * @brief Get the executor running the requests of a priority class
+   * @param priority The priority class
+   * @return The executor
+   */
+  std::shared_ptr<tf::Executor> getExecutor(ProcessPlanningPriority priority) const;
+
+  /**
+   * @brief Submit the taskflow of a request
+   * @details The input of the template is unbound once the taskflow finished. If the request is rejected its process
+   * is aborted and the returned future is ready.
+   * @param priority The priority class of the request
+   * @param taskflow_template The taskflow and its input
+   * @param taskflow_cache The cache the template was acquired from, if nullptr the scheduler owns the template until
+   * the taskflow finished
+   * @param finished_callback An optional callback called once the taskflow finished or the request was rejected,
+   * before the returned future is ready
+   * @return A future which is ready once the taskflow finished
+   */
+  std::future<void> submit(ProcessPlanningPriority priority,
+                           TaskflowTemplate::Ptr taskflow_template,
+                           TaskflowCache::Ptr taskflow_cache = nullptr,
+                           FinishedCallback finished_callback = nullptr);
+
+  /**
+   * @brief Get the metrics of a priority class
+   * @param priority The priority class
+   * @return The metrics
+   */
+  RequestSchedulerMetrics getMetrics(ProcessPlanningPriority priority) const;
+
+  /** @brief Wait until all submitted requests have finished */
+  void waitForAll();
+
+  /**
+   * @brief Set the observer which records the task results of the finished requests
+   * @param observer The observer, if nullptr the results are not recorded
+   */
+  void setMetricsObserver(MetricsObserver::Ptr observer);
+
+protected:
+  /** @brief A submitted request */
+  struct Request
+  {
+    TaskflowTemplate::Ptr taskflow_template;
+    TaskflowCache::Ptr taskflow_cache;
+    std::shared_ptr<std::promise<void>> promise;
+    Clock::time_point submitted;
+    FinishedCallback finished_callback;
+  };
+
+  /** @brief The state of a priority class */
+  struct PriorityClass
+  {
+    std::shared_ptr<tf::Executor> executor;
+    std::size_t max_active{ 0 };
+    std::size_t max_queued{ 0 };
+    std::deque<Request> queue;
+    RequestSchedulerMetrics metrics;
+    double total_wait_time{ 0 };
+  };
+
+  std::shared_ptr<tf::Executor> executor_;
+  mutable std::mutex mutex_;
+  std::condition_variable idle_cv_;
+  std::array<PriorityClass, 3> classes_;
+  MetricsObserver::Ptr metrics_observer_;
+
+  /** @brief The templates owned by the scheduler, they are destroyed once their taskflow finished */
+  std::vector<TaskflowTemplate::Ptr> running_;
+
+  /** @brief Start a request, this must be called without holding the mutex */
+  void start(const std::shared_ptr<tf::Executor>& executor, ProcessPlanningPriority priority, Request request);
+
+  /** @brief Called once the taskflow of a request finished */
+  void finished(ProcessPlanningPriority priority);
+
+  /** @brief Check if no requests are queued or running, the mutex must be held */
+  bool isIdle() const;
+
+  /** @brief Destroy the owned templates whose taskflow finished, the mutex must be held */
+  void removeFinished();
+
+  /** @brief Record that a request of a class was started, the mutex must be held */
+  static void recordStart(PriorityClass& priority_class, const Request& request);
+
+  PriorityClass& getClass(ProcessPlanningPriority priority);
+  const PriorityClass& getClass(ProcessPlanningPriority priority) const;
+};
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_REQUEST_SCHEDULER_H
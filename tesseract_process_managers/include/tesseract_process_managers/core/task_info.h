@@ -28,9 +28,11 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <deque>
 #include <memory>
 #include <shared_mutex>
 #include <map>
+#include <string>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/core/instruction.h>
@@ -45,6 +47,43 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/** @brief How much of the inputs and outputs of each task is saved to its TaskInfo */
+enum class TaskInfoCaptureMode : int
+{
+  NONE = 0,        /**< @brief Nothing is saved */
+  LIGHTWEIGHT = 1, /**< @brief The environment revision and the instructions are saved */
+  FULL = 2,        /**< @brief A clone of the environment and the instructions are saved */
+};
+
+/**
+ * @brief Which TaskInfos are kept once their task finished
+ * @details The TaskInfos of tasks which are still running are always kept. The limits apply together.
+ */
+struct TaskInfoRetentionPolicy
+{
+  /** @brief Only keep the TaskInfos of tasks which failed, so whose return value is zero */
+  bool failed_only{ false };
+
+  /** @brief The maximum number of TaskInfos kept, the oldest are removed first. Zero is unlimited */
+  std::size_t max_count{ 0 };
+
+  /**
+   * @brief The maximum estimated memory in bytes of the TaskInfos kept, the oldest are removed first. Zero is
+   * unlimited
+   */
+  std::size_t max_memory_usage{ 0 };
+};
+
+/** @brief The number of finished tasks with the same name which succeeded and failed */
+struct TaskResultCounts
+{
+  /** @brief The number of tasks which succeeded, so whose return value is not zero */
+  std::size_t successes{ 0 };
+
+  /** @brief The number of tasks which failed */
+  std::size_t failures{ 0 };
+};
+
 /** Stores information about a Task */
 class TaskInfo
 {
@@ -79,6 +118,16 @@ public:
   Instruction results_output{ NullInstruction() };
   /** @brief This is a clone of the environment at the beginning of the task (optionally set)*/
   tesseract_environment::Environment::ConstPtr environment{ nullptr };
+  /** @brief The revision of the environment at the beginning of the task (optionally set) */
+  int environment_revision{ -1 };
+
+  /**
+   * @brief Estimate the memory used by this TaskInfo
+   * @details The saved instructions are estimated as if they did not share their children, so this is an upper bound.
+   * The clone of the environment is not included.
+   * @return The estimated memory in bytes
+   */
+  virtual std::size_t estimateMemoryUsage() const;
 };
 
 /** @brief A threadsafe container for TaskInfos */
@@ -89,14 +138,54 @@ struct TaskInfoContainer
 
   void addTaskInfo(TaskInfo::ConstPtr task_info);
 
+  /**
+   * @brief Apply the retention policy to a TaskInfo once its task finished
+   * @details This is called by saveOutputs, so the TaskInfo must not be modified afterwards
+   * @param task_info The TaskInfo of the finished task
+   */
+  void finishTaskInfo(const TaskInfo::ConstPtr& task_info);
+
+  /** @note This throws if the TaskInfo was removed by the retention policy */
   TaskInfo::ConstPtr operator[](std::size_t index) const;
 
   /** @brief Get a copy of the task_info_map_ in case it gets resized*/
   std::map<std::size_t, TaskInfo::ConstPtr> getTaskInfoMap() const;
 
+  /**
+   * @brief Set how much of the inputs and outputs of each task is saved
+   * @details This must be set before the process is run. TaskInput::save_io always saves everything.
+   */
+  void setCaptureMode(TaskInfoCaptureMode mode);
+  TaskInfoCaptureMode getCaptureMode() const;
+
+  /** @brief Set which TaskInfos are kept, this must be set before the process is run */
+  void setRetentionPolicy(const TaskInfoRetentionPolicy& policy);
+  TaskInfoRetentionPolicy getRetentionPolicy() const;
+
+  /** @brief Get the estimated memory in bytes of the TaskInfos of the finished tasks which are kept */
+  std::size_t getMemoryUsage() const;
+
+  /** @brief Get the number of TaskInfos removed by the retention policy */
+  std::size_t getRemovedCount() const;
+
+  /**
+   * @brief Get the results of the finished tasks by task name
+   * @details These are counted when the task finished, so this includes the tasks whose TaskInfo was removed by the
+   * retention policy
+   */
+  std::map<std::string, TaskResultCounts> getTaskResults() const;
+
 private:
   mutable std::shared_mutex mutex_;
   std::map<std::size_t, TaskInfo::ConstPtr> task_info_map_;
+  TaskInfoCaptureMode capture_mode_{ TaskInfoCaptureMode::NONE };
+  TaskInfoRetentionPolicy retention_policy_;
+
+  /** @brief The unique IDs and estimated memory of the TaskInfos of the finished tasks, the oldest first */
+  std::deque<std::pair<std::size_t, std::size_t>> finished_;
+  std::size_t memory_usage_{ 0 };
+  std::size_t removed_count_{ 0 };
+  std::map<std::string, TaskResultCounts> task_results_;
 };
 }  // namespace tesseract_planning
 
@@ -30,7 +30,10 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <memory>
 #include <atomic>
+#include <functional>
 #include <map>
+#include <set>
+#include <taskflow/taskflow.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_process_managers/core/taskflow_interface.h>
@@ -51,12 +54,28 @@ namespace tesseract_planning
  *
  * Note that it does not have ownership of any of its members (except the pointer). This means that if a TaskInput
  * spawns a child that is a subset, it does not have to remain in scope as the references will still be valid
+ *
+ * The request data (environment, instructions, results, profiles, etc.) is shared by every copy and sub-input created
+ * from a TaskInput, so a taskflow generated for one request may be rebound to another request with the same structure
+ * (see rebind()). Generators should only access the request data when the task is executed, not when it is generated.
+ *
+ * The composite instructions of the results are unshared from any copy when the input is created or rebound, so tasks
+ * running in parallel only write to the results of their own sub-input. The composites containing those results must
+ * not be copied while the tasks are running.
  */
 struct TaskInput
 {
   using Ptr = std::shared_ptr<TaskInput>;
   using ConstPtr = std::shared_ptr<const TaskInput>;
+  using InstructionFn = std::function<Instruction()>;
+
+protected:
+  struct Data;
+
+  /** @brief The request data shared by all copies, this must be declared before the members referencing it */
+  std::shared_ptr<Data> data_;
 
+public:
   TaskInput(tesseract_environment::Environment::ConstPtr env,
             const Instruction* instruction,
             const ManipulatorInfo& manip_info,
@@ -88,7 +107,7 @@ struct TaskInput
             ProfileDictionary::ConstPtr profiles);
 
   /** @brief Tesseract associated with current state of the system */
-  const tesseract_environment::Environment::ConstPtr env;
+  const tesseract_environment::Environment::ConstPtr& env;
 
   /** @brief Global Manipulator Information */
   const ManipulatorInfo& manip_info;
@@ -106,14 +125,32 @@ struct TaskInput
   const PlannerProfileRemapping& composite_profile_remapping;
 
   /** @brief The Profiles to use */
-  const ProfileDictionary::ConstPtr profiles;
+  const ProfileDictionary::ConstPtr& profiles;
 
   /**
    * @brief This indicates if a seed was provided
    * @details In the case of the raster process planner a skeleton seed is provided which make it
    * computationaly intensive to determine if a seed was provide so this was added.
    */
-  const bool has_seed{ false };
+  const bool& has_seed;
+
+  /**
+   * @brief Rebind this input, every copy of it and every sub-input created from it to a new request
+   * @details Sub-inputs only store indices into the instructions, so the new request must have the same structure as
+   * the original. A new task interface is created for the request. This must not be called while a taskflow using
+   * this input is running.
+   */
+  void rebind(tesseract_environment::Environment::ConstPtr env,
+              const Instruction* instruction,
+              const ManipulatorInfo& manip_info,
+              const PlannerProfileRemapping& plan_profile_remapping,
+              const PlannerProfileRemapping& composite_profile_remapping,
+              Instruction* seed,
+              bool has_seed,
+              ProfileDictionary::ConstPtr profiles);
+
+  /** @brief Release the request data, the input and all of its copies must be rebound before they are used again */
+  void unbind();
 
   /**
    * @brief Creates a sub-TaskInput from instruction[index] and seed[index]
@@ -122,6 +159,16 @@ struct TaskInput
    */
   TaskInput operator[](std::size_t index);
 
+  /**
+   * @brief Create an input for the same instructions which stores its results separately
+   * @details This is used to run several planners for the same instructions at the same time. The branch has its own
+   * task interface, created with TaskflowInterface::createChild, so it can be aborted without aborting this input. The
+   * start and end instructions are resolved when the branch is created.
+   * @param results The results of the branch, which must remain valid while the branch is used
+   * @return The branch
+   */
+  TaskInput createBranch(Instruction* results) const;
+
   /**
    * @brief Gets the number of instructions contained in the TaskInput
    * @return 1 instruction if not a composite, otherwise size of the composite @todo Should this be -1, becuase
@@ -135,11 +182,20 @@ struct TaskInput
    */
   const Instruction* getInstruction() const;
 
+  /**
+   * @brief Get the indices of the instruction of this input in the instructions of the request
+   * @return The indices, empty if this is not a sub-input
+   */
+  const std::vector<std::size_t>& getInstructionIndices() const;
+
   /**
    * @brief Get the process inputs results instruction
+   * @details The composites containing the results are only read, so several sub-inputs may modify their results at
+   * the same time
    * @return A pointer to the results instruction
    */
   Instruction* getResults();
+  const Instruction* getResults() const;
 
   /**
    * @brief Gets the task interface for checking success and aborting active process
@@ -147,9 +203,21 @@ struct TaskInput
    */
   TaskflowInterface::Ptr getTaskInterface();
 
+  /**
+   * @brief Get the recorder for the time spans of the process
+   * @return The recorder, nullptr if the process is not traced
+   */
+  TraceRecorder::Ptr getTraceRecorder() const;
+
+  /**
+   * @brief Get the pool the contact checks of the process borrow their contact managers from
+   * @return The pool, nullptr if the contact managers are cloned from the environment
+   */
+  ContactManagerPool::Ptr getContactManagerPool() const;
+
   /**
    * @brief Check if process has been aborted
-   * @details This accesses the internal process interface class
+   * @details This accesses the internal process interface class and aborts the process if its deadline has passed
    * @return True if aborted otherwise false;
    */
   bool isAborted() const;
@@ -162,6 +230,13 @@ struct TaskInput
 
   void setStartInstruction(Instruction start);
   void setStartInstruction(std::vector<std::size_t> start);
+
+  /**
+   * @brief Set a function which provides the start instruction
+   * @details The function is called each time the start instruction is requested, so unlike setting the instruction
+   * directly it remains valid when the input is rebound to a new request
+   */
+  void setStartInstructionFn(InstructionFn start);
   Instruction getStartInstruction() const;
 
   void setEndInstruction(Instruction end);
@@ -172,22 +247,37 @@ struct TaskInput
   TaskInfo::ConstPtr getTaskInfo(const std::size_t& index) const;
   std::map<std::size_t, TaskInfo::ConstPtr> getTaskInfoMap() const;
 
-  /** @brief If true the task will save the inputs and outputs to the TaskInfo*/
+  /**
+   * @brief If true the task will save the inputs and outputs to the TaskInfo
+   * @details This is the same as TaskInfoCaptureMode::FULL, regardless of the capture mode of the process
+   */
   bool save_io{ false };
 
-protected:
-  /** @brief Instructions to be carried out by process */
-  const Instruction* instruction_;
+  /**
+   * @brief The executor running the task, this may be a nullptr
+   * @details This is set by the planning server so tasks may spread their own work across the executor workers
+   */
+  std::shared_ptr<tf::Executor> executor;
 
-  /** @brief Results/Seed for this process */
-  Instruction* results_;
+  /**
+   * @brief The indices of the children of the instruction whose results are reused from a previous request
+   * @details This is set by the planning server before the taskflow is generated, see
+   * TaskflowGenerator::getReusableSegments. Generators supporting this add a task which only publishes the segment
+   * instead of planning it, so a taskflow is only reused for requests reusing the same segments. It is not copied to
+   * sub-inputs.
+   */
+  std::set<std::size_t> reused_segments;
 
+protected:
   /** @brief The indicies used to access this process inputs instructions and results */
   std::vector<std::size_t> instruction_indice_;
 
   /** @brief This proccess inputs start instruction */
   Instruction start_instruction_{ NullInstruction() };
 
+  /** @brief Provides this proccess inputs start instruction */
+  InstructionFn start_instruction_fn_;
+
   /** @brief Indices to the start instruction in the results data struction */
   std::vector<std::size_t> start_instruction_indice_;
 
@@ -196,9 +286,6 @@ protected:
 
   /** @brief Indices to the end instruction in the results data struction */
   std::vector<std::size_t> end_instruction_indice_;
-
-  /** @brief Used to store if process input is aborted which is thread safe */
-  TaskflowInterface::Ptr interface_{ std::make_shared<TaskflowInterface>() };
 };
 
 }  // namespace tesseract_planning
@@ -0,0 +1,151 @@
+/**
+ * @file taskflow_cache.h
+ * @brief A cache of generated taskflows which are reused by requests with the same shape
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_PROCESS_MANAGERS_TASKFLOW_CACHE_H
+#define TESSERACT_PROCESS_MANAGERS_TASKFLOW_CACHE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/task_input.h>
+#include <tesseract_process_managers/core/taskflow_container.h>
+
+#include <tesseract_command_language/composite_instruction.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A taskflow generated for a request along with the input it was generated with
+ * @details Every task of the taskflow holds a copy of the input, so running the taskflow for another request with the
+ * same shape only requires rebinding the input (see TaskInput::rebind).
+ */
+struct TaskflowTemplate
+{
+  using Ptr = std::shared_ptr<TaskflowTemplate>;
+  using ConstPtr = std::shared_ptr<const TaskflowTemplate>;
+
+  TaskflowTemplate(std::string key, std::size_t profiles_revision, TaskInput input, TaskflowContainer container);
+  ~TaskflowTemplate();
+  TaskflowTemplate(const TaskflowTemplate&) = delete;
+  TaskflowTemplate& operator=(const TaskflowTemplate&) = delete;
+  TaskflowTemplate(TaskflowTemplate&&) = delete;
+  TaskflowTemplate& operator=(TaskflowTemplate&&) = delete;
+
+  /** @brief The key identifying the process planner and shape of the request */
+  std::string key;
+
+  /** @brief The revision of the profile dictionary when the taskflow was generated */
+  std::size_t profiles_revision;
+
+  /** @brief The input shared by all tasks of the taskflow */
+  TaskInput input;
+
+  /** @brief The generated taskflow */
+  TaskflowContainer container;
+
+  /** @brief The future of the last run, the taskflow may not be reused or destroyed until it is ready */
+  std::shared_future<void> future;
+
+  /** @brief Indicates the template was acquired and is about to be run */
+  bool acquired{ true };
+};
+
+/**
+ * @brief A cache of generated taskflows
+ * @details Generating a taskflow only depends on the process planner, the structure of the program, whether a seed was
+ * provided and the profiles, so a taskflow may be reused by any request which matches all of them. The structure of a
+ * program is which children of each composite are composites. Templates generated with an older revision of the
+ * profiles are discarded. This is thread safe.
+ */
+class TaskflowCache
+{
+public:
+  using Ptr = std::shared_ptr<TaskflowCache>;
+  using ConstPtr = std::shared_ptr<const TaskflowCache>;
+
+  /** @param max_size The maximum number of templates stored for each key */
+  TaskflowCache(std::size_t max_size);
+  ~TaskflowCache() = default;
+  TaskflowCache(const TaskflowCache&) = delete;
+  TaskflowCache& operator=(const TaskflowCache&) = delete;
+  TaskflowCache(TaskflowCache&&) = delete;
+  TaskflowCache& operator=(TaskflowCache&&) = delete;
+
+  /**
+   * @brief Create the key identifying a request
+   * @param name The name of the process planner
+   * @param program The program of the request
+   * @param has_seed Indicate if a seed was provided
+   * @return The key
+   */
+  static std::string getKey(const std::string& name, const CompositeInstruction& program, bool has_seed);
+
+  /**
+   * @brief Acquire a template which is not running
+   * @details The template must be released after it is run
+   * @param key The key of the request
+   * @param profiles_revision The current revision of the profile dictionary
+   * @return The template, nullptr if none are available
+   */
+  TaskflowTemplate::Ptr acquire(const std::string& key, std::size_t profiles_revision);
+
+  /**
+   * @brief Add an acquired template to the cache
+   * @param taskflow_template The template to add
+   * @return False if the cache already stores the maximum number of templates for the key, otherwise true
+   */
+  bool add(TaskflowTemplate::Ptr taskflow_template);
+
+  /**
+   * @brief Release an acquired template
+   * @param taskflow_template The template to release
+   * @param future The future of the run, an invalid future if it was not run
+   */
+  void release(const TaskflowTemplate::Ptr& taskflow_template, std::shared_future<void> future);
+
+  /** @brief Get the number of templates stored */
+  std::size_t size() const;
+
+  /**
+   * @brief Remove all templates
+   * @details Running templates are destroyed once they finish, so do not call this while requests are submitted
+   */
+  void clear();
+
+protected:
+  std::size_t max_size_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<TaskflowTemplate::Ptr>> templates_;
+};
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_PROCESS_MANAGERS_TASKFLOW_CACHE_H
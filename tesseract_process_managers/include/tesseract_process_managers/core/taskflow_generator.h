@@ -26,11 +26,18 @@
 #ifndef TESSERACT_PROCESS_MANAGERS_TASKFLOW_GENERATOR_H
 #define TESSERACT_PROCESS_MANAGERS_TASKFLOW_GENERATOR_H
 
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <map>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
 #include <tesseract_process_managers/core/types.h>
 #include <tesseract_process_managers/core/task_input.h>
 #include <tesseract_process_managers/core/task_generator.h>
 #include <tesseract_process_managers/core/taskflow_container.h>
 
+#include <tesseract_command_language/composite_instruction.h>
+
 namespace tesseract_planning
 {
 /** @brief Base class for generating a taskflow */
@@ -63,6 +70,20 @@ public:
                                              TaskflowVoidFn done_cb,
                                              TaskflowVoidFn error_cb) = 0;
 
+  /**
+   * @brief Find the top level segments of a program whose results can be reused from a previous program
+   * @details The planning server copies the results of these segments from the previous request and sets
+   * TaskInput::reused_segments before generating the taskflow. By default nothing is reused.
+   * @param program The formatted program
+   * @param previous_program The formatted program of the previous request
+   * @return The index of the segment of the previous program by index of the segment of the program
+   */
+  virtual std::map<std::size_t, std::size_t>
+  getReusableSegments(const CompositeInstruction& /*program*/, const CompositeInstruction& /*previous_program*/) const
+  {
+    return {};
+  }
+
   //  /**
   //   * @brief Generate a series of task assigned to the provided taskflow but not connected
   //   * @details The task generated must be attached to other tasks in the taskflow outside this function.
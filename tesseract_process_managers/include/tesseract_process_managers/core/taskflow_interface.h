@@ -29,11 +29,19 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_process_managers/core/contact_manager_pool.h>
 #include <tesseract_process_managers/core/task_info.h>
+#include <tesseract_command_language/core/instruction.h>
+#include <tesseract_command_language/null_instruction.h>
+#include <tesseract_motion_planners/core/cancellation_token.h>
+#include <tesseract_motion_planners/core/trace_recorder.h>
 
 #ifdef SWIG
 %shared_ptr(tesseract_planning::TaskflowInterface)
@@ -41,6 +49,21 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/** @brief A segment of the program which finished planning, see TaskflowInterface::setSegmentCallback */
+struct ProcessPlanningSegment
+{
+  /** @brief The indices of the segment in the program, one for each level of nested composite instructions */
+  std::vector<std::size_t> indices;
+
+  /** @brief The description of the segment */
+  std::string description;
+
+  /** @brief The results of the segment, including its contact check and time parameterization */
+  Instruction results{ NullInstruction() };
+};
+
+using ProcessPlanningSegmentFn = std::function<void(const ProcessPlanningSegment&)>;
+
 /**
  * @brief This is a thread safe class used for aborting a process along with checking if a process was succesful
  * @details If a process failed then the process has been abort by some child process
@@ -62,9 +85,100 @@ public:
    */
   bool isSuccessful() const;
 
-  /** @brief Abort the process associated with this interface */
+  /**
+   * @brief Abort the process associated with this interface
+   * @details This also cancels the motion planners which are currently running for the process
+   */
   void abort();
 
+  /**
+   * @brief Set the deadline of the process
+   * @details This must be set before the process is run
+   * @param deadline The deadline
+   */
+  void setDeadline(CancellationToken::Clock::time_point deadline);
+
+  /**
+   * @brief Get the deadline of the process
+   * @return The deadline, CancellationToken::Clock::time_point::max() if it does not have one
+   */
+  CancellationToken::Clock::time_point getDeadline() const;
+
+  /**
+   * @brief Abort the process if its deadline has passed
+   * @return True if the process was aborted, otherwise false
+   */
+  bool abortIfExpired();
+
+  /**
+   * @brief Check if the process was aborted after its deadline had passed
+   * @return True if the process ran out of time, otherwise false
+   */
+  bool isExpired() const;
+
+  /**
+   * @brief Get the token which is cancelled when the process is aborted
+   * @details This is passed to the motion planners so they stop as soon as the process is aborted
+   * @return The cancellation token
+   */
+  CancellationToken::ConstPtr getCancellationToken() const;
+
+  /**
+   * @brief Set the recorder for the time spans of the tasks and planners of the process
+   * @details This must be set before the process is run
+   * @param recorder The recorder, if nullptr nothing is recorded
+   */
+  void setTraceRecorder(TraceRecorder::Ptr recorder);
+
+  /**
+   * @brief Get the recorder for the time spans of the tasks and planners of the process
+   * @return The recorder, nullptr if the process is not traced
+   */
+  TraceRecorder::Ptr getTraceRecorder() const;
+
+  /**
+   * @brief Set the callback called with each segment of the program as soon as it finished planning
+   * @details This must be set before the process is run. The callback is called from the executor workers, possibly
+   * for several segments at the same time, so it must be thread safe and should return quickly. Segments may be
+   * published before another segment fails, so the process must still be checked once it finished.
+   * @param callback The callback, if nullptr no segments are published
+   */
+  void setSegmentCallback(ProcessPlanningSegmentFn callback);
+
+  /**
+   * @brief Check if the segments of the process are published
+   * @return True if a segment callback was set, otherwise false
+   */
+  bool hasSegmentCallback() const;
+
+  /**
+   * @brief Publish a segment of the program which finished planning to the segment callback
+   * @param segment The segment
+   */
+  void publishSegment(const ProcessPlanningSegment& segment) const;
+
+  /**
+   * @brief Set the pool the contact checks of the process borrow their contact managers from
+   * @details This must be set before the process is run. The environment of the process must not have been modified
+   * without changing its revision, see ContactManagerPool.
+   * @param pool The pool, if nullptr the contact managers are cloned from the environment
+   */
+  void setContactManagerPool(ContactManagerPool::Ptr pool);
+
+  /**
+   * @brief Get the pool the contact checks of the process borrow their contact managers from
+   * @return The pool, nullptr if the contact managers are cloned from the environment
+   */
+  ContactManagerPool::Ptr getContactManagerPool() const;
+
+  /**
+   * @brief Create an interface for a part of the process which may be aborted on its own
+   * @details The child is aborted with this interface and has the same deadline, trace recorder, segment callback,
+   * contact manager pool and TaskInfos, but aborting the child does not abort this interface.
+   * @return The child interface
+   */
+  TaskflowInterface::Ptr createChild() const;
+
   /**
    * @brief Get TaskInfo for a specific task by unique ID
    * @param index Unique ID assigned the task from taskflow
@@ -85,7 +199,20 @@ public:
   TaskInfoContainer::Ptr getTaskInfoContainer() const;
 
 protected:
-  std::atomic<bool> abort_{ false };
+  /** @brief The token cancelled when the process is aborted */
+  CancellationToken::Ptr cancellation_token_{ std::make_shared<CancellationToken>() };
+
+  /** @brief Indicates the process was aborted after its deadline had passed */
+  std::atomic<bool> expired_{ false };
+
+  /** @brief The recorder for the time spans of the process, nullptr if the process is not traced */
+  TraceRecorder::Ptr trace_recorder_;
+
+  /** @brief The callback called with each segment of the program which finished planning, may be nullptr */
+  ProcessPlanningSegmentFn segment_callback_;
+
+  /** @brief The pool of contact managers, nullptr if the contact managers are cloned from the environment */
+  ContactManagerPool::Ptr contact_manager_pool_;
 
   /** @brief Threadsafe container for TaskInfos */
   TaskInfoContainer::Ptr task_infos_{ std::make_shared<TaskInfoContainer>() };
@@ -29,14 +29,24 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+#include <taskflow/taskflow.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_process_managers/core/types.h>
+#include <tesseract_process_managers/core/task_generator.h>
 #include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/utils/hash_utils.h>
 #include <tesseract_process_managers/core/task_input.h>
 #include <tesseract_process_managers/core/task_info.h>
+#include <tesseract_motion_planners/core/utils.h>
 
 namespace tesseract_planning
 {
@@ -63,6 +73,32 @@ void failureTask(TaskInput instruction,
                  const std::string& message,
                  const TaskflowVoidFn& user_callback = nullptr);
 
+/**
+ * @brief Publish the results of a segment of the program which finished planning
+ * @details This is called from the done callback of the taskflow of the segment. Nothing is published if the process
+ * has no segment callback or was aborted, see TaskflowInterface::setSegmentCallback.
+ * @param input The process input of the segment
+ */
+void publishSegment(TaskInput input);
+
+/**
+ * @brief Add a task for a segment of the program whose results are reused from a previous request
+ * @details The planning server copied the results of the segment before the taskflow runs, see
+ * TaskInput::reused_segments, so the task only publishes the segment and reports its success. It is intended to take
+ * the place of the taskflow of the segment, so the tasks depending on the segment do not change.
+ * @param taskflow The taskflow the task is added to
+ * @param input The process input of the program
+ * @param segment_input The process input of the segment
+ * @param name The name of the process
+ * @param user_callback A user callback function called once the task runs
+ * @return The task
+ */
+tf::Task emplaceReusedSegmentTask(tf::Taskflow& taskflow,
+                                  const TaskInput& input,
+                                  const TaskInput& segment_input,
+                                  const std::string& name,
+                                  const TaskflowVoidFn& user_callback = nullptr);
+
 /**
  * @brief Check if composite is empty along with children composites
  * @param composite The composite to check
@@ -70,6 +106,70 @@ void failureTask(TaskInput instruction,
  */
 bool isCompositeEmpty(const CompositeInstruction& composite);
 
+/**
+ * @brief Check that the instructions and seed of an input do not contain trajectory segments
+ * @details The planners do not support trajectory segments yet, so they are rejected instead of being skipped. An
+ * error is logged if one is found.
+ * @param input The process input
+ * @return True if the input does not contain a trajectory segment
+ */
+bool checkNoTrajectorySegments(const TaskInput& input);
+
+/**
+ * @brief Create a function providing the start instruction of the input composite
+ * @details This is intended for TaskInput::setStartInstructionFn, so the instruction is looked up when the task runs
+ * @param input The process input of a composite instruction
+ * @return The function providing the start instruction
+ */
+TaskInput::InstructionFn startInstructionFn(TaskInput input);
+
+/**
+ * @brief Create a function providing the last plan instruction of the input composite
+ * @details This is intended for TaskInput::setStartInstructionFn, so the instruction is looked up when the task runs
+ * @param input The process input of a composite instruction
+ * @param as_start If true the plan type of the instruction is changed to START
+ * @return The function providing the last plan instruction
+ */
+TaskInput::InstructionFn lastPlanInstructionFn(TaskInput input, bool as_start = true);
+
+/**
+ * @brief Add the fingerprints of the profile overrides of an instruction and all of its children
+ * @details The profile overrides are not part of the structural hash of an instruction, see hashAppend
+ * @param hash The hash the fingerprints are added to
+ * @param instruction The instruction
+ */
+void hashProfileOverrides(StableHash& hash, const Instruction& instruction);
+void hashProfileOverrides(StableHash& hash, const CompositeInstruction& instruction);
+
+/**
+ * @brief Get the fingerprint of an environment, made of its name, revision and current state
+ * @details Commands applied to the environment change its revision but not what they did, so two environments modified
+ * by different commands of the same length have the same fingerprint.
+ * @param env The environment
+ * @return The fingerprint
+ */
+std::uint64_t getEnvironmentFingerprint(const tesseract_environment::Environment& env);
+
+/**
+ * @brief Find the segments of a raster program whose results can be reused from a previous program
+ * @details The programs alternate between raster segments and the segments connecting them, like transitions or the
+ * from start and to end segments. A raster is planned from the last plan instruction of the segment before it, so it
+ * is reused if it and the segment before it did not change, or the start instruction of the program for the first
+ * segment. Rasters are matched in order, so inserting or removing rasters only replans the segments around them. The
+ * other segments are planned between the results of the adjacent rasters, so they are only reused if they did not
+ * change and the adjacent rasters are reused and were adjacent in the previous program too.
+ *
+ * Everything else the planning depends on, like the environment and the profiles, must be the same as for the previous
+ * program.
+ * @param program The formatted program
+ * @param previous_program The formatted previous program
+ * @param first_raster The index of the first raster segment, which is zero or one
+ * @return The index of the segment of the previous program by index of the segment of the program
+ */
+std::map<std::size_t, std::size_t> getReusableRasterSegments(const CompositeInstruction& program,
+                                                             const CompositeInstruction& previous_program,
+                                                             std::size_t first_raster);
+
 /**
  * @brief Check if the input has a seed
  * @details It checks if a any composite instruction is empty in the results data structure
@@ -80,6 +180,8 @@ int hasSeedTask(TaskInput input);
 
 /**
  * @brief Saves the appropriate inputs to the TaskInfo
+ * @details What is saved depends on the capture mode of the TaskInfoContainer of the process, see
+ * TaskInfoContainer::setCaptureMode
  * @param info TaskInfo to which the inputs are saved
  * @param input TaskInput from which the inputs are taken
  */
@@ -87,11 +189,104 @@ void saveInputs(TaskInfo::Ptr info, TaskInput& input);
 
 /**
  * @brief Saves the appropriate outputs to the TaskInfo
+ * @details This must be called once the task finished, since the retention policy of the TaskInfoContainer of the
+ * process is then applied to the TaskInfo, see TaskInfoContainer::finishTaskInfo
  * @param info TaskInfo to which the outputs are saved
  * @param input TaskInput from which the outputs are taken
  */
 void saveOutputs(TaskInfo::Ptr info, TaskInput& input);
 
+/**
+ * @brief Create the contact check task generator run on the results of a taskflow
+ * @param continuous If true a ContinuousContactCheckTaskGenerator is created, otherwise a
+ * DiscreteContactCheckTaskGenerator
+ * @param parallel If true long trajectories are checked in chunks on the executor workers, see
+ * DiscreteContactCheckTaskGenerator::parallel
+ * @return The contact check task generator
+ */
+TaskGenerator::UPtr createContactCheckTaskGenerator(bool continuous, bool parallel);
+
+/**
+ * @brief Call a function for every chunk index in [0, num_chunks) spread across the executor workers
+ * @details Chunks are claimed dynamically and the calling thread processes chunks too, so this is safe to call from a
+ * task running on the same executor even when every other worker is busy. If the executor is a nullptr the chunks are
+ * processed serially on the calling thread. The first exception thrown by a chunk is rethrown once all claimed chunks
+ * have finished.
+ * @param executor The executor to spread the chunks across
+ * @param num_chunks The number of chunks
+ * @param fn The function called with each chunk index
+ */
+void parallelForChunks(const std::shared_ptr<tf::Executor>& executor,
+                       std::size_t num_chunks,
+                       const std::function<void(std::size_t)>& fn);
+
+/**
+ * @brief Perform a collision check over the trajectory split into chunks that are checked in parallel
+ * @details Each chunk is checked with its own clone of the contact manager and the contact results are merged back
+ * into timestep order. When the contact test type is FIRST, a chunk finding a contact cancels all later chunks so the
+ * result matches a serial check.
+ * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
+ * @param manager A configured contact manager which is cloned for each chunk
+ * @param state_solver The environment state solver
+ * @param program The flattened move instructions of the program to check for contacts
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param executor The executor to spread the chunks across
+ * @param num_chunks The number of chunks to split the trajectory into
+ * @return True if collision was found, otherwise false.
+ */
+template <typename ContactManagerType>
+bool contactCheckProgramParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                                 const ContactManagerType& manager,
+                                 const tesseract_environment::StateSolver& state_solver,
+                                 const std::vector<std::reference_wrapper<const Instruction>>& program,
+                                 const tesseract_collision::CollisionCheckConfig& config,
+                                 const std::shared_ptr<tf::Executor>& executor,
+                                 std::size_t num_chunks)
+{
+  num_chunks = std::max<std::size_t>(1, std::min(num_chunks, program.size()));
+  const std::size_t chunk_size = (program.size() + num_chunks - 1) / num_chunks;
+  const bool first_only = (config.contact_request.type == tesseract_collision::ContactTestType::FIRST);
+
+  std::vector<std::vector<tesseract_collision::ContactResultMap>> chunk_contacts(num_chunks);
+  std::vector<int> chunk_found(num_chunks, 0);
+  std::unique_ptr<std::atomic<bool>[]> chunk_abort(new std::atomic<bool>[num_chunks]);
+  for (std::size_t i = 0; i < num_chunks; ++i)
+    chunk_abort[i] = false;
+
+  parallelForChunks(executor, num_chunks, [&](std::size_t i) {
+    if (chunk_abort[i])
+      return;
+
+    auto chunk_manager = manager.clone();
+    const std::size_t start_step = i * chunk_size;
+    const std::size_t end_step = std::min(start_step + chunk_size, program.size());
+    if (contactCheckProgram(
+            chunk_contacts[i], *chunk_manager, state_solver, program, start_step, end_step, config, &chunk_abort[i]))
+    {
+      chunk_found[i] = 1;
+
+      // Only the earliest contact is of interest so there is no need to finish the chunks after this one
+      if (first_only)
+        for (std::size_t j = i + 1; j < num_chunks; ++j)
+          chunk_abort[j] = true;
+    }
+  });
+
+  bool found = false;
+  for (std::size_t i = 0; i < num_chunks; ++i)
+  {
+    if (chunk_found[i] == 0)
+      continue;
+
+    found = true;
+    contacts.insert(contacts.end(), chunk_contacts[i].begin(), chunk_contacts[i].end());
+    if (first_only)
+      break;
+  }
+
+  return found;
+}
+
 }  // namespace tesseract_planning
 
 #endif  // TESSERACT_PROCESS_MANAGERS_UTILS_H
@@ -54,6 +54,16 @@ public:
 
   tesseract_collision::CollisionCheckConfig config;
 
+  /**
+   * @brief If true, long trajectories are split into chunks which are checked in parallel on the executor workers
+   * @details Each chunk uses its own clone of the contact manager. This only applies when the task input provides an
+   * executor.
+   */
+  bool parallel{ false };
+
+  /** @brief The minimum number of states in a chunk when checking in parallel */
+  std::size_t min_states_per_chunk{ 200 };
+
   int conditionalProcess(TaskInput input, std::size_t unique_id) const override;
 
   void process(TaskInput input, std::size_t unique_id) const override;
@@ -68,6 +68,15 @@ struct FixStateCollisionProfile
 
   /** @brief Number of sampling attempts if TrajOpt correction fails*/
   int sampling_attempts{ 100 };
+
+  /**
+   * @brief Number of samples generated at once
+   * @details The first batch is checked for collision serially, the following batches are checked in parallel
+   */
+  int sampling_batch_size{ 16 };
+
+  /** @brief If true the collision free sample of a batch closest to the waypoint is used instead of the first one */
+  bool sampling_rank_by_distance{ false };
 };
 using FixStateCollisionProfileMap = std::unordered_map<std::string, FixStateCollisionProfile::ConstPtr>;
 
@@ -143,6 +152,8 @@ bool MoveWaypointFromCollisionTrajopt(Waypoint& waypoint,
 
 /**
  * @brief Takes a waypoint and uses random sampling to find a position that is out of collision
+ * @details The collision checking is set up once for the waypoint. The samples are generated in batches which are
+ * checked in parallel on the executor of the input, stopping at the first collision free sample.
  * @param waypoint Must be a waypoint for which getJointPosition will return a position
  * @param input Process Input associated with waypoint. Needed for kinematics, etc.
  * @param profile Profile containing needed params
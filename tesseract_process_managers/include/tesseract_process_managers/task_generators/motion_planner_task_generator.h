@@ -38,7 +38,13 @@ class MotionPlannerTaskGenerator : public TaskGenerator
 public:
   using UPtr = std::unique_ptr<MotionPlannerTaskGenerator>;
 
-  MotionPlannerTaskGenerator(std::shared_ptr<MotionPlanner> planner);
+  /**
+   * @brief Constructor
+   * @param planner The motion planner
+   * @param time_share The share of the time remaining before the deadline of the request given to the planner, the
+   * rest is left for the following tasks
+   */
+  MotionPlannerTaskGenerator(std::shared_ptr<MotionPlanner> planner, double time_share = 1.0);
   ~MotionPlannerTaskGenerator() override = default;
   MotionPlannerTaskGenerator(const MotionPlannerTaskGenerator&) = delete;
   MotionPlannerTaskGenerator& operator=(const MotionPlannerTaskGenerator&) = delete;
@@ -51,6 +57,7 @@ public:
 
 private:
   std::shared_ptr<MotionPlanner> planner_{ nullptr };
+  double time_share_{ 1.0 };
 };
 
 class MotionPlannerTaskInfo : public TaskInfo
@@ -43,7 +43,22 @@ struct CartesianTaskflowParams
 {
   bool enable_post_contact_discrete_check{ true };
   bool enable_post_contact_continuous_check{ false };
+
+  /**
+   * @brief If true long trajectories are split into chunks whose contact check runs in parallel on the executor
+   * @details See DiscreteContactCheckTaskGenerator::parallel
+   */
+  bool enable_parallel_contact_check{ false };
+
   bool enable_time_parameterization{ true };
+
+  /**
+   * @brief The share of the time remaining before the deadline of the request given to each motion planner
+   * @details The remaining time is measured when the planner starts, the rest is left for the following stages
+   */
+  double interpolator_time_share{ 0.1 };
+  double descartes_time_share{ 0.5 };
+  double trajopt_time_share{ 0.8 };
 };
 
 class CartesianTaskflow : public TaskflowGenerator
@@ -43,6 +43,7 @@ enum class FreespaceTaskflowType : int
 {
   DEFAULT = 0,       /**< @brief This will run omp followed by trajopt */
   TRAJOPT_FIRST = 1, /**< @brief This will run trajopt first then if it fails it will run ompl followed by trajopt */
+  RACE = 2,          /**< @brief This will run trajopt and ompl followed by trajopt in parallel, keeping the first */
 };
 
 struct FreespaceTaskflowParams
@@ -50,7 +51,24 @@ struct FreespaceTaskflowParams
   FreespaceTaskflowType type{ FreespaceTaskflowType::DEFAULT };
   bool enable_post_contact_discrete_check{ true };
   bool enable_post_contact_continuous_check{ false };
+
+  /**
+   * @brief If true long trajectories are split into chunks whose contact check runs in parallel on the executor
+   * @details See DiscreteContactCheckTaskGenerator::parallel
+   */
+  bool enable_parallel_contact_check{ false };
+
   bool enable_time_parameterization{ true };
+
+  /**
+   * @brief The share of the time remaining before the deadline of the request given to each motion planner
+   * @details The remaining time is measured when the planner starts, the rest is left for the following stages. The
+   * first TrajOpt stage of FreespaceTaskflowType::TRAJOPT_FIRST uses the OMPL share. The planners of
+   * FreespaceTaskflowType::RACE run at the same time, so both of its TrajOpt stages use the TrajOpt share.
+   */
+  double interpolator_time_share{ 0.1 };
+  double ompl_time_share{ 0.5 };
+  double trajopt_time_share{ 0.8 };
 };
 
 class FreespaceTaskflow : public TaskflowGenerator
@@ -79,6 +97,20 @@ private:
    * @return True if in the correct format
    */
   bool checkTaskInput(const TaskInput& input) const;
+
+  /**
+   * @brief Add the tasks racing the planners of FreespaceTaskflowType::RACE
+   * @param container The container of the taskflow
+   * @param input The process input
+   * @param seed_task The task providing the seed, which precedes the race
+   * @param error_task The task called if no planner passes
+   * @param done_task The task called if a planner passes
+   */
+  void addRaceTasks(TaskflowContainer& container,
+                    TaskInput input,
+                    tf::Task& seed_task,
+                    tf::Task& error_task,
+                    tf::Task& done_task) const;
 };
 }  // namespace tesseract_planning
 #endif  // TESSERACT_PROCESS_MANAGERS_FREESPACE_TASKFLOW_H
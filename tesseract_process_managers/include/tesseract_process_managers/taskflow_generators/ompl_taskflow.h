@@ -42,6 +42,13 @@ struct OMPLTaskflowParams
 {
   bool enable_post_contact_discrete_check{ true };
   bool enable_post_contact_continuous_check{ false };
+
+  /**
+   * @brief If true long trajectories are split into chunks whose contact check runs in parallel on the executor
+   * @details See DiscreteContactCheckTaskGenerator::parallel
+   */
+  bool enable_parallel_contact_check{ false };
+
   bool enable_time_parameterization{ true };
 };
 
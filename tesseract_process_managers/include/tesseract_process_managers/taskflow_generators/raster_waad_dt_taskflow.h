@@ -100,6 +100,9 @@ public:
 
   TaskflowContainer generateTaskflow(TaskInput input, TaskflowVoidFn done_cb, TaskflowVoidFn error_cb) override;
 
+  std::map<std::size_t, std::size_t> getReusableSegments(const CompositeInstruction& program,
+                                                         const CompositeInstruction& previous_program) const override;
+
 private:
   TaskflowGenerator::UPtr freespace_taskflow_generator_;
   TaskflowGenerator::UPtr transition_taskflow_generator_;
@@ -0,0 +1,235 @@
+/**
+ * @file contact_manager_pool.cpp
+ * @brief A pool of configured contact managers shared by the tasks of process planning requests
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/contact_manager_pool.h>
+
+#include <tesseract_command_language/utils/hash_utils.h>
+#include <tesseract_motion_planners/core/utils.h>
+
+namespace tesseract_planning
+{
+/** @brief Configure a new contact manager for the manipulator, like the contact check tasks do */
+template <typename ContactManagerType>
+static void configureContactManager(ContactManagerType& manager,
+                                    const tesseract_environment::Environment& env,
+                                    const std::string& manipulator,
+                                    const tesseract_collision::CollisionMarginData& margin_data)
+{
+  manager.setActiveCollisionObjects(getActiveLinkNames(env, manipulator));
+  manager.setCollisionMarginData(margin_data);
+
+  // The manager may outlive the environment, which may also be modified later, so it checks against a copy of the
+  // allowed collision matrix of this revision
+  auto acm = std::make_shared<const tesseract_scene_graph::AllowedCollisionMatrix>(*env.getAllowedCollisionMatrix());
+  manager.setIsContactAllowedFn(
+      [acm](const std::string& a, const std::string& b) { return acm->isCollisionAllowed(a, b); });
+}
+
+template <typename ContactManagerPtr>
+ContactManagerPtr ContactManagerPool::take(std::uint64_t key, const tesseract_environment::Environment& env)
+{
+  const std::string& env_name = env.getName();
+  const int revision = env.getRevision();
+
+  std::scoped_lock lock(mutex_);
+  auto rev_it = revisions_.find(env_name);
+  if (rev_it == revisions_.end() || rev_it->second < revision)
+  {
+    revisions_[env_name] = revision;
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+      if (it->second.env_name == env_name && it->second.revision < revision)
+        it = entries_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+  {
+    ++misses_;
+    return nullptr;
+  }
+
+  auto& managers = [&it]() -> std::vector<ContactManagerPtr>& {
+    if constexpr (std::is_same_v<ContactManagerPtr, tesseract_collision::DiscreteContactManager::Ptr>)
+      return it->second.discrete;
+    else
+      return it->second.continuous;
+  }();
+
+  if (managers.empty())
+  {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  ContactManagerPtr manager = std::move(managers.back());
+  managers.pop_back();
+  return manager;
+}
+
+template <typename ContactManagerPtr>
+ContactManagerPtr
+ContactManagerPool::lend(std::uint64_t key, const tesseract_environment::Environment& env, ContactManagerPtr manager)
+{
+  std::weak_ptr<ContactManagerPool> weak_pool = weak_from_this();
+  if (weak_pool.expired())
+    return manager;
+
+  // The borrowed manager shares ownership with a handle which returns the manager to the pool when released
+  std::shared_ptr<void> handle(
+      nullptr, [weak_pool, key, env_name = env.getName(), revision = env.getRevision(), manager](void*) mutable {
+        if (auto pool = weak_pool.lock())
+          pool->giveBack(key, env_name, revision, std::move(manager));
+      });
+
+  return ContactManagerPtr(handle, manager.get());
+}
+
+template <typename ContactManagerPtr>
+void ContactManagerPool::giveBack(std::uint64_t key,
+                                  const std::string& env_name,
+                                  int revision,
+                                  ContactManagerPtr manager)
+{
+  std::scoped_lock lock(mutex_);
+  auto rev_it = revisions_.find(env_name);
+  if (rev_it != revisions_.end() && rev_it->second > revision)
+    return;
+
+  Entry& entry = entries_[key];
+  entry.env_name = env_name;
+  entry.revision = revision;
+  if constexpr (std::is_same_v<ContactManagerPtr, tesseract_collision::DiscreteContactManager::Ptr>)
+    entry.discrete.push_back(std::move(manager));
+  else
+    entry.continuous.push_back(std::move(manager));
+}
+
+tesseract_collision::DiscreteContactManager::Ptr
+ContactManagerPool::borrowDiscreteContactManager(const tesseract_environment::Environment& env,
+                                                 const std::string& manipulator,
+                                                 const tesseract_collision::CollisionMarginData& margin_data)
+{
+  const std::uint64_t key = getKey(env, manipulator, margin_data, false);
+  auto manager = take<tesseract_collision::DiscreteContactManager::Ptr>(key, env);
+  if (manager == nullptr)
+  {
+    manager = env.getDiscreteContactManager();
+    configureContactManager(*manager, env, manipulator, margin_data);
+  }
+  else
+  {
+    manager->setCollisionObjectsTransform(env.getCurrentState()->link_transforms);
+  }
+
+  return lend(key, env, std::move(manager));
+}
+
+tesseract_collision::ContinuousContactManager::Ptr
+ContactManagerPool::borrowContinuousContactManager(const tesseract_environment::Environment& env,
+                                                   const std::string& manipulator,
+                                                   const tesseract_collision::CollisionMarginData& margin_data)
+{
+  const std::uint64_t key = getKey(env, manipulator, margin_data, true);
+  auto manager = take<tesseract_collision::ContinuousContactManager::Ptr>(key, env);
+  if (manager == nullptr)
+  {
+    manager = env.getContinuousContactManager();
+    configureContactManager(*manager, env, manipulator, margin_data);
+  }
+  else
+  {
+    manager->setCollisionObjectsTransform(env.getCurrentState()->link_transforms);
+  }
+
+  return lend(key, env, std::move(manager));
+}
+
+std::size_t ContactManagerPool::size() const
+{
+  std::scoped_lock lock(mutex_);
+  std::size_t size{ 0 };
+  for (const auto& entry : entries_)
+    size += entry.second.discrete.size() + entry.second.continuous.size();
+
+  return size;
+}
+
+std::size_t ContactManagerPool::getHits() const
+{
+  std::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+std::size_t ContactManagerPool::getMisses() const
+{
+  std::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+void ContactManagerPool::clear()
+{
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+std::uint64_t ContactManagerPool::getKey(const tesseract_environment::Environment& env,
+                                         const std::string& manipulator,
+                                         const tesseract_collision::CollisionMarginData& margin_data,
+                                         bool continuous)
+{
+  StableHash hash;
+  hash.addString(env.getName());
+  hash.addInteger(env.getRevision());
+  hash.addString(manipulator);
+  hash.addInteger((continuous) ? 1 : 0);
+  hash.addDouble(margin_data.getDefaultCollisionMargin());
+
+  // The pairs are sorted since the iteration order of an unordered map is not stable
+  const auto& pair_margins = margin_data.getPairCollisionMarginData();
+  std::vector<std::pair<std::pair<std::string, std::string>, double>> pairs(pair_margins.begin(), pair_margins.end());
+  std::sort(pairs.begin(), pairs.end());
+  hash.addUnsigned(pairs.size());
+  for (const auto& pair : pairs)
+  {
+    hash.addString(pair.first.first);
+    hash.addString(pair.first.second);
+    hash.addDouble(pair.second);
+  }
+
+  return hash.getValue();
+}
+}  // namespace tesseract_planning
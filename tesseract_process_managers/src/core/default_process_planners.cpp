@@ -40,6 +40,22 @@
 
 namespace tesseract_planning
 {
+namespace
+{
+/**
+ * @brief Create the Cartesian taskflow planning the rasters of the raster process planners
+ * @details The rasters are planned before the transitions, so its planners only get part of the remaining time and the
+ * rest is left for the transitions
+ */
+TaskflowGenerator::UPtr createRasterCartesianGenerator()
+{
+  CartesianTaskflowParams params;
+  params.descartes_time_share = 0.25;
+  params.trajopt_time_share = 0.4;
+  return std::make_unique<CartesianTaskflow>(params);
+}
+}  // namespace
+
 TaskflowGenerator::UPtr createTrajOptGenerator()
 {
   TrajOptTaskflowParams params;
@@ -78,8 +94,7 @@ TaskflowGenerator::UPtr createRasterGenerator()
   TaskflowGenerator::UPtr transition_task = std::make_unique<FreespaceTaskflow>(fparams);
 
   // Create Raster Taskflow
-  CartesianTaskflowParams cparams;
-  TaskflowGenerator::UPtr raster_task = std::make_unique<CartesianTaskflow>(cparams);
+  TaskflowGenerator::UPtr raster_task = createRasterCartesianGenerator();
 
   return std::make_unique<RasterTaskflow>(
       std::move(freespace_task), std::move(transition_task), std::move(raster_task));
@@ -92,8 +107,7 @@ TaskflowGenerator::UPtr createRasterOnlyGenerator()
   TaskflowGenerator::UPtr transition_task = std::make_unique<FreespaceTaskflow>(tparams);
 
   // Create Raster Taskflow
-  CartesianTaskflowParams cparams;
-  TaskflowGenerator::UPtr raster_task = std::make_unique<CartesianTaskflow>(cparams);
+  TaskflowGenerator::UPtr raster_task = createRasterCartesianGenerator();
 
   return std::make_unique<RasterOnlyTaskflow>(std::move(transition_task), std::move(raster_task));
 }
@@ -126,8 +140,7 @@ TaskflowGenerator::UPtr createRasterDTGenerator()
   TaskflowGenerator::UPtr transition_task = std::make_unique<FreespaceTaskflow>(fparams);
 
   // Create Raster Taskflow
-  CartesianTaskflowParams cparams;
-  TaskflowGenerator::UPtr raster_task = std::make_unique<CartesianTaskflow>(cparams);
+  TaskflowGenerator::UPtr raster_task = createRasterCartesianGenerator();
 
   return std::make_unique<RasterDTTaskflow>(
       std::move(freespace_task), std::move(transition_task), std::move(raster_task));
@@ -141,8 +154,7 @@ TaskflowGenerator::UPtr createRasterWAADGenerator()
   TaskflowGenerator::UPtr transition_task = std::make_unique<FreespaceTaskflow>(fparams);
 
   // Create Raster Taskflow
-  CartesianTaskflowParams cparams;
-  TaskflowGenerator::UPtr raster_task = std::make_unique<CartesianTaskflow>(cparams);
+  TaskflowGenerator::UPtr raster_task = createRasterCartesianGenerator();
 
   return std::make_unique<RasterWAADTaskflow>(
       std::move(freespace_task), std::move(transition_task), std::move(raster_task));
@@ -156,8 +168,7 @@ TaskflowGenerator::UPtr createRasterWAADDTGenerator()
   TaskflowGenerator::UPtr transition_task = std::make_unique<FreespaceTaskflow>(fparams);
 
   // Create Raster Taskflow
-  CartesianTaskflowParams cparams;
-  TaskflowGenerator::UPtr raster_task = std::make_unique<CartesianTaskflow>(cparams);
+  TaskflowGenerator::UPtr raster_task = createRasterCartesianGenerator();
 
   return std::make_unique<RasterWAADDTTaskflow>(
       std::move(freespace_task), std::move(transition_task), std::move(raster_task));
@@ -0,0 +1,202 @@
+/**
+ * @file metrics_observer.cpp
+ * @brief A taskflow observer which records task latency histograms and worker utilization
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/metrics_observer.h>
+
+namespace tesseract_planning
+{
+const std::array<double, LatencyHistogram::BUCKET_COUNT>& LatencyHistogram::getBucketBounds()
+{
+  static const std::array<double, BUCKET_COUNT> bounds{ 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+                                                        0.01,   0.025,   0.05,   0.1,   0.25,   0.5,
+                                                        1,      2.5,     5,      10,    25,     60 };
+  return bounds;
+}
+
+void LatencyHistogram::record(double seconds)
+{
+  const auto& bounds = getBucketBounds();
+  auto index = static_cast<std::size_t>(std::lower_bound(bounds.begin(), bounds.end(), seconds) - bounds.begin());
+  ++buckets[index];
+  ++count;
+  sum += seconds;
+  max = std::max(max, seconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (std::size_t i = 0; i < buckets.size(); ++i)
+    buckets[i] += other.buckets[i];
+
+  count += other.count;
+  sum += other.sum;
+  max = std::max(max, other.max);
+}
+
+double LatencyHistogram::getPercentile(double percentile) const
+{
+  if (count == 0)
+    return 0;
+
+  const auto& bounds = getBucketBounds();
+  auto rank = static_cast<std::uint64_t>(std::ceil(percentile * static_cast<double>(count)));
+  rank = std::max<std::uint64_t>(rank, 1);
+
+  std::uint64_t cumulative{ 0 };
+  for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+  {
+    cumulative += buckets[i];
+    if (cumulative >= rank)
+      return std::min(bounds[i], max);
+  }
+
+  return max;
+}
+
+MetricsObserver::MetricsObserver(std::string name) : name_(std::move(name)), start_time_(Clock::now()) {}
+
+void MetricsObserver::set_up(size_t num_workers)
+{
+  shards_.clear();
+  shards_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; ++i)
+    shards_.push_back(std::make_unique<WorkerShard>());
+
+  std::scoped_lock lock(results_mutex_);
+  start_time_ = Clock::now();
+}
+
+void MetricsObserver::on_entry(tf::WorkerView w, tf::TaskView /*tv*/)
+{
+  // Tasks of a subflow or module may run nested on the same worker
+  shards_[w.id()]->entry_times.push_back(Clock::now());
+}
+
+void MetricsObserver::on_exit(tf::WorkerView w, tf::TaskView tv)
+{
+  auto stop = Clock::now();
+  WorkerShard& shard = *shards_[w.id()];
+  if (shard.entry_times.empty())
+    return;
+
+  double duration = std::chrono::duration<double>(stop - shard.entry_times.back()).count();
+  shard.entry_times.pop_back();
+
+  std::scoped_lock lock(shard.mutex);
+  if (!tv.name().empty())
+    shard.latencies[tv.name()].record(duration);
+
+  // Only the outermost task counts towards the busy time
+  if (shard.entry_times.empty())
+    shard.busy_time += duration;
+}
+
+void MetricsObserver::recordTaskResults(const std::map<std::string, TaskResultCounts>& task_results)
+{
+  std::scoped_lock lock(results_mutex_);
+  for (const auto& task_result : task_results)
+  {
+    TaskResultCounts& results = results_[task_result.first];
+    results.successes += task_result.second.successes;
+    results.failures += task_result.second.failures;
+  }
+}
+
+void MetricsObserver::getTaskMetrics(std::map<std::string, TaskMetrics>& tasks) const
+{
+  for (const auto& shard : shards_)
+  {
+    std::scoped_lock lock(shard->mutex);
+    for (const auto& latency : shard->latencies)
+      tasks[getTaskGroupName(latency.first)].latency.merge(latency.second);
+  }
+
+  std::scoped_lock lock(results_mutex_);
+  for (const auto& results : results_)
+  {
+    TaskMetrics& task = tasks[getTaskGroupName(results.first)];
+    task.successes += results.second.successes;
+    task.failures += results.second.failures;
+  }
+}
+
+ExecutorMetrics MetricsObserver::getExecutorMetrics() const
+{
+  ExecutorMetrics metrics;
+  metrics.name = name_;
+  metrics.num_workers = shards_.size();
+  for (const auto& shard : shards_)
+  {
+    std::scoped_lock lock(shard->mutex);
+    metrics.busy_time += shard->busy_time;
+  }
+
+  {
+    std::scoped_lock lock(results_mutex_);
+    metrics.elapsed_time = std::chrono::duration<double>(Clock::now() - start_time_).count();
+  }
+
+  if (metrics.num_workers > 0 && metrics.elapsed_time > 0)
+    metrics.utilization = metrics.busy_time / (metrics.elapsed_time * static_cast<double>(metrics.num_workers));
+
+  return metrics;
+}
+
+void MetricsObserver::clear()
+{
+  for (const auto& shard : shards_)
+  {
+    std::scoped_lock lock(shard->mutex);
+    shard->latencies.clear();
+    shard->busy_time = 0;
+  }
+
+  std::scoped_lock lock(results_mutex_);
+  results_.clear();
+  start_time_ = Clock::now();
+}
+
+std::string MetricsObserver::getTaskGroupName(const std::string& task_name)
+{
+  // Raster and transition tasks are named like "Raster #1: description"
+  std::size_t pos = task_name.find(" #");
+  if (pos != std::string::npos && pos > 0 && pos + 2 < task_name.size() &&
+      std::isdigit(static_cast<unsigned char>(task_name[pos + 2])) != 0)
+    return task_name.substr(0, pos);
+
+  pos = task_name.find_last_not_of("0123456789");
+  if (pos == std::string::npos || pos == 0 || pos == task_name.size() - 1 || task_name[pos] != '_')
+    return task_name;
+
+  return task_name.substr(0, pos);
+}
+}  // namespace tesseract_planning
@@ -0,0 +1,189 @@
+/**
+ * @file plan_result_cache.cpp
+ * @brief A cache of the results of process planning requests
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <utility>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/plan_result_cache.h>
+#include <tesseract_process_managers/core/utils.h>
+
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/utils/hash_utils.h>
+#include <tesseract_command_language/utils/utils.h>
+
+namespace tesseract_planning
+{
+/** @brief Add the remapping sorted by key since the iteration order of an unordered map is not stable */
+static void hashAppend(StableHash& hash, const PlannerProfileRemapping& remapping)
+{
+  std::vector<std::pair<std::string, std::vector<std::pair<std::string, std::string>>>> sorted;
+  sorted.reserve(remapping.size());
+  for (const auto& planner : remapping)
+  {
+    std::vector<std::pair<std::string, std::string>> profiles(planner.second.begin(), planner.second.end());
+    std::sort(profiles.begin(), profiles.end());
+    sorted.emplace_back(planner.first, std::move(profiles));
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  hash.addUnsigned(sorted.size());
+  for (const auto& planner : sorted)
+  {
+    hash.addString(planner.first);
+    hash.addUnsigned(planner.second.size());
+    for (const auto& profile : planner.second)
+    {
+      hash.addString(profile.first);
+      hash.addString(profile.second);
+    }
+  }
+}
+
+bool PlanResultCache::Key::operator==(const Key& rhs) const
+{
+  return (hash == rhs.hash && program == rhs.program && seed == rhs.seed);
+}
+
+bool PlanResultCache::Key::operator!=(const Key& rhs) const { return !operator==(rhs); }
+
+PlanResultCache::PlanResultCache(std::size_t max_memory_usage) : max_memory_usage_(max_memory_usage) {}
+
+PlanResultCache::Key PlanResultCache::getKey(const std::string& name,
+                                      const CompositeInstruction& program,
+                                      const Instruction* seed,
+                                      const PlannerProfileRemapping& plan_profile_remapping,
+                                      const PlannerProfileRemapping& composite_profile_remapping,
+                                      const tesseract_environment::Environment& env,
+                                      std::size_t profiles_fingerprint)
+{
+  StableHash hash;
+  hash.addString(name);
+  hashAppend(hash, program);
+  hashProfileOverrides(hash, program);
+
+  hash.addInteger((seed != nullptr) ? 1 : 0);
+  if (seed != nullptr)
+    hashAppend(hash, *seed);
+
+  hashAppend(hash, plan_profile_remapping);
+  hashAppend(hash, composite_profile_remapping);
+
+  hash.addUnsigned(getEnvironmentFingerprint(env));
+  hash.addUnsigned(profiles_fingerprint);
+  return Key{ hash.getValue(), program, (seed != nullptr) ? *seed : Instruction(NullInstruction()) };
+}
+
+std::shared_ptr<const PlanResultCache::Plan> PlanResultCache::get(const Key& key)
+{
+  std::scoped_lock lock(mutex_);
+  auto it = index_.find(key.hash);
+  if (it == index_.end() || it->second->key != key)
+  {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->plan;
+}
+
+bool PlanResultCache::add(const Key& key,
+                          const Instruction& results,
+                          const std::vector<ProcessPlanningSegment>& segments)
+{
+  // The program and seed of the key usually share their children with the request, but are kept alive by the entry
+  std::size_t memory_usage =
+      estimateMemoryUsage(results) + estimateMemoryUsage(key.program) + estimateMemoryUsage(key.seed);
+  for (const auto& segment : segments)
+    memory_usage += sizeof(ProcessPlanningSegment) + segment.indices.size() * sizeof(std::size_t) +
+                    segment.description.size();
+
+  if (memory_usage > max_memory_usage_)
+    return false;
+
+  // Copy outside of the lock since this may copy the whole program
+  auto plan = std::make_shared<const Plan>(Plan{ results, segments });
+
+  std::scoped_lock lock(mutex_);
+  auto it = index_.find(key.hash);
+  if (it != index_.end())
+  {
+    memory_usage_ -= it->second->memory_usage;
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  while (!entries_.empty() && memory_usage_ + memory_usage > max_memory_usage_)
+  {
+    memory_usage_ -= entries_.back().memory_usage;
+    index_.erase(entries_.back().key.hash);
+    entries_.pop_back();
+  }
+
+  entries_.push_front(Entry{ key, std::move(plan), memory_usage });
+  index_[key.hash] = entries_.begin();
+  memory_usage_ += memory_usage;
+  return true;
+}
+
+std::size_t PlanResultCache::size() const
+{
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t PlanResultCache::getMemoryUsage() const
+{
+  std::scoped_lock lock(mutex_);
+  return memory_usage_;
+}
+
+std::size_t PlanResultCache::getMaxMemoryUsage() const { return max_memory_usage_; }
+
+std::size_t PlanResultCache::getHits() const
+{
+  std::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+std::size_t PlanResultCache::getMisses() const
+{
+  std::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+void PlanResultCache::clear()
+{
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  memory_usage_ = 0;
+}
+}  // namespace tesseract_planning
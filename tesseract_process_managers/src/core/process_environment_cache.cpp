@@ -30,59 +30,185 @@ namespace tesseract_planning
 {
 ProcessEnvironmentCache::ProcessEnvironmentCache(tesseract_environment::Environment::ConstPtr env,
                                                  std::size_t cache_size)
-  : env_(std::move(env)), cache_size_(cache_size)
+  : env_(std::move(env)), cache_env_revision_(env_->getRevision()), cache_size_(cache_size)
 {
+  refill_thread_ = std::thread([this]() { refill(); });
 }
 
-void ProcessEnvironmentCache::setCacheSize(long size)
+ProcessEnvironmentCache::~ProcessEnvironmentCache()
 {
-  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-  cache_size_ = static_cast<std::size_t>(size);
+  {
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    refill_stop_ = true;
+  }
+  refill_cv_.notify_all();
+  refill_thread_.join();
 }
 
-long ProcessEnvironmentCache::getCacheSize() const { return static_cast<long>(cache_size_); }
+void ProcessEnvironmentCache::setCacheSize(long size)
+{
+  {
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    cache_size_ = static_cast<std::size_t>(size);
+    while (cache_.size() > cache_size_)
+      cache_.pop_front();
+  }
+  refill_cv_.notify_all();
+}
 
-void ProcessEnvironmentCache::refreshCache()
+long ProcessEnvironmentCache::getCacheSize() const
 {
-  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-  tesseract_environment::Environment::Ptr env;
+  std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+  return static_cast<long>(cache_size_);
+}
 
-  int rev = env_->getRevision();
-  if (rev != cache_env_revision_ || cache_.empty())
+void ProcessEnvironmentCache::setCacheLowWatermark(long size)
+{
   {
-    env = env_->clone();
-    cache_env_revision_ = rev;
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    cache_low_watermark_ = static_cast<std::size_t>(size);
   }
+  refill_cv_.notify_all();
+}
 
-  if (env != nullptr)
+long ProcessEnvironmentCache::getCacheLowWatermark() const
+{
+  std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+  return static_cast<long>(cache_low_watermark_);
+}
+
+void ProcessEnvironmentCache::refreshCache()
+{
+  int rev = env_->getRevision();
+  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+  if (rev != cache_env_revision_)
   {
     cache_.clear();
-    for (std::size_t i = 0; i < cache_size_; ++i)
-      cache_.push_back(env->clone());
+    cache_env_revision_ = rev;
   }
-  else if (cache_.size() <= 2)
+
+  while (cache_.size() < cache_size_)
   {
-    for (std::size_t i = (cache_.size() - 1); i < cache_size_; ++i)
-      cache_.push_back(cache_.front()->clone());
+    // Clone without holding the lock so requests are not blocked
+    lock.unlock();
+    tesseract_environment::Environment::Ptr env = env_->clone();
+    lock.lock();
+
+    if (env->getRevision() != cache_env_revision_)
+    {
+      cache_.clear();
+      cache_env_revision_ = env->getRevision();
+    }
+
+    cache_.push_back(env);
   }
 }
 
-tesseract_environment::Environment::Ptr ProcessEnvironmentCache::getCachedEnvironment()
+tesseract_environment::Environment::Ptr ProcessEnvironmentCache::getCachedEnvironment() { return takeEnvironment(); }
+
+tesseract_environment::Environment::Ptr ProcessEnvironmentCache::leaseEnvironment()
 {
-  // This is to make sure the cached items are updated if needed
-  refreshCache();
+  tesseract_environment::Environment::Ptr env = takeEnvironment();
+  std::weak_ptr<ProcessEnvironmentCache> weak_cache = weak_from_this();
+  if (weak_cache.expired())
+    return env;
+
+  // The lease shares ownership with a handle which returns the environment to the cache when released
+  const int revision = env->getRevision();
+  std::shared_ptr<void> handle(nullptr, [weak_cache, env, revision](void*) mutable {
+    if (auto cache = weak_cache.lock())
+      cache->returnEnvironment(std::move(env), revision);
+  });
+
+  return tesseract_environment::Environment::Ptr(handle, env.get());
+}
+
+std::size_t ProcessEnvironmentCache::getCacheHits() const { return hits_.load(); }
 
+std::size_t ProcessEnvironmentCache::getCacheMisses() const { return misses_.load(); }
+
+double ProcessEnvironmentCache::getCacheHitRate() const
+{
+  const std::size_t hits = hits_.load();
+  const std::size_t total = hits + misses_.load();
+  return (total == 0) ? 0 : static_cast<double>(hits) / static_cast<double>(total);
+}
+
+tesseract_environment::Environment::Ptr ProcessEnvironmentCache::takeEnvironment()
+{
   tesseract_environment::EnvState current_state;
   current_state = *(env_->getCurrentState());
+  int rev = env_->getRevision();
 
-  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-  tesseract_environment::Environment::Ptr t = cache_.back();
+  tesseract_environment::Environment::Ptr t;
+  {
+    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    // The cached environments are out of date so they are cloned again in the background
+    if (rev != cache_env_revision_)
+    {
+      cache_.clear();
+      cache_env_revision_ = rev;
+    }
+
+    if (!cache_.empty())
+    {
+      t = cache_.back();
+      cache_.pop_back();
+    }
+
+    if (cache_.size() <= cache_low_watermark_)
+      refill_cv_.notify_all();
+  }
+
+  if (t != nullptr)
+  {
+    ++hits_;
+  }
+  else
+  {
+    ++misses_;
+    t = env_->clone();
+  }
 
   // Update to the current joint values
   t->setState(current_state.joints);
 
-  cache_.pop_back();
-
   return t;
 }
+
+void ProcessEnvironmentCache::returnEnvironment(tesseract_environment::Environment::Ptr env, int revision)
+{
+  // Environments which were modified while leased or are out of date are discarded
+  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+  if (env->getRevision() != revision || revision != cache_env_revision_ || cache_.size() >= cache_size_)
+    return;
+
+  cache_.push_back(std::move(env));
+}
+
+void ProcessEnvironmentCache::refill()
+{
+  std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+  while (!refill_stop_)
+  {
+    while (!refill_stop_ && cache_.size() < cache_size_)
+    {
+      // Clone without holding the lock so requests are not blocked
+      lock.unlock();
+      tesseract_environment::Environment::Ptr env = env_->clone();
+      lock.lock();
+
+      if (env->getRevision() != cache_env_revision_)
+      {
+        cache_.clear();
+        cache_env_revision_ = env->getRevision();
+      }
+
+      cache_.push_back(env);
+    }
+
+    if (!refill_stop_)
+      refill_cv_.wait(lock);
+  }
+}
 }  // namespace tesseract_planning
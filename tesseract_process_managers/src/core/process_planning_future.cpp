@@ -30,6 +30,7 @@ namespace tesseract_planning
 void ProcessPlanningFuture::clear()
 {
   interface = nullptr;
+  environment_fingerprint = 0;
   input = nullptr;
   results = nullptr;
   global_manip_info = nullptr;
@@ -43,6 +44,12 @@ bool ProcessPlanningFuture::ready() const
   return (process_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
 }
 
+void ProcessPlanningFuture::cancel()
+{
+  if (interface != nullptr)
+    interface->abort();
+}
+
 void ProcessPlanningFuture::wait() const { process_future.wait(); }
 
 std::future_status ProcessPlanningFuture::waitFor(const std::chrono::duration<double>& duration) const
@@ -0,0 +1,261 @@
+/**
+ * @file process_planning_metrics.cpp
+ * @brief A snapshot of the metrics of a process planning server
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/process_planning_metrics.h>
+
+namespace tesseract_planning
+{
+/** @brief Escape a string so it may be used as a Prometheus label value or a JSON string */
+static std::string escape(const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value)
+  {
+    if (c == '\\' || c == '"')
+    {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    }
+    else if (c == '\n')
+    {
+      escaped.append("\\n");
+    }
+    else
+    {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+/** @brief Write the samples of a histogram in the Prometheus text format */
+static void writePrometheusHistogram(std::ostream& out,
+                                     const std::string& metric,
+                                     const std::string& labels,
+                                     const LatencyHistogram& histogram)
+{
+  const auto& bounds = LatencyHistogram::getBucketBounds();
+  std::uint64_t cumulative{ 0 };
+  for (std::size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i)
+  {
+    cumulative += histogram.buckets[i];
+    out << metric << "_bucket{" << labels << ",le=\"" << bounds[i] << "\"} " << cumulative << "\n";
+  }
+  out << metric << "_bucket{" << labels << ",le=\"+Inf\"} " << histogram.count << "\n";
+  out << metric << "_sum{" << labels << "} " << histogram.sum << "\n";
+  out << metric << "_count{" << labels << "} " << histogram.count << "\n";
+}
+
+/** @brief Write a histogram as a JSON object */
+static void writeJSONHistogram(std::ostream& out, const LatencyHistogram& histogram)
+{
+  const auto& bounds = LatencyHistogram::getBucketBounds();
+  out << "{\"count\":" << histogram.count << ",\"sum\":" << histogram.sum << ",\"max\":" << histogram.max
+      << ",\"p50\":" << histogram.getPercentile(0.5) << ",\"p99\":" << histogram.getPercentile(0.99)
+      << ",\"buckets\":[";
+  for (std::size_t i = 0; i < histogram.buckets.size(); ++i)
+  {
+    if (i > 0)
+      out << ",";
+
+    out << "{\"le\":";
+    if (i < LatencyHistogram::BUCKET_COUNT)
+      out << bounds[i];
+    else
+      out << "null";
+    out << ",\"count\":" << histogram.buckets[i] << "}";
+  }
+  out << "]}";
+}
+
+std::string ProcessPlanningMetrics::toPrometheus() const
+{
+  std::ostringstream out;
+  out << std::setprecision(9);
+
+  out << "# HELP tesseract_task_duration_seconds The time spent running a task\n";
+  out << "# TYPE tesseract_task_duration_seconds histogram\n";
+  for (const auto& task : tasks)
+    writePrometheusHistogram(
+        out, "tesseract_task_duration_seconds", "task=\"" + escape(task.first) + "\"", task.second.latency);
+
+  out << "# HELP tesseract_task_results_total The number of times a task succeeded or failed\n";
+  out << "# TYPE tesseract_task_results_total counter\n";
+  for (const auto& task : tasks)
+  {
+    std::string task_label = "task=\"" + escape(task.first) + "\"";
+    out << "tesseract_task_results_total{" << task_label << ",result=\"success\"} " << task.second.successes << "\n";
+    out << "tesseract_task_results_total{" << task_label << ",result=\"failure\"} " << task.second.failures << "\n";
+  }
+
+  out << "# HELP tesseract_executor_utilization The fraction of the available worker time spent running tasks\n";
+  out << "# TYPE tesseract_executor_utilization gauge\n";
+  for (const auto& executor : executors)
+    out << "tesseract_executor_utilization{executor=\"" << escape(executor.name) << "\"} " << executor.utilization
+        << "\n";
+
+  out << "# HELP tesseract_executor_busy_seconds_total The time the workers spent running tasks\n";
+  out << "# TYPE tesseract_executor_busy_seconds_total counter\n";
+  for (const auto& executor : executors)
+    out << "tesseract_executor_busy_seconds_total{executor=\"" << escape(executor.name) << "\"} "
+        << executor.busy_time << "\n";
+
+  out << "# HELP tesseract_executor_workers The number of workers\n";
+  out << "# TYPE tesseract_executor_workers gauge\n";
+  for (const auto& executor : executors)
+    out << "tesseract_executor_workers{executor=\"" << escape(executor.name) << "\"} " << executor.num_workers
+        << "\n";
+
+  out << "# HELP tesseract_request_queue_depth The number of requests waiting to run\n";
+  out << "# TYPE tesseract_request_queue_depth gauge\n";
+  for (const auto& request : requests)
+    out << "tesseract_request_queue_depth{priority=\"" << toString(request.first) << "\"} "
+        << request.second.queue_depth << "\n";
+
+  out << "# HELP tesseract_requests_active The number of requests running\n";
+  out << "# TYPE tesseract_requests_active gauge\n";
+  for (const auto& request : requests)
+    out << "tesseract_requests_active{priority=\"" << toString(request.first) << "\"} " << request.second.active
+        << "\n";
+
+  out << "# HELP tesseract_requests_total The number of requests admitted, rejected and completed\n";
+  out << "# TYPE tesseract_requests_total counter\n";
+  for (const auto& request : requests)
+  {
+    std::string priority_label = "priority=\"" + toString(request.first) + "\"";
+    out << "tesseract_requests_total{" << priority_label << ",state=\"admitted\"} " << request.second.admitted << "\n";
+    out << "tesseract_requests_total{" << priority_label << ",state=\"rejected\"} " << request.second.rejected << "\n";
+    out << "tesseract_requests_total{" << priority_label << ",state=\"completed\"} " << request.second.completed
+        << "\n";
+  }
+
+  out << "# HELP tesseract_request_wait_seconds The time between submitting and starting a request\n";
+  out << "# TYPE tesseract_request_wait_seconds histogram\n";
+  for (const auto& request : requests)
+    writePrometheusHistogram(out,
+                             "tesseract_request_wait_seconds",
+                             "priority=\"" + toString(request.first) + "\"",
+                             request.second.wait_times);
+
+  return out.str();
+}
+
+std::string ProcessPlanningMetrics::toJSON() const
+{
+  std::ostringstream out;
+  out << std::setprecision(9);
+
+  out << "{\"tasks\":{";
+  bool first{ true };
+  for (const auto& task : tasks)
+  {
+    if (!first)
+      out << ",";
+    first = false;
+
+    out << "\"" << escape(task.first) << "\":{\"successes\":" << task.second.successes
+        << ",\"failures\":" << task.second.failures << ",\"latency\":";
+    writeJSONHistogram(out, task.second.latency);
+    out << "}";
+  }
+
+  out << "},\"executors\":[";
+  first = true;
+  for (const auto& executor : executors)
+  {
+    if (!first)
+      out << ",";
+    first = false;
+
+    out << "{\"name\":\"" << escape(executor.name) << "\",\"num_workers\":" << executor.num_workers
+        << ",\"busy_time\":" << executor.busy_time << ",\"elapsed_time\":" << executor.elapsed_time
+        << ",\"utilization\":" << executor.utilization << "}";
+  }
+
+  out << "],\"requests\":{";
+  first = true;
+  for (const auto& request : requests)
+  {
+    if (!first)
+      out << ",";
+    first = false;
+
+    const RequestSchedulerMetrics& metrics = request.second;
+    out << "\"" << toString(request.first) << "\":{\"queue_depth\":" << metrics.queue_depth
+        << ",\"active\":" << metrics.active << ",\"admitted\":" << metrics.admitted
+        << ",\"rejected\":" << metrics.rejected << ",\"completed\":" << metrics.completed
+        << ",\"average_wait_time\":" << metrics.average_wait_time << ",\"max_wait_time\":" << metrics.max_wait_time
+        << ",\"wait_times\":";
+    writeJSONHistogram(out, metrics.wait_times);
+    out << "}";
+  }
+  out << "}}";
+
+  return out.str();
+}
+
+bool ProcessPlanningMetrics::savePrometheus(const std::string& filepath) const
+{
+  std::ofstream out(filepath);
+  if (!out)
+    return false;
+
+  out << toPrometheus();
+  return static_cast<bool>(out);
+}
+
+bool ProcessPlanningMetrics::saveJSON(const std::string& filepath) const
+{
+  std::ofstream out(filepath);
+  if (!out)
+    return false;
+
+  out << toJSON();
+  return static_cast<bool>(out);
+}
+
+std::string toString(ProcessPlanningPriority priority)
+{
+  switch (priority)
+  {
+    case ProcessPlanningPriority::LOW:
+      return "low";
+    case ProcessPlanningPriority::NORMAL:
+      return "normal";
+    case ProcessPlanningPriority::HIGH:
+      return "high";
+  }
+
+  return "unknown";
+}
+}  // namespace tesseract_planning
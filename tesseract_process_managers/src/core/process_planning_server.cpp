@@ -27,12 +27,14 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
+#include <mutex>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_process_managers/core/task_info.h>
 #include <tesseract_process_managers/core/process_planning_server.h>
-#include <tesseract_process_managers/core/debug_observer.h>
 #include <tesseract_process_managers/core/default_process_planners.h>
+#include <tesseract_process_managers/core/utils.h>
 
 #include <tesseract_motion_planners/descartes/profile/descartes_profile.h>
 #include <tesseract_motion_planners/trajopt/profile/trajopt_profile.h>
@@ -45,11 +47,34 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+namespace
+{
+/** @brief The segments published while planning a request, without their results */
+struct PublishedSegments
+{
+  std::mutex mutex;
+  std::vector<ProcessPlanningSegment> segments;
+};
+
+/** @brief Get the results of a segment from the results of the program, see ProcessPlanningSegment::indices */
+const Instruction& getSegmentResults(const Instruction& results, const std::vector<std::size_t>& indices)
+{
+  const Instruction* instruction = &results;
+  for (std::size_t index : indices)
+    instruction = &(instruction->as<CompositeInstruction>().at(index));
+
+  return *instruction;
+}
+}  // namespace
+
 ProcessPlanningServer::ProcessPlanningServer(EnvironmentCache::Ptr cache, size_t n)
-  : cache_(std::move(cache)), executor_(std::make_shared<tf::Executor>(n))
+  : cache_(std::move(cache))
+  , executor_(std::make_shared<tf::Executor>(n))
+  , scheduler_(std::make_shared<RequestScheduler>(executor_))
 {
   /** @todo Need to figure out if these can associated with an individual run versus global */
-  executor_->make_observer<DebugObserver>("ProcessPlanningObserver");
+  metrics_observers_.push_back(executor_->make_observer<MetricsObserver>("ProcessPlanningObserver"));
+  scheduler_->setMetricsObserver(metrics_observers_.front());
 }
 
 ProcessPlanningServer::ProcessPlanningServer(tesseract_environment::Environment::ConstPtr environment,
@@ -57,9 +82,11 @@ ProcessPlanningServer::ProcessPlanningServer(tesseract_environment::Environment:
                                              size_t n)
   : cache_(std::make_shared<ProcessEnvironmentCache>(environment, cache_size))
   , executor_(std::make_shared<tf::Executor>(n))
+  , scheduler_(std::make_shared<RequestScheduler>(executor_))
 {
   /** @todo Need to figure out if these can associated with an individual run versus global */
-  executor_->make_observer<DebugObserver>("ProcessPlanningObserver");
+  metrics_observers_.push_back(executor_->make_observer<MetricsObserver>("ProcessPlanningObserver"));
+  scheduler_->setMetricsObserver(metrics_observers_.front());
 }
 
 void ProcessPlanningServer::registerProcessPlanner(const std::string& name, TaskflowGenerator::UPtr generator)
@@ -68,6 +95,14 @@ void ProcessPlanningServer::registerProcessPlanner(const std::string& name, Task
     CONSOLE_BRIDGE_logDebug("Process planner %s already exist so replacing with new generator.", name.c_str());
 
   process_planners_[name] = std::move(generator);
+
+  // The cached taskflows may have been generated by the replaced generator
+  if (taskflow_cache_ != nullptr)
+    taskflow_cache_->clear();
+
+  // The cached results may have been planned by the replaced generator
+  if (plan_cache_ != nullptr)
+    plan_cache_->clear();
 }
 
 void ProcessPlanningServer::loadDefaultProcessPlanners()
@@ -139,7 +174,18 @@ ProcessPlanningFuture ProcessPlanningServer::run(const ProcessPlanningRequest& r
     return response;
   }
 
-  tesseract_environment::Environment::Ptr tc = cache_->getCachedEnvironment();
+  // The planners do not support trajectory segments yet. This is checked here because a cached taskflow is reused
+  // without checking its input again.
+  if (hasTrajectorySegment(composite_program) ||
+      (has_seed && isCompositeInstruction(request.seed) &&
+       hasTrajectorySegment(request.seed.as<CompositeInstruction>())))
+  {
+    CONSOLE_BRIDGE_logError("Tesseract Planning Server: Trajectory segments are not supported by the planners!");
+    return response;
+  }
+
+  // The environment is returned to the cache once the request has finished
+  tesseract_environment::Environment::Ptr tc = cache_->leaseEnvironment();
 
   // Set the env state if provided
   if (request.env_state != nullptr)
@@ -157,34 +203,292 @@ ProcessPlanningFuture ProcessPlanningServer::run(const ProcessPlanningRequest& r
     return response;
   }
 
-  TaskInput task_input(tc,
-                       response.input.get(),
-                       *(response.global_manip_info),
-                       *(response.plan_profile_remapping),
-                       *(response.composite_profile_remapping),
-                       response.results.get(),
-                       has_seed,
-                       profiles_);
-  response.interface = task_input.getTaskInterface();
-  response.taskflow_container = it->second->generateTaskflow(task_input, nullptr, nullptr);
+  response.environment_fingerprint = getEnvironmentFingerprint(*tc);
+
+  // Return the results of an identical successful request without planning. The commands of a request modify the
+  // leased environment without a revision the cache could tell apart, so such requests are never cached.
+  PlanResultCache::Ptr plan_cache = (request.commands.empty()) ? plan_cache_ : nullptr;
+  PlanResultCache::Key plan_key;
+  std::size_t profiles_fingerprint{ 0 };
+  if (plan_cache != nullptr)
+  {
+    profiles_fingerprint = profiles_->getFingerprint();
+    plan_key = PlanResultCache::getKey(request.name,
+                                       composite_program,
+                                       (has_seed) ? &request.seed : nullptr,
+                                       request.plan_profile_remapping,
+                                       request.composite_profile_remapping,
+                                       *tc,
+                                       profiles_fingerprint);
+
+    std::shared_ptr<const PlanResultCache::Plan> cached_plan = plan_cache->get(plan_key);
+    if (cached_plan != nullptr)
+    {
+      CONSOLE_BRIDGE_logInform("Tesseract Planning Server: Returning cached results!");
+      *(response.results) = cached_plan->results;
+
+      // Publish the segments which were published while planning the cached results
+      if (request.segment_callback)
+      {
+        for (ProcessPlanningSegment segment : cached_plan->segments)
+        {
+          segment.results = getSegmentResults(*(response.results), segment.indices);
+          request.segment_callback(segment);
+        }
+      }
+
+      response.interface = std::make_shared<TaskflowInterface>();
+      std::promise<void> promise;
+      promise.set_value();
+      response.process_future = promise.get_future();
+      return response;
+    }
+  }
+
+  // Copy the results of the segments which did not change since the previous request instead of planning them
+  std::set<std::size_t> reused_segments;
+  if (!isNullInstruction(request.previous_instructions))
+    reused_segments = reusePreviousResults(request,
+                                           *(it->second),
+                                           composite_program,
+                                           *tc,
+                                           response.environment_fingerprint,
+                                           *(response.results));
+
+  // Tracing is opt-in since every task and planner stage records a span
+  auto request_start = TraceRecorder::Clock::now();
+  TraceRecorder::Ptr trace_recorder = (request.trace) ? std::make_shared<TraceRecorder>() : nullptr;
+
+  // Reuse a cached taskflow if one is available, the revision must be read before generating a new one
+  const std::size_t profiles_revision = profiles_->getRevision();
+  TaskflowCache::Ptr taskflow_cache = taskflow_cache_;
+  std::string key;
+  TaskflowTemplate::Ptr taskflow_template;
+  if (taskflow_cache != nullptr)
+  {
+    key = getTaskflowKey(request, composite_program, has_seed, reused_segments);
+    taskflow_template = taskflow_cache->acquire(key, profiles_revision);
+  }
+
+  bool cached{ true };
+  if (taskflow_template != nullptr)
+  {
+    taskflow_template->input.rebind(tc,
+                                    response.input.get(),
+                                    *(response.global_manip_info),
+                                    *(response.plan_profile_remapping),
+                                    *(response.composite_profile_remapping),
+                                    response.results.get(),
+                                    has_seed,
+                                    profiles_);
+  }
+  else
+  {
+    TaskInput task_input(tc,
+                         response.input.get(),
+                         *(response.global_manip_info),
+                         *(response.plan_profile_remapping),
+                         *(response.composite_profile_remapping),
+                         response.results.get(),
+                         has_seed,
+                         profiles_);
+    task_input.executor = scheduler_->getExecutor(request.priority);
+    task_input.reused_segments = reused_segments;
+    TaskflowContainer container = it->second->generateTaskflow(task_input, nullptr, nullptr);
+    taskflow_template =
+        std::make_shared<TaskflowTemplate>(key, profiles_revision, std::move(task_input), std::move(container));
+    cached = (taskflow_cache != nullptr && taskflow_cache->add(taskflow_template));
+  }
+
+  response.interface = taskflow_template->input.getTaskInterface();
+  response.interface->setDeadline(request.deadline);
+  response.interface->setTraceRecorder(trace_recorder);
+
+  // The indices of the published segments are stored with the results, so they can be published for a cache hit
+  auto published_segments = std::make_shared<PublishedSegments>();
+  if (plan_cache != nullptr)
+  {
+    response.interface->setSegmentCallback(
+        [published_segments, callback = request.segment_callback](const ProcessPlanningSegment& segment) {
+          ProcessPlanningSegment published;
+          published.indices = segment.indices;
+          published.description = segment.description;
+          {
+            std::scoped_lock lock(published_segments->mutex);
+            published_segments->segments.push_back(std::move(published));
+          }
+
+          if (callback)
+            callback(segment);
+        });
+  }
+  else
+  {
+    response.interface->setSegmentCallback(request.segment_callback);
+  }
+
+  response.interface->getTaskInfoContainer()->setCaptureMode(request.task_info_capture_mode);
+  response.interface->getTaskInfoContainer()->setRetentionPolicy(request.task_info_retention_policy);
+
+  // The commands of the request modify the leased environment without a revision the pool could tell apart
+  response.interface->setContactManagerPool((request.commands.empty()) ? contact_manager_pool_ : nullptr);
+  tf::Taskflow& taskflow = *(taskflow_template->container.taskflow);
+
+  if (trace_recorder != nullptr)
+    trace_recorder->record("Prepare Taskflow", "request", request_start, TraceRecorder::Clock::now());
 
   // Dump taskflow graph before running
+  const std::string filepath_prefix =
+      tesseract_common::getTempPath() + request.name + "-" + tesseract_common::getTimestampString();
   if (console_bridge::getLogLevel() == console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_DEBUG)
   {
     std::ofstream out_data;
-    out_data.open(tesseract_common::getTempPath() + request.name + "-" + tesseract_common::getTimestampString() +
-                  ".dot");
-    response.taskflow_container.taskflow->dump(out_data);
+    out_data.open(filepath_prefix + ".dot");
+    taskflow.dump(out_data);
     out_data.close();
   }
 
-  response.process_future = executor_->run(*(response.taskflow_container.taskflow));
+  // Store the results and save the trace next to the taskflow graph once the request finished
+  RequestScheduler::FinishedCallback finished_callback;
+  if (trace_recorder != nullptr || plan_cache != nullptr)
+  {
+    finished_callback = [trace_recorder,
+                         request_start,
+                         name = request.name,
+                         filepath = filepath_prefix + ".json",
+                         plan_cache,
+                         plan_key,
+                         published_segments,
+                         profiles = profiles_,
+                         profiles_fingerprint,
+                         interface = response.interface,
+                         results = response.results.get()]() {
+      // The results are only stored if the profiles were not modified while planning
+      if (plan_cache != nullptr && interface->isSuccessful() && profiles->getFingerprint() == profiles_fingerprint)
+      {
+        std::scoped_lock lock(published_segments->mutex);
+        plan_cache->add(plan_key, *results, published_segments->segments);
+      }
+
+      if (trace_recorder == nullptr)
+        return;
+
+      trace_recorder->record("Request: " + name, "request", request_start, TraceRecorder::Clock::now());
+      if (trace_recorder->save(filepath))
+        CONSOLE_BRIDGE_logInform("Tesseract Planning Server: Saved request trace to %s", filepath.c_str());
+      else
+        CONSOLE_BRIDGE_logError("Tesseract Planning Server: Failed to save request trace to %s", filepath.c_str());
+    };
+  }
+
+  // The request data, including the leased environment, is released as soon as the last task has finished
+  response.process_future = scheduler_->submit(request.priority,
+                                                std::move(taskflow_template),
+                                                (cached) ? taskflow_cache : nullptr,
+                                                std::move(finished_callback));
   return response;
 }
 
+std::size_t ProcessPlanningServer::precompileTaskflows(const ProcessPlanningRequest& request, std::size_t count)
+{
+  if (taskflow_cache_ == nullptr)
+  {
+    CONSOLE_BRIDGE_logError("Taskflows can only be precompiled when the taskflow cache is enabled!");
+    return 0;
+  }
+
+  auto it = process_planners_.find(request.name);
+  if (it == process_planners_.end())
+  {
+    CONSOLE_BRIDGE_logError("Requested motion Process Pipeline (aka. Taskflow) is not supported!");
+    return 0;
+  }
+
+  const auto& composite_program = request.instructions.as<CompositeInstruction>();
+  const bool has_seed = !isNullInstruction(request.seed);
+  Instruction results = (has_seed) ? request.seed : generateSkeletonSeed(composite_program);
+  const std::string key = getTaskflowKey(request, composite_program, has_seed, {});
+  const std::size_t profiles_revision = profiles_->getRevision();
+
+  std::size_t added{ 0 };
+  for (; added < count; ++added)
+  {
+    TaskInput task_input(cache_->leaseEnvironment(),
+                         &request.instructions,
+                         composite_program.getManipulatorInfo(),
+                         request.plan_profile_remapping,
+                         request.composite_profile_remapping,
+                         &results,
+                         has_seed,
+                         profiles_);
+    task_input.executor = scheduler_->getExecutor(request.priority);
+    TaskflowContainer container = it->second->generateTaskflow(task_input, nullptr, nullptr);
+    task_input.unbind();
+
+    auto taskflow_template =
+        std::make_shared<TaskflowTemplate>(key, profiles_revision, std::move(task_input), std::move(container));
+    if (!taskflow_cache_->add(taskflow_template))
+      break;
+
+    taskflow_cache_->release(taskflow_template, std::shared_future<void>());
+  }
+
+  return added;
+}
+
 std::future<void> ProcessPlanningServer::run(tf::Taskflow& taskflow) { return executor_->run(taskflow); }
 
-void ProcessPlanningServer::waitForAll() { executor_->wait_for_all(); }
+void ProcessPlanningServer::waitForAll()
+{
+  scheduler_->waitForAll();
+  executor_->wait_for_all();
+}
+
+void ProcessPlanningServer::configurePriorityClass(ProcessPlanningPriority priority,
+                                                   std::size_t num_threads,
+                                                   std::size_t max_active,
+                                                   std::size_t max_queued)
+{
+  std::shared_ptr<tf::Executor> executor;
+  if (num_threads > 0)
+  {
+    executor = std::make_shared<tf::Executor>(num_threads);
+    metrics_observers_.push_back(
+        executor->make_observer<MetricsObserver>("ProcessPlanningObserver_" + toString(priority)));
+  }
+
+  // The cached taskflows are bound to the executor of their priority class
+  if (taskflow_cache_ != nullptr)
+    taskflow_cache_->clear();
+
+  scheduler_->configure(priority, std::move(executor), max_active, max_queued);
+}
+
+RequestSchedulerMetrics ProcessPlanningServer::getSchedulerMetrics(ProcessPlanningPriority priority) const
+{
+  return scheduler_->getMetrics(priority);
+}
+
+ProcessPlanningMetrics ProcessPlanningServer::getMetrics() const
+{
+  ProcessPlanningMetrics metrics;
+  for (const auto& observer : metrics_observers_)
+  {
+    observer->getTaskMetrics(metrics.tasks);
+    metrics.executors.push_back(observer->getExecutorMetrics());
+  }
+
+  for (auto priority : { ProcessPlanningPriority::LOW, ProcessPlanningPriority::NORMAL, ProcessPlanningPriority::HIGH })
+    metrics.requests[priority] = scheduler_->getMetrics(priority);
+
+  return metrics;
+}
+
+void ProcessPlanningServer::clearMetrics()
+{
+  for (const auto& observer : metrics_observers_)
+    observer->clear();
+}
 
 void ProcessPlanningServer::enableTaskflowProfiling()
 {
@@ -201,8 +505,108 @@ void ProcessPlanningServer::disableTaskflowProfiling()
   }
 }
 
+void ProcessPlanningServer::enableTaskflowCache(std::size_t max_size)
+{
+  if (taskflow_cache_ != nullptr)
+    return;
+
+  if (max_size == 0)
+    max_size = executor_->num_workers();
+
+  taskflow_cache_ = std::make_shared<TaskflowCache>(max_size);
+}
+
+void ProcessPlanningServer::disableTaskflowCache() { taskflow_cache_ = nullptr; }
+
+void ProcessPlanningServer::enablePlanCache(std::size_t max_memory_usage)
+{
+  if (plan_cache_ == nullptr)
+    plan_cache_ = std::make_shared<PlanResultCache>(max_memory_usage);
+}
+
+void ProcessPlanningServer::disablePlanCache() { plan_cache_ = nullptr; }
+
+PlanResultCache::Ptr ProcessPlanningServer::getPlanCache() const { return plan_cache_; }
+
+void ProcessPlanningServer::enableContactManagerPool()
+{
+  if (contact_manager_pool_ == nullptr)
+    contact_manager_pool_ = std::make_shared<ContactManagerPool>();
+}
+
+void ProcessPlanningServer::disableContactManagerPool() { contact_manager_pool_ = nullptr; }
+
+ContactManagerPool::Ptr ProcessPlanningServer::getContactManagerPool() const { return contact_manager_pool_; }
+
 ProfileDictionary::Ptr ProcessPlanningServer::getProfiles() { return profiles_; }
 
+std::string ProcessPlanningServer::getTaskflowKey(const ProcessPlanningRequest& request,
+                                                  const CompositeInstruction& program,
+                                                  bool has_seed,
+                                                  const std::set<std::size_t>& reused_segments)
+{
+  // The taskflows of each priority class run on its own executor
+  std::string key = TaskflowCache::getKey(request.name, program, has_seed) + ";" +
+                    std::to_string(static_cast<int>(request.priority));
+
+  // The reused segments have no taskflow of their own
+  for (std::size_t index : reused_segments)
+    key += ";r" + std::to_string(index);
+
+  return key;
+}
+
+std::set<std::size_t> ProcessPlanningServer::reusePreviousResults(const ProcessPlanningRequest& request,
+                                                                  const TaskflowGenerator& generator,
+                                                                  const CompositeInstruction& program,
+                                                                  const tesseract_environment::Environment& env,
+                                                                  std::uint64_t environment_fingerprint,
+                                                                  Instruction& results)
+{
+  std::set<std::size_t> reused_segments;
+
+  // The commands of the request modify the environment without a revision the fingerprint could tell apart
+  if (!request.commands.empty() || request.previous_environment_fingerprint != environment_fingerprint)
+  {
+    CONSOLE_BRIDGE_logWarn("Tesseract Planning Server: The environment changed since the previous request, planning "
+                           "every segment!");
+    return reused_segments;
+  }
+
+  if (!isCompositeInstruction(request.previous_instructions) || !isCompositeInstruction(request.previous_results) ||
+      !isCompositeInstruction(results))
+  {
+    CONSOLE_BRIDGE_logError("Tesseract Planning Server: The previous instructions and results must be composites!");
+    return reused_segments;
+  }
+
+  // The previous program is formatted the same way, so the joint order of the waypoints matches
+  CompositeInstruction previous_program = request.previous_instructions.as<CompositeInstruction>();
+  formatProgram(previous_program, env);
+
+  const auto& previous_results = request.previous_results.as<CompositeInstruction>();
+  auto& composite_results = results.as<CompositeInstruction>();
+  if (previous_results.size() != previous_program.size())
+  {
+    CONSOLE_BRIDGE_logError("Tesseract Planning Server: The previous results do not match the previous instructions!");
+    return reused_segments;
+  }
+
+  for (const auto& segment : generator.getReusableSegments(program, previous_program))
+  {
+    if (segment.first >= composite_results.size())
+      continue;
+
+    composite_results[segment.first] = previous_results[segment.second];
+    reused_segments.insert(segment.first);
+  }
+
+  CONSOLE_BRIDGE_logInform("Tesseract Planning Server: Reusing %zu of %zu segments of the previous results!",
+                           reused_segments.size(),
+                           program.size());
+  return reused_segments;
+}
+
 ProfileDictionary::ConstPtr ProcessPlanningServer::getProfiles() const { return profiles_; }
 
 }  // namespace tesseract_planning
@@ -0,0 +1,261 @@
+/**
+ * @file request_scheduler.cpp
+ * @brief Schedules the taskflows of process planning requests by priority class
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/request_scheduler.h>
+
+namespace tesseract_planning
+{
+RequestScheduler::RequestScheduler(std::shared_ptr<tf::Executor> executor) : executor_(std::move(executor)) {}
+
+RequestScheduler::~RequestScheduler()
+{
+  waitForAll();
+  running_.clear();
+}
+
+void RequestScheduler::configure(ProcessPlanningPriority priority,
+                                 std::shared_ptr<tf::Executor> executor,
+                                 std::size_t max_active,
+                                 std::size_t max_queued)
+{
+  std::scoped_lock lock(mutex_);
+  PriorityClass& priority_class = getClass(priority);
+  priority_class.executor = std::move(executor);
+  priority_class.max_active = max_active;
+  priority_class.max_queued = max_queued;
+}
+
+std::shared_ptr<tf::Executor> RequestScheduler::getExecutor(ProcessPlanningPriority priority) const
+{
+  std::scoped_lock lock(mutex_);
+  const PriorityClass& priority_class = getClass(priority);
+  return (priority_class.executor != nullptr) ? priority_class.executor : executor_;
+}
+
+std::future<void> RequestScheduler::submit(ProcessPlanningPriority priority,
+                                           TaskflowTemplate::Ptr taskflow_template,
+                                           TaskflowCache::Ptr taskflow_cache,
+                                           FinishedCallback finished_callback)
+{
+  Request request{ std::move(taskflow_template),
+                   std::move(taskflow_cache),
+                   std::make_shared<std::promise<void>>(),
+                   Clock::now(),
+                   std::move(finished_callback) };
+  std::future<void> future = request.promise->get_future();
+
+  std::shared_ptr<tf::Executor> executor;
+  {
+    std::scoped_lock lock(mutex_);
+    removeFinished();
+
+    PriorityClass& priority_class = getClass(priority);
+    if (priority_class.max_active == 0 || priority_class.metrics.active < priority_class.max_active)
+    {
+      ++priority_class.metrics.admitted;
+      recordStart(priority_class, request);
+      executor = (priority_class.executor != nullptr) ? priority_class.executor : executor_;
+    }
+    else if (priority_class.max_queued == 0 || priority_class.queue.size() < priority_class.max_queued)
+    {
+      ++priority_class.metrics.admitted;
+      priority_class.queue.push_back(std::move(request));
+      priority_class.metrics.queue_depth = priority_class.queue.size();
+      return future;
+    }
+    else
+    {
+      ++priority_class.metrics.rejected;
+    }
+  }
+
+  if (executor == nullptr)
+  {
+    // The request was rejected
+    request.taskflow_template->input.abort();
+    request.taskflow_template->input.unbind();
+    if (request.taskflow_cache != nullptr)
+      request.taskflow_cache->release(request.taskflow_template, std::shared_future<void>());
+
+    if (request.finished_callback)
+      request.finished_callback();
+
+    request.promise->set_value();
+    return future;
+  }
+
+  start(executor, priority, std::move(request));
+  return future;
+}
+
+RequestSchedulerMetrics RequestScheduler::getMetrics(ProcessPlanningPriority priority) const
+{
+  std::scoped_lock lock(mutex_);
+  const PriorityClass& priority_class = getClass(priority);
+  RequestSchedulerMetrics metrics = priority_class.metrics;
+  std::size_t started = metrics.active + metrics.completed;
+  if (started > 0)
+    metrics.average_wait_time = priority_class.total_wait_time / static_cast<double>(started);
+
+  return metrics;
+}
+
+void RequestScheduler::waitForAll()
+{
+  std::vector<std::shared_ptr<tf::Executor>> executors{ executor_ };
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return isIdle(); });
+
+    for (const auto& priority_class : classes_)
+    {
+      if (priority_class.executor != nullptr &&
+          std::find(executors.begin(), executors.end(), priority_class.executor) == executors.end())
+        executors.push_back(priority_class.executor);
+    }
+  }
+
+  // The last task of a request may still be finishing after the request was marked finished
+  for (const auto& executor : executors)
+    executor->wait_for_all();
+
+  std::scoped_lock lock(mutex_);
+  removeFinished();
+}
+
+void RequestScheduler::setMetricsObserver(MetricsObserver::Ptr observer)
+{
+  std::scoped_lock lock(mutex_);
+  metrics_observer_ = std::move(observer);
+}
+
+void RequestScheduler::start(const std::shared_ptr<tf::Executor>& executor,
+                             ProcessPlanningPriority priority,
+                             Request request)
+{
+  // The request data is released as soon as the last task has finished
+  TaskInput input = request.taskflow_template->input;
+  std::shared_ptr<std::promise<void>> promise = request.promise;
+  MetricsObserver::Ptr observer;
+  {
+    std::scoped_lock lock(mutex_);
+    observer = metrics_observer_;
+  }
+
+  tf::Taskflow& taskflow = *(request.taskflow_template->container.taskflow);
+  FinishedCallback finished_callback = std::move(request.finished_callback);
+  std::shared_future<void> future =
+      executor->run(taskflow, [this, priority, input, promise, observer, finished_callback]() mutable {
+        if (observer != nullptr)
+          observer->recordTaskResults(input.getTaskInterface()->getTaskInfoContainer()->getTaskResults());
+
+        if (finished_callback)
+          finished_callback();
+
+        input.unbind();
+        finished(priority);
+        promise->set_value();
+      });
+
+  // The taskflow may only be reused or destroyed once the executor future is ready
+  if (request.taskflow_cache != nullptr)
+  {
+    request.taskflow_cache->release(request.taskflow_template, std::move(future));
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  request.taskflow_template->future = std::move(future);
+  running_.push_back(std::move(request.taskflow_template));
+}
+
+void RequestScheduler::finished(ProcessPlanningPriority priority)
+{
+  Request next;
+  std::shared_ptr<tf::Executor> executor;
+  {
+    std::scoped_lock lock(mutex_);
+    PriorityClass& priority_class = getClass(priority);
+    --priority_class.metrics.active;
+    ++priority_class.metrics.completed;
+
+    // Start the request which has waited the longest
+    if (!priority_class.queue.empty())
+    {
+      next = std::move(priority_class.queue.front());
+      priority_class.queue.pop_front();
+      priority_class.metrics.queue_depth = priority_class.queue.size();
+      recordStart(priority_class, next);
+      executor = (priority_class.executor != nullptr) ? priority_class.executor : executor_;
+    }
+  }
+
+  if (executor != nullptr)
+    start(executor, priority, std::move(next));
+
+  idle_cv_.notify_all();
+}
+
+bool RequestScheduler::isIdle() const
+{
+  return std::all_of(classes_.begin(), classes_.end(), [](const PriorityClass& priority_class) {
+    return (priority_class.metrics.active == 0 && priority_class.queue.empty());
+  });
+}
+
+void RequestScheduler::removeFinished()
+{
+  running_.erase(std::remove_if(running_.begin(),
+                                running_.end(),
+                                [](const TaskflowTemplate::Ptr& t) {
+                                  return (t->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                                }),
+                 running_.end());
+}
+
+void RequestScheduler::recordStart(PriorityClass& priority_class, const Request& request)
+{
+  double wait_time = std::chrono::duration<double>(Clock::now() - request.submitted).count();
+  priority_class.total_wait_time += wait_time;
+  priority_class.metrics.max_wait_time = std::max(priority_class.metrics.max_wait_time, wait_time);
+  priority_class.metrics.wait_times.record(wait_time);
+  ++priority_class.metrics.active;
+}
+
+RequestScheduler::PriorityClass& RequestScheduler::getClass(ProcessPlanningPriority priority)
+{
+  return classes_.at(static_cast<std::size_t>(priority));
+}
+
+const RequestScheduler::PriorityClass& RequestScheduler::getClass(ProcessPlanningPriority priority) const
+{
+  return classes_.at(static_cast<std::size_t>(priority));
+}
+}  // namespace tesseract_planning
@@ -36,7 +36,10 @@ tf::Task TaskGenerator::generateTask(TaskInput input, tf::Taskflow& taskflow)
 {
   tf::Task task = taskflow.placeholder();
   std::size_t unique_id = task.hash_value();
-  task.work([=]() { process(input, unique_id); });
+  task.work([=]() {
+    TraceSpan span(input.getTraceRecorder(), name_, "task");
+    process(input, unique_id);
+  });
   task.name(getName());
   return task;
 }
@@ -44,7 +47,10 @@ tf::Task TaskGenerator::generateTask(TaskInput input, tf::Taskflow& taskflow)
 void TaskGenerator::assignTask(TaskInput input, tf::Task& task)
 {
   std::size_t unique_id = task.hash_value();
-  task.work([=]() { process(input, unique_id); });
+  task.work([=]() {
+    TraceSpan span(input.getTraceRecorder(), name_, "task");
+    process(input, unique_id);
+  });
   task.name(getName());
 }
 
@@ -52,7 +58,10 @@ tf::Task TaskGenerator::generateConditionalTask(TaskInput input, tf::Taskflow& t
 {
   tf::Task task = taskflow.placeholder();
   std::size_t unique_id = task.hash_value();
-  task.work([=]() { return conditionalProcess(input, unique_id); });
+  task.work([=]() {
+    TraceSpan span(input.getTraceRecorder(), name_, "task");
+    return conditionalProcess(input, unique_id);
+  });
   task.name(getName());
   return task;
 }
@@ -60,7 +69,10 @@ tf::Task TaskGenerator::generateConditionalTask(TaskInput input, tf::Taskflow& t
 void TaskGenerator::assignConditionalTask(TaskInput input, tf::Task& task)
 {
   std::size_t unique_id = task.hash_value();
-  task.work([=]() { return conditionalProcess(input, unique_id); });
+  task.work([=]() {
+    TraceSpan span(input.getTraceRecorder(), name_, "task");
+    return conditionalProcess(input, unique_id);
+  });
   task.name(getName());
 }
 }  // namespace tesseract_planning
@@ -25,17 +25,66 @@
  */
 
 #include <tesseract_process_managers/core/task_info.h>
+#include <tesseract_command_language/utils/utils.h>
 
 namespace tesseract_planning
 {
 TaskInfo::TaskInfo(std::size_t unique_id, std::string name) : unique_id(unique_id), task_name(std::move(name)) {}
 
+std::size_t TaskInfo::estimateMemoryUsage() const
+{
+  // The member function hides the estimate of an instruction, so it must be qualified
+  return sizeof(*this) + task_name.size() + message.size() +
+         tesseract_planning::estimateMemoryUsage(instructions_input) +
+         tesseract_planning::estimateMemoryUsage(instructions_output) +
+         tesseract_planning::estimateMemoryUsage(results_input) +
+         tesseract_planning::estimateMemoryUsage(results_output);
+}
+
 void TaskInfoContainer::addTaskInfo(TaskInfo::ConstPtr task_info)
 {
   std::unique_lock<std::shared_mutex> lock(mutex_);
   task_info_map_[task_info->unique_id] = std::move(task_info);
 }
 
+void TaskInfoContainer::finishTaskInfo(const TaskInfo::ConstPtr& task_info)
+{
+  // Estimate outside of the lock since this walks the saved instructions
+  const std::size_t memory_usage = task_info->estimateMemoryUsage();
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto it = task_info_map_.find(task_info->unique_id);
+  if (it == task_info_map_.end() || it->second != task_info)
+    return;
+
+  TaskResultCounts& results = task_results_[task_info->task_name];
+  if (task_info->return_value != 0)
+    ++results.successes;
+  else
+    ++results.failures;
+
+  if (retention_policy_.failed_only && task_info->return_value != 0)
+  {
+    task_info_map_.erase(it);
+    ++removed_count_;
+    return;
+  }
+
+  finished_.emplace_back(task_info->unique_id, memory_usage);
+  memory_usage_ += memory_usage;
+
+  const std::size_t max_count = retention_policy_.max_count;
+  const std::size_t max_memory_usage = retention_policy_.max_memory_usage;
+  while (!finished_.empty() && ((max_count > 0 && finished_.size() > max_count) ||
+                                (max_memory_usage > 0 && memory_usage_ > max_memory_usage)))
+  {
+    memory_usage_ -= finished_.front().second;
+    task_info_map_.erase(finished_.front().first);
+    finished_.pop_front();
+    ++removed_count_;
+  }
+}
+
 TaskInfo::ConstPtr TaskInfoContainer::operator[](std::size_t index) const
 {
   std::shared_lock<std::shared_mutex> lock(mutex_);
@@ -48,4 +97,46 @@ std::map<std::size_t, TaskInfo::ConstPtr> TaskInfoContainer::getTaskInfoMap() co
   return task_info_map_;
 }
 
+void TaskInfoContainer::setCaptureMode(TaskInfoCaptureMode mode)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  capture_mode_ = mode;
+}
+
+TaskInfoCaptureMode TaskInfoContainer::getCaptureMode() const
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return capture_mode_;
+}
+
+void TaskInfoContainer::setRetentionPolicy(const TaskInfoRetentionPolicy& policy)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  retention_policy_ = policy;
+}
+
+TaskInfoRetentionPolicy TaskInfoContainer::getRetentionPolicy() const
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return retention_policy_;
+}
+
+std::size_t TaskInfoContainer::getMemoryUsage() const
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return memory_usage_;
+}
+
+std::size_t TaskInfoContainer::getRemovedCount() const
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return removed_count_;
+}
+
+std::map<std::string, TaskResultCounts> TaskInfoContainer::getTaskResults() const
+{
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return task_results_;
+}
+
 }  // namespace tesseract_planning
@@ -26,6 +26,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <utility>
 #include <vector>
 #include <console_bridge/console.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -40,20 +41,74 @@ namespace tesseract_planning
 static const ManipulatorInfo EMPTY_MANIPULATOR_INFO;
 static const PlannerProfileRemapping EMPTY_PROFILE_MAPPING;
 
+/**
+ * @brief Unshare the composites of the results from any copy
+ * @details This hands out a mutable reference to the children of every composite, so accessing them later through
+ * TaskInput::getResults does not write to the composites containing them while other tasks modify their own results
+ */
+static void unshareResults(Instruction& results)
+{
+  if (!isCompositeInstruction(results))
+    return;
+
+  for (auto& child : results.as<CompositeInstruction>())
+    unshareResults(child);
+}
+
+struct TaskInput::Data
+{
+  tesseract_environment::Environment::ConstPtr env;
+  ManipulatorInfo manip_info;
+  PlannerProfileRemapping plan_profile_remapping;
+  PlannerProfileRemapping composite_profile_remapping;
+  ProfileDictionary::ConstPtr profiles;
+  bool has_seed{ false };
+
+  /** @brief Instructions to be carried out by process */
+  const Instruction* instruction{ nullptr };
+
+  /** @brief Results/Seed for this process */
+  Instruction* results{ nullptr };
+
+  /** @brief Used to store if process input is aborted which is thread safe */
+  TaskflowInterface::Ptr interface{ std::make_shared<TaskflowInterface>() };
+
+  Data(tesseract_environment::Environment::ConstPtr env,
+       const Instruction* instruction,
+       const ManipulatorInfo& manip_info,
+       const PlannerProfileRemapping& plan_profile_remapping,
+       const PlannerProfileRemapping& composite_profile_remapping,
+       Instruction* seed,
+       bool has_seed,
+       ProfileDictionary::ConstPtr profiles)
+    : env(std::move(env))
+    , manip_info(manip_info)
+    , plan_profile_remapping(plan_profile_remapping)
+    , composite_profile_remapping(composite_profile_remapping)
+    , profiles(std::move(profiles))
+    , has_seed(has_seed)
+    , instruction(instruction)
+    , results(seed)
+  {
+    if (results != nullptr)
+      unshareResults(*results);
+  }
+};
+
 TaskInput::TaskInput(tesseract_environment::Environment::ConstPtr env,
                      const Instruction* instruction,
                      const ManipulatorInfo& manip_info,
                      Instruction* seed,
                      bool has_seed,
                      ProfileDictionary::ConstPtr profiles)
-  : env(std::move(env))
-  , manip_info(manip_info)
-  , plan_profile_remapping(EMPTY_PROFILE_MAPPING)
-  , composite_profile_remapping(EMPTY_PROFILE_MAPPING)
-  , profiles(std::move(profiles))
-  , has_seed(has_seed)
-  , instruction_(instruction)
-  , results_(seed)
+  : TaskInput(std::move(env),
+              instruction,
+              manip_info,
+              EMPTY_PROFILE_MAPPING,
+              EMPTY_PROFILE_MAPPING,
+              seed,
+              has_seed,
+              std::move(profiles))
 {
 }
 
@@ -65,14 +120,20 @@ TaskInput::TaskInput(tesseract_environment::Environment::ConstPtr env,
                      Instruction* seed,
                      bool has_seed,
                      ProfileDictionary::ConstPtr profiles)
-  : env(std::move(env))
-  , manip_info(manip_info)
-  , plan_profile_remapping(plan_profile_remapping)
-  , composite_profile_remapping(composite_profile_remapping)
-  , profiles(std::move(profiles))
-  , has_seed(has_seed)
-  , instruction_(instruction)
-  , results_(seed)
+  : data_(std::make_shared<Data>(std::move(env),
+                                 instruction,
+                                 manip_info,
+                                 plan_profile_remapping,
+                                 composite_profile_remapping,
+                                 seed,
+                                 has_seed,
+                                 std::move(profiles)))
+  , env(data_->env)
+  , manip_info(data_->manip_info)
+  , plan_profile_remapping(data_->plan_profile_remapping)
+  , composite_profile_remapping(data_->composite_profile_remapping)
+  , profiles(data_->profiles)
+  , has_seed(data_->has_seed)
 {
 }
 
@@ -83,14 +144,14 @@ TaskInput::TaskInput(tesseract_environment::Environment::ConstPtr env,
                      Instruction* seed,
                      bool has_seed,
                      ProfileDictionary::ConstPtr profiles)
-  : env(std::move(env))
-  , manip_info(EMPTY_MANIPULATOR_INFO)
-  , plan_profile_remapping(plan_profile_remapping)
-  , composite_profile_remapping(composite_profile_remapping)
-  , profiles(std::move(profiles))
-  , has_seed(has_seed)
-  , instruction_(instruction)
-  , results_(seed)
+  : TaskInput(std::move(env),
+              instruction,
+              EMPTY_MANIPULATOR_INFO,
+              plan_profile_remapping,
+              composite_profile_remapping,
+              seed,
+              has_seed,
+              std::move(profiles))
 {
 }
 
@@ -99,28 +160,82 @@ TaskInput::TaskInput(tesseract_environment::Environment::ConstPtr env,
                      Instruction* seed,
                      bool has_seed,
                      ProfileDictionary::ConstPtr profiles)
-  : env(std::move(env))
-  , manip_info(EMPTY_MANIPULATOR_INFO)
-  , plan_profile_remapping(EMPTY_PROFILE_MAPPING)
-  , composite_profile_remapping(EMPTY_PROFILE_MAPPING)
-  , profiles(std::move(profiles))
-  , has_seed(has_seed)
-  , instruction_(instruction)
-  , results_(seed)
+  : TaskInput(std::move(env),
+              instruction,
+              EMPTY_MANIPULATOR_INFO,
+              EMPTY_PROFILE_MAPPING,
+              EMPTY_PROFILE_MAPPING,
+              seed,
+              has_seed,
+              std::move(profiles))
 {
 }
 
+void TaskInput::rebind(tesseract_environment::Environment::ConstPtr env,
+                       const Instruction* instruction,
+                       const ManipulatorInfo& manip_info,
+                       const PlannerProfileRemapping& plan_profile_remapping,
+                       const PlannerProfileRemapping& composite_profile_remapping,
+                       Instruction* seed,
+                       bool has_seed,
+                       ProfileDictionary::ConstPtr profiles)
+{
+  data_->env = std::move(env);
+  data_->instruction = instruction;
+  data_->manip_info = manip_info;
+  data_->plan_profile_remapping = plan_profile_remapping;
+  data_->composite_profile_remapping = composite_profile_remapping;
+  data_->results = seed;
+  if (seed != nullptr)
+    unshareResults(*seed);
+
+  data_->has_seed = has_seed;
+  data_->profiles = std::move(profiles);
+  data_->interface = std::make_shared<TaskflowInterface>();
+}
+
+void TaskInput::unbind()
+{
+  rebind(nullptr,
+         nullptr,
+         EMPTY_MANIPULATOR_INFO,
+         EMPTY_PROFILE_MAPPING,
+         EMPTY_PROFILE_MAPPING,
+         nullptr,
+         false,
+         nullptr);
+}
+
 TaskInput TaskInput::operator[](std::size_t index)
 {
   TaskInput pi(*this);
   pi.instruction_indice_.push_back(index);
+  pi.reused_segments.clear();
 
   return pi;
 }
 
+TaskInput TaskInput::createBranch(Instruction* results) const
+{
+  TaskInput branch(data_->env,
+                   getInstruction(),
+                   data_->manip_info,
+                   data_->plan_profile_remapping,
+                   data_->composite_profile_remapping,
+                   results,
+                   data_->has_seed,
+                   data_->profiles);
+  branch.data_->interface = data_->interface->createChild();
+  branch.setStartInstruction(getStartInstruction());
+  branch.setEndInstruction(getEndInstruction());
+  branch.save_io = save_io;
+  branch.executor = executor;
+  return branch;
+}
+
 std::size_t TaskInput::size()
 {
-  const Instruction* ci = instruction_;
+  const Instruction* ci = data_->instruction;
   for (const auto& i : instruction_indice_)
   {
     if (isCompositeInstruction(*ci))
@@ -145,7 +260,7 @@ std::size_t TaskInput::size()
 
 const Instruction* TaskInput::getInstruction() const
 {
-  const Instruction* ci = instruction_;
+  const Instruction* ci = data_->instruction;
   for (const auto& i : instruction_indice_)
   {
     if (isCompositeInstruction(*ci))
@@ -161,14 +276,23 @@ const Instruction* TaskInput::getInstruction() const
   return ci;
 }
 
+const std::vector<std::size_t>& TaskInput::getInstructionIndices() const { return instruction_indice_; }
+
 Instruction* TaskInput::getResults()
 {
-  Instruction* ci = results_;
+  // The composites containing the results were unshared when the results were bound and are only read here, so tasks
+  // modifying the results of different sub-inputs at the same time do not write to the same composite
+  return const_cast<Instruction*>(std::as_const(*this).getResults());
+}
+
+const Instruction* TaskInput::getResults() const
+{
+  const Instruction* ci = data_->results;
   for (const auto& i : instruction_indice_)
   {
     if (isCompositeInstruction(*ci))
     {
-      auto& composite = ci->as<CompositeInstruction>();
+      const auto& composite = ci->as<CompositeInstruction>();
       ci = &(composite.at(i));
     }
     else
@@ -179,38 +303,61 @@ Instruction* TaskInput::getResults()
   return ci;
 }
 
-TaskflowInterface::Ptr TaskInput::getTaskInterface() { return interface_; }
+TaskflowInterface::Ptr TaskInput::getTaskInterface() { return data_->interface; }
+
+TraceRecorder::Ptr TaskInput::getTraceRecorder() const { return data_->interface->getTraceRecorder(); }
 
-bool TaskInput::isAborted() const { return interface_->isAborted(); }
+ContactManagerPool::Ptr TaskInput::getContactManagerPool() const
+{
+  return data_->interface->getContactManagerPool();
+}
+
+bool TaskInput::isAborted() const
+{
+  // A process which ran out of time is aborted so the remaining tasks fail fast
+  return (data_->interface->isAborted() || data_->interface->abortIfExpired());
+}
 
-void TaskInput::abort() { interface_->abort(); }
+void TaskInput::abort() { data_->interface->abort(); }
 
 void TaskInput::setStartInstruction(Instruction start)
 {
   start_instruction_ = start;
+  start_instruction_fn_ = nullptr;
   start_instruction_indice_.clear();
 }
 
 void TaskInput::setStartInstruction(std::vector<std::size_t> start)
 {
   start_instruction_indice_ = start;
+  start_instruction_fn_ = nullptr;
   start_instruction_ = NullInstruction();
 }
 
+void TaskInput::setStartInstructionFn(InstructionFn start)
+{
+  start_instruction_fn_ = std::move(start);
+  start_instruction_ = NullInstruction();
+  start_instruction_indice_.clear();
+}
+
 Instruction TaskInput::getStartInstruction() const
 {
+  if (start_instruction_fn_)
+    return start_instruction_fn_();
+
   if (!isNullInstruction(start_instruction_))
     return start_instruction_;
 
   if (start_instruction_indice_.empty())
     return NullInstruction();
 
-  Instruction* ci = results_;
+  const Instruction* ci = data_->results;
   for (const auto& i : start_instruction_indice_)
   {
     if (isCompositeInstruction(*ci))
     {
-      auto& composite = ci->as<CompositeInstruction>();
+      const auto& composite = ci->as<CompositeInstruction>();
       ci = &(composite.at(i));
     }
     else
@@ -245,12 +392,12 @@ Instruction TaskInput::getEndInstruction() const
   if (end_instruction_indice_.empty())
     return NullInstruction();
 
-  Instruction* ci = results_;
+  const Instruction* ci = data_->results;
   for (const auto& i : end_instruction_indice_)
   {
     if (isCompositeInstruction(*ci))
     {
-      auto& composite = ci->as<CompositeInstruction>();
+      const auto& composite = ci->as<CompositeInstruction>();
       ci = &(composite.at(i));
     }
     else
@@ -261,7 +408,7 @@ Instruction TaskInput::getEndInstruction() const
 
   if (isCompositeInstruction(*ci))
   {
-    auto& composite = ci->as<CompositeInstruction>();
+    const auto& composite = ci->as<CompositeInstruction>();
     return composite.getStartInstruction();
   }
 
@@ -270,16 +417,16 @@ Instruction TaskInput::getEndInstruction() const
 
 void TaskInput::addTaskInfo(const TaskInfo::ConstPtr& task_info)
 {
-  interface_->getTaskInfoContainer()->addTaskInfo(task_info);
+  data_->interface->getTaskInfoContainer()->addTaskInfo(task_info);
 }
 
 TaskInfo::ConstPtr TaskInput::getTaskInfo(const std::size_t& index) const
 {
-  return (*interface_->getTaskInfoContainer())[index];
+  return (*data_->interface->getTaskInfoContainer())[index];
 }
 
 std::map<std::size_t, TaskInfo::ConstPtr> TaskInput::getTaskInfoMap() const
 {
-  return interface_->getTaskInfoContainer()->getTaskInfoMap();
+  return data_->interface->getTaskInfoContainer()->getTaskInfoMap();
 }
 }  // namespace tesseract_planning
@@ -0,0 +1,146 @@
+/**
+ * @file taskflow_cache.cpp
+ * @brief A cache of generated taskflows which are reused by requests with the same shape
+ *
+ * @author Levi Armstrong
+ * @date October 17, 2026
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <chrono>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_process_managers/core/taskflow_cache.h>
+#include <tesseract_command_language/instruction_type.h>
+
+namespace tesseract_planning
+{
+static bool isRunning(const TaskflowTemplate& taskflow_template)
+{
+  return (taskflow_template.future.valid() &&
+          taskflow_template.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+}
+
+static void appendShape(std::string& key, const CompositeInstruction& composite)
+{
+  key += '(';
+  for (const auto& instruction : composite)
+  {
+    if (isCompositeInstruction(instruction))
+      appendShape(key, instruction.as<CompositeInstruction>());
+    else
+      key += '.';
+  }
+  key += ')';
+}
+
+TaskflowTemplate::TaskflowTemplate(std::string key,
+                                   std::size_t profiles_revision,
+                                   TaskInput input,
+                                   TaskflowContainer container)
+  : key(std::move(key)), profiles_revision(profiles_revision), input(std::move(input)), container(std::move(container))
+{
+}
+
+TaskflowTemplate::~TaskflowTemplate()
+{
+  if (future.valid())
+    future.wait();
+}
+
+TaskflowCache::TaskflowCache(std::size_t max_size) : max_size_(max_size) {}
+
+std::string TaskflowCache::getKey(const std::string& name, const CompositeInstruction& program, bool has_seed)
+{
+  std::string key = name;
+  key += (has_seed) ? ":seed:" : ":";
+  appendShape(key, program);
+  return key;
+}
+
+TaskflowTemplate::Ptr TaskflowCache::acquire(const std::string& key, std::size_t profiles_revision)
+{
+  std::scoped_lock lock(mutex_);
+  auto it = templates_.find(key);
+  if (it == templates_.end())
+    return nullptr;
+
+  // Templates generated with older profiles are discarded once they are no longer running
+  auto& templates = it->second;
+  templates.erase(std::remove_if(templates.begin(),
+                                 templates.end(),
+                                 [profiles_revision](const TaskflowTemplate::Ptr& t) {
+                                   return (!t->acquired && t->profiles_revision != profiles_revision && !isRunning(*t));
+                                 }),
+                  templates.end());
+
+  for (auto& t : templates)
+  {
+    if (!t->acquired && !isRunning(*t))
+    {
+      t->acquired = true;
+      return t;
+    }
+  }
+
+  return nullptr;
+}
+
+bool TaskflowCache::add(TaskflowTemplate::Ptr taskflow_template)
+{
+  std::scoped_lock lock(mutex_);
+  auto& templates = templates_[taskflow_template->key];
+  if (templates.size() >= max_size_)
+    return false;
+
+  taskflow_template->acquired = true;
+  templates.push_back(std::move(taskflow_template));
+  return true;
+}
+
+void TaskflowCache::release(const TaskflowTemplate::Ptr& taskflow_template, std::shared_future<void> future)
+{
+  std::scoped_lock lock(mutex_);
+  taskflow_template->future = std::move(future);
+  taskflow_template->acquired = false;
+}
+
+std::size_t TaskflowCache::size() const
+{
+  std::scoped_lock lock(mutex_);
+  std::size_t size{ 0 };
+  for (const auto& templates : templates_)
+    size += templates.second.size();
+
+  return size;
+}
+
+void TaskflowCache::clear()
+{
+  std::unordered_map<std::string, std::vector<TaskflowTemplate::Ptr>> templates;
+  {
+    std::scoped_lock lock(mutex_);
+    templates.swap(templates_);
+  }
+  // The templates wait for running taskflows when destroyed
+}
+}  // namespace tesseract_planning
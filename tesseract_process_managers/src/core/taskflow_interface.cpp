@@ -29,11 +29,72 @@
 
 namespace tesseract_planning
 {
-bool TaskflowInterface::isAborted() const { return abort_; }
+bool TaskflowInterface::isAborted() const { return cancellation_token_->isCancelled(); }
 
-bool TaskflowInterface::isSuccessful() const { return !abort_; }
+bool TaskflowInterface::isSuccessful() const { return !cancellation_token_->isCancelled(); }
 
-void TaskflowInterface::abort() { abort_ = true; }
+void TaskflowInterface::abort()
+{
+  if (cancellation_token_->isExpired())
+    expired_ = true;
+
+  cancellation_token_->cancel();
+}
+
+void TaskflowInterface::setDeadline(CancellationToken::Clock::time_point deadline)
+{
+  cancellation_token_->setDeadline(deadline);
+}
+
+CancellationToken::Clock::time_point TaskflowInterface::getDeadline() const
+{
+  return cancellation_token_->getDeadline();
+}
+
+bool TaskflowInterface::abortIfExpired()
+{
+  if (!cancellation_token_->isExpired())
+    return false;
+
+  abort();
+  return true;
+}
+
+bool TaskflowInterface::isExpired() const { return expired_; }
+
+CancellationToken::ConstPtr TaskflowInterface::getCancellationToken() const { return cancellation_token_; }
+
+void TaskflowInterface::setTraceRecorder(TraceRecorder::Ptr recorder) { trace_recorder_ = std::move(recorder); }
+
+TraceRecorder::Ptr TaskflowInterface::getTraceRecorder() const { return trace_recorder_; }
+
+void TaskflowInterface::setSegmentCallback(ProcessPlanningSegmentFn callback)
+{
+  segment_callback_ = std::move(callback);
+}
+
+bool TaskflowInterface::hasSegmentCallback() const { return (segment_callback_ != nullptr); }
+
+void TaskflowInterface::publishSegment(const ProcessPlanningSegment& segment) const
+{
+  if (segment_callback_)
+    segment_callback_(segment);
+}
+
+void TaskflowInterface::setContactManagerPool(ContactManagerPool::Ptr pool) { contact_manager_pool_ = std::move(pool); }
+
+ContactManagerPool::Ptr TaskflowInterface::getContactManagerPool() const { return contact_manager_pool_; }
+
+TaskflowInterface::Ptr TaskflowInterface::createChild() const
+{
+  auto child = std::make_shared<TaskflowInterface>();
+  child->cancellation_token_ = std::make_shared<CancellationToken>(cancellation_token_);
+  child->trace_recorder_ = trace_recorder_;
+  child->segment_callback_ = segment_callback_;
+  child->contact_manager_pool_ = contact_manager_pool_;
+  child->task_infos_ = task_infos_;
+  return child;
+}
 
 TaskInfo::ConstPtr TaskflowInterface::getTaskInfo(const std::size_t& index) const
 {
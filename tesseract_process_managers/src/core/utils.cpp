@@ -25,7 +25,24 @@
  * limitations under the License.
  */
 
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <utility>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
 #include <tesseract_process_managers/core/utils.h>
+#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
+#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
+#include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/instruction_type.h>
+#include <tesseract_command_language/plan_instruction.h>
+#include <tesseract_command_language/utils/get_instruction_utils.h>
+#include <tesseract_command_language/utils/utils.h>
 
 namespace tesseract_planning
 {
@@ -53,6 +70,31 @@ void failureTask(TaskInput instruction,
     user_callback();
 }
 
+void publishSegment(TaskInput input)
+{
+  TaskflowInterface::Ptr interface = input.getTaskInterface();
+  if (!interface->hasSegmentCallback() || input.isAborted())
+    return;
+
+  ProcessPlanningSegment segment;
+  segment.indices = input.getInstructionIndices();
+  segment.description = input.getInstruction()->getDescription();
+  segment.results = *std::as_const(input).getResults();
+  interface->publishSegment(segment);
+}
+
+tf::Task emplaceReusedSegmentTask(tf::Taskflow& taskflow,
+                                  const TaskInput& input,
+                                  const TaskInput& segment_input,
+                                  const std::string& name,
+                                  const TaskflowVoidFn& user_callback)
+{
+  return taskflow.emplace([input, segment_input, name, user_callback]() {
+    publishSegment(segment_input);
+    successTask(input, name, "Reused " + segment_input.getInstruction()->getDescription(), user_callback);
+  });
+}
+
 bool isCompositeEmpty(const CompositeInstruction& composite)
 {
   if (composite.empty())
@@ -71,15 +113,218 @@ bool isCompositeEmpty(const CompositeInstruction& composite)
   return false;
 }
 
+bool checkNoTrajectorySegments(const TaskInput& input)
+{
+  const Instruction* instruction = input.getInstruction();
+  if (instruction != nullptr && isCompositeInstruction(*instruction) &&
+      hasTrajectorySegment(instruction->as<CompositeInstruction>()))
+  {
+    CONSOLE_BRIDGE_logError("TaskInput Invalid: input.instructions should not contain trajectory segments");
+    return false;
+  }
+
+  const Instruction* results = input.getResults();
+  if (input.has_seed && results != nullptr && isCompositeInstruction(*results) &&
+      hasTrajectorySegment(results->as<CompositeInstruction>()))
+  {
+    CONSOLE_BRIDGE_logError("TaskInput Invalid: input.results should not contain trajectory segments");
+    return false;
+  }
+
+  return true;
+}
+
+TaskInput::InstructionFn startInstructionFn(TaskInput input)
+{
+  return [input]() {
+    const Instruction* instruction = input.getInstruction();
+    assert(isCompositeInstruction(*instruction));
+    return instruction->as<CompositeInstruction>().getStartInstruction();
+  };
+}
+
+TaskInput::InstructionFn lastPlanInstructionFn(TaskInput input, bool as_start)
+{
+  return [input, as_start]() {
+    const Instruction* instruction = input.getInstruction();
+    assert(isCompositeInstruction(*instruction));
+    const auto* li = getLastPlanInstruction(instruction->as<CompositeInstruction>());
+    assert(li != nullptr);
+    Instruction start_instruction = *li;
+    if (as_start)
+      start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
+
+    return start_instruction;
+  };
+}
+
+/** @brief Add the fingerprint of the profile overrides, nullptr is added as zero */
+static void hashProfileOverrides(StableHash& hash, const ProfileDictionary::Ptr& profile_overrides)
+{
+  hash.addUnsigned((profile_overrides != nullptr) ? profile_overrides->getFingerprint() : 0);
+}
+
+void hashProfileOverrides(StableHash& hash, const Instruction& instruction)
+{
+  if (isCompositeInstruction(instruction))
+  {
+    hashProfileOverrides(hash, instruction.as<CompositeInstruction>());
+  }
+  else if (isPlanInstruction(instruction))
+  {
+    hashProfileOverrides(hash, instruction.as<PlanInstruction>().profile_overrides);
+  }
+  else if (isMoveInstruction(instruction))
+  {
+    hashProfileOverrides(hash, instruction.as<MoveInstruction>().profile_overrides);
+  }
+}
+
+void hashProfileOverrides(StableHash& hash, const CompositeInstruction& instruction)
+{
+  hashProfileOverrides(hash, instruction.profile_overrides);
+  hashProfileOverrides(hash, instruction.getStartInstruction());
+  for (const auto& child : instruction)
+    hashProfileOverrides(hash, child);
+}
+
+std::uint64_t getEnvironmentFingerprint(const tesseract_environment::Environment& env)
+{
+  StableHash hash;
+  hash.addString(env.getName());
+  hash.addInteger(env.getRevision());
+
+  // The joints of the state are sorted by name since the iteration order of an unordered map is not stable
+  tesseract_environment::EnvState::ConstPtr state = env.getCurrentState();
+  std::vector<std::pair<std::string, double>> joints(state->joints.begin(), state->joints.end());
+  std::sort(joints.begin(), joints.end());
+  hash.addUnsigned(joints.size());
+  for (const auto& joint : joints)
+  {
+    hash.addString(joint.first);
+    hash.addDouble(joint.second);
+  }
+
+  return hash.getValue();
+}
+
+/** @brief Get the hash of the settings of a program every segment is planned with */
+static std::uint64_t getProgramSettingsHash(const CompositeInstruction& program)
+{
+  StableHash hash;
+  hashAppend(hash, program.getManipulatorInfo());
+  hash.addString(program.getProfile());
+  hashProfileOverrides(hash, program.profile_overrides);
+  hashAppend(hash, program.getStartInstruction());
+  hashProfileOverrides(hash, program.getStartInstruction());
+  return hash.getValue();
+}
+
+/** @brief Get the hash of each segment of a program, including the profile overrides */
+static std::vector<std::uint64_t> getSegmentHashes(const CompositeInstruction& program)
+{
+  std::vector<std::uint64_t> hashes;
+  hashes.reserve(program.size());
+  for (const auto& segment : program)
+  {
+    StableHash hash;
+    hashAppend(hash, segment);
+    hashProfileOverrides(hash, segment);
+    hashes.push_back(hash.getValue());
+  }
+
+  return hashes;
+}
+
+/** @brief Get the hash of a raster and of the segment it is planned from */
+static std::vector<std::uint64_t> getRasterKeys(const std::vector<std::uint64_t>& segment_hashes,
+                                                std::size_t first_raster)
+{
+  std::vector<std::uint64_t> keys(segment_hashes.size(), 0);
+  for (std::size_t idx = first_raster; idx < segment_hashes.size(); idx += 2)
+  {
+    StableHash hash;
+    hash.addUnsigned(segment_hashes[idx]);
+    hash.addUnsigned((idx > 0) ? segment_hashes[idx - 1] : 0);
+    keys[idx] = hash.getValue();
+  }
+
+  return keys;
+}
+
+std::map<std::size_t, std::size_t> getReusableRasterSegments(const CompositeInstruction& program,
+                                                             const CompositeInstruction& previous_program,
+                                                             std::size_t first_raster)
+{
+  std::map<std::size_t, std::size_t> reusable;
+  if (first_raster > 1 || program.size() <= first_raster || previous_program.size() <= first_raster)
+    return reusable;
+
+  // The start instruction of the program is compared here, since the first segment is planned from it
+  if (getProgramSettingsHash(program) != getProgramSettingsHash(previous_program))
+    return reusable;
+
+  const std::vector<std::uint64_t> hashes = getSegmentHashes(program);
+  const std::vector<std::uint64_t> previous_hashes = getSegmentHashes(previous_program);
+  const std::vector<std::uint64_t> keys = getRasterKeys(hashes, first_raster);
+  const std::vector<std::uint64_t> previous_keys = getRasterKeys(previous_hashes, first_raster);
+
+  // The rasters are matched in order
+  std::size_t previous_idx = first_raster;
+  for (std::size_t idx = first_raster; idx < program.size(); idx += 2)
+  {
+    for (std::size_t j = previous_idx; j < previous_program.size(); j += 2)
+    {
+      if (keys[idx] == previous_keys[j])
+      {
+        reusable[idx] = j;
+        previous_idx = j + 2;
+        break;
+      }
+    }
+  }
+
+  // The other segments must connect the same rasters as before
+  for (std::size_t idx = 1 - first_raster; idx < program.size(); idx += 2)
+  {
+    std::size_t j{ 0 };
+    if (idx > 0)
+    {
+      auto before = reusable.find(idx - 1);
+      if (before == reusable.end())
+        continue;
+
+      j = before->second + 1;
+    }
+
+    if (idx + 1 < program.size())
+    {
+      auto after = reusable.find(idx + 1);
+      if (after == reusable.end() || after->second != j + 1)
+        continue;
+    }
+
+    // The to end segment must still be the last segment
+    if (idx + 1 == program.size() && j + 1 != previous_program.size())
+      continue;
+
+    if (j < previous_hashes.size() && hashes[idx] == previous_hashes[j])
+      reusable[idx] = j;
+  }
+
+  return reusable;
+}
+
 int hasSeedTask(TaskInput input)
 {
   if (input.has_seed)
     return 1;
 
-  assert(isCompositeInstruction(*(input.getResults())));
-  if (isCompositeInstruction(*(input.getResults())))
+  const Instruction* results = std::as_const(input).getResults();
+  assert(isCompositeInstruction(*results));
+  if (isCompositeInstruction(*results))
   {
-    const auto& composite = input.getResults()->as<CompositeInstruction>();
+    const auto& composite = results->as<CompositeInstruction>();
     if (isCompositeEmpty(composite))
     {
       CONSOLE_BRIDGE_logDebug("Seed is empty!");
@@ -89,22 +334,109 @@ int hasSeedTask(TaskInput input)
   return 1;
 }
 
-void saveInputs(TaskInfo::Ptr info, TaskInput& input)
+static TaskInfoCaptureMode getCaptureMode(TaskInput& input)
 {
   if (input.save_io)
-  {
+    return TaskInfoCaptureMode::FULL;
+
+  return input.getTaskInterface()->getTaskInfoContainer()->getCaptureMode();
+}
+
+void saveInputs(TaskInfo::Ptr info, TaskInput& input)
+{
+  const TaskInfoCaptureMode mode = getCaptureMode(input);
+  if (mode == TaskInfoCaptureMode::NONE)
+    return;
+
+  info->environment_revision = input.env->getRevision();
+  if (mode == TaskInfoCaptureMode::FULL)
     info->environment = input.env->clone();
-    info->instructions_input = *input.getInstruction();
-    info->results_input = *input.getResults();
-  }
+
+  // Composite instructions share their children with the copies until either is modified
+  info->instructions_input = *input.getInstruction();
+  info->results_input = *std::as_const(input).getResults();
 }
 
 void saveOutputs(TaskInfo::Ptr info, TaskInput& input)
 {
-  if (input.save_io)
+  if (getCaptureMode(input) != TaskInfoCaptureMode::NONE)
   {
     info->instructions_output = *input.getInstruction();
-    info->results_output = *input.getResults();
+    info->results_output = *std::as_const(input).getResults();
   }
+
+  input.getTaskInterface()->getTaskInfoContainer()->finishTaskInfo(info);
+}
+
+TaskGenerator::UPtr createContactCheckTaskGenerator(bool continuous, bool parallel)
+{
+  if (continuous)
+  {
+    auto generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
+    generator->parallel = parallel;
+    return generator;
+  }
+
+  auto generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+  generator->parallel = parallel;
+  return generator;
+}
+
+void parallelForChunks(const std::shared_ptr<tf::Executor>& executor,
+                       std::size_t num_chunks,
+                       const std::function<void(std::size_t)>& fn)
+{
+  if (executor == nullptr || num_chunks < 2)
+  {
+    for (std::size_t i = 0; i < num_chunks; ++i)
+      fn(i);
+
+    return;
+  }
+
+  struct ChunkState
+  {
+    std::atomic<std::size_t> next{ 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t completed{ 0 };
+    std::exception_ptr exception;
+  };
+  auto state = std::make_shared<ChunkState>();
+
+  // Workers which start after every chunk has been claimed return without touching fn, so fn only has to outlive the
+  // claimed chunks which this function waits on below.
+  auto worker = [state, num_chunks, &fn]() {
+    for (std::size_t i = state->next++; i < num_chunks; i = state->next++)
+    {
+      std::exception_ptr exception;
+      try
+      {
+        fn(i);
+      }
+      catch (...)
+      {
+        exception = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (exception != nullptr && state->exception == nullptr)
+        state->exception = exception;
+
+      if (++state->completed == num_chunks)
+        state->cv.notify_all();
+    }
+  };
+
+  std::size_t num_helpers = std::min(num_chunks, std::max<std::size_t>(executor->num_workers(), 1)) - 1;
+  for (std::size_t i = 0; i < num_helpers; ++i)
+    executor->async(worker);
+
+  worker();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&state, num_chunks]() { return state->completed == num_chunks; });
+  if (state->exception != nullptr)
+    std::rethrow_exception(state->exception);
 }
 }  // namespace tesseract_planning
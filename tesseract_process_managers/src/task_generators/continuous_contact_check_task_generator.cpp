@@ -26,12 +26,14 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <utility>
 #include <console_bridge/console.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_process_managers/core/utils.h>
 #include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
 #include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/utils/utils.h>
 #include <tesseract_motion_planners/core/utils.h>
 
 namespace tesseract_planning
@@ -72,7 +74,7 @@ int ContinuousContactCheckTaskGenerator::conditionalProcess(TaskInput input, std
   // --------------------
   // Check that inputs are valid
   // --------------------
-  Instruction* input_results = input.getResults();
+  const Instruction* input_results = std::as_const(input).getResults();
   if (!isCompositeInstruction(*input_results))
   {
     info->message = "Input seed to ContinuousContactCheckTaskGenerator must be a composite instruction";
@@ -81,27 +83,53 @@ int ContinuousContactCheckTaskGenerator::conditionalProcess(TaskInput input, std
     return 0;
   }
 
+  // Trajectory segments are not checked yet, so they are rejected instead of being skipped
+  if (hasTrajectorySegment(input_results->as<CompositeInstruction>()))
+  {
+    info->message = "Input seed to ContinuousContactCheckTaskGenerator must not contain trajectory segments";
+    CONSOLE_BRIDGE_logError("%s", info->message.c_str());
+    saveOutputs(info, input);
+    return 0;
+  }
+
   // Get state solver
   tesseract_environment::StateSolver::Ptr state_solver = input.env->getStateSolver();
-  tesseract_collision::ContinuousContactManager::Ptr manager = input.env->getContinuousContactManager();
-  manager->setCollisionMarginData(config.collision_margin_data);
 
-  // Set the active links based on the manipulator
-  std::vector<std::string> active_links_manip;
+  // Borrow a configured contact manager instead of cloning the collision world if the process has a pool
+  tesseract_collision::ContinuousContactManager::Ptr manager;
+  ContactManagerPool::Ptr contact_manager_pool = input.getContactManagerPool();
+  if (contact_manager_pool != nullptr)
+  {
+    manager = contact_manager_pool->borrowContinuousContactManager(
+        *input.env, input.manip_info.manipulator, config.collision_margin_data);
+  }
+  else
   {
-    tesseract_environment::AdjacencyMap::Ptr adjacency_map_manip =
-        std::make_shared<tesseract_environment::AdjacencyMap>(input.env->getSceneGraph(),
-                                                              input.env->getManipulatorManager()
-                                                                  ->getFwdKinematicSolver(input.manip_info.manipulator)
-                                                                  ->getActiveLinkNames(),
-                                                              input.env->getCurrentState()->link_transforms);
-    active_links_manip = adjacency_map_manip->getActiveLinkNames();
+    manager = input.env->getContinuousContactManager();
+    manager->setCollisionMarginData(config.collision_margin_data);
+
+    // Set the active links based on the manipulator
+    manager->setActiveCollisionObjects(getActiveLinkNames(*input.env, input.manip_info.manipulator));
   }
-  manager->setActiveCollisionObjects(active_links_manip);
 
   const auto& ci = input_results->as<CompositeInstruction>();
+  std::vector<std::reference_wrapper<const Instruction>> mi = flatten(ci, moveFilter);
+
+  std::size_t num_chunks = 1;
+  if (parallel && input.executor != nullptr && min_states_per_chunk > 0)
+    num_chunks = std::min(input.executor->num_workers(), mi.size() / min_states_per_chunk);
+
   std::vector<tesseract_collision::ContactResultMap> contacts;
-  if (contactCheckProgram(contacts, *manager, *state_solver, ci, config))
+  bool found{ false };
+  {
+    TraceSpan span(input.getTraceRecorder(), "Continuous Contact Check", "contact");
+    if (num_chunks > 1)
+      found = contactCheckProgramParallel(contacts, *manager, *state_solver, mi, config, input.executor, num_chunks);
+    else
+      found = contactCheckProgram(contacts, *manager, *state_solver, mi, 0, mi.size(), config);
+  }
+
+  if (found)
   {
     CONSOLE_BRIDGE_logInform("Results are not contact free for process input: %s!",
                              input_results->getDescription().c_str());
@@ -129,7 +129,7 @@ int FixStateBoundsTaskGenerator::conditionalProcess(TaskInput input, std::size_t
     break;
     case FixStateBoundsProfile::Settings::ALL:
     {
-      auto flattened = flatten(ci, planFilter);
+      auto flattened = flattenView(ci, planFilter);
       if (flattened.empty())
       {
         CONSOLE_BRIDGE_logWarn("FixStateBoundsTaskGenerator found no PlanInstructions to process");
@@ -139,17 +139,17 @@ int FixStateBoundsTaskGenerator::conditionalProcess(TaskInput input, std::size_t
       }
 
       bool outside_limits = false;
-      for (const auto& instruction : flattened)
+      for (const Instruction& instruction : flattened)
       {
-        outside_limits |= isWithinJointLimits(instruction.get().as<PlanInstruction>().getWaypoint(), limits);
+        outside_limits |= isWithinJointLimits(instruction.as<PlanInstruction>().getWaypoint(), limits);
       }
       if (!outside_limits)
         break;
 
       CONSOLE_BRIDGE_logInform("FixStateBoundsTaskGenerator is modifying the const input instructions");
-      for (const auto& instruction : flattened)
+      for (const Instruction& instruction : flattened)
       {
-        const Instruction* instr_const_ptr = &instruction.get();
+        const Instruction* instr_const_ptr = &instruction;
         Instruction* mutable_instruction = const_cast<Instruction*>(instr_const_ptr);
         auto& plan = mutable_instruction->as<PlanInstruction>();
         if (!clampToJointLimits(plan.getWaypoint(), limits, cur_composite_profile->max_deviation_global))
@@ -26,6 +26,9 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <console_bridge/console.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -53,12 +56,19 @@ bool StateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
   auto kin = env->getManipulatorManager()->getFwdKinematicSolver(input.manip_info.manipulator);
 
   std::vector<ContactResultMap> collisions;
-  DiscreteContactManager::Ptr manager = env->getDiscreteContactManager();
-  AdjacencyMap::Ptr adjacency_map = std::make_shared<tesseract_environment::AdjacencyMap>(
-      env->getSceneGraph(), kin->getActiveLinkNames(), env->getCurrentState()->link_transforms);
-
-  manager->setActiveCollisionObjects(adjacency_map->getActiveLinkNames());
-  manager->setCollisionMarginData(profile.collision_check_config.collision_margin_data);
+  DiscreteContactManager::Ptr manager;
+  ContactManagerPool::Ptr contact_manager_pool = input.getContactManagerPool();
+  if (contact_manager_pool != nullptr)
+  {
+    manager = contact_manager_pool->borrowDiscreteContactManager(
+        *env, input.manip_info.manipulator, profile.collision_check_config.collision_margin_data);
+  }
+  else
+  {
+    manager = env->getDiscreteContactManager();
+    manager->setActiveCollisionObjects(getActiveLinkNames(*env, input.manip_info.manipulator));
+    manager->setCollisionMarginData(profile.collision_check_config.collision_margin_data);
+  }
   collisions.clear();
 
   tesseract_environment::EnvState::Ptr state = env->getState(kin->getJointNames(), start_pos);
@@ -218,23 +228,108 @@ bool MoveWaypointFromCollisionRandomSampler(Waypoint& waypoint,
   const auto kin = input.env->getManipulatorManager()->getFwdKinematicSolver(input.manip_info.manipulator);
   Eigen::MatrixXd limits = kin->getLimits().joint_limits;
   Eigen::VectorXd range = limits.col(1).array() - limits.col(0).array();
-
+  const std::vector<std::string> joint_names = kin->getJointNames();
   assert(start_pos.size() == range.size());
-  for (int i = 0; i < profile.sampling_attempts; i++)
+
+  if (profile.sampling_attempts <= 0)
+    return false;
+
+  const auto batch_size = static_cast<std::size_t>(std::max(profile.sampling_batch_size, 1));
+  std::size_t num_chunks = 1;
+  if (input.executor != nullptr)
+    num_chunks = std::min(input.executor->num_workers(), batch_size);
+
+  // The collision checking is set up once for the waypoint, each chunk of a batch is checked with its own clones. The
+  // first batch is checked serially, so the clones are only created if it has no collision free sample.
+  std::vector<tesseract_collision::DiscreteContactManager::Ptr> managers(1);
+  std::vector<tesseract_environment::StateSolver::Ptr> state_solvers(1);
+  ContactManagerPool::Ptr contact_manager_pool = input.getContactManagerPool();
+  if (contact_manager_pool != nullptr)
   {
-    Eigen::VectorXd start_sampled_pos =
-        start_pos + Eigen::VectorXd::Random(start_pos.size()).cwiseProduct(range) * profile.jiggle_factor;
+    managers[0] = contact_manager_pool->borrowDiscreteContactManager(
+        *input.env, input.manip_info.manipulator, profile.collision_check_config.collision_margin_data);
+  }
+  else
+  {
+    managers[0] = input.env->getDiscreteContactManager();
+    managers[0]->setActiveCollisionObjects(getActiveLinkNames(*input.env, input.manip_info.manipulator));
+    managers[0]->setCollisionMarginData(profile.collision_check_config.collision_margin_data);
+  }
+
+  state_solvers[0] = input.env->getStateSolver();
+
+  const auto sampling_attempts = static_cast<std::size_t>(profile.sampling_attempts);
+  for (std::size_t attempt = 0; attempt < sampling_attempts; attempt += batch_size)
+  {
+    if (attempt > 0 && managers.size() < num_chunks)
+    {
+      managers.reserve(num_chunks);
+      state_solvers.reserve(num_chunks);
+      for (std::size_t i = 1; i < num_chunks; ++i)
+      {
+        managers.push_back(managers[0]->clone());
+        state_solvers.push_back(state_solvers[0]->clone());
+      }
+    }
+
+    // The samples are generated up front since the random number generator is not thread safe
+    const std::size_t num_samples = std::min(batch_size, sampling_attempts - attempt);
+    Eigen::MatrixXd samples(start_pos.size(), static_cast<Eigen::Index>(num_samples));
+    for (Eigen::Index j = 0; j < samples.cols(); ++j)
+    {
+      Eigen::VectorXd sampled_pos =
+          start_pos + Eigen::VectorXd::Random(start_pos.size()).cwiseProduct(range) * profile.jiggle_factor;
+
+      // Make sure it doesn't violate joint limits
+      samples.col(j) = sampled_pos.cwiseMax(limits.col(0)).cwiseMin(limits.col(1));
+    }
 
-    // Make sure it doesn't violate joint limits
-    Eigen::VectorXd sampled_pos = start_sampled_pos;
-    sampled_pos = sampled_pos.cwiseMax(limits.col(0));
-    sampled_pos = sampled_pos.cwiseMin(limits.col(1));
+    std::vector<int> collision_free(num_samples, 0);
+    std::atomic<bool> found{ false };
+    const std::size_t batch_chunks = managers.size();
+    parallelForChunks(input.executor, std::min(batch_chunks, num_samples), [&](std::size_t chunk) {
+      for (std::size_t j = chunk; j < num_samples; j += batch_chunks)
+      {
+        // The first collision free sample is used unless the samples are ranked by distance
+        if (found && !profile.sampling_rank_by_distance)
+          return;
+
+        std::vector<tesseract_collision::ContactResultMap> collisions;
+        tesseract_environment::EnvState::Ptr state =
+            state_solvers[chunk]->getState(joint_names, samples.col(static_cast<Eigen::Index>(j)));
+        if (!checkTrajectoryState(collisions, *managers[chunk], state, profile.collision_check_config))
+        {
+          collision_free[j] = 1;
+          found = true;
+        }
+      }
+    });
 
-    tesseract_collision::ContactResultMap contacts;
-    if (!StateInCollision(sampled_pos, input, profile, contacts))
+    if (!found)
+      continue;
+
+    std::size_t best = num_samples;
+    double best_distance = std::numeric_limits<double>::max();
+    for (std::size_t j = 0; j < num_samples; ++j)
     {
-      return setJointPosition(waypoint, sampled_pos);
+      if (collision_free[j] == 0)
+        continue;
+
+      if (!profile.sampling_rank_by_distance)
+      {
+        best = j;
+        break;
+      }
+
+      double distance = (samples.col(static_cast<Eigen::Index>(j)) - start_pos).norm();
+      if (distance < best_distance)
+      {
+        best = j;
+        best_distance = distance;
+      }
     }
+
+    return setJointPosition(waypoint, samples.col(static_cast<Eigen::Index>(best)));
   }
 
   return false;
@@ -358,6 +453,7 @@ int FixStateCollisionTaskGenerator::conditionalProcess(TaskInput input, std::siz
       {
         CONSOLE_BRIDGE_logWarn("FixStateCollisionTaskGenerator found no PlanInstructions to process");
         info->return_value = 1;
+        saveOutputs(info, input);
         return 1;
       }
 
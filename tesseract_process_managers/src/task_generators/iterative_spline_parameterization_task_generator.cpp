@@ -88,7 +88,7 @@ int IterativeSplineParameterizationTaskGenerator::conditionalProcess(TaskInput i
   cur_composite_profile = applyProfileOverrides(name_, cur_composite_profile, ci.profile_overrides);
 
   // Create data structures for checking for plan profile overrides
-  auto flattened = flatten(ci, moveFilter);
+  auto flattened = flattenView(ci, moveFilter);
   if (flattened.empty())
   {
     CONSOLE_BRIDGE_logWarn("Iterative spline time parameterization found no MoveInstructions to process");
@@ -97,15 +97,17 @@ int IterativeSplineParameterizationTaskGenerator::conditionalProcess(TaskInput i
     return 1;
   }
 
-  Eigen::VectorXd velocity_scaling_factors = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(flattened.size())) *
-                                             cur_composite_profile->max_velocity_scaling_factor;
-  Eigen::VectorXd acceleration_scaling_factors = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(flattened.size())) *
-                                                 cur_composite_profile->max_acceleration_scaling_factor;
+  const auto num_moves = static_cast<Eigen::Index>(flattened.size());
+  Eigen::VectorXd velocity_scaling_factors =
+      Eigen::VectorXd::Ones(num_moves) * cur_composite_profile->max_velocity_scaling_factor;
+  Eigen::VectorXd acceleration_scaling_factors =
+      Eigen::VectorXd::Ones(num_moves) * cur_composite_profile->max_acceleration_scaling_factor;
 
   // Loop over all PlanInstructions
-  for (Eigen::Index idx = 0; idx < static_cast<Eigen::Index>(flattened.size()); idx++)
+  Eigen::Index idx = 0;
+  for (auto it = flattened.begin(); it != flattened.end(); ++it, ++idx)
   {
-    const auto& mi = flattened[static_cast<std::size_t>(idx)].get().as<MoveInstruction>();
+    const auto& mi = it->as<MoveInstruction>();
     std::string plan_profile = mi.getProfile();
 
     // Check for remapping of the plan profile
@@ -37,8 +37,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
-MotionPlannerTaskGenerator::MotionPlannerTaskGenerator(std::shared_ptr<MotionPlanner> planner)
-  : TaskGenerator(planner->getName()), planner_(planner)
+MotionPlannerTaskGenerator::MotionPlannerTaskGenerator(std::shared_ptr<MotionPlanner> planner, double time_share)
+  : TaskGenerator(planner->getName()), planner_(planner), time_share_(time_share)
 {
 }
 
@@ -151,6 +151,17 @@ int MotionPlannerTaskGenerator::conditionalProcess(TaskInput input, std::size_t
   request.instructions = instructions;
   request.plan_profile_remapping = input.plan_profile_remapping;
   request.composite_profile_remapping = input.composite_profile_remapping;
+  request.cancellation_token = input.getTaskInterface()->getCancellationToken();
+  request.trace_recorder = input.getTraceRecorder();
+
+  // Only give the planner its share of the time remaining before the deadline of the request
+  if (time_share_ < 1.0 && request.cancellation_token->hasDeadline())
+  {
+    auto now = CancellationToken::Clock::now();
+    auto time = std::chrono::duration_cast<CancellationToken::Clock::duration>(
+        (request.cancellation_token->getDeadline() - now) * time_share_);
+    request.cancellation_token = std::make_shared<CancellationToken>(request.cancellation_token, now + time);
+  }
 
   // --------------------
   // Fill out response
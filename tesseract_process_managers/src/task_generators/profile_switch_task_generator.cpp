@@ -75,6 +75,8 @@ int ProfileSwitchTaskGenerator::conditionalProcess(TaskInput input, std::size_t
 
   // Return the value specified in the profile
   CONSOLE_BRIDGE_logDebug("ProfileSwitchProfile returning %d", cur_composite_profile->return_value);
+  info->return_value = cur_composite_profile->return_value;
+  saveOutputs(info, input);
   return cur_composite_profile->return_value;
 }
 
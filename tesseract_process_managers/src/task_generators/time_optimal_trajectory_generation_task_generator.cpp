@@ -96,8 +96,7 @@ int TimeOptimalTrajectoryGenerationTaskGenerator::conditionalProcess(TaskInput i
   cur_composite_profile = applyProfileOverrides(name_, cur_composite_profile, ci.profile_overrides);
 
   // Create data structures for checking for plan profile overrides
-  auto flattened = flatten(ci, moveFilter);
-  if (flattened.empty())
+  if (flattenView(ci, moveFilter).empty())
   {
     CONSOLE_BRIDGE_logWarn("TOTG found no MoveInstructions to process");
     info->return_value = 1;
@@ -32,8 +32,6 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_process_managers/taskflow_generators/cartesian_taskflow.h>
 
 #include <tesseract_process_managers/task_generators/motion_planner_task_generator.h>
-#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
-#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
 #include <tesseract_process_managers/task_generators/iterative_spline_parameterization_task_generator.h>
 #include <tesseract_process_managers/task_generators/seed_min_length_task_generator.h>
 
@@ -93,13 +91,14 @@ TaskflowContainer CartesianTaskflow::generateTaskflow(TaskInput input, TaskflowV
   auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<SimplePlannerPlanProfile>())
-      interpolator->plan_profiles = input.profiles->getProfileEntry<SimplePlannerPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+      interpolator->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<SimplePlannerCompositeProfile>())
-      interpolator->composite_profiles = input.profiles->getProfileEntry<SimplePlannerCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerCompositeProfile>())
+      interpolator->composite_profiles = *entry;
   }
-  TaskGenerator::UPtr interpolator_generator = std::make_unique<MotionPlannerTaskGenerator>(interpolator);
+  TaskGenerator::UPtr interpolator_generator =
+      std::make_unique<MotionPlannerTaskGenerator>(interpolator, params_.interpolator_time_share);
   interpolator_generator->assignConditionalTask(input, interpolator_task);
   container.generators.push_back(std::move(interpolator_generator));
 
@@ -115,10 +114,11 @@ TaskflowContainer CartesianTaskflow::generateTaskflow(TaskInput input, TaskflowV
   descartes_planner->problem_generator = &DefaultDescartesProblemGenerator<float>;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<DescartesPlanProfile<float>>())
-      descartes_planner->plan_profiles = input.profiles->getProfileEntry<DescartesPlanProfile<float>>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<DescartesPlanProfile<float>>())
+      descartes_planner->plan_profiles = *entry;
   }
-  auto descartes_generator = std::make_unique<MotionPlannerTaskGenerator>(descartes_planner);
+  auto descartes_generator =
+      std::make_unique<MotionPlannerTaskGenerator>(descartes_planner, params_.descartes_time_share);
   descartes_generator->assignConditionalTask(input, descartes_task);
   container.generators.push_back(std::move(descartes_generator));
 
@@ -127,16 +127,17 @@ TaskflowContainer CartesianTaskflow::generateTaskflow(TaskInput input, TaskflowV
   trajopt_planner->problem_generator = &DefaultTrajoptProblemGenerator;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<TrajOptPlanProfile>())
-      trajopt_planner->plan_profiles = input.profiles->getProfileEntry<TrajOptPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptPlanProfile>())
+      trajopt_planner->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<TrajOptCompositeProfile>())
-      trajopt_planner->composite_profiles = input.profiles->getProfileEntry<TrajOptCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptCompositeProfile>())
+      trajopt_planner->composite_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<TrajOptSolverProfile>())
-      trajopt_planner->solver_profiles = input.profiles->getProfileEntry<TrajOptSolverProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptSolverProfile>())
+      trajopt_planner->solver_profiles = *entry;
   }
-  TaskGenerator::UPtr trajopt_generator = std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner);
+  TaskGenerator::UPtr trajopt_generator =
+      std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner, params_.trajopt_time_share);
   trajopt_generator->assignConditionalTask(input, trajopt_task);
   container.generators.push_back(std::move(trajopt_generator));
 
@@ -144,10 +145,8 @@ TaskflowContainer CartesianTaskflow::generateTaskflow(TaskInput input, TaskflowV
   bool has_contact_check = (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check);
   if (has_contact_check)
   {
-    if (params_.enable_post_contact_continuous_check)
-      contact_check_generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
-    else if (params_.enable_post_contact_discrete_check)
-      contact_check_generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
   }
 
   TaskGenerator::UPtr time_parameterization_generator;
@@ -211,5 +210,9 @@ bool CartesianTaskflow::checkTaskInput(const tesseract_planning::TaskInput& inpu
     return false;
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
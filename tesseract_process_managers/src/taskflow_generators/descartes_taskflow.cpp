@@ -31,8 +31,6 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_process_managers/core/utils.h>
 #include <tesseract_process_managers/taskflow_generators/descartes_taskflow.h>
 #include <tesseract_process_managers/task_generators/motion_planner_task_generator.h>
-#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
-#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
 #include <tesseract_process_managers/task_generators/iterative_spline_parameterization_task_generator.h>
 
 #include <tesseract_motion_planners/simple/simple_motion_planner.h>
@@ -83,11 +81,11 @@ TaskflowContainer DescartesTaskflow::generateTaskflow(TaskInput input, TaskflowV
   auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<SimplePlannerPlanProfile>())
-      interpolator->plan_profiles = input.profiles->getProfileEntry<SimplePlannerPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+      interpolator->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<SimplePlannerCompositeProfile>())
-      interpolator->composite_profiles = input.profiles->getProfileEntry<SimplePlannerCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerCompositeProfile>())
+      interpolator->composite_profiles = *entry;
   }
   auto interpolator_generator = std::make_unique<MotionPlannerTaskGenerator>(interpolator);
   interpolator_generator->assignConditionalTask(input, interpolator_task);
@@ -98,8 +96,8 @@ TaskflowContainer DescartesTaskflow::generateTaskflow(TaskInput input, TaskflowV
   descartes_planner->problem_generator = &DefaultDescartesProblemGenerator<float>;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<DescartesPlanProfile<float>>())
-      descartes_planner->plan_profiles = input.profiles->getProfileEntry<DescartesPlanProfile<float>>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<DescartesPlanProfile<float>>())
+      descartes_planner->plan_profiles = *entry;
   }
   auto descartes_generator = std::make_unique<MotionPlannerTaskGenerator>(descartes_planner);
   descartes_generator->assignConditionalTask(input, descartes_task);
@@ -109,10 +107,8 @@ TaskflowContainer DescartesTaskflow::generateTaskflow(TaskInput input, TaskflowV
   bool has_contact_check = (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check);
   if (has_contact_check)
   {
-    if (params_.enable_post_contact_continuous_check)
-      contact_check_generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
-    else if (params_.enable_post_contact_discrete_check)
-      contact_check_generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
   }
 
   TaskGenerator::UPtr time_parameterization_generator;
@@ -176,5 +172,9 @@ bool DescartesTaskflow::checkTaskInput(const tesseract_planning::TaskInput& inpu
     return false;
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
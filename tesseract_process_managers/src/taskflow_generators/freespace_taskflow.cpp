@@ -25,14 +25,16 @@
  */
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <atomic>
 #include <functional>
+#include <utility>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_process_managers/core/utils.h>
 #include <tesseract_process_managers/taskflow_generators/freespace_taskflow.h>
 #include <tesseract_process_managers/task_generators/motion_planner_task_generator.h>
-#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
-#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
 #include <tesseract_process_managers/task_generators/iterative_spline_parameterization_task_generator.h>
 #include <tesseract_process_managers/task_generators/seed_min_length_task_generator.h>
 
@@ -49,6 +51,40 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 using namespace tesseract_planning;
 
+namespace
+{
+/** @brief The names of the branches of FreespaceTaskflowType::RACE */
+const std::array<std::string, 2> RACE_BRANCH_NAMES{ "TrajOpt", "OMPL" };
+
+/** @brief The state shared by the tasks of FreespaceTaskflowType::RACE, which is reset each time the race starts */
+struct FreespaceRace
+{
+  /** @brief The results of each branch, seeded with a copy of the process results */
+  std::vector<Instruction> results;
+
+  /** @brief The index of the first branch which passed, -1 if none has passed */
+  std::atomic<int> winner{ -1 };
+};
+}  // namespace
+
+static std::shared_ptr<TrajOptMotionPlanner> createTrajOptPlanner(const TaskInput& input)
+{
+  auto trajopt_planner = std::make_shared<TrajOptMotionPlanner>();
+  trajopt_planner->problem_generator = &DefaultTrajoptProblemGenerator;
+  if (input.profiles)
+  {
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptPlanProfile>())
+      trajopt_planner->plan_profiles = *entry;
+
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptCompositeProfile>())
+      trajopt_planner->composite_profiles = *entry;
+
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptSolverProfile>())
+      trajopt_planner->solver_profiles = *entry;
+  }
+  return trajopt_planner;
+}
+
 FreespaceTaskflow::FreespaceTaskflow(FreespaceTaskflowParams params, std::string name) : name_(name), params_(params) {}
 
 const std::string& FreespaceTaskflow::getName() const { return name_; }
@@ -65,6 +101,8 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   std::string name = name_;
   if (params_.type == FreespaceTaskflowType::TRAJOPT_FIRST)
     name += "(TrajOpt First)";
+  else if (params_.type == FreespaceTaskflowType::RACE)
+    name += "(Race)";
   else
     name += "(Default)";
 
@@ -85,9 +123,7 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   tf::Task has_seed_task = container.taskflow->emplace([=]() { return hasSeedTask(input); }).name("Has Seed Check");
 
   tf::Task interpolator_task = container.taskflow->placeholder();
-  tf::Task ompl_task = container.taskflow->placeholder();
   tf::Task seed_min_length_task = container.taskflow->placeholder();
-  tf::Task trajopt_task = container.taskflow->placeholder();
 
   has_seed_task.precede(interpolator_task, seed_min_length_task);
   interpolator_task.precede(error_task, seed_min_length_task);
@@ -96,13 +132,14 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<SimplePlannerPlanProfile>())
-      interpolator->plan_profiles = input.profiles->getProfileEntry<SimplePlannerPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+      interpolator->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<SimplePlannerCompositeProfile>())
-      interpolator->composite_profiles = input.profiles->getProfileEntry<SimplePlannerCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerCompositeProfile>())
+      interpolator->composite_profiles = *entry;
   }
-  auto interpolator_generator = std::make_unique<MotionPlannerTaskGenerator>(interpolator);
+  auto interpolator_generator =
+      std::make_unique<MotionPlannerTaskGenerator>(interpolator, params_.interpolator_time_share);
   interpolator_generator->assignConditionalTask(input, interpolator_task);
   container.generators.push_back(std::move(interpolator_generator));
 
@@ -110,31 +147,31 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   seed_min_length_generator->assignTask(input, seed_min_length_task);
   container.generators.push_back(std::move(seed_min_length_generator));
 
+  if (params_.type == FreespaceTaskflowType::RACE)
+  {
+    addRaceTasks(container, input, seed_min_length_task, error_task, done_task);
+    return container;
+  }
+
+  tf::Task ompl_task = container.taskflow->placeholder();
+  tf::Task trajopt_task = container.taskflow->placeholder();
+
   auto ompl_planner = std::make_shared<OMPLMotionPlanner>();
   ompl_planner->problem_generator = &DefaultOMPLProblemGenerator;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<OMPLPlanProfile>())
-      ompl_planner->plan_profiles = input.profiles->getProfileEntry<OMPLPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<OMPLPlanProfile>())
+      ompl_planner->plan_profiles = *entry;
   }
-  auto ompl_generator = std::make_unique<MotionPlannerTaskGenerator>(ompl_planner);
+  auto ompl_generator = std::make_unique<MotionPlannerTaskGenerator>(ompl_planner, params_.ompl_time_share);
   ompl_generator->assignTask(input, ompl_task);
   container.generators.push_back(std::move(ompl_generator));
 
-  auto trajopt_planner = std::make_shared<TrajOptMotionPlanner>();
-  trajopt_planner->problem_generator = &DefaultTrajoptProblemGenerator;
-  if (input.profiles)
-  {
-    if (input.profiles->hasProfileEntry<TrajOptPlanProfile>())
-      trajopt_planner->plan_profiles = input.profiles->getProfileEntry<TrajOptPlanProfile>();
-
-    if (input.profiles->hasProfileEntry<TrajOptCompositeProfile>())
-      trajopt_planner->composite_profiles = input.profiles->getProfileEntry<TrajOptCompositeProfile>();
-
-    if (input.profiles->hasProfileEntry<TrajOptSolverProfile>())
-      trajopt_planner->solver_profiles = input.profiles->getProfileEntry<TrajOptSolverProfile>();
-  }
-  auto trajopt_generator = std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner);
+  auto trajopt_planner = createTrajOptPlanner(input);
+  // The first TrajOpt stage of TRAJOPT_FIRST runs before OMPL, so it is given the OMPL share
+  double trajopt_time_share =
+      (params_.type == FreespaceTaskflowType::TRAJOPT_FIRST) ? params_.ompl_time_share : params_.trajopt_time_share;
+  auto trajopt_generator = std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner, trajopt_time_share);
   trajopt_generator->assignConditionalTask(input, trajopt_task);
   container.generators.push_back(std::move(trajopt_generator));
 
@@ -142,10 +179,8 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   bool has_contact_check = (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check);
   if (has_contact_check)
   {
-    if (params_.enable_post_contact_continuous_check)
-      contact_check_generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
-    else if (params_.enable_post_contact_discrete_check)
-      contact_check_generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
   }
 
   TaskGenerator::UPtr time_parameterization_generator;
@@ -159,20 +194,9 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
     tf::Task trajopt_second_task = container.taskflow->placeholder();
 
     // Setup TrajOpt
-    auto trajopt_planner2 = std::make_shared<TrajOptMotionPlanner>();
-    trajopt_planner2->problem_generator = &DefaultTrajoptProblemGenerator;
-    if (input.profiles)
-    {
-      if (input.profiles->hasProfileEntry<TrajOptPlanProfile>())
-        trajopt_planner2->plan_profiles = input.profiles->getProfileEntry<TrajOptPlanProfile>();
-
-      if (input.profiles->hasProfileEntry<TrajOptCompositeProfile>())
-        trajopt_planner2->composite_profiles = input.profiles->getProfileEntry<TrajOptCompositeProfile>();
-
-      if (input.profiles->hasProfileEntry<TrajOptSolverProfile>())
-        trajopt_planner2->solver_profiles = input.profiles->getProfileEntry<TrajOptSolverProfile>();
-    }
-    TaskGenerator::UPtr trajopt_generator2 = std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner2);
+    auto trajopt_planner2 = createTrajOptPlanner(input);
+    TaskGenerator::UPtr trajopt_generator2 =
+        std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner2, params_.trajopt_time_share);
     trajopt_generator2->assignConditionalTask(input, trajopt_second_task);
     container.generators.push_back(std::move(trajopt_generator2));
 
@@ -267,6 +291,132 @@ TaskflowContainer FreespaceTaskflow::generateTaskflow(TaskInput input, TaskflowV
   return container;
 }
 
+void FreespaceTaskflow::addRaceTasks(TaskflowContainer& container,
+                                     TaskInput input,
+                                     tf::Task& seed_task,
+                                     tf::Task& error_task,
+                                     tf::Task& done_task) const
+{
+  // Each branch has its own planners since they run at the same time
+  auto ompl_planner = std::make_shared<OMPLMotionPlanner>();
+  ompl_planner->problem_generator = &DefaultOMPLProblemGenerator;
+  if (input.profiles)
+  {
+    if (auto entry = input.profiles->getProfileEntrySnapshot<OMPLPlanProfile>())
+      ompl_planner->plan_profiles = *entry;
+  }
+  auto ompl_generator = std::make_unique<MotionPlannerTaskGenerator>(ompl_planner, params_.ompl_time_share);
+  std::array<TaskGenerator::UPtr, 2> trajopt_generators{
+    std::make_unique<MotionPlannerTaskGenerator>(createTrajOptPlanner(input), params_.trajopt_time_share),
+    std::make_unique<MotionPlannerTaskGenerator>(createTrajOptPlanner(input), params_.trajopt_time_share)
+  };
+
+  // The contact check only reads its input, so it is shared by both branches
+  TaskGenerator::UPtr contact_check_generator;
+  if (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check)
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
+
+  TaskGenerator* ompl = ompl_generator.get();
+  std::array<TaskGenerator*, 2> trajopt{ trajopt_generators[0].get(), trajopt_generators[1].get() };
+  TaskGenerator* contact_check = contact_check_generator.get();
+
+  auto race = std::make_shared<FreespaceRace>();
+  auto race_fn = [=](tf::Subflow& subflow) mutable {
+    race->winner = -1;
+    race->results.assign(2, *std::as_const(input).getResults());
+    std::array<TaskInput, 2> branches{ input.createBranch(&(race->results[0])),
+                                       input.createBranch(&(race->results[1])) };
+
+    for (std::size_t i = 0; i < branches.size(); ++i)
+    {
+      TaskInput branch = branches[i];
+      TaskInput other = branches[1 - i];
+      int index = static_cast<int>(i);
+
+      tf::Task failed_task = subflow.placeholder().name(RACE_BRANCH_NAMES[i] + " Failed");
+      tf::Task passed_task = subflow
+                                 .emplace([race, other, index]() mutable {
+                                   // Only the first branch to pass keeps its results, the other is aborted
+                                   int none = -1;
+                                   if (race->winner.compare_exchange_strong(none, index))
+                                     other.abort();
+                                 })
+                                 .name(RACE_BRANCH_NAMES[i] + " Passed");
+
+      tf::Task trajopt_task = subflow.placeholder();
+      trajopt[i]->assignConditionalTask(branch, trajopt_task);
+      if (contact_check != nullptr)
+      {
+        tf::Task contact_task = subflow.placeholder();
+        contact_check->assignConditionalTask(branch, contact_task);
+        trajopt_task.precede(failed_task, contact_task);
+        contact_task.precede(failed_task, passed_task);
+      }
+      else
+      {
+        trajopt_task.precede(failed_task, passed_task);
+      }
+
+      // The OMPL branch ends if OMPL fails, since TrajOpt from the interpolated seed is already the other branch
+      if (i == 1)
+      {
+        tf::Task ompl_task = subflow.placeholder();
+        ompl->assignConditionalTask(branch, ompl_task);
+        ompl_task.precede(failed_task, trajopt_task);
+      }
+    }
+  };
+  tf::Task race_task = container.taskflow->emplace(race_fn).name("Race");
+  seed_task.precede(race_task);
+
+  tf::Task result_task = container.taskflow->placeholder();
+  std::size_t unique_id = result_task.hash_value();
+  auto result_fn = [=]() mutable {
+    auto info = std::make_shared<TaskInfo>(unique_id, "Race Result");
+    info->return_value = 0;
+
+    int winner = race->winner;
+    if (winner < 0 || input.isAborted())
+    {
+      info->message = "No planner passed";
+    }
+    else
+    {
+      *input.getResults() = race->results[static_cast<std::size_t>(winner)];
+      info->message = RACE_BRANCH_NAMES[static_cast<std::size_t>(winner)];
+      info->return_value = 1;
+    }
+
+    race->results.clear();
+    input.addTaskInfo(info);
+    saveOutputs(info, input);
+    return info->return_value;
+  };
+  result_task.work(result_fn).name("Race Result");
+  race_task.precede(result_task);
+
+  if (params_.enable_time_parameterization)
+  {
+    tf::Task time_task = container.taskflow->placeholder();
+    auto time_parameterization_generator = std::make_unique<IterativeSplineParameterizationTaskGenerator>();
+    time_parameterization_generator->assignConditionalTask(input, time_task);
+    container.generators.push_back(std::move(time_parameterization_generator));
+    result_task.precede(error_task, time_task);
+    time_task.precede(error_task, done_task);
+  }
+  else
+  {
+    result_task.precede(error_task, done_task);
+  }
+
+  container.generators.push_back(std::move(ompl_generator));
+  container.generators.push_back(std::move(trajopt_generators[0]));
+  container.generators.push_back(std::move(trajopt_generators[1]));
+  if (contact_check_generator != nullptr)
+    container.generators.push_back(std::move(contact_check_generator));
+}
+
 bool FreespaceTaskflow::checkTaskInput(const tesseract_planning::TaskInput& input) const
 {
   // Check Input
@@ -284,5 +434,9 @@ bool FreespaceTaskflow::checkTaskInput(const tesseract_planning::TaskInput& inpu
     return false;
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
@@ -32,8 +32,6 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_process_managers/taskflow_generators/ompl_taskflow.h>
 
 #include <tesseract_process_managers/task_generators/motion_planner_task_generator.h>
-#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
-#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
 #include <tesseract_process_managers/task_generators/iterative_spline_parameterization_task_generator.h>
 
 #include <tesseract_motion_planners/simple/simple_motion_planner.h>
@@ -84,11 +82,11 @@ TaskflowContainer OMPLTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn
   auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<SimplePlannerPlanProfile>())
-      interpolator->plan_profiles = input.profiles->getProfileEntry<SimplePlannerPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+      interpolator->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<SimplePlannerCompositeProfile>())
-      interpolator->composite_profiles = input.profiles->getProfileEntry<SimplePlannerCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerCompositeProfile>())
+      interpolator->composite_profiles = *entry;
   }
   auto interpolator_generator = std::make_unique<MotionPlannerTaskGenerator>(interpolator);
   interpolator_generator->assignConditionalTask(input, interpolator_task);
@@ -99,8 +97,8 @@ TaskflowContainer OMPLTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn
   ompl_planner->problem_generator = &DefaultOMPLProblemGenerator;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<OMPLPlanProfile>())
-      ompl_planner->plan_profiles = input.profiles->getProfileEntry<OMPLPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<OMPLPlanProfile>())
+      ompl_planner->plan_profiles = *entry;
   }
   auto ompl_generator = std::make_unique<MotionPlannerTaskGenerator>(ompl_planner);
   ompl_generator->assignConditionalTask(input, ompl_task);
@@ -110,10 +108,8 @@ TaskflowContainer OMPLTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn
   bool has_contact_check = (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check);
   if (has_contact_check)
   {
-    if (params_.enable_post_contact_continuous_check)
-      contact_check_generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
-    else if (params_.enable_post_contact_discrete_check)
-      contact_check_generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
   }
 
   TaskGenerator::UPtr time_parameterization_generator;
@@ -177,5 +173,9 @@ bool OMPLTaskflow::checkTaskInput(const tesseract_planning::TaskInput& input) co
     return false;
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
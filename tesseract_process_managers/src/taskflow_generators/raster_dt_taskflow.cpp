@@ -54,6 +54,13 @@ RasterDTTaskflow::RasterDTTaskflow(TaskflowGenerator::UPtr freespace_taskflow_ge
 
 const std::string& RasterDTTaskflow::getName() const { return name_; }
 
+std::map<std::size_t, std::size_t>
+RasterDTTaskflow::getReusableSegments(const CompositeInstruction& program,
+                                      const CompositeInstruction& previous_program) const
+{
+  return getReusableRasterSegments(program, previous_program, 1);
+}
+
 TaskflowContainer RasterDTTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn done_cb, TaskflowVoidFn error_cb)
 {
   // This should make all of the isComposite checks so that you can safely cast below
@@ -72,38 +79,29 @@ TaskflowContainer RasterDTTaskflow::generateTaskflow(TaskInput input, TaskflowVo
   std::size_t raster_idx = 0;
   for (std::size_t idx = 1; idx < input.size() - 1; idx += 2)
   {
-    // Get Start Plan Instruction
-    Instruction start_instruction{ NullInstruction() };
-    if (idx == 1)
+    // The start instruction is the last plan instruction of the from start or the first transition composite
+    TaskInput raster_input = input[idx];
+    raster_input.setStartInstructionFn(lastPlanInstructionFn((idx == 1) ? input[0] : input[idx - 1][0]));
+    tf::Task raster_step;
+    if (input.reused_segments.count(idx) > 0)
     {
-      assert(isCompositeInstruction(*(input[0].getInstruction())));
-      const auto& ci = input[0].getInstruction()->as<CompositeInstruction>();
-      const auto* li = getLastPlanInstruction(ci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      raster_step = emplaceReusedSegmentTask(*container.taskflow, input, raster_input, name_, done_cb);
     }
     else
     {
-      assert(isCompositeInstruction(*(input[idx - 1].getInstruction())));
-      const auto& tci = input[idx - 1].getInstruction()->as<CompositeInstruction>();
-      assert(isCompositeInstruction(tci[0]));
-      const auto& ci = tci[0].as<CompositeInstruction>();
-      const auto* li = getLastPlanInstruction(ci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
+          raster_input,
+          [=]() {
+            publishSegment(raster_input);
+            successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
+
+      raster_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
     }
 
-    start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
-    TaskInput raster_input = input[idx];
-    raster_input.setStartInstruction(start_instruction);
-    TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
-        raster_input,
-        [=]() { successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
-
-    auto raster_step =
-        container.taskflow->composed_of(*(sub_container.taskflow)).name("raster_" + std::to_string(raster_idx + 1));
-    container.containers.push_back(std::move(sub_container));
+    raster_step.name("raster_" + std::to_string(raster_idx + 1));
     container.input.precede(raster_step);
     tasks.push_back(raster_step);
     raster_idx++;
@@ -118,17 +116,33 @@ TaskflowContainer RasterDTTaskflow::generateTaskflow(TaskInput input, TaskflowVo
     // composite and let the generateTaskflow extract the start and end waypoint from the composite. This is also more
     // robust because planners could modify composite size, which is rare but does happen when using OMPL where it is
     // not possible to simplify the trajectory to the desired number of states.
+    const bool reused = (input.reused_segments.count(input_idx) > 0);
     TaskInput transition_from_end_input = input[input_idx][0];
     transition_from_end_input.setStartInstruction(std::vector<std::size_t>({ input_idx - 1 }));
     transition_from_end_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1 }));
-    TaskflowContainer sub_container1 = transition_taskflow_generator_->generateTaskflow(
-        transition_from_end_input,
-        [=]() { successTask(input, name_, transition_from_end_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, transition_from_end_input.getInstruction()->getDescription(), error_cb); });
+    tf::Task transition_from_end_step;
+    if (reused)
+    {
+      transition_from_end_step =
+          emplaceReusedSegmentTask(*container.taskflow, input, transition_from_end_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container1 = transition_taskflow_generator_->generateTaskflow(
+          transition_from_end_input,
+          [=]() {
+            publishSegment(transition_from_end_input);
+            successTask(input, name_, transition_from_end_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() {
+            failureTask(input, name_, transition_from_end_input.getInstruction()->getDescription(), error_cb);
+          });
+
+      transition_from_end_step = container.taskflow->composed_of(*(sub_container1.taskflow));
+      container.containers.push_back(std::move(sub_container1));
+    }
 
-    auto transition_from_end_step = container.taskflow->composed_of(*(sub_container1.taskflow))
-                                        .name("transition_from_end_" + std::to_string(transition_idx + 1));
-    container.containers.push_back(std::move(sub_container1));
+    transition_from_end_step.name("transition_from_end_" + std::to_string(transition_idx + 1));
 
     // Each transition is independent and thus depends only on the adjacent rasters
     transition_from_end_step.succeed(tasks[transition_idx]);
@@ -137,14 +151,29 @@ TaskflowContainer RasterDTTaskflow::generateTaskflow(TaskInput input, TaskflowVo
     TaskInput transition_to_start_input = input[input_idx][1];
     transition_to_start_input.setStartInstruction(std::vector<std::size_t>({ input_idx + 1 }));
     transition_to_start_input.setEndInstruction(std::vector<std::size_t>({ input_idx - 1 }));
-    TaskflowContainer sub_container2 = transition_taskflow_generator_->generateTaskflow(
-        transition_to_start_input,
-        [=]() { successTask(input, name_, transition_to_start_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, transition_to_start_input.getInstruction()->getDescription(), error_cb); });
+    tf::Task transition_to_start_step;
+    if (reused)
+    {
+      transition_to_start_step =
+          emplaceReusedSegmentTask(*container.taskflow, input, transition_to_start_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container2 = transition_taskflow_generator_->generateTaskflow(
+          transition_to_start_input,
+          [=]() {
+            publishSegment(transition_to_start_input);
+            successTask(input, name_, transition_to_start_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() {
+            failureTask(input, name_, transition_to_start_input.getInstruction()->getDescription(), error_cb);
+          });
+
+      transition_to_start_step = container.taskflow->composed_of(*(sub_container2.taskflow));
+      container.containers.push_back(std::move(sub_container2));
+    }
 
-    auto transition_to_start_step = container.taskflow->composed_of(*(sub_container2.taskflow))
-                                        .name("transition_to_start" + std::to_string(transition_idx + 1));
-    container.containers.push_back(std::move(sub_container2));
+    transition_to_start_step.name("transition_to_start" + std::to_string(transition_idx + 1));
 
     // Each transition is independent and thus depends only on the adjacent rasters
     transition_to_start_step.succeed(tasks[transition_idx]);
@@ -155,27 +184,53 @@ TaskflowContainer RasterDTTaskflow::generateTaskflow(TaskInput input, TaskflowVo
 
   // Plan from_start - preceded by the first raster
   TaskInput from_start_input = input[0];
-  from_start_input.setStartInstruction(input.getInstruction()->as<CompositeInstruction>().getStartInstruction());
+  from_start_input.setStartInstructionFn(startInstructionFn(input));
   from_start_input.setEndInstruction(std::vector<std::size_t>({ 1 }));
-  TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
-      from_start_input,
-      [=]() { successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
+  tf::Task from_start;
+  if (input.reused_segments.count(0) > 0)
+  {
+    from_start = emplaceReusedSegmentTask(*container.taskflow, input, from_start_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
+        from_start_input,
+        [=]() {
+          publishSegment(from_start_input);
+          successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
+
+    from_start = container.taskflow->composed_of(*(sub_container1.taskflow));
+    container.containers.push_back(std::move(sub_container1));
+  }
 
-  auto from_start = container.taskflow->composed_of(*(sub_container1.taskflow)).name("from_start");
-  container.containers.push_back(std::move(sub_container1));
+  from_start.name("from_start");
   tasks[0].precede(from_start);
 
   // Plan to_end - preceded by the last raster
   TaskInput to_end_input = input[input.size() - 1];
   to_end_input.setStartInstruction(std::vector<std::size_t>({ input.size() - 2 }));
-  TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
-      to_end_input,
-      [=]() { successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
+  tf::Task to_end;
+  if (input.reused_segments.count(input.size() - 1) > 0)
+  {
+    to_end = emplaceReusedSegmentTask(*container.taskflow, input, to_end_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
+        to_end_input,
+        [=]() {
+          publishSegment(to_end_input);
+          successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
+
+    to_end = container.taskflow->composed_of(*(sub_container2.taskflow));
+    container.containers.push_back(std::move(sub_container2));
+  }
 
-  auto to_end = container.taskflow->composed_of(*(sub_container2.taskflow)).name("to_end");
-  container.containers.push_back(std::move(sub_container2));
+  to_end.name("to_end");
   tasks.back().precede(to_end);
 
   return container;
@@ -270,5 +325,9 @@ bool RasterDTTaskflow::checkTaskInput(const tesseract_planning::TaskInput& input
     return false;
   };
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
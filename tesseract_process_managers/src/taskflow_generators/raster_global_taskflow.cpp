@@ -71,11 +71,10 @@ TaskflowContainer RasterGlobalTaskflow::generateTaskflow(TaskInput input,
   container.taskflow = std::make_unique<tf::Taskflow>(name_);
   std::vector<tf::Task> tasks;
 
-  const Instruction* input_instruction = input.getInstruction();
   TaskflowContainer sub_container = global_taskflow_generator_->generateTaskflow(
       input,
-      [=]() { successTask(input, name_, input_instruction->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, input_instruction->getDescription(), error_cb); });
+      [=]() { successTask(input, name_, input.getInstruction()->getDescription(), done_cb); },
+      [=]() { failureTask(input, name_, input.getInstruction()->getDescription(), error_cb); });
 
   auto global_task = container.taskflow->composed_of(*(sub_container.taskflow)).name("global");
   container.containers.push_back(std::move(sub_container));
@@ -93,7 +92,10 @@ TaskflowContainer RasterGlobalTaskflow::generateTaskflow(TaskInput input,
     raster_input.setEndInstruction(std::vector<std::size_t>({ idx + 1 }));
     TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
         raster_input,
-        [=]() { successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb); },
+        [=]() {
+          publishSegment(raster_input);
+          successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb);
+        },
         [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
 
     auto raster_step =
@@ -119,7 +121,10 @@ TaskflowContainer RasterGlobalTaskflow::generateTaskflow(TaskInput input,
     transition_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1 }));
     TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
         transition_input,
-        [=]() { successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb); },
+        [=]() {
+          publishSegment(transition_input);
+          successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb);
+        },
         [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
 
     auto transition_step = container.taskflow->composed_of(*(sub_container.taskflow))
@@ -136,12 +141,15 @@ TaskflowContainer RasterGlobalTaskflow::generateTaskflow(TaskInput input,
 
   // Plan from_start - preceded by the first raster
   TaskInput from_start_input = input[0];
-  from_start_input.setStartInstruction(input_instruction->as<CompositeInstruction>().getStartInstruction());
+  from_start_input.setStartInstructionFn(startInstructionFn(input));
   from_start_input.setEndInstruction(std::vector<std::size_t>({ 1 }));
 
   TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
       from_start_input,
-      [=]() { successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb); },
+      [=]() {
+        publishSegment(from_start_input);
+        successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb);
+      },
       [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
 
   auto from_start = container.taskflow->composed_of(*(sub_container1.taskflow))
@@ -154,7 +162,10 @@ TaskflowContainer RasterGlobalTaskflow::generateTaskflow(TaskInput input,
   to_end_input.setStartInstruction(std::vector<std::size_t>({ input.size() - 2 }));
   TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
       to_end_input,
-      [=]() { successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb); },
+      [=]() {
+        publishSegment(to_end_input);
+        successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb);
+      },
       [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
 
   auto to_end = container.taskflow->composed_of(*(sub_container2.taskflow))
@@ -238,5 +249,9 @@ bool RasterGlobalTaskflow::checkTaskInput(const tesseract_planning::TaskInput& i
     return false;
   };
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
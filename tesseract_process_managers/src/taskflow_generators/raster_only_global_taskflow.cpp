@@ -69,11 +69,10 @@ TaskflowContainer RasterOnlyGlobalTaskflow::generateTaskflow(TaskInput input,
   container.taskflow = std::make_unique<tf::Taskflow>(name_);
   std::vector<tf::Task> tasks;
 
-  const Instruction* input_instruction = input.getInstruction();
   TaskflowContainer sub_container = global_taskflow_generator_->generateTaskflow(
       input,
-      [=]() { successTask(input, name_, input_instruction->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, input_instruction->getDescription(), error_cb); });
+      [=]() { successTask(input, name_, input.getInstruction()->getDescription(), done_cb); },
+      [=]() { failureTask(input, name_, input.getInstruction()->getDescription(), error_cb); });
 
   container.input = container.taskflow->composed_of(*(sub_container.taskflow)).name("global");
   container.containers.push_back(std::move(sub_container));
@@ -88,7 +87,7 @@ TaskflowContainer RasterOnlyGlobalTaskflow::generateTaskflow(TaskInput input,
   {
     TaskInput raster_input = input[idx];
     if (idx == 0)
-      raster_input.setStartInstruction(input_instruction->as<CompositeInstruction>().getStartInstruction());
+      raster_input.setStartInstructionFn(startInstructionFn(input));
     else
       raster_input.setStartInstruction(std::vector<std::size_t>({ idx - 1 }));
 
@@ -97,7 +96,10 @@ TaskflowContainer RasterOnlyGlobalTaskflow::generateTaskflow(TaskInput input,
 
     TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
         raster_input,
-        [=]() { successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb); },
+        [=]() {
+          publishSegment(raster_input);
+          successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb);
+        },
         [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
 
     auto raster_step =
@@ -123,7 +125,10 @@ TaskflowContainer RasterOnlyGlobalTaskflow::generateTaskflow(TaskInput input,
     transition_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1 }));
     TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
         transition_input,
-        [=]() { successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb); },
+        [=]() {
+          publishSegment(transition_input);
+          successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb);
+        },
         [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
 
     auto transition_step = container.taskflow->composed_of(*(sub_container.taskflow))
@@ -200,5 +205,9 @@ bool RasterOnlyGlobalTaskflow::checkTaskInput(const tesseract_planning::TaskInpu
     }
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
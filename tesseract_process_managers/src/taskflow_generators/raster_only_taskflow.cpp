@@ -52,6 +52,13 @@ RasterOnlyTaskflow::RasterOnlyTaskflow(TaskflowGenerator::UPtr transition_taskfl
 
 const std::string& RasterOnlyTaskflow::getName() const { return name_; }
 
+std::map<std::size_t, std::size_t>
+RasterOnlyTaskflow::getReusableSegments(const CompositeInstruction& program,
+                                        const CompositeInstruction& previous_program) const
+{
+  return getReusableRasterSegments(program, previous_program, 0);
+}
+
 TaskflowContainer RasterOnlyTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn done_cb, TaskflowVoidFn error_cb)
 {
   // This should make all of the isComposite checks so that you can safely cast below
@@ -68,39 +75,44 @@ TaskflowContainer RasterOnlyTaskflow::generateTaskflow(TaskInput input, Taskflow
 
   // Generate all of the raster tasks. They don't depend on anything
   std::size_t raster_idx = 0;
-  const Instruction* input_instruction = input.getInstruction();
   for (std::size_t idx = 0; idx < input.size(); idx += 2)
   {
-    // Get Start Plan Instruction
-    Instruction start_instruction{ NullInstruction() };
+    // The start instruction is the program start or the last plan instruction of the previous transition
+    TaskInput raster_input = input[idx];
     if (idx == 0)
     {
-      assert(isCompositeInstruction(*input_instruction));
-      start_instruction = input_instruction->as<CompositeInstruction>().getStartInstruction();
+      raster_input.setStartInstructionFn([input]() {
+        Instruction start_instruction = startInstructionFn(input)();
+        start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
+        return start_instruction;
+      });
     }
     else
     {
-      TaskInput pre_input = input[idx - 1];
-      const Instruction* pre_input_instruction = pre_input.getInstruction();
-      assert(isCompositeInstruction(*pre_input_instruction));
-      const auto& tci = pre_input_instruction->as<CompositeInstruction>();
-      auto* li = getLastPlanInstruction(tci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      raster_input.setStartInstructionFn(lastPlanInstructionFn(input[idx - 1]));
     }
 
-    start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
-    TaskInput raster_input = input[idx];
-    raster_input.setStartInstruction(start_instruction);
-    TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
-        raster_input,
-        [=]() { successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
-
-    auto raster_step =
-        container.taskflow->composed_of(*(sub_container.taskflow))
-            .name("Raster #" + std::to_string(raster_idx + 1) + ": " + raster_input.getInstruction()->getDescription());
-    container.containers.push_back(std::move(sub_container));
+    tf::Task raster_step;
+    if (input.reused_segments.count(idx) > 0)
+    {
+      raster_step = emplaceReusedSegmentTask(*container.taskflow, input, raster_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
+          raster_input,
+          [=]() {
+            publishSegment(raster_input);
+            successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
+
+      raster_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
+    }
+
+    raster_step.name("Raster #" + std::to_string(raster_idx + 1) + ": " +
+                     raster_input.getInstruction()->getDescription());
     container.input.precede(raster_step);
     tasks.push_back(raster_step);
     raster_idx++;
@@ -118,15 +130,27 @@ TaskflowContainer RasterOnlyTaskflow::generateTaskflow(TaskInput input, Taskflow
     TaskInput transition_input = input[input_idx];
     transition_input.setStartInstruction(std::vector<std::size_t>({ input_idx - 1 }));
     transition_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1 }));
-    TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
-        transition_input,
-        [=]() { successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
+    tf::Task transition_step;
+    if (input.reused_segments.count(input_idx) > 0)
+    {
+      transition_step = emplaceReusedSegmentTask(*container.taskflow, input, transition_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
+          transition_input,
+          [=]() {
+            publishSegment(transition_input);
+            successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
+
+      transition_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
+    }
 
-    auto transition_step = container.taskflow->composed_of(*(sub_container.taskflow))
-                               .name("Transition #" + std::to_string(transition_idx + 1) + ": " +
-                                     transition_input.getInstruction()->getDescription());
-    container.containers.push_back(std::move(sub_container));
+    transition_step.name("Transition #" + std::to_string(transition_idx + 1) + ": " +
+                         transition_input.getInstruction()->getDescription());
 
     // Each transition is independent and thus depends only on the adjacent rasters
     transition_step.succeed(tasks[transition_idx]);
@@ -176,5 +200,9 @@ bool RasterOnlyTaskflow::checkTaskInput(const tesseract_planning::TaskInput& inp
     }
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
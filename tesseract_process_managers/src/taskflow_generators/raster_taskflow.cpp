@@ -54,6 +54,13 @@ RasterTaskflow::RasterTaskflow(TaskflowGenerator::UPtr freespace_taskflow_genera
 
 const std::string& RasterTaskflow::getName() const { return name_; }
 
+std::map<std::size_t, std::size_t>
+RasterTaskflow::getReusableSegments(const CompositeInstruction& program,
+                                    const CompositeInstruction& previous_program) const
+{
+  return getReusableRasterSegments(program, previous_program, 1);
+}
+
 TaskflowContainer RasterTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn done_cb, TaskflowVoidFn error_cb)
 {
   // This should make all of the isComposite checks so that you can safely cast below
@@ -70,44 +77,32 @@ TaskflowContainer RasterTaskflow::generateTaskflow(TaskInput input, TaskflowVoid
 
   // Generate all of the raster tasks. They don't depend on anything
   std::size_t raster_idx = 0;
-  const Instruction* input_instruction = input.getInstruction();
   for (std::size_t idx = 1; idx < input.size() - 1; idx += 2)
   {
-    // Get Start Plan Instruction
-    Instruction start_instruction{ NullInstruction() };
-    if (idx == 1)
+    // The start instruction is the last plan instruction of the previous composite
+    TaskInput raster_input = input[idx];
+    raster_input.setStartInstructionFn(lastPlanInstructionFn(input[idx - 1]));
+    tf::Task raster_step;
+    if (input.reused_segments.count(idx) > 0)
     {
-      TaskInput from_start_input = input[0];
-      const Instruction* from_start_input_instruction = from_start_input.getInstruction();
-      assert(isCompositeInstruction(*from_start_input_instruction));
-      const auto& ci = from_start_input_instruction->as<CompositeInstruction>();
-      const auto* li = getLastPlanInstruction(ci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      raster_step = emplaceReusedSegmentTask(*container.taskflow, input, raster_input, name_, done_cb);
     }
     else
     {
-      TaskInput pre_input = input[idx - 1];
-      const Instruction* pre_input_instruction = pre_input.getInstruction();
-      assert(isCompositeInstruction(*pre_input_instruction));
-      const auto& tci = pre_input_instruction->as<CompositeInstruction>();
-      auto* li = getLastPlanInstruction(tci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
+          raster_input,
+          [=]() {
+            publishSegment(raster_input);
+            successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
+
+      raster_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
     }
 
-    start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
-    TaskInput raster_input = input[idx];
-    raster_input.setStartInstruction(start_instruction);
-    TaskflowContainer sub_container = raster_taskflow_generator_->generateTaskflow(
-        raster_input,
-        [=]() { successTask(input, name_, raster_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, raster_input.getInstruction()->getDescription(), error_cb); });
-
-    auto raster_step =
-        container.taskflow->composed_of(*(sub_container.taskflow))
-            .name("Raster #" + std::to_string(raster_idx + 1) + ": " + raster_input.getInstruction()->getDescription());
-    container.containers.push_back(std::move(sub_container));
+    raster_step.name("Raster #" + std::to_string(raster_idx + 1) + ": " +
+                     raster_input.getInstruction()->getDescription());
     container.input.precede(raster_step);
     tasks.push_back(raster_step);
     raster_idx++;
@@ -125,15 +120,27 @@ TaskflowContainer RasterTaskflow::generateTaskflow(TaskInput input, TaskflowVoid
     TaskInput transition_input = input[input_idx];
     transition_input.setStartInstruction(std::vector<std::size_t>({ input_idx - 1 }));
     transition_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1 }));
-    TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
-        transition_input,
-        [=]() { successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
+    tf::Task transition_step;
+    if (input.reused_segments.count(input_idx) > 0)
+    {
+      transition_step = emplaceReusedSegmentTask(*container.taskflow, input, transition_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
+          transition_input,
+          [=]() {
+            publishSegment(transition_input);
+            successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
 
-    auto transition_step = container.taskflow->composed_of(*(sub_container.taskflow))
-                               .name("Transition #" + std::to_string(transition_idx + 1) + ": " +
-                                     transition_input.getInstruction()->getDescription());
-    container.containers.push_back(std::move(sub_container));
+      transition_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
+    }
+
+    transition_step.name("Transition #" + std::to_string(transition_idx + 1) + ": " +
+                         transition_input.getInstruction()->getDescription());
 
     // Each transition is independent and thus depends only on the adjacent rasters
     transition_step.succeed(tasks[transition_idx]);
@@ -144,29 +151,53 @@ TaskflowContainer RasterTaskflow::generateTaskflow(TaskInput input, TaskflowVoid
 
   // Plan from_start - preceded by the first raster
   TaskInput from_start_input = input[0];
-  from_start_input.setStartInstruction(input_instruction->as<CompositeInstruction>().getStartInstruction());
+  from_start_input.setStartInstructionFn(startInstructionFn(input));
   from_start_input.setEndInstruction(std::vector<std::size_t>({ 1 }));
-  TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
-      from_start_input,
-      [=]() { successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
-
-  auto from_start = container.taskflow->composed_of(*(sub_container1.taskflow))
-                        .name("From Start: " + from_start_input.getInstruction()->getDescription());
-  container.containers.push_back(std::move(sub_container1));
+  tf::Task from_start;
+  if (input.reused_segments.count(0) > 0)
+  {
+    from_start = emplaceReusedSegmentTask(*container.taskflow, input, from_start_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
+        from_start_input,
+        [=]() {
+          publishSegment(from_start_input);
+          successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
+
+    from_start = container.taskflow->composed_of(*(sub_container1.taskflow));
+    container.containers.push_back(std::move(sub_container1));
+  }
+
+  from_start.name("From Start: " + from_start_input.getInstruction()->getDescription());
   tasks[0].precede(from_start);
 
   // Plan to_end - preceded by the last raster
   TaskInput to_end_input = input[input.size() - 1];
   to_end_input.setStartInstruction(std::vector<std::size_t>({ input.size() - 2 }));
-  TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
-      to_end_input,
-      [=]() { successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
-
-  auto to_end = container.taskflow->composed_of(*(sub_container2.taskflow))
-                    .name("To End: " + to_end_input.getInstruction()->getDescription());
-  container.containers.push_back(std::move(sub_container2));
+  tf::Task to_end;
+  if (input.reused_segments.count(input.size() - 1) > 0)
+  {
+    to_end = emplaceReusedSegmentTask(*container.taskflow, input, to_end_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
+        to_end_input,
+        [=]() {
+          publishSegment(to_end_input);
+          successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
+
+    to_end = container.taskflow->composed_of(*(sub_container2.taskflow));
+    container.containers.push_back(std::move(sub_container2));
+  }
+
+  to_end.name("To End: " + to_end_input.getInstruction()->getDescription());
   tasks.back().precede(to_end);
 
   return container;
@@ -224,5 +255,9 @@ bool RasterTaskflow::checkTaskInput(const tesseract_planning::TaskInput& input)
     return false;
   };
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
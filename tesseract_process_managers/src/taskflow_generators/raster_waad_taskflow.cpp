@@ -54,6 +54,13 @@ RasterWAADTaskflow::RasterWAADTaskflow(TaskflowGenerator::UPtr freespace_taskflo
 
 const std::string& RasterWAADTaskflow::getName() const { return name_; }
 
+std::map<std::size_t, std::size_t>
+RasterWAADTaskflow::getReusableSegments(const CompositeInstruction& program,
+                                        const CompositeInstruction& previous_program) const
+{
+  return getReusableRasterSegments(program, previous_program, 1);
+}
+
 TaskflowContainer RasterWAADTaskflow::generateTaskflow(TaskInput input, TaskflowVoidFn done_cb, TaskflowVoidFn error_cb)
 {
   // This should make all of the isComposite checks so that you can safely cast below
@@ -72,68 +79,67 @@ TaskflowContainer RasterWAADTaskflow::generateTaskflow(TaskInput input, Taskflow
   std::size_t raster_idx = 0;
   for (std::size_t idx = 1; idx < input.size() - 1; idx += 2)
   {
-    // Get the last plan instruction of the approach
-    assert(isCompositeInstruction(*(input[idx][0].getInstruction())));
-    const auto& aci = input[idx][0].getInstruction()->as<CompositeInstruction>();
-    auto* ali = getLastPlanInstruction(aci);
-    assert(ali != nullptr);
-
-    // Create the process taskflow
+    // Create the process taskflow, the start instruction is the last plan instruction of the approach
     TaskInput task_input = input[idx][1];
-    task_input.setStartInstruction(*ali);
-    TaskflowContainer sub_container1 = raster_taskflow_generator_->generateTaskflow(
-        task_input,
-        [=]() { successTask(input, name_, task_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, task_input.getInstruction()->getDescription(), error_cb); });
-
-    auto process_step =
-        container.taskflow->composed_of(*(sub_container1.taskflow)).name("raster_" + std::to_string(raster_idx + 1));
-    container.containers.push_back(std::move(sub_container1));
+    task_input.setStartInstructionFn(lastPlanInstructionFn(input[idx][0], false));
 
     // Create Departure Taskflow
     TaskInput departure_input = input[idx][2];
     departure_input.setStartInstruction(std::vector<std::size_t>({ idx, 1 }));
-    TaskflowContainer sub_container2 = raster_taskflow_generator_->generateTaskflow(
-        departure_input,
-        [=]() { successTask(input, name_, departure_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, departure_input.getInstruction()->getDescription(), error_cb); });
 
-    auto departure_step =
-        container.taskflow->composed_of(*(sub_container2.taskflow)).name("departure_" + std::to_string(raster_idx + 1));
-    container.containers.push_back(std::move(sub_container2));
+    // Create the approach taskflow, the start instruction is the last plan instruction of the previous composite
+    TaskInput approach_input = input[idx][0];
+    approach_input.setStartInstructionFn(lastPlanInstructionFn(input[idx - 1]));
+    approach_input.setEndInstruction(std::vector<std::size_t>({ idx, 1 }));
 
-    // Get Start Plan Instruction for approach
-    Instruction start_instruction{ NullInstruction() };
-    if (idx == 1)
+    tf::Task process_step;
+    tf::Task departure_step;
+    tf::Task approach_step;
+    if (input.reused_segments.count(idx) > 0)
     {
-      assert(isCompositeInstruction(*(input[0].getInstruction())));
-      const auto& ci = input[0].getInstruction()->as<CompositeInstruction>();
-      const auto* li = getLastPlanInstruction(ci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      process_step = emplaceReusedSegmentTask(*container.taskflow, input, task_input, name_, done_cb);
+      departure_step = emplaceReusedSegmentTask(*container.taskflow, input, departure_input, name_, done_cb);
+      approach_step = emplaceReusedSegmentTask(*container.taskflow, input, approach_input, name_, done_cb);
     }
     else
     {
-      assert(isCompositeInstruction(*(input[idx - 1].getInstruction())));
-      const auto& tci = input[idx - 1].getInstruction()->as<CompositeInstruction>();
-      auto* li = getLastPlanInstruction(tci);
-      assert(li != nullptr);
-      start_instruction = *li;
+      TaskflowContainer sub_container1 = raster_taskflow_generator_->generateTaskflow(
+          task_input,
+          [=]() {
+            publishSegment(task_input);
+            successTask(input, name_, task_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, task_input.getInstruction()->getDescription(), error_cb); });
+
+      process_step = container.taskflow->composed_of(*(sub_container1.taskflow));
+      container.containers.push_back(std::move(sub_container1));
+
+      TaskflowContainer sub_container2 = raster_taskflow_generator_->generateTaskflow(
+          departure_input,
+          [=]() {
+            publishSegment(departure_input);
+            successTask(input, name_, departure_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, departure_input.getInstruction()->getDescription(), error_cb); });
+
+      departure_step = container.taskflow->composed_of(*(sub_container2.taskflow));
+      container.containers.push_back(std::move(sub_container2));
+
+      TaskflowContainer sub_container0 = raster_taskflow_generator_->generateTaskflow(
+          approach_input,
+          [=]() {
+            publishSegment(approach_input);
+            successTask(input, name_, approach_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, approach_input.getInstruction()->getDescription(), error_cb); });
+
+      approach_step = container.taskflow->composed_of(*(sub_container0.taskflow));
+      container.containers.push_back(std::move(sub_container0));
     }
 
-    // Create the departure taskflow
-    start_instruction.as<PlanInstruction>().setPlanType(PlanInstructionType::START);
-    TaskInput approach_input = input[idx][0];
-    approach_input.setStartInstruction(start_instruction);
-    approach_input.setEndInstruction(std::vector<std::size_t>({ idx, 1 }));
-    TaskflowContainer sub_container0 = raster_taskflow_generator_->generateTaskflow(
-        approach_input,
-        [=]() { successTask(input, name_, approach_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, approach_input.getInstruction()->getDescription(), error_cb); });
-
-    auto approach_step =
-        container.taskflow->composed_of(*(sub_container0.taskflow)).name("approach_" + std::to_string(raster_idx + 1));
-    container.containers.push_back(std::move(sub_container0));
+    process_step.name("raster_" + std::to_string(raster_idx + 1));
+    departure_step.name("departure_" + std::to_string(raster_idx + 1));
+    approach_step.name("approach_" + std::to_string(raster_idx + 1));
 
     // Each approach and departure depend on raster
     approach_step.succeed(process_step);
@@ -156,14 +162,26 @@ TaskflowContainer RasterWAADTaskflow::generateTaskflow(TaskInput input, Taskflow
     TaskInput transition_input = input[input_idx];
     transition_input.setStartInstruction(std::vector<std::size_t>({ input_idx - 1, 2 }));
     transition_input.setEndInstruction(std::vector<std::size_t>({ input_idx + 1, 0 }));
-    TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
-        transition_input,
-        [=]() { successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb); },
-        [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
-
-    auto transition_step = container.taskflow->composed_of(*(sub_container.taskflow))
-                               .name("transition_" + std::to_string(transition_idx + 1));
-    container.containers.push_back(std::move(sub_container));
+    tf::Task transition_step;
+    if (input.reused_segments.count(input_idx) > 0)
+    {
+      transition_step = emplaceReusedSegmentTask(*container.taskflow, input, transition_input, name_, done_cb);
+    }
+    else
+    {
+      TaskflowContainer sub_container = transition_taskflow_generator_->generateTaskflow(
+          transition_input,
+          [=]() {
+            publishSegment(transition_input);
+            successTask(input, name_, transition_input.getInstruction()->getDescription(), done_cb);
+          },
+          [=]() { failureTask(input, name_, transition_input.getInstruction()->getDescription(), error_cb); });
+
+      transition_step = container.taskflow->composed_of(*(sub_container.taskflow));
+      container.containers.push_back(std::move(sub_container));
+    }
+
+    transition_step.name("transition_" + std::to_string(transition_idx + 1));
     // Each transition is independent and thus depends only on the adjacent rasters approach and departure
     transition_step.succeed(raster_tasks[transition_idx][2]);
     transition_step.succeed(raster_tasks[transition_idx + 1][0]);
@@ -173,27 +191,53 @@ TaskflowContainer RasterWAADTaskflow::generateTaskflow(TaskInput input, Taskflow
 
   // Plan from_start - preceded by the first raster
   TaskInput from_start_input = input[0];
-  from_start_input.setStartInstruction(input.getInstruction()->as<CompositeInstruction>().getStartInstruction());
+  from_start_input.setStartInstructionFn(startInstructionFn(input));
   from_start_input.setEndInstruction(std::vector<std::size_t>({ 1, 0 }));
-  TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
-      from_start_input,
-      [=]() { successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
+  tf::Task from_start;
+  if (input.reused_segments.count(0) > 0)
+  {
+    from_start = emplaceReusedSegmentTask(*container.taskflow, input, from_start_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container1 = freespace_taskflow_generator_->generateTaskflow(
+        from_start_input,
+        [=]() {
+          publishSegment(from_start_input);
+          successTask(input, name_, from_start_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, from_start_input.getInstruction()->getDescription(), error_cb); });
+
+    from_start = container.taskflow->composed_of(*(sub_container1.taskflow));
+    container.containers.push_back(std::move(sub_container1));
+  }
 
-  auto from_start = container.taskflow->composed_of(*(sub_container1.taskflow)).name("from_start");
-  container.containers.push_back(std::move(sub_container1));
+  from_start.name("from_start");
   raster_tasks[0][0].precede(from_start);
 
   // Plan to_end - preceded by the last raster
   TaskInput to_end_input = input[input.size() - 1];
   to_end_input.setStartInstruction(std::vector<std::size_t>({ input.size() - 2, 2 }));
-  TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
-      to_end_input,
-      [=]() { successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb); },
-      [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
+  tf::Task to_end;
+  if (input.reused_segments.count(input.size() - 1) > 0)
+  {
+    to_end = emplaceReusedSegmentTask(*container.taskflow, input, to_end_input, name_, done_cb);
+  }
+  else
+  {
+    TaskflowContainer sub_container2 = freespace_taskflow_generator_->generateTaskflow(
+        to_end_input,
+        [=]() {
+          publishSegment(to_end_input);
+          successTask(input, name_, to_end_input.getInstruction()->getDescription(), done_cb);
+        },
+        [=]() { failureTask(input, name_, to_end_input.getInstruction()->getDescription(), error_cb); });
+
+    to_end = container.taskflow->composed_of(*(sub_container2.taskflow));
+    container.containers.push_back(std::move(sub_container2));
+  }
 
-  auto to_end = container.taskflow->composed_of(*(sub_container2.taskflow)).name("to_end");
-  container.containers.push_back(std::move(sub_container2));
+  to_end.name("to_end");
   raster_tasks.back()[2].precede(to_end);
 
   return container;
@@ -285,5 +329,9 @@ bool RasterWAADTaskflow::checkTaskInput(const tesseract_planning::TaskInput& inp
     return false;
   };
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
@@ -32,8 +32,6 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_process_managers/taskflow_generators/trajopt_taskflow.h>
 
 #include <tesseract_process_managers/task_generators/motion_planner_task_generator.h>
-#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
-#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
 #include <tesseract_process_managers/task_generators/iterative_spline_parameterization_task_generator.h>
 #include <tesseract_process_managers/task_generators/seed_min_length_task_generator.h>
 
@@ -87,11 +85,11 @@ TaskflowContainer TrajOptTaskflow::generateTaskflow(TaskInput input, TaskflowVoi
   auto interpolator = std::make_shared<SimpleMotionPlanner>("Interpolator");
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<SimplePlannerPlanProfile>())
-      interpolator->plan_profiles = input.profiles->getProfileEntry<SimplePlannerPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerPlanProfile>())
+      interpolator->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<SimplePlannerCompositeProfile>())
-      interpolator->composite_profiles = input.profiles->getProfileEntry<SimplePlannerCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<SimplePlannerCompositeProfile>())
+      interpolator->composite_profiles = *entry;
   }
   TaskGenerator::UPtr interpolator_generator = std::make_unique<MotionPlannerTaskGenerator>(interpolator);
   interpolator_generator->assignConditionalTask(input, interpolator_task);
@@ -109,14 +107,14 @@ TaskflowContainer TrajOptTaskflow::generateTaskflow(TaskInput input, TaskflowVoi
   trajopt_planner->problem_generator = &DefaultTrajoptProblemGenerator;
   if (input.profiles)
   {
-    if (input.profiles->hasProfileEntry<TrajOptPlanProfile>())
-      trajopt_planner->plan_profiles = input.profiles->getProfileEntry<TrajOptPlanProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptPlanProfile>())
+      trajopt_planner->plan_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<TrajOptCompositeProfile>())
-      trajopt_planner->composite_profiles = input.profiles->getProfileEntry<TrajOptCompositeProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptCompositeProfile>())
+      trajopt_planner->composite_profiles = *entry;
 
-    if (input.profiles->hasProfileEntry<TrajOptSolverProfile>())
-      trajopt_planner->solver_profiles = input.profiles->getProfileEntry<TrajOptSolverProfile>();
+    if (auto entry = input.profiles->getProfileEntrySnapshot<TrajOptSolverProfile>())
+      trajopt_planner->solver_profiles = *entry;
   }
   TaskGenerator::UPtr trajopt_generator = std::make_unique<MotionPlannerTaskGenerator>(trajopt_planner);
   trajopt_generator->assignConditionalTask(input, trajopt_task);
@@ -126,10 +124,8 @@ TaskflowContainer TrajOptTaskflow::generateTaskflow(TaskInput input, TaskflowVoi
   bool has_contact_check = (params_.enable_post_contact_continuous_check || params_.enable_post_contact_discrete_check);
   if (has_contact_check)
   {
-    if (params_.enable_post_contact_continuous_check)
-      contact_check_generator = std::make_unique<ContinuousContactCheckTaskGenerator>();
-    else if (params_.enable_post_contact_discrete_check)
-      contact_check_generator = std::make_unique<DiscreteContactCheckTaskGenerator>();
+    contact_check_generator = createContactCheckTaskGenerator(params_.enable_post_contact_continuous_check,
+                                                              params_.enable_parallel_contact_check);
   }
 
   TaskGenerator::UPtr time_parameterization_generator;
@@ -193,5 +189,9 @@ bool TrajOptTaskflow::checkTaskInput(const tesseract_planning::TaskInput& input)
     return false;
   }
 
+  // Trajectory segments are not supported by the planners yet
+  if (!checkNoTrajectorySegments(input))
+    return false;
+
   return true;
 }
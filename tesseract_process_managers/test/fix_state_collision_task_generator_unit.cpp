@@ -185,6 +185,46 @@ TEST_F(FixStateCollisionTaskGeneratorUnit, MoveWaypointFromCollisionRandomSample
   EXPECT_FALSE(WaypointInCollision(wp, input, profile, contacts));
 }
 
+TEST_F(FixStateCollisionTaskGeneratorUnit, MoveWaypointFromCollisionRandomSamplerBatchTest)
+{
+  CompositeInstruction program = freespaceExampleProgramABB();
+  const Instruction program_instruction{ program };
+  Instruction seed = generateSkeletonSeed(program);
+  TaskInput input(env_, &program_instruction, manip_, &seed, false, nullptr);
+  input.executor = std::make_shared<tf::Executor>(4);
+
+  FixStateCollisionProfile profile;
+  profile.collision_check_config.collision_margin_data = CollisionMarginData(0.1);
+  profile.jiggle_factor = 1.0;
+  profile.sampling_attempts = 1000;
+  profile.sampling_batch_size = 50;
+
+  Eigen::VectorXd state = Eigen::VectorXd::Zero(2);
+  JointWaypoint waypoint({ "boxbot_x_joint", "boxbot_y_joint" }, state);
+  waypoint[0] = 0.0;
+  waypoint[1] = 1.09;
+  tesseract_collision::ContactResultMap contacts;
+
+  // The batches are checked in parallel, stopping at the first collision free sample
+  Waypoint wp(waypoint);
+  EXPECT_TRUE(WaypointInCollision(wp, input, profile, contacts));
+  EXPECT_TRUE(MoveWaypointFromCollisionRandomSampler(wp, input, profile));
+  EXPECT_FALSE(WaypointInCollision(wp, input, profile, contacts));
+
+  // Ranking the samples by distance uses the collision free sample of a batch closest to the waypoint
+  profile.sampling_rank_by_distance = true;
+  Waypoint ranked_wp(waypoint);
+  EXPECT_TRUE(MoveWaypointFromCollisionRandomSampler(ranked_wp, input, profile));
+  EXPECT_FALSE(WaypointInCollision(ranked_wp, input, profile, contacts));
+
+  // Small batches are likely to check the batches after the serial first one in parallel
+  profile.sampling_rank_by_distance = false;
+  profile.sampling_batch_size = 2;
+  Waypoint small_batch_wp(waypoint);
+  EXPECT_TRUE(MoveWaypointFromCollisionRandomSampler(small_batch_wp, input, profile));
+  EXPECT_FALSE(WaypointInCollision(small_batch_wp, input, profile, contacts));
+}
+
 TEST_F(FixStateCollisionTaskGeneratorUnit, MoveWaypointFromCollisionTrajoptTest)
 {
   CompositeInstruction program = freespaceExampleProgramABB();
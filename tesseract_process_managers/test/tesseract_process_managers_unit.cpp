@@ -1,6 +1,11 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_common/types.h>
@@ -10,10 +15,12 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_motion_planners/core/types.h>
 #include <tesseract_motion_planners/simple/simple_motion_planner.h>
 #include <tesseract_motion_planners/simple/profile/simple_planner_fixed_size_assign_plan_profile.h>
+#include <tesseract_motion_planners/ompl/profile/ompl_default_plan_profile.h>
 #include <tesseract_motion_planners/core/utils.h>
 #include <tesseract_motion_planners/interface_utils.h>
 
 #include <tesseract_process_managers/core/task_input.h>
+#include <tesseract_process_managers/core/utils.h>
 #include <tesseract_process_managers/core/process_planning_server.h>
 #include <tesseract_process_managers/taskflow_generators/raster_taskflow.h>
 #include <tesseract_process_managers/taskflow_generators/raster_global_taskflow.h>
@@ -27,6 +34,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_process_managers/taskflow_generators/descartes_taskflow.h>
 #include <tesseract_process_managers/taskflow_generators/trajopt_taskflow.h>
 #include <tesseract_process_managers/task_generators/seed_min_length_task_generator.h>
+#include <tesseract_process_managers/task_generators/discrete_contact_check_task_generator.h>
+#include <tesseract_process_managers/task_generators/continuous_contact_check_task_generator.h>
 
 #include "raster_example_program.h"
 #include "raster_dt_example_program.h"
@@ -261,6 +270,198 @@ TEST_F(TesseractProcessManagerUnit, FreespaceSimpleMotionPlannerDefaultLVSPlanPr
   EXPECT_FALSE(response.results.getManipulatorInfo().empty());
 }
 
+TEST_F(TesseractProcessManagerUnit, ReadOnlyAccessKeepsProgramSharedTest)
+{
+  CompositeInstruction program = rasterExampleProgram();
+  program.setManipulatorInfo(manip);
+
+  // Formatting an already formatted program only reads its children, so copies still share them
+  EXPECT_FALSE(formatProgram(program, *env_));
+  const CompositeInstruction program_copy = program;
+  EXPECT_EQ(&std::as_const(program).getInstructions(), &program_copy.getInstructions());
+  EXPECT_EQ(&std::as_const(program).front().as<CompositeInstruction>().getInstructions(),
+            &program_copy.front().as<CompositeInstruction>().getInstructions());
+
+  Instruction program_instruction = program;
+  Instruction results_instruction = generateSkeletonSeed(program);
+  TaskInput input(env_, &program_instruction, manip, &results_instruction, false, nullptr);
+
+  // Reading the results of a segment does not prevent sharing them either
+  const TaskInput segment_input = input[0];
+  ASSERT_TRUE(segment_input.getResults() != nullptr);
+  EXPECT_TRUE(isCompositeInstruction(*segment_input.getResults()));
+
+  const auto& results = std::as_const(results_instruction).as<CompositeInstruction>();
+  const CompositeInstruction results_copy = results;
+  EXPECT_EQ(&results.getInstructions(), &results_copy.getInstructions());
+  EXPECT_EQ(&results.front().as<CompositeInstruction>().getInstructions(),
+            &results_copy.front().as<CompositeInstruction>().getInstructions());
+}
+
+TEST_F(TesseractProcessManagerUnit, TaskInputUnsharesResultsTest)
+{
+  CompositeInstruction program = rasterExampleProgram();
+  program.setManipulatorInfo(manip);
+
+  // The results share every composite with the seed until the input is created
+  Instruction program_instruction = program;
+  const Instruction seed = generateSkeletonSeed(program);
+  Instruction results_instruction = seed;
+  TaskInput input(env_, &program_instruction, manip, &results_instruction, true, nullptr);
+
+  const auto& results = std::as_const(results_instruction).as<CompositeInstruction>();
+  const auto& seed_composite = seed.as<CompositeInstruction>();
+  EXPECT_NE(&results.getInstructions(), &seed_composite.getInstructions());
+  EXPECT_NE(&results.front().as<CompositeInstruction>().getInstructions(),
+            &seed_composite.front().as<CompositeInstruction>().getInstructions());
+  EXPECT_TRUE(results_instruction == seed);
+
+  // The results of a segment are handed out without writing to the composites containing them
+  const std::vector<Instruction>* children = &results.getInstructions();
+  TaskInput segment_input = input[1];
+  Instruction* segment_results = segment_input.getResults();
+  EXPECT_EQ(segment_results, &results[1]);
+  EXPECT_EQ(&results.getInstructions(), children);
+
+  // Modifying the results of a segment only clones the children of that segment
+  const std::vector<Instruction>* segment_children = &results[1].as<CompositeInstruction>().getInstructions();
+  segment_results->as<CompositeInstruction>().front().setDescription("Modified");
+  EXPECT_EQ(&results[1].as<CompositeInstruction>().getInstructions(), segment_children);
+  EXPECT_NE(seed_composite[1].as<CompositeInstruction>().front().getDescription(), "Modified");
+}
+
+TEST_F(TesseractProcessManagerUnit, TrajectorySegmentsRejectedTest)
+{
+  CompositeInstruction program = rasterExampleProgram();
+  program.setManipulatorInfo(manip);
+  auto fwd_kin = env_->getManipulatorManager()->getFwdKinematicSolver(manip.manipulator);
+  std::vector<std::string> joint_names = fwd_kin->getJointNames();
+
+  // The planners do not support trajectory segments yet, so they are rejected instead of being skipped
+  CompositeInstruction program_with_segment = program;
+  program_with_segment[1].as<CompositeInstruction>().push_back(TrajectorySegmentInstruction(joint_names, 2));
+
+  Instruction program_instruction = program;
+  Instruction segment_instruction = program_with_segment;
+  Instruction results_instruction = generateSkeletonSeed(program);
+  Instruction segment_results = generateSkeletonSeed(program_with_segment);
+  TaskInput input(env_, &program_instruction, manip, &results_instruction, false, nullptr);
+  EXPECT_TRUE(checkNoTrajectorySegments(input));
+
+  TaskInput segment_input(env_, &segment_instruction, manip, &results_instruction, false, nullptr);
+  EXPECT_FALSE(checkNoTrajectorySegments(segment_input));
+
+  // The seed is only checked if it is used
+  TaskInput seed_input(env_, &program_instruction, manip, &segment_results, true, nullptr);
+  EXPECT_FALSE(checkNoTrajectorySegments(seed_input));
+  TaskInput unused_seed_input(env_, &program_instruction, manip, &segment_results, false, nullptr);
+  EXPECT_TRUE(checkNoTrajectorySegments(unused_seed_input));
+
+  // The server rejects them before a taskflow is generated or reused from the cache
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+  request.instructions = segment_instruction;
+  ProcessPlanningFuture response = planning_server.run(request);
+  EXPECT_EQ(response.interface, nullptr);
+}
+
+TEST_F(TesseractProcessManagerUnit, ContactCheckTaskGeneratorParallelTest)
+{
+  tesseract_planning::CompositeInstruction program = rasterExampleProgram();
+  program.setManipulatorInfo(manip);
+
+  auto interpolator = std::make_shared<SimpleMotionPlanner>("INTERPOLATOR");
+  interpolator->plan_profiles["PROCESS"] = std::make_shared<SimplePlannerLVSPlanProfile>();
+  interpolator->plan_profiles[DEFAULT_PROFILE_KEY] = std::make_shared<SimplePlannerLVSPlanProfile>();
+
+  PlannerRequest request;
+  request.instructions = program;
+  request.env = env_;
+  request.env_state = env_->getCurrentState();
+
+  PlannerResponse response;
+  EXPECT_TRUE(interpolator->solve(request, response));
+
+  Instruction program_instruction = program;
+  Instruction results_instruction = response.results;
+
+  TaskInput serial_input(env_, &program_instruction, manip, &results_instruction, true, nullptr);
+  TaskInput parallel_input(env_, &program_instruction, manip, &results_instruction, true, nullptr);
+  parallel_input.executor = std::make_shared<tf::Executor>(4);
+
+  // The merged contacts of the chunks must be in timestep order and equal to the contacts of a serial check
+  auto expect_same_contacts = [](const std::vector<tesseract_collision::ContactResultMap>& serial,
+                                 const std::vector<tesseract_collision::ContactResultMap>& parallel) {
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i)
+    {
+      ASSERT_EQ(serial[i].size(), parallel[i].size());
+      auto parallel_it = parallel[i].begin();
+      for (auto serial_it = serial[i].begin(); serial_it != serial[i].end(); ++serial_it, ++parallel_it)
+      {
+        EXPECT_EQ(serial_it->first, parallel_it->first);
+        ASSERT_EQ(serial_it->second.size(), parallel_it->second.size());
+        for (std::size_t j = 0; j < serial_it->second.size(); ++j)
+          EXPECT_NEAR(serial_it->second[j].distance, parallel_it->second[j].distance, 1e-6);
+      }
+    }
+  };
+
+  // A large contact distance so the trajectory is not contact free
+  std::size_t unique_id = 0;
+  for (auto type : { tesseract_collision::ContactTestType::ALL, tesseract_collision::ContactTestType::FIRST })
+  {
+    DiscreteContactCheckTaskGenerator discrete_serial(0.05, 1.0);
+    DiscreteContactCheckTaskGenerator discrete_parallel(0.05, 1.0);
+    discrete_serial.config.contact_request.type = type;
+    discrete_parallel.config.contact_request.type = type;
+    discrete_parallel.parallel = true;
+    discrete_parallel.min_states_per_chunk = 20;
+
+    std::size_t serial_id = ++unique_id;
+    std::size_t parallel_id = ++unique_id;
+    EXPECT_EQ(discrete_serial.conditionalProcess(serial_input, serial_id), 0);
+    EXPECT_EQ(discrete_parallel.conditionalProcess(parallel_input, parallel_id), 0);
+
+    auto discrete_serial_info =
+        std::dynamic_pointer_cast<const DiscreteContactCheckTaskInfo>(serial_input.getTaskInfo(serial_id));
+    auto discrete_parallel_info =
+        std::dynamic_pointer_cast<const DiscreteContactCheckTaskInfo>(parallel_input.getTaskInfo(parallel_id));
+    ASSERT_TRUE(discrete_serial_info != nullptr);
+    ASSERT_TRUE(discrete_parallel_info != nullptr);
+    EXPECT_FALSE(discrete_serial_info->contact_results.empty());
+    expect_same_contacts(discrete_serial_info->contact_results, discrete_parallel_info->contact_results);
+    if (type == tesseract_collision::ContactTestType::FIRST)
+      EXPECT_EQ(discrete_parallel_info->contact_results.size(), 1);
+
+    ContinuousContactCheckTaskGenerator continuous_serial(0.05, 1.0);
+    ContinuousContactCheckTaskGenerator continuous_parallel(0.05, 1.0);
+    continuous_serial.config.contact_request.type = type;
+    continuous_parallel.config.contact_request.type = type;
+    continuous_parallel.parallel = true;
+    continuous_parallel.min_states_per_chunk = 20;
+
+    serial_id = ++unique_id;
+    parallel_id = ++unique_id;
+    EXPECT_EQ(continuous_serial.conditionalProcess(serial_input, serial_id), 0);
+    EXPECT_EQ(continuous_parallel.conditionalProcess(parallel_input, parallel_id), 0);
+
+    auto continuous_serial_info =
+        std::dynamic_pointer_cast<const ContinuousContactCheckTaskInfo>(serial_input.getTaskInfo(serial_id));
+    auto continuous_parallel_info =
+        std::dynamic_pointer_cast<const ContinuousContactCheckTaskInfo>(parallel_input.getTaskInfo(parallel_id));
+    ASSERT_TRUE(continuous_serial_info != nullptr);
+    ASSERT_TRUE(continuous_parallel_info != nullptr);
+    EXPECT_FALSE(continuous_serial_info->contact_results.empty());
+    expect_same_contacts(continuous_serial_info->contact_results, continuous_parallel_info->contact_results);
+    if (type == tesseract_collision::ContactTestType::FIRST)
+      EXPECT_EQ(continuous_parallel_info->contact_results.size(), 1);
+  }
+}
+
 TEST_F(TesseractProcessManagerUnit, RasterProcessManagerDefaultPlanProfileTest)
 {
   // Create Process Planning Server
@@ -757,6 +958,860 @@ TEST_F(TesseractProcessManagerUnit, RasterWAADDTProcessManagerDefaultLVSPlanProf
   EXPECT_TRUE(response.interface->isSuccessful());
 }
 
+TEST_F(TesseractProcessManagerUnit, ProcessEnvironmentCacheLeaseTest)
+{
+  auto cache = std::make_shared<ProcessEnvironmentCache>(env_, 2);
+  cache->refreshCache();
+
+  // A released lease is returned to the cache
+  for (int i = 0; i < 5; ++i)
+  {
+    Environment::Ptr env = cache->leaseEnvironment();
+    ASSERT_TRUE(env != nullptr);
+    EXPECT_EQ(env->getRevision(), env_->getRevision());
+  }
+
+  EXPECT_EQ(cache->getCacheHits(), 5);
+  EXPECT_EQ(cache->getCacheMisses(), 0);
+  EXPECT_NEAR(cache->getCacheHitRate(), 1.0, 1e-6);
+
+  // Holding more leases than the cache size clones the environment
+  std::vector<Environment::ConstPtr> envs;
+  for (int i = 0; i < 3; ++i)
+    envs.push_back(cache->leaseEnvironment());
+
+  EXPECT_EQ(cache->getCacheHits() + cache->getCacheMisses(), 8);
+}
+
+TEST_F(TesseractProcessManagerUnit, ContactManagerPoolTest)
+{
+  auto pool = std::make_shared<ContactManagerPool>();
+  Environment::Ptr env = env_->clone();
+  tesseract_collision::CollisionMarginData margin_data(0.025);
+
+  // A released contact manager is borrowed again
+  for (int i = 0; i < 5; ++i)
+  {
+    auto manager = pool->borrowDiscreteContactManager(*env, manip.manipulator, margin_data);
+    ASSERT_TRUE(manager != nullptr);
+    EXPECT_FALSE(manager->getActiveCollisionObjects().empty());
+    EXPECT_NEAR(manager->getCollisionMarginData().getMaxCollisionMargin(), 0.025, 1e-6);
+  }
+
+  EXPECT_EQ(pool->getMisses(), 1);
+  EXPECT_EQ(pool->getHits(), 4);
+  EXPECT_EQ(pool->size(), 1);
+
+  // Contact managers borrowed at the same time are not shared
+  {
+    auto manager1 = pool->borrowDiscreteContactManager(*env, manip.manipulator, margin_data);
+    auto manager2 = pool->borrowDiscreteContactManager(*env, manip.manipulator, margin_data);
+    EXPECT_NE(manager1.get(), manager2.get());
+    EXPECT_EQ(pool->size(), 0);
+  }
+
+  EXPECT_EQ(pool->getMisses(), 2);
+  EXPECT_EQ(pool->size(), 2);
+
+  // A different margin or type of contact manager is not taken from the same contact managers
+  pool->borrowDiscreteContactManager(*env, manip.manipulator, tesseract_collision::CollisionMarginData(0.05));
+  pool->borrowContinuousContactManager(*env, manip.manipulator, margin_data);
+  EXPECT_EQ(pool->getMisses(), 4);
+  EXPECT_EQ(pool->size(), 4);
+
+  // The contact managers of an older revision are discarded
+  env->addAllowedCollision("link_1", "link_4", "Test");
+  auto manager = pool->borrowDiscreteContactManager(*env, manip.manipulator, margin_data);
+  EXPECT_EQ(pool->getMisses(), 5);
+  EXPECT_EQ(pool->size(), 0);
+
+  manager = nullptr;
+  EXPECT_EQ(pool->size(), 1);
+
+  // The contact checks of requests borrow from the pool of the planning server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+  planning_server.enableContactManagerPool();
+  ContactManagerPool::Ptr server_pool = planning_server.getContactManagerPool();
+  ASSERT_TRUE(server_pool != nullptr);
+
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+  request.instructions = Instruction(rasterExampleProgram(freespace_profile, process_profile));
+
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  planning_server.getProfiles()->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  planning_server.getProfiles()->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  ProcessPlanningFuture response = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(response.interface->isSuccessful());
+  EXPECT_GT(server_pool->getHits(), 0);
+  EXPECT_GT(server_pool->size(), 0);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterWAADProcessManagerTaskflowCacheTest)
+{
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string approach_profile = "APPROACH";
+  std::string process_profile = "PROCESS";
+  std::string departure_profile = "DEPARTURE";
+
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_WAAD_PLANNER_NAME;
+  request.instructions =
+      Instruction(rasterWAADExampleProgram(freespace_profile, approach_profile, process_profile, departure_profile));
+
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerLVSPlanProfile>();
+  auto addProfiles = [&](ProcessPlanningServer& planning_server) {
+    ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+    profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+    profiles->addProfile<SimplePlannerPlanProfile>(approach_profile, default_simple_plan_profile);
+    profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+    profiles->addProfile<SimplePlannerPlanProfile>(departure_profile, default_simple_plan_profile);
+  };
+
+  // Solve without the cache for reference
+  ProcessPlanningServer reference_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  reference_server.loadDefaultProcessPlanners();
+  addProfiles(reference_server);
+  ProcessPlanningFuture reference = reference_server.run(request);
+  reference_server.waitForAll();
+  ASSERT_TRUE(reference.interface->isSuccessful());
+
+  // Precompile a taskflow and reuse it for every request
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+  addProfiles(planning_server);
+  planning_server.enableTaskflowCache(1);
+  EXPECT_EQ(planning_server.precompileTaskflows(request, 2), 1);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    ProcessPlanningFuture response = planning_server.run(request);
+    response.wait();
+    planning_server.waitForAll();
+
+    EXPECT_TRUE(response.taskflow_container.taskflow == nullptr);
+    EXPECT_TRUE(response.interface->isSuccessful());
+    EXPECT_TRUE(*response.results == *reference.results);
+  }
+
+  // Changing the profiles discards the cached taskflow and a new one is generated and cached
+  planning_server.getProfiles()->addProfile<SimplePlannerPlanProfile>("UNUSED", default_simple_plan_profile);
+  ProcessPlanningFuture response = planning_server.run(request);
+  response.wait();
+  planning_server.waitForAll();
+  EXPECT_TRUE(response.taskflow_container.taskflow == nullptr);
+  EXPECT_TRUE(response.interface->isSuccessful());
+  EXPECT_TRUE(*response.results == *reference.results);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerCancelTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Cancel the process planning as soon as it was submitted
+  ProcessPlanningFuture response = planning_server.run(request);
+  response.cancel();
+
+  // The motion planners are cancelled, so this finishes long before the planning time of the profiles
+  EXPECT_EQ(response.waitFor(std::chrono::seconds(10)), std::future_status::ready);
+  planning_server.waitForAll();
+
+  EXPECT_FALSE(response.interface->isSuccessful());
+  EXPECT_TRUE(response.interface->getCancellationToken()->isCancelled());
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerDeadlineTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  {
+    // A request which is already out of time fails fast
+    request.deadline = CancellationToken::Clock::now();
+    ProcessPlanningFuture response = planning_server.run(request);
+    EXPECT_EQ(response.waitFor(std::chrono::seconds(10)), std::future_status::ready);
+    planning_server.waitForAll();
+
+    EXPECT_FALSE(response.interface->isSuccessful());
+    EXPECT_TRUE(response.interface->isExpired());
+  }
+
+  {
+    // A request with enough time is not affected by the deadline
+    request.deadline = CancellationToken::Clock::now() + std::chrono::minutes(10);
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+
+    EXPECT_TRUE(response.interface->isSuccessful());
+    EXPECT_FALSE(response.interface->isExpired());
+  }
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerPriorityTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+  planning_server.configurePriorityClass(ProcessPlanningPriority::LOW, 1, 1, 1);
+  planning_server.configurePriorityClass(ProcessPlanningPriority::HIGH, 1);
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  // Only one background request runs and one waits, the others are rejected
+  std::vector<ProcessPlanningFuture> low_responses;
+  request.priority = ProcessPlanningPriority::LOW;
+  for (int i = 0; i < 4; ++i)
+    low_responses.push_back(planning_server.run(request));
+
+  request.priority = ProcessPlanningPriority::HIGH;
+  ProcessPlanningFuture high_response = planning_server.run(request);
+  EXPECT_EQ(high_response.waitFor(std::chrono::seconds(60)), std::future_status::ready);
+  planning_server.waitForAll();
+
+  EXPECT_TRUE(high_response.interface->isSuccessful());
+
+  std::size_t successful{ 0 };
+  for (const auto& response : low_responses)
+  {
+    EXPECT_EQ(response.waitFor(std::chrono::seconds(0)), std::future_status::ready);
+    if (response.interface->isSuccessful())
+      ++successful;
+  }
+
+  RequestSchedulerMetrics low_metrics = planning_server.getSchedulerMetrics(ProcessPlanningPriority::LOW);
+  EXPECT_GE(low_metrics.admitted, 2);
+  EXPECT_EQ(low_metrics.admitted + low_metrics.rejected, 4);
+  EXPECT_EQ(low_metrics.completed, low_metrics.admitted);
+  EXPECT_EQ(low_metrics.active, 0);
+  EXPECT_EQ(low_metrics.queue_depth, 0);
+  EXPECT_EQ(successful, low_metrics.admitted);
+
+  RequestSchedulerMetrics high_metrics = planning_server.getSchedulerMetrics(ProcessPlanningPriority::HIGH);
+  EXPECT_EQ(high_metrics.admitted, 1);
+  EXPECT_EQ(high_metrics.rejected, 0);
+  EXPECT_EQ(high_metrics.completed, 1);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerMetricsTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  ProcessPlanningFuture response = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(response.interface->isSuccessful());
+
+  ProcessPlanningMetrics metrics = planning_server.getMetrics();
+  EXPECT_FALSE(metrics.tasks.empty());
+  std::uint64_t successes{ 0 };
+  std::uint64_t latencies{ 0 };
+  for (const auto& task : metrics.tasks)
+  {
+    successes += task.second.successes;
+    latencies += task.second.latency.count;
+  }
+  EXPECT_GT(successes, 0);
+  EXPECT_GT(latencies, 0);
+
+  // Tasks with an index are grouped by dropping it
+  EXPECT_EQ(MetricsObserver::getTaskGroupName("Raster #12: Raster 12"), "Raster");
+  EXPECT_EQ(MetricsObserver::getTaskGroupName("transition_3"), "transition");
+  EXPECT_EQ(MetricsObserver::getTaskGroupName("TrajOpt Motion Planner"), "TrajOpt Motion Planner");
+
+  ASSERT_EQ(metrics.executors.size(), 1);
+  EXPECT_EQ(metrics.executors.front().num_workers, 1);
+  EXPECT_GT(metrics.executors.front().busy_time, 0);
+  EXPECT_EQ(metrics.requests.at(ProcessPlanningPriority::NORMAL).completed, 1);
+  EXPECT_EQ(metrics.requests.at(ProcessPlanningPriority::NORMAL).wait_times.count, 1);
+
+  std::string prometheus = metrics.toPrometheus();
+  EXPECT_NE(prometheus.find("# TYPE tesseract_task_duration_seconds histogram"), std::string::npos);
+  EXPECT_NE(prometheus.find("tesseract_requests_total{priority=\"normal\",state=\"completed\"} 1"), std::string::npos);
+
+  std::string json = metrics.toJSON();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find("\"tasks\""), std::string::npos);
+
+  planning_server.clearMetrics();
+  metrics = planning_server.getMetrics();
+  EXPECT_TRUE(metrics.tasks.empty());
+
+  // The results are counted when the tasks finish, so task infos removed by the retention policy are counted too
+  request.task_info_retention_policy.failed_only = true;
+  response = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(response.interface->isSuccessful());
+  EXPECT_GT(response.interface->getTaskInfoContainer()->getRemovedCount(), 0);
+
+  metrics = planning_server.getMetrics();
+  std::uint64_t retained_successes{ 0 };
+  for (const auto& task : metrics.tasks)
+    retained_successes += task.second.successes;
+  EXPECT_EQ(retained_successes, successes);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerTraceTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  {
+    // Requests are not traced by default
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    EXPECT_TRUE(response.interface->isSuccessful());
+    EXPECT_TRUE(response.interface->getTraceRecorder() == nullptr);
+  }
+
+  {
+    request.trace = true;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    EXPECT_TRUE(response.interface->isSuccessful());
+    ASSERT_TRUE(response.interface->getTraceRecorder() != nullptr);
+
+    std::size_t task_spans{ 0 };
+    std::size_t request_spans{ 0 };
+    for (const auto& span : response.interface->getTraceRecorder()->getSpans())
+    {
+      if (span.category == "task")
+        ++task_spans;
+      else if (span.name == "Request: " + request.name)
+        ++request_spans;
+    }
+    EXPECT_GT(task_spans, 0);
+    EXPECT_EQ(request_spans, 1);
+  }
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerPlanCacheTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+  planning_server.enablePlanCache();
+  PlanResultCache::Ptr plan_cache = planning_server.getPlanCache();
+  ASSERT_TRUE(plan_cache != nullptr);
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  ProcessPlanningFuture planned = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(planned.interface->isSuccessful());
+  EXPECT_EQ(plan_cache->size(), 1);
+  EXPECT_EQ(plan_cache->getMisses(), 1);
+  EXPECT_GT(plan_cache->getMemoryUsage(), 0);
+
+  // An identical request is served from the cache without planning, publishing the segments of the cached results
+  std::vector<ProcessPlanningSegment> segments;
+  request.segment_callback = [&segments](const ProcessPlanningSegment& segment) { segments.push_back(segment); };
+  ProcessPlanningFuture cached = planning_server.run(request);
+  EXPECT_TRUE(cached.ready());
+  EXPECT_TRUE(cached.interface->isSuccessful());
+  EXPECT_EQ(plan_cache->getHits(), 1);
+  EXPECT_TRUE(*(cached.results) == *(planned.results));
+
+  const auto& results = cached.results->as<CompositeInstruction>();
+  ASSERT_EQ(segments.size(), program.size());
+  for (const auto& segment : segments)
+  {
+    ASSERT_EQ(segment.indices.size(), 1);
+    EXPECT_EQ(segment.description, program.at(segment.indices.front()).getDescription());
+    EXPECT_TRUE(segment.results == results.at(segment.indices.front()));
+  }
+  request.segment_callback = nullptr;
+
+  // Modifying the profiles changes the key
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile,
+                                                 std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>());
+  ProcessPlanningFuture replanned = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(replanned.interface->isSuccessful());
+  EXPECT_EQ(plan_cache->getHits(), 1);
+  EXPECT_EQ(plan_cache->size(), 2);
+
+  // Modifying the program changes the key
+  program.setDescription("Modified Raster");
+  request.instructions = Instruction(program);
+  ProcessPlanningFuture modified = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_EQ(plan_cache->getHits(), 1);
+  EXPECT_EQ(plan_cache->size(), 3);
+
+  // The least recently used results are evicted once the memory limit is exceeded
+  PlanResultCache::Key key1{ 1, Instruction(program), NullInstruction() };
+  PlanResultCache::Key key2{ 2, Instruction(program), NullInstruction() };
+  PlanResultCache small_cache(estimateMemoryUsage(*(planned.results)) + estimateMemoryUsage(program) +
+                              estimateMemoryUsage(NullInstruction()) + 1);
+  EXPECT_TRUE(small_cache.add(key1, *(planned.results)));
+  EXPECT_TRUE(small_cache.add(key2, *(planned.results)));
+  EXPECT_EQ(small_cache.size(), 1);
+  EXPECT_TRUE(small_cache.get(key1) == nullptr);
+  EXPECT_TRUE(small_cache.get(key2) != nullptr);
+
+  // A different program or seed with the same hash is not served from the cache
+  PlanResultCache::Key collision = key2;
+  collision.program = Instruction(program);
+  collision.program.as<CompositeInstruction>().setDescription("Colliding Raster");
+  EXPECT_TRUE(small_cache.get(collision) == nullptr);
+
+  collision = key2;
+  collision.seed = *(planned.results);
+  EXPECT_TRUE(small_cache.get(collision) == nullptr);
+  EXPECT_TRUE(small_cache.get(key2) != nullptr);
+  EXPECT_EQ(small_cache.getHits(), 2);
+  EXPECT_EQ(small_cache.getMisses(), 3);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerPlanCacheCommandsTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+  planning_server.enablePlanCache();
+  PlanResultCache::Ptr plan_cache = planning_server.getPlanCache();
+  ASSERT_TRUE(plan_cache != nullptr);
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  // Two command lists of the same length leave the leased environments at the same revision
+  request.commands = { std::make_shared<ChangeLinkCollisionEnabledCommand>("link_6", false) };
+  ProcessPlanningFuture first = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(first.interface->isSuccessful());
+
+  request.commands = { std::make_shared<ChangeLinkCollisionEnabledCommand>("link_5", false) };
+  ProcessPlanningFuture second = planning_server.run(request);
+  planning_server.waitForAll();
+  EXPECT_TRUE(second.interface->isSuccessful());
+
+  // Neither request is served from nor added to the cache
+  EXPECT_EQ(plan_cache->getHits(), 0);
+  EXPECT_EQ(plan_cache->size(), 0);
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerSegmentTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 2);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  // The segments are published from the executor workers
+  std::mutex mutex;
+  std::vector<ProcessPlanningSegment> segments;
+  request.segment_callback = [&mutex, &segments](const ProcessPlanningSegment& segment) {
+    std::scoped_lock lock(mutex);
+    segments.push_back(segment);
+  };
+
+  ProcessPlanningFuture response = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(response.interface->isSuccessful());
+
+  // Every raster, transition, from start and to end segment is published once with its final results
+  const auto& results = response.results->as<CompositeInstruction>();
+  ASSERT_EQ(segments.size(), program.size());
+  std::vector<bool> published(program.size(), false);
+  for (const auto& segment : segments)
+  {
+    ASSERT_EQ(segment.indices.size(), 1);
+    std::size_t index = segment.indices.front();
+    ASSERT_LT(index, program.size());
+    EXPECT_FALSE(published[index]);
+    published[index] = true;
+
+    EXPECT_EQ(segment.description, program.at(index).getDescription());
+    EXPECT_TRUE(segment.results == results.at(index));
+  }
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerIncrementalTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 2);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+  request.instructions = Instruction(program);
+  ProcessPlanningFuture previous = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(previous.interface->isSuccessful());
+
+  // Change the second raster, only it and the transitions around it are planned again
+  CompositeInstruction changed_program = program;
+  changed_program[3].as<CompositeInstruction>().setDescription("Changed Raster");
+
+  RasterTaskflow generator(nullptr, nullptr, nullptr);
+  std::map<std::size_t, std::size_t> reusable = generator.getReusableSegments(changed_program, program);
+  EXPECT_EQ(reusable.size(), program.size() - 3);
+  for (std::size_t index = 0; index < program.size(); ++index)
+  {
+    if (index >= 2 && index <= 4)
+      EXPECT_EQ(reusable.count(index), 0);
+    else
+      EXPECT_EQ(reusable.at(index), index);
+  }
+
+  // Removing the first raster shifts the indices of the remaining segments, the raster after it is planned again
+  // since it starts from the from start segment now
+  CompositeInstruction removed_program = program;
+  removed_program.erase(removed_program.begin() + 1, removed_program.begin() + 3);
+  reusable = generator.getReusableSegments(removed_program, program);
+  EXPECT_EQ(reusable.count(0), 0);
+  EXPECT_EQ(reusable.count(1), 0);
+  EXPECT_EQ(reusable.count(2), 0);
+  for (std::size_t index = 3; index < removed_program.size(); ++index)
+    EXPECT_EQ(reusable.at(index), index + 2);
+
+  // The reused segments are published too
+  std::mutex mutex;
+  std::vector<ProcessPlanningSegment> segments;
+  request.instructions = Instruction(changed_program);
+  request.previous_instructions = Instruction(program);
+  request.previous_results = *previous.results;
+  request.previous_environment_fingerprint = previous.environment_fingerprint;
+  request.segment_callback = [&mutex, &segments](const ProcessPlanningSegment& segment) {
+    std::scoped_lock lock(mutex);
+    segments.push_back(segment);
+  };
+
+  ProcessPlanningFuture response = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(response.interface->isSuccessful());
+  EXPECT_EQ(segments.size(), changed_program.size());
+  EXPECT_EQ(response.environment_fingerprint, previous.environment_fingerprint);
+  EXPECT_LT(response.interface->getTaskInfoMap().size(), previous.interface->getTaskInfoMap().size());
+
+  const auto& results = response.results->as<CompositeInstruction>();
+  const auto& previous_results = previous.results->as<CompositeInstruction>();
+  ASSERT_EQ(results.size(), previous_results.size());
+  for (std::size_t index = 0; index < results.size(); ++index)
+  {
+    if (index != 3)
+      EXPECT_TRUE(results.at(index) == previous_results.at(index));
+    else
+      EXPECT_EQ(results.at(index).as<CompositeInstruction>().size(),
+                previous_results.at(index).as<CompositeInstruction>().size());
+  }
+
+  // Nothing is reused once the environment changed since the previous request
+  auto changed_state = std::make_shared<EnvState>(*env_->getCurrentState());
+  changed_state->joints["joint_1"] += 0.1;
+  request.env_state = changed_state;
+  request.segment_callback = nullptr;
+  ProcessPlanningFuture replanned = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(replanned.interface->isSuccessful());
+  EXPECT_NE(replanned.environment_fingerprint, previous.environment_fingerprint);
+  EXPECT_EQ(replanned.interface->getTaskInfoMap().size(), previous.interface->getTaskInfoMap().size());
+}
+
+TEST_F(TesseractProcessManagerUnit, RasterProcessManagerTaskInfoCaptureTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 1);
+  planning_server.loadDefaultProcessPlanners();
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = process_planner_names::RASTER_FT_PLANNER_NAME;
+
+  // Define the program
+  std::string freespace_profile = DEFAULT_PROFILE_KEY;
+  std::string process_profile = "PROCESS";
+
+  CompositeInstruction program = rasterExampleProgram(freespace_profile, process_profile);
+  request.instructions = Instruction(program);
+
+  // Add profiles to planning server
+  auto default_simple_plan_profile = std::make_shared<SimplePlannerFixedSizeAssignPlanProfile>();
+  ProfileDictionary::Ptr profiles = planning_server.getProfiles();
+  profiles->addProfile<SimplePlannerPlanProfile>(freespace_profile, default_simple_plan_profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(process_profile, default_simple_plan_profile);
+
+  std::size_t full_memory_usage{ 0 };
+  std::size_t task_count{ 0 };
+  {
+    // Full capture clones the environment for every task
+    request.task_info_capture_mode = TaskInfoCaptureMode::FULL;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    ASSERT_TRUE(response.interface->isSuccessful());
+
+    auto task_infos = response.interface->getTaskInfoMap();
+    ASSERT_FALSE(task_infos.empty());
+    for (const auto& task_info : task_infos)
+    {
+      EXPECT_TRUE(task_info.second->environment != nullptr);
+      EXPECT_FALSE(isNullInstruction(task_info.second->results_output));
+    }
+
+    task_count = task_infos.size();
+    full_memory_usage = response.interface->getTaskInfoContainer()->getMemoryUsage();
+    EXPECT_GT(full_memory_usage, 0);
+  }
+
+  {
+    // Lightweight capture only stores the environment revision
+    request.task_info_capture_mode = TaskInfoCaptureMode::LIGHTWEIGHT;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    ASSERT_TRUE(response.interface->isSuccessful());
+
+    auto task_infos = response.interface->getTaskInfoMap();
+    EXPECT_EQ(task_infos.size(), task_count);
+    for (const auto& task_info : task_infos)
+    {
+      EXPECT_TRUE(task_info.second->environment == nullptr);
+      EXPECT_EQ(task_info.second->environment_revision, env_->getRevision());
+      EXPECT_FALSE(isNullInstruction(task_info.second->results_output));
+    }
+  }
+
+  {
+    // Only the last TaskInfos are kept
+    request.task_info_retention_policy.max_count = 5;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    ASSERT_TRUE(response.interface->isSuccessful());
+    EXPECT_EQ(response.interface->getTaskInfoMap().size(), 5);
+    EXPECT_EQ(response.interface->getTaskInfoContainer()->getRemovedCount(), task_count - 5);
+  }
+
+  {
+    // The TaskInfos are kept within the byte budget
+    request.task_info_retention_policy = TaskInfoRetentionPolicy();
+    request.task_info_retention_policy.max_memory_usage = full_memory_usage / 4;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    ASSERT_TRUE(response.interface->isSuccessful());
+    EXPECT_LE(response.interface->getTaskInfoContainer()->getMemoryUsage(), full_memory_usage / 4);
+    EXPECT_LT(response.interface->getTaskInfoMap().size(), task_count);
+  }
+
+  {
+    // Only the TaskInfos of failed tasks are kept
+    request.task_info_retention_policy = TaskInfoRetentionPolicy();
+    request.task_info_retention_policy.failed_only = true;
+    ProcessPlanningFuture response = planning_server.run(request);
+    planning_server.waitForAll();
+    ASSERT_TRUE(response.interface->isSuccessful());
+    for (const auto& task_info : response.interface->getTaskInfoMap())
+      EXPECT_EQ(task_info.second->return_value, 0);
+  }
+}
+
+TEST_F(TesseractProcessManagerUnit, FreespaceProcessManagerRaceTest)
+{
+  // Create Process Planning Server
+  ProcessPlanningServer planning_server(std::make_shared<ProcessEnvironmentCache>(env_), 2);
+  FreespaceTaskflowParams params;
+  params.type = FreespaceTaskflowType::RACE;
+  planning_server.registerProcessPlanner("FreespaceRacePlanner", std::make_unique<FreespaceTaskflow>(params));
+
+  // Create Process Planning Request
+  ProcessPlanningRequest request;
+  request.name = "FreespaceRacePlanner";
+
+  CompositeInstruction program = freespaceExampleProgramABB(DEFAULT_PROFILE_KEY, DEFAULT_PROFILE_KEY);
+  program.setManipulatorInfo(manip);
+  request.instructions = Instruction(program);
+
+  // OMPL keeps optimizing until it runs out of time, so it only stops early if the TrajOpt branch cancels it
+  auto ompl_profile = std::make_shared<OMPLDefaultPlanProfile>();
+  ompl_profile->planning_time = 60;
+  ompl_profile->optimize = true;
+  ompl_profile->max_solutions = std::numeric_limits<int>::max();
+  planning_server.getProfiles()->addProfile<OMPLPlanProfile>(DEFAULT_PROFILE_KEY, ompl_profile);
+
+  auto start = std::chrono::steady_clock::now();
+  ProcessPlanningFuture response = planning_server.run(request);
+  planning_server.waitForAll();
+  ASSERT_TRUE(response.interface->isSuccessful());
+  EXPECT_TRUE(isCompositeInstruction(*(response.results)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+
+  // Exactly one of the branches provided the results
+  int passed = 0;
+  int trajopt_runs = 0;
+  int ompl_runs = 0;
+  for (const auto& task_info : response.interface->getTaskInfoMap())
+  {
+    if (task_info.second->task_name == "Race Result")
+    {
+      EXPECT_EQ(task_info.second->return_value, 1);
+      EXPECT_EQ(task_info.second->message, "TrajOpt");
+      ++passed;
+    }
+    else if (task_info.second->task_name == "OMPL")
+    {
+      // The losing branch saw its cancellation token cancelled
+      EXPECT_EQ(task_info.second->return_value, 0);
+      EXPECT_EQ(task_info.second->message, "Planning was cancelled");
+      ++ompl_runs;
+    }
+    else if (task_info.second->task_name == "TRAJOPT")
+    {
+      ++trajopt_runs;
+    }
+  }
+  EXPECT_EQ(passed, 1);
+  EXPECT_EQ(ompl_runs, 1);
+
+  // The losing branch stopped without running its TrajOpt stage
+  EXPECT_EQ(trajopt_runs, 1);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -216,6 +216,54 @@ public:
                const Eigen::Ref<const Eigen::VectorXd>& max_velocity_scaling_factors,
                const Eigen::Ref<const Eigen::VectorXd>& max_acceleration_scaling_factors) const;
 
+  /**
+   * @brief Compute the time stamps for a trajectory segment
+   * @param trajectory The trajectory segment, the first and last velocities and accelerations are used as constraints
+   * @param max_velocities The max velocities for each joint
+   * @param max_accelerations The max acceleration for each joint
+   * @param max_velocity_scaling_factor The max velocity scaling factor
+   * @param max_acceleration_scaling_factor The max acceleration scaling factor
+   * @return True if successful, otherwise false
+   */
+  bool compute(TrajectorySegmentInstruction& trajectory,
+               const double& max_velocity,
+               const double& max_acceleration,
+               double max_velocity_scaling_factor = 1.0,
+               double max_acceleration_scaling_factor = 1.0) const;
+
+  /**
+   * @brief Compute the time stamps for a trajectory segment
+   * @param trajectory The trajectory segment, the first and last velocities and accelerations are used as constraints
+   * @param max_velocities The max velocities for each joint
+   * @param max_accelerations The max acceleration for each joint
+   * @param max_velocity_scaling_factor The max velocity scaling factor
+   * @param max_acceleration_scaling_factor The max acceleration scaling factor
+   * @return True if successful, otherwise false
+   */
+  bool compute(TrajectorySegmentInstruction& trajectory,
+               const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+               double max_velocity_scaling_factor = 1.0,
+               double max_acceleration_scaling_factor = 1.0) const;
+
+  /**
+   * @brief Compute the time stamps for a trajectory segment
+   *
+   * This operates directly on the contiguous blocks of the segment and is used by all other overloads.
+   *
+   * @param trajectory The trajectory segment, the first and last velocities and accelerations are used as constraints
+   * @param max_velocities The max velocities for each joint
+   * @param max_accelerations The max acceleration for each joint
+   * @param max_velocity_scaling_factor The max velocity scaling factor. Size should be trajectory.size()
+   * @param max_acceleration_scaling_factor The max acceleration scaling factor. Size should be trajectory.size()
+   * @return True if successful, otherwise false
+   */
+  bool compute(TrajectorySegmentInstruction& trajectory,
+               const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+               const Eigen::Ref<const Eigen::VectorXd>& max_velocity_scaling_factors,
+               const Eigen::Ref<const Eigen::VectorXd>& max_acceleration_scaling_factors) const;
+
 private:
   /**
    * @brief If true, add two points to trajectory (first and last segments).
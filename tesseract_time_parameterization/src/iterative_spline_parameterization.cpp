@@ -232,26 +232,96 @@ bool IterativeSplineParameterization::compute(
     const Eigen::Ref<const Eigen::VectorXd>& max_velocity_scaling_factors,
     const Eigen::Ref<const Eigen::VectorXd>& max_acceleration_scaling_factors) const
 {
-  // Make a copy of the vector in case it introduces point we do not want it to modify the original trajectory size
-  // just the data.
-  std::vector<std::reference_wrapper<Instruction>> local_trajectory = trajectory;
-  Instruction point_to_insert_front{ NullInstruction() };
-  Instruction point_to_insert_back{ NullInstruction() };
-
-  if (local_trajectory.empty())
+  if (trajectory.empty())
     return true;
 
-  Eigen::VectorXd velocity_scaling_factor = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(trajectory.size()));
-  Eigen::VectorXd acceleration_scaling_factor = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(trajectory.size()));
-  std::size_t num_points = local_trajectory.size();
+  // Gather the states into contiguous blocks, only the first and last velocity and acceleration are used as constraints
+  const auto num_points = static_cast<Eigen::Index>(trajectory.size());
 
-  assert(isMoveInstruction(local_trajectory[0].get()));
-  auto& mi = local_trajectory[0].get().as<MoveInstruction>();
+  assert(isMoveInstruction(trajectory[0].get()));
+  const auto& start_swp = trajectory[0].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
 
-  assert(isStateWaypoint(mi.getWaypoint()));
-  auto& swp = mi.getWaypoint().as<StateWaypoint>();
+  assert(isMoveInstruction(trajectory.back().get()));
+  const auto& last_swp = trajectory.back().get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
 
-  auto num_joints = static_cast<std::size_t>(swp.position.size());
+  TrajectorySegmentInstruction segment(start_swp.joint_names, start_swp.position.size(), num_points);
+  for (Eigen::Index i = 0; i < num_points; i++)
+  {
+    assert(isMoveInstruction(trajectory[static_cast<std::size_t>(i)].get()));
+    const auto& swp =
+        trajectory[static_cast<std::size_t>(i)].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+    segment.getPositions().col(i) = swp.position;
+  }
+
+  segment.getTimes()(0) = start_swp.time;
+  if (start_swp.velocity.size() > 0)
+    segment.getVelocities().col(0) = start_swp.velocity;
+  if (start_swp.acceleration.size() > 0)
+    segment.getAccelerations().col(0) = start_swp.acceleration;
+  if (last_swp.velocity.size() > 0)
+    segment.getVelocities().col(num_points - 1) = last_swp.velocity;
+  if (last_swp.acceleration.size() > 0)
+    segment.getAccelerations().col(num_points - 1) = last_swp.acceleration;
+
+  if (!compute(segment, max_velocity, max_acceleration, max_velocity_scaling_factors, max_acceleration_scaling_factors))
+    return false;
+
+  // Scatter the results back into the move instructions
+  for (Eigen::Index i = 0; i < num_points; i++)
+  {
+    auto& swp = trajectory[static_cast<std::size_t>(i)].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+    swp.time = segment.getTimes()(i);
+    swp.velocity = segment.getVelocities().col(i);
+    swp.acceleration = segment.getAccelerations().col(i);
+  }
+
+  return true;
+}
+
+bool IterativeSplineParameterization::compute(TrajectorySegmentInstruction& trajectory,
+                                              const double& max_velocity,
+                                              const double& max_acceleration,
+                                              double max_velocity_scaling_factor,
+                                              double max_acceleration_scaling_factor) const
+{
+  return compute(trajectory,
+                 Eigen::VectorXd::Constant(trajectory.getPositions().rows(), max_velocity),
+                 Eigen::VectorXd::Constant(trajectory.getPositions().rows(), max_acceleration),
+                 max_velocity_scaling_factor,
+                 max_acceleration_scaling_factor);
+}
+
+bool IterativeSplineParameterization::compute(TrajectorySegmentInstruction& trajectory,
+                                              const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+                                              const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+                                              double max_velocity_scaling_factor,
+                                              double max_acceleration_scaling_factor) const
+{
+  Eigen::VectorXd max_velocity_scaling_factors =
+      Eigen::VectorXd::Constant(trajectory.size(), max_velocity_scaling_factor);
+  Eigen::VectorXd max_acceleration_scaling_factors =
+      Eigen::VectorXd::Constant(trajectory.size(), max_acceleration_scaling_factor);
+  return compute(
+      trajectory, max_velocity, max_acceleration, max_velocity_scaling_factors, max_acceleration_scaling_factors);
+}
+
+bool IterativeSplineParameterization::compute(
+    TrajectorySegmentInstruction& trajectory,
+    const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+    const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+    const Eigen::Ref<const Eigen::VectorXd>& max_velocity_scaling_factors,
+    const Eigen::Ref<const Eigen::VectorXd>& max_acceleration_scaling_factors) const
+{
+  if (trajectory.empty())
+    return true;
+
+  const Eigen::MatrixXd& original_positions = trajectory.getPositions();
+  const auto num_original_points = static_cast<std::size_t>(original_positions.cols());
+  auto num_joints = static_cast<std::size_t>(original_positions.rows());
+  std::size_t num_points = num_original_points;
+
+  Eigen::VectorXd velocity_scaling_factor = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points));
+  Eigen::VectorXd acceleration_scaling_factor = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points));
 
   if (static_cast<std::size_t>(max_velocity.size()) != num_joints ||
       static_cast<std::size_t>(max_acceleration.size()) != num_joints)
@@ -303,93 +373,72 @@ bool IterativeSplineParameterization::compute(
     }
   }
 
-  if (add_points_)
+  // Make a copy of the positions in case points are introduced, we do not want to modify the original trajectory size
+  // just the data.
+  Eigen::MatrixXd positions;
+  bool points_added = false;
+  if (add_points_ && num_original_points >= 2)
   {
     // Insert 2nd and 2nd-last points
     // (required to force acceleration to specified values at endpoints)
-    if (local_trajectory.size() >= 2)
-    {
-      point_to_insert_front = local_trajectory[1].get();
-      auto& point_to_insert_front_swp = point_to_insert_front.as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-
-      // 2nd point is 90% of p0, and 10% of p1
-      const auto& point_first = local_trajectory[0].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      const auto& point_second = local_trajectory[1].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      for (unsigned int j = 0; j < num_joints; j++)
-      {
-        point_to_insert_front_swp.position[j] = 0.9 * point_first.position[j] + 0.1 * point_second.position[j];
-      }
-      local_trajectory.insert(local_trajectory.begin() + 1, point_to_insert_front);
-      num_points++;
-
-      point_to_insert_back = local_trajectory[num_points - 2].get();
-      auto& point_to_insert_back_swp = point_to_insert_back.as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-
-      // 2nd-last point is 10% of p0, and 90% of p1
-      const auto& point_second_to_last =
-          local_trajectory[num_points - 2].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      const auto& point_last =
-          local_trajectory[num_points - 1].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      for (unsigned int j = 0; j < num_joints; j++)
-      {
-        point_to_insert_back_swp.position[j] = 0.1 * point_second_to_last.position[j] + 0.9 * point_last.position[j];
-      }
-      local_trajectory.insert(local_trajectory.end() - 1, point_to_insert_back);
-      num_points++;
-
-      // Add points to scaling factors
-      auto velocity_scaling_factor_tmp = velocity_scaling_factor;
-      auto acceleration_scaling_factor_tmp = acceleration_scaling_factor;
-      velocity_scaling_factor.resize(velocity_scaling_factor.size() + 2);
-      acceleration_scaling_factor.resize(acceleration_scaling_factor.size() + 2);
-
-      velocity_scaling_factor[0] = velocity_scaling_factor_tmp[0];
-      acceleration_scaling_factor[0] = acceleration_scaling_factor_tmp[0];
-      velocity_scaling_factor.block(1, 0, velocity_scaling_factor_tmp.size(), 1) = velocity_scaling_factor_tmp;
-      acceleration_scaling_factor.block(1, 0, acceleration_scaling_factor_tmp.size(), 1) =
-          acceleration_scaling_factor_tmp;
-      velocity_scaling_factor.bottomRows(1) = velocity_scaling_factor_tmp.bottomRows(1);
-      acceleration_scaling_factor.bottomRows(1) = acceleration_scaling_factor_tmp.bottomRows(1);
-    }
+    const auto n = static_cast<Eigen::Index>(num_original_points);
+    positions.resize(original_positions.rows(), n + 2);
+    positions.col(0) = original_positions.col(0);
+    positions.middleCols(2, n - 1) = original_positions.rightCols(n - 1);
+
+    // 2nd point is 90% of p0, and 10% of p1
+    positions.col(1) = 0.9 * original_positions.col(0) + 0.1 * original_positions.col(1);
+
+    // 2nd-last point is 10% of p0, and 90% of p1
+    positions.col(n + 1) = positions.col(n);
+    positions.col(n) = 0.1 * positions.col(n - 1) + 0.9 * positions.col(n + 1);
+
+    num_points += 2;
+    points_added = true;
+
+    // Add points to scaling factors
+    auto velocity_scaling_factor_tmp = velocity_scaling_factor;
+    auto acceleration_scaling_factor_tmp = acceleration_scaling_factor;
+    velocity_scaling_factor.resize(velocity_scaling_factor.size() + 2);
+    acceleration_scaling_factor.resize(acceleration_scaling_factor.size() + 2);
+
+    velocity_scaling_factor[0] = velocity_scaling_factor_tmp[0];
+    acceleration_scaling_factor[0] = acceleration_scaling_factor_tmp[0];
+    velocity_scaling_factor.block(1, 0, velocity_scaling_factor_tmp.size(), 1) = velocity_scaling_factor_tmp;
+    acceleration_scaling_factor.block(1, 0, acceleration_scaling_factor_tmp.size(), 1) =
+        acceleration_scaling_factor_tmp;
+    velocity_scaling_factor.bottomRows(1) = velocity_scaling_factor_tmp.bottomRows(1);
+    acceleration_scaling_factor.bottomRows(1) = acceleration_scaling_factor_tmp.bottomRows(1);
+  }
+  else
+  {
+    positions = original_positions;
   }
 
-  // JointTrajectory indexes in [point][joint] order.
-  // We need [joint][point] order to solve efficiently,
-  // so convert form here.
+  // The trajectory is stored as [joint][point], the solver needs each joint's points contiguous so convert here.
 
   std::vector<SingleJointTrajectory> t2(num_joints);
 
+  const auto last_original_point = static_cast<Eigen::Index>(num_original_points) - 1;
   for (unsigned int j = 0; j < num_joints; j++)
   {
+    const auto joint = static_cast<Eigen::Index>(j);
+
     // Copy positions
     t2[j].positions_.resize(num_points, 0.0);
     for (unsigned int i = 0; i < num_points; i++)
-    {
-      const auto& swp = local_trajectory[i].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-      t2[j].positions_[i] = swp.position[j];
-    }
+      t2[j].positions_[i] = positions(joint, static_cast<Eigen::Index>(i));
 
-    // Initialize velocities
-    const auto& start_swp = local_trajectory[0].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-    const auto& last_swp =
-        local_trajectory[num_points - 1].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
+    // Initialize velocities, copying initial/final velocities
     t2[j].velocities_.resize(num_points, 0.0);
-    // Copy initial/final velocities if specified
-    if (start_swp.velocity.size() > 0)
-      t2[j].velocities_[0] = start_swp.velocity[j];
-    if (last_swp.velocity.size() > 0)
-      t2[j].velocities_[num_points - 1] = last_swp.velocity[j];
+    t2[j].velocities_[0] = trajectory.getVelocities()(joint, 0);
+    t2[j].velocities_[num_points - 1] = trajectory.getVelocities()(joint, last_original_point);
 
-    // Initialize accelerations
+    // Initialize accelerations, copying initial/final accelerations
     t2[j].accelerations_.resize(num_points, 0.0);
-    t2[j].initial_acceleration_ = 0.0;
-    t2[j].final_acceleration_ = 0.0;
-    // Copy initial/final accelerations if specified
-    if (start_swp.acceleration.size() > 0)
-      t2[j].initial_acceleration_ = start_swp.acceleration[j];
+    t2[j].initial_acceleration_ = trajectory.getAccelerations()(joint, 0);
     t2[j].accelerations_[0] = t2[j].initial_acceleration_;
-    if (last_swp.acceleration.size() > 0)
-      t2[j].final_acceleration_ = last_swp.acceleration[j];
+    t2[j].final_acceleration_ = trajectory.getAccelerations()(joint, last_original_point);
     t2[j].accelerations_[num_points - 1] = t2[j].final_acceleration_;
 
     // Set bounds based on inputs
@@ -466,7 +515,7 @@ bool IterativeSplineParameterization::compute(
   // Initialize times
   // start with valid velocities, then expand intervals
   // epsilon to prevent divide-by-zero
-  std::vector<double> time_diff(local_trajectory.size() - 1, std::numeric_limits<double>::epsilon());
+  std::vector<double> time_diff(num_points - 1, std::numeric_limits<double>::epsilon());
   for (unsigned int j = 0; j < num_joints; j++)
     init_times(
         static_cast<int>(num_points), &time_diff[0], &t2[j].positions_[0], t2[j].max_velocity_, t2[j].min_velocity_);
@@ -526,31 +575,28 @@ bool IterativeSplineParameterization::compute(
   // Final adjustment forces the trajectory within bounds
   globalAdjustment(t2, static_cast<int>(num_joints), static_cast<int>(num_points), time_diff);
 
-  // Convert back to JointTrajectory form
-  for (unsigned int i = 1; i < num_points; i++)
-  {
-    auto& swp = local_trajectory[i].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-    const auto& pre_swp = local_trajectory[i - 1].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-    swp.time = pre_swp.time + time_diff[i - 1];
-  }
+  // Convert back to trajectory form, skipping the points that were added
+  Eigen::VectorXd& times = trajectory.getTimes();
+  Eigen::MatrixXd& velocities = trajectory.getVelocities();
+  Eigen::MatrixXd& accelerations = trajectory.getAccelerations();
 
+  double time = times(0);
+  Eigen::Index idx = 0;
   for (unsigned int i = 0; i < num_points; i++)
   {
-    auto& swp = local_trajectory[i].get().as<MoveInstruction>().getWaypoint().as<StateWaypoint>();
-    swp.velocity.resize(static_cast<long>(num_joints));
-    swp.acceleration.resize(static_cast<long>(num_joints));
-    for (unsigned int j = 0; j < num_joints; j++)
-    {
-      swp.velocity[j] = t2[j].velocities_[i];
-      swp.acceleration[j] = t2[j].accelerations_[i];
-    }
+    if (i > 0)
+      time += time_diff[i - 1];
 
-    // Only update position of additionally inserted points (at second and next-to-last position)
-    if (add_points_ && (i == 1 || i == num_points - 2))
+    if (points_added && (i == 1 || i == num_points - 2))
+      continue;
+
+    times(idx) = time;
+    for (unsigned int j = 0; j < num_joints; j++)
     {
-      for (unsigned int j = 0; j < num_joints; j++)
-        swp.velocity[j] = t2[j].velocities_[i];
+      velocities(static_cast<Eigen::Index>(j), idx) = t2[j].velocities_[i];
+      accelerations(static_cast<Eigen::Index>(j), idx) = t2[j].accelerations_[i];
     }
+    ++idx;
   }
 
   return true;
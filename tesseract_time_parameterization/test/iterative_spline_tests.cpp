@@ -41,6 +41,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/command_language.h>
+#include <tesseract_command_language/utils/utils.h>
 #include <tesseract_time_parameterization/iterative_spline_parameterization.h>
 
 using namespace tesseract_planning;
@@ -150,6 +151,51 @@ TEST(TestTimeParameterization, TestRepeatedPoint)
   ASSERT_LT(program.back().as<MoveInstruction>().getWaypoint().as<StateWaypoint>().time, 0.001);
 }
 
+TEST(TestTimeParameterization, TestIterativeSplineTrajectorySegment)
+{
+  IterativeSplineParameterization time_parameterization(true);
+  CompositeInstruction program = createStraightTrajectory();
+  TrajectorySegmentInstruction segment = toTrajectorySegment(program);
+  Eigen::VectorXd max_velocity(6);
+  max_velocity << 2.088, 2.082, 3.27, 3.6, 3.3, 3.078;
+  Eigen::VectorXd max_acceleration = Eigen::VectorXd::Ones(6);
+  EXPECT_TRUE(time_parameterization.compute(program, max_velocity, max_acceleration));
+  EXPECT_TRUE(time_parameterization.compute(segment, max_velocity, max_acceleration));
+
+  // Both representations should produce the same result
+  tesseract_common::JointTrajectory trajectory = toJointTrajectory(program);
+  ASSERT_EQ(static_cast<Eigen::Index>(trajectory.size()), segment.size());
+  for (Eigen::Index i = 0; i < segment.size(); ++i)
+  {
+    const auto& state = trajectory[static_cast<std::size_t>(i)];
+    EXPECT_NEAR(state.time, segment.getTimes()(i), 1e-6);
+    EXPECT_TRUE(state.velocity.isApprox(segment.getVelocities().col(i), 1e-6));
+    EXPECT_TRUE(state.acceleration.isApprox(segment.getAccelerations().col(i), 1e-6));
+  }
+  EXPECT_LT(segment.getTimes()(segment.size() - 1), 5.0);
+}
+
+TEST(TestTimeParameterization, TestIterativeSplineWithoutJointNames)
+{
+  IterativeSplineParameterization time_parameterization(true);
+  CompositeInstruction program = createStraightTrajectory();
+  CompositeInstruction unnamed_program = createStraightTrajectory();
+
+  // The joint names are only metadata, the number of joints comes from the positions
+  unnamed_program.getStartInstruction().as<MoveInstruction>().getWaypoint().as<StateWaypoint>().joint_names.clear();
+  for (auto& instruction : unnamed_program)
+    instruction.as<MoveInstruction>().getWaypoint().as<StateWaypoint>().joint_names.clear();
+
+  Eigen::VectorXd max_velocity(6);
+  max_velocity << 2.088, 2.082, 3.27, 3.6, 3.3, 3.078;
+  Eigen::VectorXd max_acceleration = Eigen::VectorXd::Ones(6);
+  EXPECT_TRUE(time_parameterization.compute(program, max_velocity, max_acceleration));
+  EXPECT_TRUE(time_parameterization.compute(unnamed_program, max_velocity, max_acceleration));
+  EXPECT_NEAR(program.back().as<MoveInstruction>().getWaypoint().as<StateWaypoint>().time,
+              unnamed_program.back().as<MoveInstruction>().getWaypoint().as<StateWaypoint>().time,
+              1e-6);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);